@@ -1710,6 +1710,12 @@ display(int otype, int ptype, char *oname, struct batch_status *status,
 
 		while (attr != NULL) {
 			if (format) {
+				if (((otype == MGR_OBJ_SITE_HOOK) || (otype == MGR_OBJ_PBS_HOOK)) &&
+					IS_HOOK_RUN_STAT(attr->name)) {
+					/* read-only run statistics can't be set back */
+					attr = attr->next;
+					continue;
+				}
 				if ((otype == MGR_OBJ_SITE_HOOK) || (otype == MGR_OBJ_PBS_HOOK) ||
 					is_attr(otype, attr->name, TYPE_ATTR_PUBLIC)) {
 					if ((otype != MGR_OBJ_SITE_HOOK) && (otype != MGR_OBJ_PBS_HOOK) &&
@@ -85,6 +85,7 @@ extern "C" {
 #define PBS_ACCT_PROV_END	(int)'p'	/* Provisioning end record */
 
 extern int  acct_open(char *filename);
+extern void acct_flush(void);
 extern void acct_close(void);
 extern void account_record(int acctype, const job *pjob, char *text);
 extern void write_account_record(int acctype, const char *jobid, char *text);
@@ -112,6 +112,20 @@ struct rq_deletejoblist {
 	int subjobid_to_resume;
 };
 
+/* RunJobList */
+struct rq_runjoblist {
+	int rq_count;
+	char **rq_jobslist;
+	char **rq_destins;	/* execvnode of each job in rq_jobslist */
+};
+
+/* ModifyJobList */
+struct rq_modifyjoblist {
+	int rq_count;
+	char **rq_jobslist;
+	pbs_list_head *rq_attrs; /* svrattrlist of each job in rq_jobslist */
+};
+
 /* Management - used by PBS_BATCH_Manager requests */
 struct rq_management {
 	struct rq_manage rq_manager;
@@ -187,6 +201,13 @@ struct rq_status {
 	pbs_list_head rq_attr;
 };
 
+/* Status Delta, objects changed after a change sequence number */
+struct rq_statdelta {
+	int rq_objtype;		/* MGR_OBJ_JOB or MGR_OBJ_NODE */
+	long rq_seq;		/* client's change sequence number */
+	pbs_list_head rq_attr;
+};
+
 /* Select Job  and selstat */
 struct rq_selstat {
 	pbs_list_head rq_selattr;
@@ -309,6 +330,8 @@ struct batch_request {
 		char rq_commit[PBS_MAXSVRJOBID + 1];
 		struct rq_manage rq_delete;
 		struct rq_deletejoblist rq_deletejoblist;
+		struct rq_runjoblist rq_runjoblist;
+		struct rq_modifyjoblist rq_modifyjoblist;
 		struct rq_hold rq_hold;
 		char rq_locate[PBS_MAXSVRJOBID + 1];
 		struct rq_manage rq_manager;
@@ -328,6 +351,7 @@ struct batch_request {
 		int rq_shutdown;
 		struct rq_signal rq_signal;
 		struct rq_status rq_status;
+		struct rq_statdelta rq_statdelta;
 		struct rq_track rq_track;
 		struct rq_cpyfile rq_cpyfile;
 		struct rq_cpyfile_cred rq_cpyfile_cred;
@@ -350,6 +374,7 @@ extern void reply_badattr_msg(int, int, svrattrl *, struct batch_request *, int)
 extern int reply_text(struct batch_request *, int, char *);
 extern int reply_send(struct batch_request *);
 extern int reply_send_status_part(struct batch_request *);
+extern int add_joblist_stat(struct batch_request *, char *, int);
 extern int reply_jobid(struct batch_request *, char *, int);
 extern int reply_jobid_msg(struct batch_request *, char *, int, int);
 extern void reply_free(struct batch_reply *);
@@ -357,6 +382,7 @@ extern void dispatch_request(int, struct batch_request *);
 extern void free_br(struct batch_request *);
 extern int isode_request_read(int, struct batch_request *);
 extern void req_stat_job(struct batch_request *);
+extern void req_stat_delta(struct batch_request *);
 extern void req_stat_resv(struct batch_request *);
 extern void req_stat_resc(struct batch_request *);
 extern void req_rerunjob(struct batch_request *);
@@ -372,11 +398,13 @@ extern void req_connect(struct batch_request *);
 extern void req_defschedreply(struct batch_request *);
 extern void req_locatejob(struct batch_request *);
 extern void req_manager(struct batch_request *);
+extern void req_modifyjoblist(struct batch_request *);
 extern void req_movejob(struct batch_request *);
 extern void req_register(struct batch_request *);
 extern void req_releasejob(struct batch_request *);
 extern void req_rescq(struct batch_request *);
 extern void req_runjob(struct batch_request *);
+extern void req_runjoblist(struct batch_request *);
 extern void req_selectjobs(struct batch_request *);
 extern void req_stat_que(struct batch_request *);
 extern void req_stat_svr(struct batch_request *);
@@ -409,6 +437,7 @@ extern int decode_DIS_DelJobList(int, struct batch_request *);
 extern int decode_DIS_MoveJob(int, struct batch_request *);
 extern int decode_DIS_MessageJob(int, struct batch_request *);
 extern int decode_DIS_ModifyResv(int, struct batch_request *);
+extern int decode_DIS_ModifyJobList(int, struct batch_request *);
 extern int decode_DIS_PySpawn(int, struct batch_request *);
 extern int decode_DIS_QueueJob(int, struct batch_request *);
 extern int decode_DIS_Register(int, struct batch_request *);
@@ -418,9 +447,11 @@ extern int decode_DIS_ReqHdr(int, struct batch_request *, int *, int *);
 extern int decode_DIS_Rescl(int, struct batch_request *);
 extern int decode_DIS_Rescq(int, struct batch_request *);
 extern int decode_DIS_Run(int, struct batch_request *);
+extern int decode_DIS_RunJobList(int, struct batch_request *);
 extern int decode_DIS_ShutDown(int, struct batch_request *);
 extern int decode_DIS_SignalJob(int, struct batch_request *);
 extern int decode_DIS_Status(int, struct batch_request *);
+extern int decode_DIS_StatusDelta(int, struct batch_request *);
 extern int decode_DIS_TrackJob(int, struct batch_request *);
 extern int decode_DIS_replySvr(int, struct batch_reply *);
 extern int decode_DIS_svrattrl(int, pbs_list_head *);
@@ -434,6 +465,7 @@ extern int encode_DIS_TrackJob(int, struct batch_request *);
 extern int encode_DIS_reply(int, struct batch_reply *);
 extern int encode_DIS_replyTPP(int, char *, struct batch_reply *);
 extern int encode_DIS_svrattrl(int, svrattrl *);
+extern void free_brp_encoded(struct brp_encoded *);
 extern int encode_DIS_Cred(int, char *, char *, int, char *, size_t, long);
 extern int dis_request_read(int, struct batch_request *);
 extern int dis_reply_read(int, struct batch_reply *, int);
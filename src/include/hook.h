@@ -158,6 +158,13 @@ struct hook {
 	pbs_list_link	hi_execjob_postsuspend_hooks;
 	pbs_list_link	hi_execjob_preresume_hooks;
 	struct work_task *ptask;		    /* work task pointer, used in periodic hooks */
+	/* run statistics, see hook_run_stat_start() */
+	unsigned long	run_count;	/* number of runs */
+	double		run_walltime;	/* total walltime of the runs, in seconds */
+	double		run_walltime_max; /* longest run, in seconds */
+	double		run_cputime;	/* total cputime of the runs, in seconds */
+	double		run_start_walltime; /* start of the current run */
+	double		run_start_cputime;
 };
 
 typedef struct hook hook;
@@ -210,6 +217,20 @@ typedef struct hook hook;
 #define	HOOKATT_FAIL_ACTION	"fail_action"
 #define	HOOKATT_PENDING_DELETE  "pending_delete"
 
+/* Read-only hook run statistics, reported by "list hook" */
+#define	HOOKATT_RUN_COUNT	"run_count"
+#define	HOOKATT_RUN_WALLTIME	"run_walltime"
+#define	HOOKATT_RUN_WALLTIME_MAX "run_walltime_max"
+#define	HOOKATT_RUN_CPUTIME	"run_cputime"
+#define	IS_HOOK_RUN_STAT(n)	((strcmp((n), HOOKATT_RUN_COUNT) == 0) || \
+				(strcmp((n), HOOKATT_RUN_WALLTIME) == 0) || \
+				(strcmp((n), HOOKATT_RUN_WALLTIME_MAX) == 0) || \
+				(strcmp((n), HOOKATT_RUN_CPUTIME) == 0))
+
+/* Event params built on first use, see pbs_python_set_event_param_loader() */
+#define	HOOK_REFS_VNODE_LIST	0x1	/* pbs.event().vnode_list */
+#define	HOOK_REFS_RESV_LIST	0x2	/* pbs.event().resv_list */
+
 #define	HOOK_PBS_PREFIX		"PBS"  /* valid Hook name prefix for PBS hook */
 
 /* Valid Hook type values */
@@ -302,6 +323,18 @@ typedef struct hook hook;
 #define	FMT_HOOK_RESCDEF_COPY "%s" FMT_HOOK_PREFIX "resourcedef.%s"
 #define	FMT_HOOK_LOG "%s" FMT_HOOK_PREFIX "log%d"
 
+/*
+ * A pbs_python started in HOOK_PRELOAD_MODE keeps Python loaded and forks
+ * a process per hook event requested over a socket in the hooks work
+ * directory.  A request is a 4 byte length followed by the NUL terminated
+ * working directory, PBS_HOOK_CONFIG_FILE value ("" for none) and
+ * "pbs_python --hook" arguments; the reply is the 4 byte wait status.
+ */
+#define	HOOK_PRELOAD_MODE "--hook-preload"
+#define	HOOK_PRELOAD_SOCKET "pbs_python.sock"
+#define	HOOK_PRELOAD_LOCK "pbs_python.lock"	/* flock()ed while running, holds its pid */
+#define	HOOK_PRELOAD_MAXREQ 65536
+
 /* Special log levels  - values must not intersect PBS_EVENT* values in log.h */
 
 #define SEVERITY_LOG_DEBUG		0x0005		/* syslog DEBUG */
@@ -401,6 +434,8 @@ extern int set_alarm(int sec, void (*)(void));
 
 extern void hook_perf_stat_start(char *label, char *action, int);
 extern void hook_perf_stat_stop(char *label, char *action, int);
+extern void hook_run_stat_start(hook *);
+extern void hook_run_stat_stop(hook *, int);
 #define HOOK_PERF_POPULATE "populate"
 #define HOOK_PERF_FUNC "hook_func"
 #define HOOK_PERF_RUN_CODE "run_code"
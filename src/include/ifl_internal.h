@@ -57,6 +57,8 @@ int __pbs_alterjob(int, char *, struct attrl *, char *);
 
 int __pbs_asyalterjob(int, char *, struct attrl *, char *);
 
+struct batch_deljob_status *__pbs_alterjoblist(int, char **, struct attrl **, int, char *);
+
 int __pbs_confirmresv(int, char *, char *, unsigned long, char *);
 
 int __pbs_connect(char *);
@@ -93,6 +95,8 @@ int __pbs_rlsjob(int, char *, char *, char *);
 
 int __pbs_runjob(int, char *, char *, char *);
 
+struct batch_deljob_status *__pbs_runjoblist(int, char **, char **, int, char *);
+
 char **__pbs_selectjob(int, struct attropl *, char *);
 
 int __pbs_sigjob(int, char *, char *, char *);
@@ -105,6 +109,8 @@ struct batch_status *__pbs_statrsc(int, char *, struct attrl *, char *);
 
 struct batch_status *__pbs_statjob(int, char *, struct attrl *, char *);
 
+struct batch_status *__pbs_statdelta(int, int, long, long *, struct attrl *, char *);
+
 struct batch_status *__pbs_selstat(int, struct attropl *, struct attrl *, char *);
 
 struct batch_status *__pbs_statque(int, char *, struct attrl *, char *);
@@ -234,6 +234,18 @@ typedef enum histjob_type {
 			 MOM failure.*/
 } histjob_type;
 
+/*
+ * Encoded status of a job for one privilege level and attribute selection,
+ * reused by status_job() while the job's change sequence number is unchanged.
+ */
+#define JOB_STATCACHE_SLOTS 2
+struct job_statcache {
+	struct brp_encoded *jsc_enc;
+	long jsc_chgseq;		/* JOB_ATR_chgseq when encoded */
+	int jsc_key;			/* privilege and server settings, see status_job() */
+	char *jsc_select;		/* requested attributes, "" for all */
+};
+
 #endif /* SERVER only! */
 
 #ifdef	PBS_MOM
@@ -348,8 +360,13 @@ typedef struct ajinfo {
 	int tkm_subjsct[PBS_NUMJOBSTATE]; /* count of subjobs in various states */
 	int tkm_dsubjsct;		  /* count of deleted subjobs */
 	range *trm_quelist;		  /* pointer to range list */
+	unsigned char *tkm_sjflags;	  /* TKM_SJ_* flags of each index, (index - start) / step */
 } ajinfo_t;
 
+/* per subjob index flags in tkm_sjflags */
+#define TKM_SJ_QUEUED	0x01	/* index is in trm_quelist */
+#define TKM_SJ_CREATED	0x02	/* a job structure may exist for the subjob */
+
 /*
  * Discard Job Structure,  see Server's discard_job function
  *	Used to record which Mom has responded to when we need to tell them
@@ -531,6 +548,9 @@ struct job {
 	int preempt_order_index;
 	struct work_task *ji_prov_startjob_task;
 
+	struct job_statcache ji_statcache[JOB_STATCACHE_SLOTS]; /* see status_job() */
+	int ji_modseq;		     /* modified since chgseq was stamped, see job_chgseq_update() */
+
 #endif /* END SERVER ONLY */
 
 	/*
@@ -1081,12 +1101,14 @@ extern int job_save_db(job *);
 #define job_recov job_recov_db
 
 extern char *get_job_credid(char *);
+extern void job_statcache_free(job *);
 #endif
 
 #ifdef	_BATCH_REQUEST_H
 extern job  *chk_job_request(char *, struct batch_request *, int *, int *);
 extern int   net_move(job *, struct batch_request *);
 extern int   svr_chk_owner(struct batch_request *, job *);
+extern int   svr_chk_owner_name(struct batch_request *, char *);
 extern int   svr_movejob(job *, char *, struct batch_request *);
 extern struct batch_request *cpy_stage(struct batch_request *, job *, enum job_atr, int);
 
@@ -165,12 +165,20 @@ struct brp_select {
 	char brp_jobid[PBS_MAXSVRJOBID + 1];
 };
 
+/* DIS encoded attribute list of a status reply, shared by reference count */
+struct brp_encoded {
+	int be_refct;
+	size_t be_len;
+	char *be_data; /* NULL until the attribute list is first encoded */
+};
+
 /* reply to Status Job/Queue/Server Request */
 struct brp_status {
 	pbs_list_link brp_stlink;
 	int brp_objtype;
 	char brp_objname[(PBS_MAXSVRJOBID > PBS_MAXDEST ? PBS_MAXSVRJOBID : PBS_MAXDEST) + 1];
 	pbs_list_head brp_attr; /* head of svrattrlist */
+	struct brp_encoded *brp_enc; /* if set, encoding of brp_attr to reuse or fill in */
 };
 
 /* reply to Resource Query Request */
@@ -310,6 +318,12 @@ struct batch_reply
 #define PBS_BATCH_ModifyVnode    	99
 #define PBS_BATCH_DeleteJobList  	100
 #define PBS_BATCH_ServerReady    	101
+#define PBS_BATCH_StatusDelta    	102
+#define PBS_BATCH_RunJobList     	103
+#define PBS_BATCH_ModifyJobList  	104
+
+#define PBS_RUNJOBLIST_MAX	10000	/* most jobs in one Run Job List request */
+#define PBS_MODIFYJOBLIST_MAX	10000	/* most jobs in one Modify Job List request */
 
 #define PBS_BATCH_FileOpt_Default	0
 #define PBS_BATCH_FileOpt_OFlg		1
@@ -374,6 +388,7 @@ int encode_DIS_UserCred(int, char *, int, char *, int);
 int encode_DIS_JobFile(int, int, char *, int, char *, int);
 int encode_DIS_JobId(int, char *);
 int encode_DIS_Manage(int, int, int, char *, struct attropl *);
+int encode_DIS_ModifyJobList(int, char **, struct attrl **, int);
 int encode_DIS_MessageJob(int, char *, int, char *);
 int encode_DIS_MoveJob(int, char *, char *);
 int encode_DIS_ModifyResv(int, char *, struct attropl *);
@@ -386,9 +401,11 @@ int encode_DIS_ReqExtend(int, char *);
 int encode_DIS_ReqHdr(int, int, char *);
 int encode_DIS_Rescq(int, char **, int);
 int encode_DIS_Run(int, char *, char *, unsigned long);
+int encode_DIS_RunJobList(int, char **, char **, int);
 int encode_DIS_ShutDown(int, int);
 int encode_DIS_SignalJob(int, char *, char *);
 int encode_DIS_Status(int, char *, struct attrl *);
+int encode_DIS_StatusDelta(int, int, long, struct attrl *);
 int encode_DIS_attrl(int, struct attrl *);
 int encode_DIS_attropl(int, struct attropl *);
 int encode_DIS_CopyHookFile(int, int, char *, int, char *);
@@ -341,6 +341,11 @@ void delay_query(void);
  */
 char *perf_stat_stop(char *instance);
 
+/**
+ * Current wall clock and processor times, as used by the performance stats
+ */
+void perf_stat_times(double *walltime, double *cputime);
+
 extern char *netaddr(struct sockaddr_in *);
 extern unsigned long crc_file(char *fname);
 extern int get_fullhostname(char *, char *, int);
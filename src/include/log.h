@@ -148,6 +148,12 @@ extern int  log_open_main(char *name, char *directory, int silent);
 extern void log_record(int type, int objclass, int severity, const char *objname, const char *text);
 extern char log_buffer[LOG_BUF_SIZE];
 extern int log_level_2_etype(int level);
+#ifndef WIN32
+extern int log_async_start(void);
+extern void log_async_flush(void);
+extern void log_async_flush_on_crash(void);
+extern unsigned long log_async_dropped(void);
+#endif
 
 extern int  chk_path_sec(char *path, int dir, int sticky, int bad, int);
 extern int  chk_file_sec(char *path, int isdir, int sticky, int disallow, int fullpath);
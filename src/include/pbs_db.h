@@ -348,6 +348,36 @@ int pbs_db_disconnect(void *conn);
  */
 int pbs_db_save_obj(void *conn, pbs_db_obj_info_t *obj, int savetype);
 
+/**
+ * @brief
+ *	Start a transaction on the database connection. Transactions can be
+ *	nested, only the outermost begin starts a database transaction.
+ *
+ * @param[in]	conn - Connected database handle
+ *
+ * @return      int
+ * @retval      -1  - Failure
+ * @retval       0  - success
+ *
+ */
+int pbs_db_begin_trx(void *conn);
+
+/**
+ * @brief
+ *	End a transaction started with pbs_db_begin_trx. The database
+ *	transaction is committed (or rolled back) when the outermost
+ *	transaction ends.
+ *
+ * @param[in]	conn - Connected database handle
+ * @param[in]	commit - 1 to commit, 0 to rollback
+ *
+ * @return      int
+ * @retval      -1  - Failure, or the transaction had to be rolled back
+ * @retval       0  - success
+ *
+ */
+int pbs_db_end_trx(void *conn, int commit);
+
 /**
  * @brief
  *	Delete an existing object from the database
@@ -289,6 +289,7 @@ extern "C" {
 #define PBSE_SCHEDCONNECTED	15230
 #define PBSE_NOTARRAY_ATTR  15231		/* Not an array job */
 #define PBSE_UNKOBJ	15232		/* Named object is not in the list nor in alien cache */
+#define PBSE_DELTASEQ	15233		/* change sequence older than retained deletions */
 
 
 /* the following structure is used to tie error number      */
@@ -45,6 +45,7 @@ extern "C" {
 
 #define PBS_IDX_DUPS_OK     0x01 /* duplicate key allowed in index */
 #define PBS_IDX_ICASE_CMP   0x02 /* set case-insensitive compare */
+#define PBS_IDX_HASH        0x04 /* hash index, unordered but O(1) lookup */
 
 #define PBS_IDX_RET_OK    0 /* index op succeed */
 #define PBS_IDX_RET_FAIL -1 /* index op failed */
@@ -53,15 +54,23 @@ extern "C" {
  * @brief
  *	Create an empty index
  *
- * @param[in] - dups   - Whether duplicates are allowed or not in index
+ * @param[in] - flags  - index flags like duplicates allowed, case insensitive
+ *                       compare or hash index
  * @param[in] - keylen - length of key in index (can be 0 for default size)
  *
  * @return void *
  * @retval !NULL - success
  * @retval NULL  - failure
  *
+ * @note
+ *	By default the index is an AVL tree, iterated in key order.
+ *	A PBS_IDX_HASH index is an open addressing hash table for indexes
+ *	used only for lookups: iterating from a key returns only the
+ *	entries with that key, and iterating from the first entry
+ *	returns the entries in no particular order.
+ *
  */
-extern void *pbs_idx_create(int dups, int keylen);
+extern void *pbs_idx_create(int flags, int keylen);
 
 /**
  * @brief
@@ -122,6 +122,8 @@ extern "C" {
 
 /* additional job and general attribute names */
 #define ATTR_server_inst_id "server_instance_id"
+#define ATTR_chgseq	"chgseq"
+#define ATTR_deleted	"deleted"	/* marks a deleted object in pbs_statdelta() */
 #define ATTR_ctime	"ctime"
 #define ATTR_estimated  "estimated"
 #define ATTR_exechost	"exec_host"
@@ -331,6 +333,8 @@ extern "C" {
 #define ATTR_cred_renew_period	"cred_renew_period"
 #define ATTR_cred_renew_cache_period "cred_renew_cache_period"
 #define ATTR_attr_update_period "attr_update_period"
+#define ATTR_db_group_commit "db_group_commit"
+#define ATTR_acct_sync_interval "acct_sync_interval"
 
 /**
  * RPP_MAX_PKT_CHECK_DEFAULT controls the number of loops used to process
@@ -607,6 +611,8 @@ DECLDIR int pbs_asyrunjob(int, char *, char *, char *);
 
 DECLDIR int pbs_alterjob(int, char *, struct attrl *, char *);
 
+DECLDIR struct batch_deljob_status *pbs_alterjoblist(int, char **, struct attrl **, int, char *);
+
 DECLDIR int pbs_connect(char *);
 
 DECLDIR int pbs_connect_extend(char *, char *);
@@ -641,6 +647,8 @@ DECLDIR int pbs_rlsjob(int, char *, char *, char *);
 
 DECLDIR int pbs_runjob(int, char *, char *, char *);
 
+DECLDIR struct batch_deljob_status *pbs_runjoblist(int, char **, char **, int, char *);
+
 DECLDIR char **pbs_selectjob(int, struct attropl *, char *);
 
 DECLDIR int pbs_sigjob(int, char *, char *, char *);
@@ -651,6 +659,8 @@ DECLDIR struct batch_status *pbs_statrsc(int, char *, struct attrl *, char *);
 
 DECLDIR struct batch_status *pbs_statjob(int, char *, struct attrl *, char *);
 
+DECLDIR struct batch_status *pbs_statdelta(int, int, long, long *, struct attrl *, char *);
+
 DECLDIR struct batch_status *pbs_selstat(int, struct attropl *, struct attrl *, char *);
 
 DECLDIR struct batch_status *pbs_statque(int, char *, struct attrl *, char *);
@@ -705,6 +715,8 @@ extern int pbs_alterjob(int, char *, struct attrl *, char *);
 
 extern int pbs_asyalterjob(int c, char *jobid, struct attrl *attrib, char *extend);
 
+extern struct batch_deljob_status *pbs_alterjoblist(int, char **, struct attrl **, int, char *);
+
 extern int pbs_confirmresv(int, char *, char *, unsigned long, char *);
 
 extern int pbs_connect(char *);
@@ -743,6 +755,8 @@ extern int pbs_rlsjob(int, char *, char *, char *);
 
 extern int pbs_runjob(int, char *, char *, char *);
 
+extern struct batch_deljob_status *pbs_runjoblist(int, char **, char **, int, char *);
+
 extern char **pbs_selectjob(int, struct attropl *, char *);
 
 extern int pbs_sigjob(int, char *, char *, char *);
@@ -755,6 +769,8 @@ extern struct batch_status *pbs_statrsc(int, char *, struct attrl *, char *);
 
 extern struct batch_status *pbs_statjob(int, char *, struct attrl *, char *);
 
+extern struct batch_status *pbs_statdelta(int, int, long, long *, struct attrl *, char *);
+
 extern struct batch_status *pbs_selstat(int, struct attropl *, struct attrl *, char *);
 
 extern struct batch_status *pbs_statque(int, char *, struct attrl *, char *);
@@ -793,6 +809,7 @@ extern int (*pfn_pbs_asyrunjob)(int, char *, char *, char *);
 extern int (*pfn_pbs_asyrunjob_ack)(int, char *, char *, char *);
 extern int (*pfn_pbs_alterjob)(int, char *, struct attrl *, char *);
 extern int (*pfn_pbs_asyalterjob)(int, char *, struct attrl *, char *);
+extern struct batch_deljob_status *(*pfn_pbs_alterjoblist)(int, char **, struct attrl **, int, char *);
 extern int (*pfn_pbs_confirmresv)(int, char *, char *, unsigned long, char *);
 extern int (*pfn_pbs_connect)(char *);
 extern int (*pfn_pbs_connect_extend)(char *, char *);
@@ -811,12 +828,14 @@ extern int (*pfn_pbs_orderjob)(int, char *, char *, char *);
 extern int (*pfn_pbs_rerunjob)(int, char *, char *);
 extern int (*pfn_pbs_rlsjob)(int, char *, char *, char *);
 extern int (*pfn_pbs_runjob)(int, char *, char *, char *);
+extern struct batch_deljob_status *(*pfn_pbs_runjoblist)(int, char **, char **, int, char *);
 extern char **(*pfn_pbs_selectjob)(int, struct attropl *, char *);
 extern int (*pfn_pbs_sigjob)(int, char *, char *, char *);
 extern void (*pfn_pbs_statfree)(struct batch_status *);
 extern void (*pfn_pbs_delstatfree)(struct batch_deljob_status *);
 extern struct batch_status *(*pfn_pbs_statrsc)(int, char *, struct attrl *, char *);
 extern struct batch_status *(*pfn_pbs_statjob)(int, char *, struct attrl *, char *);
+extern struct batch_status *(*pfn_pbs_statdelta)(int, int, long, long *, struct attrl *, char *);
 extern struct batch_status *(*pfn_pbs_selstat)(int, struct attropl *, struct attrl *, char *);
 extern struct batch_status *(*pfn_pbs_statque)(int, char *, struct attrl *, char *);
 extern struct batch_status *(*pfn_pbs_statserver)(int, struct attrl *, char *);
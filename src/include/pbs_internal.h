@@ -254,6 +254,7 @@ struct pbs_config
 	char *pbs_mom_node_name;	/* mom short name used for natural node, default NULL */
 	char *pbs_lr_save_path;		/* path to store undo live recordings */
 	unsigned int pbs_log_highres_timestamp; /* high resolution logging */
+	unsigned int pbs_log_async;	/* daemons log through a background writer thread */
 	unsigned int pbs_sched_threads;	/* number of threads for scheduler */
 	char *pbs_daemon_service_user; /* user the scheduler runs as */
 	char current_user[PBS_MAXUSER+1]; /* current running user */
@@ -320,6 +321,7 @@ extern struct pbs_config pbs_conf;
 #define PBS_CONF_MOM_NODE_NAME	"PBS_MOM_NODE_NAME"
 #define PBS_CONF_LR_SAVE_PATH	"PBS_LR_SAVE_PATH"
 #define PBS_CONF_LOG_HIGHRES_TIMESTAMP	"PBS_LOG_HIGHRES_TIMESTAMP"
+#define PBS_CONF_LOG_ASYNC	"PBS_LOG_ASYNC"
 #define PBS_CONF_SCHED_THREADS	"PBS_SCHED_THREADS"
 #define PBS_CONF_DAEMON_SERVICE_USER "PBS_DAEMON_SERVICE_USER"
 #ifdef WIN32
@@ -254,6 +254,7 @@ struct pbsnode {
 	char *nd_hostname;	  /* ptr to hostname */
 	struct pbssubn *nd_psn;	  /* ptr to list of virt cpus */
 	struct resvinfo *nd_resvp;
+	struct resvinfo *nd_occr_resvp;	  /* standing reservations naming this vnode in any occurrence */
 	long nd_nsn;		   /* number of VPs  */
 	long nd_nsnfree;	   /* number of VPs free */
 	long nd_ncpus;		   /* number of phy cpus on node */
@@ -265,6 +266,8 @@ struct pbsnode {
 	pbs_list_link un_lic_link;		/*Link to unlicense list */
 	int nd_svrflags;	/* server flags */
 	pbs_list_link nd_link;	/* Link to holding svr list in case if this is an alien node */
+	int nd_modseq;		/* modified since nd_chgseq was stamped, see req_stat_delta() */
+	long nd_chgseq;		/* change sequence number of the last status change */
 	attribute nd_attr[ND_ATR_LAST];
 };
 typedef struct pbsnode pbs_node;
@@ -398,6 +401,10 @@ extern	int find_vnode_in_execvnode(char *, char *);
 extern	void set_vnode_state(struct pbsnode *, unsigned long , enum vnode_state_op);
 extern	struct resvinfo *find_vnode_in_resvs(struct pbsnode *, enum vnode_degraded_op);
 extern	void free_rinf_list(struct resvinfo *);
+extern	void index_resv_occurrences(resc_resv *);
+extern	void unindex_resv_occurrences(resc_resv *);
+extern	void unindex_vnode_occurrences(struct pbsnode *);
+extern	void invalidate_resv_occurrences(void);
 extern	void degrade_offlined_nodes_reservations(void);
 extern	void degrade_downed_nodes_reservations(void);
 
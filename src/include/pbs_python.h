@@ -97,7 +97,8 @@ struct python_interpreter_data {
 };
 
 struct python_script {
-	int    check_for_recompile;
+	int    check_for_recompile;          /* stat the script before each use */
+	int    interp_gen;                   /* interpreter the code belongs to */
 	char   *path;                        /* FULL pathname of script */
 	void   *py_code_obj;                 /* the actual compiled code string
 					      * type is PyCodeObject *
@@ -460,6 +461,8 @@ extern int  pbs_python_event_set(
 
 extern void pbs_python_event_unset(void);
 
+extern void pbs_python_set_event_param_loader(pbs_list_head *(*loader)(int));
+
 extern int  pbs_python_event_to_request(unsigned int hook_event,
 	hook_output_param_t *req_params, char *perf_label, char *perf_action);
 
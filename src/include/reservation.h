@@ -189,6 +189,9 @@ struct resc_resv {
 	long			ri_degraded_time;	/* a tentative time to reconfirm the reservation */
 
 	pbsnode_list_t		*ri_pbsnode_list;	/* vnode list associated to the reservation */
+	pbsnode_list_t		*ri_occr_vnodes;	/* vnodes named in any occurrence of a standing
+							 * reservation, see index_resv_occurrences()
+							 */
 
 	/* objects used while altering a reservation. */
 	struct resv_alter	ri_alter;		/* object used to alter a reservation */
@@ -136,6 +136,8 @@ extern int make_schedselect(attribute *, resource *, pbs_queue *, attribute *);
 extern long long get_next_svr_sequence_id(void);
 extern int compare_obj_hash(void *, int , void *);
 extern void panic_stop_db();
+extern void svr_db_group_join(void);
+extern void svr_db_group_commit(void);
 extern void free_db_attr_list(pbs_db_attr_list_t *);
 extern void req_stat_svr_ready(struct work_task *);
 
@@ -182,6 +184,7 @@ extern void chk_array_doneness(job *);
 extern job *create_subjob(job *, char *, int *);
 extern job *find_arrayparent(char *);
 extern job *get_subjob_and_state(job *, int, char *, int *);
+extern int is_subjob_queued(job *, int);
 extern void update_sj_parent(job *, job *, char *, char, char);
 extern void update_subjob_state_ct(job *);
 extern char *subst_array_index(job *, char *);
@@ -257,6 +260,9 @@ extern void req_shutdown(struct batch_request *);
 extern void req_signaljob(struct batch_request *);
 extern void req_mvjobfile(struct batch_request *);
 extern void req_stat_node(struct batch_request *);
+extern long next_chgseq(void);
+extern long get_chgseq(long *);
+extern void add_stat_tombstone(int, char *, char *);
 extern void req_track(struct batch_request *);
 extern void req_stagein(struct batch_request *);
 extern void req_resvSub(struct batch_request *);
@@ -387,6 +393,7 @@ struct stat_cntl {
 extern int status_job(job *, struct batch_request *, svrattrl *, pbs_list_head *, int *, int);
 extern int status_subjob(job *, struct batch_request *, svrattrl *, int, pbs_list_head *, int *, int);
 extern int stat_to_mom(job *, struct stat_cntl *);
+extern void job_chgseq_update(job *);
 
 #endif /* STAT_CNTL */
 #ifdef __cplusplus
@@ -89,6 +89,10 @@ struct work_task  {
 	void		*wt_parm3;	/* used to store reply for deferred cmds TPP */
 	int		 wt_aux;	/* optional info: e.g. child status */
 	int		 wt_aux2;	/* optional info 2: e.g. *real* child pid (windows), tpp msgid etc */
+	pbs_list_head	*wt_tlist;	/* task list the task was queued on */
+	pbs_list_link	 wt_linkparm;	/* link to tasks hashed by the same wt_parm1 */
+	int		 wt_heap_idx;	/* index in the timed task heap, -1 if not in it */
+	unsigned long	 wt_seq;	/* creation order, orders timed tasks with equal times */
 };
 
 extern struct work_task *set_task(enum work_type, long event, void (*func)(), void *param);
@@ -908,6 +908,75 @@ int pbs_db_delete_attr_obj(void *conn, pbs_db_obj_info_t *obj, void *obj_id, pbs
 	return (db_fn_arr[obj->pbs_db_obj_type].pbs_db_del_attr_obj(conn, obj_id, db_attr_list));
 }
 
+/**
+ * @brief
+ *	Start a transaction on the database connection.
+ *	Transactions nest, only the outermost begin issues a BEGIN.
+ *
+ * @param[in]	conn - Connected database handle
+ *
+ * @return      Error code
+ * @retval	-1  - Failure
+ * @retval	 0  - Success
+ *
+ */
+int
+pbs_db_begin_trx(void *conn)
+{
+	if (conn_trx->conn_trx_nest == 0) {
+		if (db_execute_str(conn, "BEGIN") == -1)
+			return -1;
+		conn_trx->conn_trx_rollback = 0;
+	}
+	conn_trx->conn_trx_nest++;
+
+	return 0;
+}
+
+/**
+ * @brief
+ *	End a transaction on the database connection.
+ *	The outermost end commits the transaction, unless this or any nested
+ *	end asked for a rollback, or a statement inside the transaction failed
+ *	and postgres already aborted it.
+ *
+ * @param[in]	conn - Connected database handle
+ * @param[in]	commit - 1 to commit, 0 to rollback
+ *
+ * @return      Error code
+ * @retval	-1  - Failure, or the transaction was rolled back
+ * @retval	 0  - Success
+ *
+ */
+int
+pbs_db_end_trx(void *conn, int commit)
+{
+	int rc;
+
+	if (conn_trx->conn_trx_nest == 0)
+		return 0;
+
+	if (!commit)
+		conn_trx->conn_trx_rollback = 1;
+
+	if (--conn_trx->conn_trx_nest > 0)
+		return 0;
+
+	/* a COMMIT of an aborted transaction silently rolls back */
+	if (PQtransactionStatus((PGconn *) conn) == PQTRANS_INERROR)
+		conn_trx->conn_trx_rollback = 1;
+
+	if (conn_trx->conn_trx_rollback) {
+		conn_trx->conn_trx_rollback = 0;
+		(void) db_execute_str(conn, "ROLLBACK");
+		return -1;
+	}
+
+	rc = db_execute_str(conn, "COMMIT");
+
+	return (rc == -1 ? -1 : 0);
+}
+
 /**
  * @brief
  *	Function to set the database error into the db_err field of the
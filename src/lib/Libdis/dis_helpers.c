@@ -774,6 +774,38 @@ dis_puts(int fd, const char *str, size_t ct)
 	return ct;
 }
 
+/**
+ * @brief
+ * 	dis_get_written - dis support routine to look at what has been put
+ *	into the write buffer and not flushed yet.
+ *
+ * @param[in] fd - file descriptor
+ * @param[out] len - number of characters in the write buffer
+ *
+ * @return	char *
+ *
+ * @retval	start of the write buffer, the data written by the next
+ *		dis_puts() begins at offset len
+ * @retval	NULL 	if error
+ *
+ * @par Side Effects:
+ *	None
+ *
+ * @par MT-safe: Yes
+ *
+ */
+char *
+dis_get_written(int fd, size_t *len)
+{
+	pbs_dis_buf_t *tp = dis_get_writebuf(fd);
+
+	*len = 0;
+	if (tp == NULL)
+		return NULL;
+	*len = tp->tdis_len;
+	return tp->tdis_data;
+}
+
 /**
  * @brief
  *	flush dis write buffer
@@ -318,7 +318,8 @@ verify_an_attribute(int batch_request, int parent_object, int cmd,
 			batch_request == PBS_BATCH_StatusRsc ||
 			batch_request == PBS_BATCH_StatusHook ||
 			batch_request == PBS_BATCH_StatusResv ||
-			batch_request == PBS_BATCH_StatusSched)
+			batch_request == PBS_BATCH_StatusSched ||
+			batch_request == PBS_BATCH_StatusDelta)
 			return PBSE_NONE;
 	}
 
@@ -61,6 +61,7 @@
 #include <pbs_config.h>   /* the master config generated by configure */
 
 #include <sys/types.h>
+#include <stdlib.h>
 #include "libpbs.h"
 #include "list_link.h"
 #include "server_limits.h"
@@ -109,3 +110,53 @@ decode_DIS_Manage(int sock, struct batch_request *preq)
 	if (rc) return rc;
 	return (decode_DIS_svrattrl(sock, &preq->rq_ind.rq_manager.rq_attr));
 }
+
+/**
+ * @brief-
+ *	decode a Modify Job List batch request
+ *
+ * @par	Data items are:\n
+ *		unsigned int    count, at most PBS_MODIFYJOBLIST_MAX\n
+ *		count times:\n
+ *			string	job id\n
+ *			svrattrl	attributes\n
+ *
+ * @param[in] sock - socket descriptor
+ * @param[out] preq - pointer to batch_request structure
+ *
+ * @return      int
+ * @retval      DIS_SUCCESS(0)  success
+ * @retval      error code      error
+ *
+ */
+int
+decode_DIS_ModifyJobList(int sock, struct batch_request *preq)
+{
+	int rc;
+	int count;
+	int i;
+	struct rq_modifyjoblist *pml = &preq->rq_ind.rq_modifyjoblist;
+
+	count = disrui(sock, &rc);
+	if (rc)
+		return rc;
+	if (count < 0 || count > PBS_MODIFYJOBLIST_MAX)
+		return DIS_PROTO;
+
+	pml->rq_count = count;
+	pml->rq_jobslist = calloc(count + 1, sizeof(char *));
+	pml->rq_attrs = calloc(count + 1, sizeof(pbs_list_head));
+	if (pml->rq_jobslist == NULL || pml->rq_attrs == NULL)
+		return DIS_NOMALLOC;
+	for (i = 0; i < count; i++)
+		CLEAR_HEAD(pml->rq_attrs[i]);
+
+	for (i = 0; i < count; i++) {
+		pml->rq_jobslist[i] = disrst(sock, &rc);
+		if (rc)
+			return rc;
+		if ((rc = decode_DIS_svrattrl(sock, &pml->rq_attrs[i])) != 0)
+			return rc;
+	}
+	return 0;
+}
@@ -57,6 +57,7 @@
 #include <pbs_config.h>   /* the master config generated by configure */
 
 #include <sys/types.h>
+#include <stdlib.h>
 #include "libpbs.h"
 #include "list_link.h"
 #include "server_limits.h"
@@ -105,3 +106,52 @@ decode_DIS_Run(int sock, struct batch_request *preq)
 	preq->rq_ind.rq_run.rq_resch = disrul(sock, &rc);
 	return rc;
 }
+
+/**
+ * @brief-
+ *	decode a Run Job List batch request
+ *
+ * @par	Data items are:\n
+ *		unsigned int    count\n
+ *		count times:\n
+ *			string	job id\n
+ *			string	destination\n
+ *
+ * @param[in] sock - socket descriptor
+ * @param[out] preq - pointer to batch_request structure
+ *
+ * @return      int
+ * @retval      DIS_SUCCESS(0)  success
+ * @retval      error code      error
+ *
+ */
+int
+decode_DIS_RunJobList(int sock, struct batch_request *preq)
+{
+	int rc;
+	int count;
+	int i;
+	struct rq_runjoblist *prl = &preq->rq_ind.rq_runjoblist;
+
+	count = disrui(sock, &rc);
+	if (rc)
+		return rc;
+	if (count < 0 || count > PBS_RUNJOBLIST_MAX)
+		return DIS_PROTO;
+
+	prl->rq_count = count;
+	prl->rq_jobslist = calloc(count + 1, sizeof(char *));
+	prl->rq_destins = calloc(count + 1, sizeof(char *));
+	if (prl->rq_jobslist == NULL || prl->rq_destins == NULL)
+		return DIS_NOMALLOC;
+
+	for (i = 0; i < count; i++) {
+		prl->rq_jobslist[i] = disrst(sock, &rc);
+		if (rc)
+			return rc;
+		prl->rq_destins[i] = disrst(sock, &rc);
+		if (rc)
+			return rc;
+	}
+	return 0;
+}
@@ -92,3 +92,40 @@ decode_DIS_Status(int sock, struct batch_request *preq)
 	rc = decode_DIS_svrattrl(sock, &preq->rq_ind.rq_status.rq_attr);
 	return rc;
 }
+
+/**
+ * @brief
+ *	Decode a Status Delta batch request
+ *
+ * @par
+ *	The batch_request structure must already exist (be allocated by the
+ *	caller).   It is assumed that the header fields (protocol type,
+ *	protocol version, request type, and user name) have already be decoded.
+ *
+ * @param[in]     sock - socket handle from which to read.
+ * @param[in,out] preq - pointer to the batch request structure. The following
+ *		elements of the rq_ind.rq_statdelta union are updated:
+ *		rq_objtype - type of objects to status
+ *		rq_seq     - client's change sequence number
+ *		rq_attr    - the linked list of attribute structures
+ *
+ * @return int
+ * @retval 0 - request read and decoded successfully.
+ * @retval non-zero - DIS decode error.
+ */
+
+int
+decode_DIS_StatusDelta(int sock, struct batch_request *preq)
+{
+	int rc;
+
+	CLEAR_HEAD(preq->rq_ind.rq_statdelta.rq_attr);
+
+	preq->rq_ind.rq_statdelta.rq_objtype = disrsi(sock, &rc);
+	if (rc) return rc;
+	preq->rq_ind.rq_statdelta.rq_seq = disrsl(sock, &rc);
+	if (rc) return rc;
+
+	rc = decode_DIS_svrattrl(sock, &preq->rq_ind.rq_statdelta.rq_attr);
+	return rc;
+}
@@ -43,6 +43,7 @@
  * @file	enc_Manage.c
  * @brief
  * encode_DIS_Manage() - encode a Manager Batch Request
+ * encode_DIS_ModifyJobList() - encode a Modify Job List Batch Request
  *
  *	This request is used for most operations where an object is being
  *	created, deleted, or altered.
@@ -86,3 +87,41 @@ encode_DIS_Manage(int sock, int command, int objtype, char *objname, struct attr
 
 	return (encode_DIS_attropl(sock, aoplp));
 }
+
+/**
+ * @brief
+ *	-encode the body of a Modify Job List request
+ *
+ * @par Data items are:
+ *		unsigned int	count
+ *		count times:
+ *			string	job id
+ *			attrl	attributes
+ *
+ * @param[in] sock - socket descriptor
+ * @param[in] jobids - job identifiers
+ * @param[in] attribs - attribute list of each job in jobids
+ * @param[in] count - number of jobs
+ *
+ * @return      int
+ * @retval      DIS_SUCCESS(0)  success
+ * @retval      error code      error
+ *
+ */
+int
+encode_DIS_ModifyJobList(int sock, char **jobids, struct attrl **attribs, int count)
+{
+	int rc;
+	int i;
+
+	if ((rc = diswui(sock, count)) != 0)
+		return rc;
+
+	for (i = 0; i < count; i++) {
+		if ((rc = diswst(sock, jobids[i])) != 0 ||
+			(rc = encode_DIS_attrl(sock, attribs[i])) != 0)
+			return rc;
+	}
+
+	return 0;
+}
@@ -89,3 +89,41 @@ encode_DIS_Run(int sock, char *id, char *where, unsigned long arg)
 
 	return 0;
 }
+
+/**
+ * @brief
+ *	-encode the body of a Run Job List request
+ *
+ * @par Data items are:
+ *		unsigned int	count
+ *		count times:
+ *			string	job id
+ *			string	destination
+ *
+ * @param[in] sock - socket descriptor
+ * @param[in] jobids - job identifiers
+ * @param[in] where - destination of each job in jobids
+ * @param[in] count - number of jobs
+ *
+ * @return      int
+ * @retval      DIS_SUCCESS(0)  success
+ * @retval      error code      error
+ *
+ */
+int
+encode_DIS_RunJobList(int sock, char **jobids, char **where, int count)
+{
+	int rc;
+	int i;
+
+	if ((rc = diswui(sock, count)) != 0)
+		return rc;
+
+	for (i = 0; i < count; i++) {
+		if ((rc = diswst(sock, jobids[i])) != 0 ||
+			(rc = diswst(sock, where[i] ? where[i] : "")) != 0)
+			return rc;
+	}
+
+	return 0;
+}
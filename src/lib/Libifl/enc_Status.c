@@ -47,6 +47,13 @@
  * @par Data items are:
  * 			string		object id
  *			list of		attrl
+ *
+ * encode_DIS_StatusDelta() - encode a Status Delta Batch Request
+ *
+ * @par Data items are:
+ * 			signed int	object type
+ * 			signed long	change sequence number
+ *			list of		attrl
  */
 
 #include <pbs_config.h>   /* the master config generated by configure */
@@ -80,3 +87,31 @@ encode_DIS_Status(int sock, char *objid, struct attrl *pattrl)
 
 	return 0;
 }
+
+/**
+ * @brief
+ *	-encode a Status Delta Batch Request
+ *
+ * @param[in] sock - socket descriptor
+ * @param[in] objtype - type of objects to status
+ * @param[in] seq - change sequence number
+ * @param[in] pattrl - pointer to attrl struct(list)
+ *
+ * @return      int
+ * @retval      DIS_SUCCESS(0)  success
+ * @retval      error code      error
+ *
+ */
+
+int
+encode_DIS_StatusDelta(int sock, int objtype, long seq, struct attrl *pattrl)
+{
+	int   rc;
+
+	if ((rc = diswsi(sock, objtype)) ||
+		(rc = diswsl(sock, seq)) ||
+		(rc = encode_DIS_attrl(sock, pattrl)))
+			return rc;
+
+	return 0;
+}
@@ -50,6 +50,8 @@
 
 #include <pbs_config.h>   /* the master config generated by configure */
 
+#include <stdlib.h>
+#include <string.h>
 #include "libpbs.h"
 #include "list_link.h"
 #include "attribute.h"
@@ -59,6 +61,24 @@
 int encode_DIS_svrattrl(int sock, svrattrl *psattl);
 
 
+/**
+ * @brief
+ *	release a reference to the encoded attribute list of a status reply,
+ *	freeing it with the last reference
+ *
+ * @param[in] pbe - encoded attribute list, may be NULL
+ *
+ * @return void
+ */
+void
+free_brp_encoded(struct brp_encoded *pbe)
+{
+	if ((pbe == NULL) || (--pbe->be_refct > 0))
+		return;
+	free(pbe->be_data);
+	free(pbe);
+}
+
 /**
  * @brief-
  *      encode a Batch Protocol Reply Structure for a Command
@@ -82,9 +102,13 @@ encode_DIS_reply_inner(int sock, struct batch_reply *reply)
 	int i;
 	struct brp_select *psel;
 	struct brp_status *pstat;
+	struct brp_encoded *pbe;
 	struct batch_deljob_status *pdelstat;
 	svrattrl *psvrl;
 	preempt_job_info *ppj;
+	size_t start;
+	size_t end;
+	char *data;
 
 	int rc;
 
@@ -139,9 +163,23 @@ encode_DIS_reply_inner(int sock, struct batch_reply *reply)
 				if ((rc = diswui(sock, pstat->brp_objtype)) || (rc = diswst(sock, pstat->brp_objname)))
 					return rc;
 
-				psvrl = (svrattrl *) GET_NEXT(pstat->brp_attr);
-				if ((rc = encode_DIS_svrattrl(sock, psvrl)) != 0)
-					return rc;
+				pbe = pstat->brp_enc;
+				if ((pbe != NULL) && (pbe->be_data != NULL)) {
+					/* attribute list was encoded for an earlier reply */
+					if (dis_puts(sock, pbe->be_data, pbe->be_len) != (int) pbe->be_len)
+						return DIS_PROTO;
+				} else {
+					(void) dis_get_written(sock, &start);
+					psvrl = (svrattrl *) GET_NEXT(pstat->brp_attr);
+					if ((rc = encode_DIS_svrattrl(sock, psvrl)) != 0)
+						return rc;
+					/* keep a copy of the encoding for later replies */
+					if ((pbe != NULL) && ((data = dis_get_written(sock, &end)) != NULL) &&
+					    (end > start) && ((pbe->be_data = malloc(end - start)) != NULL)) {
+						memcpy(pbe->be_data, data + start, end - start);
+						pbe->be_len = end - start;
+					}
+				}
 				pstat = (struct brp_status *) GET_NEXT(pstat->brp_stlink);
 			}
 			break;
@@ -131,6 +131,26 @@ pbs_asyalterjob(int c, char *jobid, struct attrl *attrib, char *extend) {
 	return (*pfn_pbs_asyalterjob)(c, jobid, attrib, extend);
 }
 
+/**
+ * @brief
+ *	-Pass-through call to send a Modify Job List batch request
+ *
+ * @param[in] c - connection handle
+ * @param[in] jobids - job identifiers
+ * @param[in] attribs - attribute list for each job in jobids
+ * @param[in] count - number of jobs
+ * @param[in] extend - extend string for encoding req
+ *
+ * @return	struct batch_deljob_status *
+ * @retval	list of jobs the server did not alter, with their error codes
+ * @retval	NULL	all jobs altered, or error if pbs_errno is set
+ *
+ */
+struct batch_deljob_status *
+pbs_alterjoblist(int c, char **jobids, struct attrl **attribs, int count, char *extend) {
+	return (*pfn_pbs_alterjoblist)(c, jobids, attribs, count, extend);
+}
+
 /**
  * @brief
  * 	-pbs_confirmresv - this function is for exclusive use by the Scheduler
@@ -499,6 +519,26 @@ pbs_runjob(int c, char *jobid, char *location, char *extend) {
 	return (*pfn_pbs_runjob)(c, jobid, location, extend);
 }
 
+/**
+ * @brief
+ *	-Pass-through call to send a Run Job List batch request
+ *
+ * @param[in] c - communication handle
+ * @param[in] jobids - job identifiers
+ * @param[in] locations - execvnode for each job in jobids
+ * @param[in] count - number of jobs
+ * @param[in] extend - extend string to encode req
+ *
+ * @return	struct batch_deljob_status *
+ * @retval	list of jobs the server did not run, with their error codes
+ * @retval	NULL	all jobs accepted, or error if pbs_errno is set
+ *
+ */
+struct batch_deljob_status *
+pbs_runjoblist(int c, char **jobids, char **locations, int count, char *extend) {
+	return (*pfn_pbs_runjoblist)(c, jobids, locations, count, extend);
+}
+
 /**
  * @brief
  *	-Pass-through call to send SelectJob request
@@ -604,6 +644,28 @@ pbs_statjob(int c, char *id, struct attrl *attrib, char *extend) {
 	return (*pfn_pbs_statjob)(c, id, attrib, extend);
 }
 
+/**
+ * @brief
+ *	-Pass-through call to get status of jobs or vnodes changed after a
+ *	change sequence number.
+ *
+ * @param[in] c - communication handle
+ * @param[in] obj_type - MGR_OBJ_JOB or MGR_OBJ_NODE
+ * @param[in] seq - change sequence number from the previous call, 0 for all
+ * @param[out] newseq - change sequence number to pass to the next call
+ * @param[in] attrib - pointer to attribute list
+ * @param[in] extend - extend string for req
+ *
+ * @return	structure handle
+ * @retval	pointer to batch_status struct		success
+ * @retval	NULL					error or no changes
+ *
+ */
+struct batch_status *
+pbs_statdelta(int c, int obj_type, long seq, long *newseq, struct attrl *attrib, char *extend) {
+	return (*pfn_pbs_statdelta)(c, obj_type, seq, newseq, attrib, extend);
+}
+
 /**
  * @brief
  *	-Pass-through call to SelectJob request
@@ -47,6 +47,7 @@ int (*pfn_pbs_asyrunjob)(int, char *, char *, char *) = __pbs_asyrunjob;
 int (*pfn_pbs_asyrunjob_ack)(int, char *, char *, char *) = __pbs_asyrunjob_ack;
 int (*pfn_pbs_alterjob)(int, char *, struct attrl *, char *) = __pbs_alterjob;
 int (*pfn_pbs_asyalterjob)(int, char *, struct attrl *, char *) = __pbs_asyalterjob;
+struct batch_deljob_status *(*pfn_pbs_alterjoblist)(int, char **, struct attrl **, int, char *) = __pbs_alterjoblist;
 int (*pfn_pbs_confirmresv)(int, char *, char *, unsigned long, char *) = __pbs_confirmresv;
 int (*pfn_pbs_connect)(char *) = __pbs_connect;
 int (*pfn_pbs_connect_extend)(char *, char *) = __pbs_connect_extend;
@@ -65,12 +66,14 @@ int (*pfn_pbs_orderjob)(int, char *, char *, char *) = __pbs_orderjob;
 int (*pfn_pbs_rerunjob)(int, char *, char *) = __pbs_rerunjob;
 int (*pfn_pbs_rlsjob)(int, char *, char *, char *) = __pbs_rlsjob;
 int (*pfn_pbs_runjob)(int, char *, char *, char *) = __pbs_runjob;
+struct batch_deljob_status *(*pfn_pbs_runjoblist)(int, char **, char **, int, char *) = __pbs_runjoblist;
 char **(*pfn_pbs_selectjob)(int, struct attropl *, char *) = __pbs_selectjob;
 int (*pfn_pbs_sigjob)(int, char *, char *, char *) = __pbs_sigjob;
 void (*pfn_pbs_statfree)(struct batch_status *) = __pbs_statfree;
 void (*pfn_pbs_delstatfree)(struct batch_deljob_status *) = __pbs_delstatfree;
 struct batch_status *(*pfn_pbs_statrsc)(int, char *, struct attrl *, char *) = __pbs_statrsc;
 struct batch_status *(*pfn_pbs_statjob)(int, char *, struct attrl *, char *) = __pbs_statjob;
+struct batch_status *(*pfn_pbs_statdelta)(int, int, long, long *, struct attrl *, char *) = __pbs_statdelta;
 struct batch_status *(*pfn_pbs_selstat)(int, struct attropl *, struct attrl *, char *) = __pbs_selstat;
 struct batch_status *(*pfn_pbs_statque)(int, char *, struct attrl *, char *) = __pbs_statque;
 struct batch_status *(*pfn_pbs_statserver)(int, struct attrl *, char *) = __pbs_statserver;
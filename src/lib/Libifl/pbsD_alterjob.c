@@ -49,6 +49,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "libpbs.h"
+#include "dis.h"
 
 /**
  * @brief	Convenience function to create attropl list from attrl (shallow copy)
@@ -203,3 +204,97 @@ __pbs_asyalterjob(int c, char *jobid, struct attrl *attrib, char *extend)
 	return i;
 
 }
+
+/**
+ * @brief
+ *	-send a Modify Job List batch request, altering the attributes of
+ *	many jobs at once
+ *
+ * @par
+ *	Each job is altered as if by pbs_alterjob(), but all of them go to the
+ *	server in one request and the server answers once for the whole list.
+ *	The jobs must all belong to the server instance c is connected to.
+ *
+ * @param[in] c - connection handle
+ * @param[in] jobids - job identifiers
+ * @param[in] attribs - attribute list for each job in jobids
+ * @param[in] count - number of jobs, at most PBS_MODIFYJOBLIST_MAX
+ * @param[in] extend - extend string for encoding req
+ *
+ * @return	struct batch_deljob_status *
+ * @retval	list of jobs the server did not alter, with their error codes
+ * @retval	NULL	every job was altered if pbs_errno is PBSE_NONE,
+ *			otherwise the request as a whole failed
+ *
+ */
+struct batch_deljob_status *
+__pbs_alterjoblist(int c, char **jobids, struct attrl **attribs, int count, char *extend)
+{
+	int rc;
+	struct batch_reply *reply;
+	struct batch_deljob_status *ret = NULL;
+	svr_conn_t **svr_conns;
+
+	if ((jobids == NULL) || (attribs == NULL) || (count <= 0) || (count > PBS_MODIFYJOBLIST_MAX)) {
+		pbs_errno = PBSE_IVALREQ;
+		return NULL;
+	}
+
+	/* a list may span several servers, the caller has to split it up */
+	if ((svr_conns = get_conn_svr_instances(c)) != NULL) {
+		if (get_num_servers() > 1) {
+			pbs_errno = PBSE_NOSUP;
+			return NULL;
+		}
+		if ((c = random_srv_conn(c, svr_conns)) < 0)
+			return NULL;
+	}
+
+	/* initialize the thread context data, if not already initialized */
+	if (pbs_client_thread_init_thread_context() != 0)
+		return NULL;
+
+	if (pbs_client_thread_lock_connection(c) != 0)
+		return NULL;
+
+	DIS_tcp_funcs();
+
+	if ((rc = encode_DIS_ReqHdr(c, PBS_BATCH_ModifyJobList, pbs_current_user)) ||
+		(rc = encode_DIS_ModifyJobList(c, jobids, attribs, count)) ||
+		(rc = encode_DIS_ReqExtend(c, extend))) {
+		if (set_conn_errtxt(c, dis_emsg[rc]) != 0)
+			pbs_errno = PBSE_SYSTEM;
+		else
+			pbs_errno = PBSE_PROTOCOL;
+		pbs_client_thread_unlock_connection(c);
+		return NULL;
+	}
+
+	if (dis_flush(c)) {
+		pbs_errno = PBSE_PROTOCOL;
+		pbs_client_thread_unlock_connection(c);
+		return NULL;
+	}
+
+	reply = PBSD_rdrpy(c);
+	if (reply == NULL) {
+		if (pbs_errno == PBSE_NONE)
+			pbs_errno = PBSE_PROTOCOL;
+	} else if (reply->brp_choice != BATCH_REPLY_CHOICE_NULL &&
+		   reply->brp_choice != BATCH_REPLY_CHOICE_Text &&
+		   reply->brp_choice != BATCH_REPLY_CHOICE_Delete) {
+		pbs_errno = PBSE_PROTOCOL;
+	} else if (reply->brp_choice == BATCH_REPLY_CHOICE_Delete) {
+		ret = reply->brp_un.brp_deletejoblist.brp_delstatc;
+		reply->brp_un.brp_deletejoblist.brp_delstatc = NULL;
+	}
+	PBSD_FreeReply(reply);
+
+	/* unlock the thread lock and update the thread context data */
+	if (pbs_client_thread_unlock_connection(c) != 0) {
+		pbs_delstatfree(ret);
+		return NULL;
+	}
+
+	return ret;
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 1994-2021 Altair Engineering, Inc.
+ * For more information, contact Altair at www.altair.com.
+ *
+ * This file is part of both the OpenPBS software ("OpenPBS")
+ * and the PBS Professional ("PBS Pro") software.
+ *
+ * Open Source License Information:
+ *
+ * OpenPBS is free software. You can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * OpenPBS is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Commercial License Information:
+ *
+ * PBS Pro is commercially licensed software that shares a common core with
+ * the OpenPBS software.  For a copy of the commercial license terms and
+ * conditions, go to: (http://www.pbspro.com/agreement.html) or contact the
+ * Altair Legal Department.
+ *
+ * Altair's dual-license business model allows companies, individuals, and
+ * organizations to create proprietary derivative works of OpenPBS and
+ * distribute them - whether embedded or bundled with other software -
+ * under a commercial license agreement.
+ *
+ * Use of Altair's trademarks, including but not limited to "PBS™",
+ * "OpenPBS®", "PBS Professional®", and "PBS Pro™" and Altair's logos is
+ * subject to Altair's trademark licensing policies.
+ */
+
+/**
+ * @file	pbsD_statdelta.c
+ * @brief
+ * Return the status of jobs or vnodes changed after a change sequence number.
+ */
+
+#include <pbs_config.h>   /* the master config generated by configure */
+
+#include <string.h>
+#include <stdlib.h>
+#include "libpbs.h"
+#include "dis.h"
+#include "pbs_ecl.h"
+
+/**
+ * @brief
+ *	-send a Status Delta batch request
+ *
+ * @param[in] c - socket descriptor
+ * @param[in] obj_type - type of objects to status
+ * @param[in] seq - change sequence number
+ * @param[in] attrib - pointer to attribute list
+ * @param[in] extend - extention string for req encode
+ *
+ * @return      int
+ * @retval      0               Success
+ * @retval      pbs_error(!0)   error
+ */
+static int
+PBSD_statdelta_put(int c, int obj_type, long seq, struct attrl *attrib, char *extend)
+{
+	int rc;
+
+	DIS_tcp_funcs();
+
+	if ((rc = encode_DIS_ReqHdr(c, PBS_BATCH_StatusDelta, pbs_current_user)) ||
+		(rc = encode_DIS_StatusDelta(c, obj_type, seq, attrib)) ||
+		(rc = encode_DIS_ReqExtend(c, extend))) {
+		if (set_conn_errtxt(c, dis_emsg[rc]) != 0)
+			return (pbs_errno = PBSE_SYSTEM);
+		return (pbs_errno = PBSE_PROTOCOL);
+	}
+
+	if (dis_flush(c))
+		return (pbs_errno = PBSE_PROTOCOL);
+
+	return 0;
+}
+
+/**
+ * @brief
+ *	-Return the status of the jobs or vnodes whose attributes changed after
+ *	the change sequence number seq, along with an entry for each one deleted
+ *	since then.  A deleted object's entry only has the ATTR_deleted attribute.
+ *
+ * @par
+ *	The server's current change sequence number is returned in newseq, to
+ *	be passed as seq on the next call.  Pass 0 as seq to get all objects.
+ *	If the server no longer remembers deletions as old as seq, the call
+ *	fails with PBSE_DELTASEQ and the caller should start over with 0.
+ *
+ * @param[in] c - communication handle
+ * @param[in] obj_type - MGR_OBJ_JOB or MGR_OBJ_NODE
+ * @param[in] seq - change sequence number from the previous call
+ * @param[out] newseq - change sequence number for the next call
+ * @param[in] attrib - pointer to attribute list
+ * @param[in] extend - extend string for req, "x" includes history jobs
+ *
+ * @return	structure handle
+ * @retval	pointer to batch_status struct		success
+ * @retval	NULL					error, or nothing changed
+ *							if pbs_errno is PBSE_NONE
+ *
+ */
+struct batch_status *
+__pbs_statdelta(int c, int obj_type, long seq, long *newseq, struct attrl *attrib, char *extend)
+{
+	struct batch_status *ret = NULL;
+	struct batch_status *bsp;
+	struct batch_status **pprev;
+	struct attrl *pat;
+	svr_conn_t **svr_conns;
+
+	if ((newseq == NULL) || ((obj_type != MGR_OBJ_JOB) && (obj_type != MGR_OBJ_NODE))) {
+		pbs_errno = PBSE_IVALREQ;
+		return NULL;
+	}
+
+	/* change sequence numbers are local to a server */
+	if (get_num_servers() > 1) {
+		pbs_errno = PBSE_NOSUP;
+		return NULL;
+	}
+
+	if ((svr_conns = get_conn_svr_instances(c)) == NULL)
+		return NULL;
+
+	if ((c = random_srv_conn(c, svr_conns)) < 0)
+		return NULL;
+
+	/* initialize the thread context data, if not already initialized */
+	if (pbs_client_thread_init_thread_context() != 0)
+		return NULL;
+
+	/* first verify the attributes, if verification is enabled */
+	if (pbs_verify_attributes(c, PBS_BATCH_StatusDelta, obj_type, MGR_CMD_NONE, (struct attropl *) attrib))
+		return NULL;
+
+	if (pbs_client_thread_lock_connection(c) != 0)
+		return NULL;
+
+	if (PBSD_statdelta_put(c, obj_type, seq, attrib, extend) == 0)
+		ret = PBSD_status_get(c, NULL, NULL, PROT_TCP);
+
+	/* unlock the thread lock and update the thread context data */
+	if (pbs_client_thread_unlock_connection(c) != 0) {
+		pbs_statfree(ret);
+		return NULL;
+	}
+
+	/* the last entry has no name and carries the server's change sequence number */
+	for (pprev = &ret; (bsp = *pprev) != NULL; pprev = &bsp->next) {
+		if ((bsp->next == NULL) && (bsp->name != NULL) && (*bsp->name == '\0')) {
+			for (pat = bsp->attribs; pat != NULL; pat = pat->next) {
+				if ((pat->name != NULL) && (strcmp(pat->name, ATTR_chgseq) == 0) && (pat->value != NULL))
+					*newseq = strtol(pat->value, NULL, 10);
+			}
+			*pprev = NULL;
+			pbs_statfree(bsp);
+			break;
+		}
+	}
+
+	return ret;
+}
@@ -130,6 +130,7 @@ struct pbs_config pbs_conf = {
 	NULL,					/* mom short name override */
 	NULL,					/* pbs_lr_save_path */
 	0,					/* high resolution timestamp logging */
+	0,					/* asynchronous logging */
 	0,					/* number of scheduler threads */
 	NULL,					/* default scheduler user */
 	{'\0'}					/* current running user */
@@ -672,6 +673,10 @@ __pbs_loadconf(int reload)
 				if (sscanf(conf_value, "%u", &uvalue) == 1)
 					pbs_conf.pbs_log_highres_timestamp = ((uvalue > 0) ? 1 : 0);
 			}
+			else if (!strcmp(conf_name, PBS_CONF_LOG_ASYNC)) {
+				if (sscanf(conf_value, "%u", &uvalue) == 1)
+					pbs_conf.pbs_log_async = ((uvalue > 0) ? 1 : 0);
+			}
 			else if (!strcmp(conf_name, PBS_CONF_SCHED_THREADS)) {
 				if (sscanf(conf_value, "%u", &uvalue) == 1)
 					pbs_conf.pbs_sched_threads = uvalue;
@@ -920,6 +925,10 @@ __pbs_loadconf(int reload)
 		if (sscanf(gvalue, "%u", &uvalue) == 1)
 			pbs_conf.pbs_log_highres_timestamp = ((uvalue > 0) ? 1 : 0);
 	}
+	if ((gvalue = getenv(PBS_CONF_LOG_ASYNC)) != NULL) {
+		if (sscanf(gvalue, "%u", &uvalue) == 1)
+			pbs_conf.pbs_log_async = ((uvalue > 0) ? 1 : 0);
+	}
 	if ((gvalue = getenv(PBS_CONF_SCHED_THREADS)) != NULL) {
 		if (sscanf(gvalue, "%u", &uvalue) == 1)
 			pbs_conf.pbs_sched_threads = uvalue;
@@ -102,6 +102,7 @@ char *msg_daemonname;
 static int log_auto_switch = 0;
 static int log_open_day;
 static FILE *logfile; /* open stream for log file */
+static volatile int logfile_fd = -1; /* its descriptor, for log_async_crash() */
 static volatile int log_opened = 0;
 #if SYSLOG
 static int syslogopen = 0;
@@ -134,7 +135,45 @@ static unsigned int syslogfac = 0;
 static unsigned int syslogsvr = 3;
 static unsigned int pbs_log_highres_timestamp = 0;
 
+#ifndef WIN32
+/*
+ * Asynchronous logging, see log_async_start().  Each thread formats its
+ * records into its own ring buffer without taking the log mutex or
+ * blocking signals.  The thread is the only producer of its ring and
+ * whoever holds the log mutex is the only consumer, so the ring needs no
+ * lock, only ordered updates of head and tail.
+ */
+#define LOG_ASYNC_RING_SIZE	(128 * 1024)	/* bytes per thread, power of 2 */
+#define LOG_ASYNC_INTERVAL	100		/* ms a record may wait for the writer */
+#define LOG_ASYNC_BATCH		(64 * 1024)	/* bytes written in one go */
+
+struct log_ring {
+	struct log_ring *lr_next;	/* list of all rings, see log_rings */
+	size_t lr_head;			/* bytes put by the thread, free running */
+	size_t lr_tail;			/* bytes taken by the consumer, free running */
+	volatile sig_atomic_t lr_busy;	/* thread is putting a record */
+	int lr_orphan;			/* thread exited, free when empty */
+	char lr_data[LOG_ASYNC_RING_SIZE];
+};
+
+static volatile int log_async = 0;		/* asynchronous logging is on */
+static pthread_t log_async_tid;
+static pthread_key_t log_ring_key;
+static pthread_once_t log_ring_key_once = PTHREAD_ONCE_INIT;
+static struct log_ring *log_rings = NULL;	/* guarded by log_write_mutex */
+static unsigned long log_async_drops = 0;	/* records dropped on a full ring */
+static unsigned long log_async_drops_logged = 0;
+static pthread_mutex_t log_async_wake_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t log_async_wake_cond = PTHREAD_COND_INITIALIZER;
+static int log_async_wakeup = 0;
+
+static int log_record_async(int, int, int, const char *, const char *);
+static void log_async_drain(void);
+#endif /* WIN32 */
+
 static void log_init(void);
+static int log_mutex_init(void);
+static int log_open_inner(char *, char *, int);
 static int log_mutex_lock();
 static int log_mutex_unlock();
 static void get_timestamp(ms_time *mst);
@@ -236,6 +275,7 @@ set_logfile(FILE *fp)
 {
 	log_opened = 1;
 	logfile = fp;
+	logfile_fd = fileno(fp);
 }
 
 
@@ -351,16 +391,56 @@ log_parent_post_fork_handler()
 
 /**
  * @brief
- *	wrapper function for log_mutex_unlock().
+ *	Reinitialize the log mutex in the child, a recursive mutex can not be
+ *	unlocked by the child's thread as it is not the owner.
  *
  */
 static void
 log_child_post_fork_handler()
 {
-	log_mutex_unlock();
+	struct log_ring *ring;
+
+	/*
+	 * The writer thread is not in the child.  The child logs synchronously
+	 * and leaves the records still in the rings to the parent.
+	 */
+	if (log_async) {
+		log_async = 0;
+		pthread_setspecific(log_ring_key, NULL);
+		while ((ring = log_rings) != NULL) {
+			log_rings = ring->lr_next;
+			free(ring);
+		}
+	}
+	if (log_mutex_init() != 0)
+		log_console_error("PBS cannot reinitialize its log mutex");
 }
 #endif
 
+/**
+ * @brief
+ *	Initialize the log mutex.  It is recursive, log_record() may switch
+ *	the log and log_close() and log_open() lock on their own to keep the
+ *	asynchronous writer out.
+ *
+ * @return int
+ * @retval 0 - success
+ * @retval !0 - failure
+ */
+static int
+log_mutex_init(void)
+{
+	pthread_mutexattr_t attr;
+	int rc;
+
+	if ((rc = pthread_mutexattr_init(&attr)) != 0)
+		return rc;
+	if ((rc = pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE)) == 0)
+		rc = pthread_mutex_init(&log_write_mutex, &attr);
+	pthread_mutexattr_destroy(&attr);
+	return rc;
+}
+
 /**
  * @brief
  *	Initialize the log mutex and tls
@@ -374,7 +454,7 @@ log_child_post_fork_handler()
 static void
 log_init(void)
 {
-	if (pthread_mutex_init(&log_write_mutex, NULL) != 0) {
+	if (log_mutex_init() != 0) {
 		fprintf(stderr, "log write mutex init failed\n");
 		return;
 	}
@@ -553,6 +633,26 @@ log_open(char *filename, char *directory)
  */
 int
 log_open_main(char *filename, char *directory, int silent)
+{
+	int   rc;
+
+	pthread_once(&log_once_ctl, log_init); /* initialize mutex once */
+
+	if (log_mutex_lock() != 0)
+		return (-1);
+	rc = log_open_inner(filename, directory, silent);
+	log_mutex_unlock();
+	return (rc);
+}
+
+/**
+ * @brief
+ * 	Open the log file for append, with the log mutex held.
+ *
+ * @see log_open_main()
+ */
+static int
+log_open_inner(char *filename, char *directory, int silent)
 {
 	char  buf[_POSIX_PATH_MAX];
 	int   fds;
@@ -568,8 +668,6 @@ log_open_main(char *filename, char *directory, int silent)
 	 */
 	char  tbuf[LOG_BUF_SIZE];
 
-	pthread_once(&log_once_ctl, log_init); /* initialize mutex once */
-
 	if (log_opened > 0)	/* Close existing log */
 		log_close(0);
 
@@ -622,6 +720,7 @@ log_open_main(char *filename, char *directory, int silent)
 			fds = log_opened;
 		}
 		logfile = fdopen(fds, "a");
+		logfile_fd = fds;
 
 #ifdef WIN32
 		(void)setvbuf(logfile, NULL, _IONBF, 0);	/* no buffering to get instant log */
@@ -1001,6 +1100,10 @@ log_record(int eventtype, int objclass, int sev, const char *objname, const char
 	sigset_t block_mask;
 	sigset_t old_mask;
 
+	/* hand the record to the writer thread if logging asynchronously */
+	if (log_async && log_record_async(eventtype, objclass, sev, objname, text) == 0)
+		return;
+
 	/* Block all signals to the process to make the function async-safe */
 	sigfillset(&block_mask);
 	sigprocmask(SIG_BLOCK, &block_mask, &old_mask);
@@ -1034,6 +1137,11 @@ log_record(int eventtype, int objclass, int sev, const char *objname, const char
 			}
 		}
 
+#ifndef WIN32
+		/* keep the order with what the threads logged before */
+		if (log_async)
+			log_async_drain();
+#endif
 		/* call the inner routine which does not lock */
 		log_record_inner(eventtype, objclass, sev, objname, text, &mst);
 		log_mutex_unlock();
@@ -1083,6 +1191,454 @@ log_record_inner(int eventtype, int objclass, int sev, const char *objname, cons
 	}
 }
 
+#ifndef WIN32
+/**
+ * @brief
+ *	Thread specific data destructor, marks the exiting thread's ring
+ *	buffer to be freed once the writer has emptied it.
+ *
+ * @param[in] arg - the thread's struct log_ring
+ */
+static void
+log_ring_release(void *arg)
+{
+	struct log_ring *ring = arg;
+
+	__atomic_store_n(&ring->lr_orphan, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief
+ *	Create the thread specific data key for the ring buffers, once.
+ */
+static void
+log_ring_key_init(void)
+{
+	if (pthread_key_create(&log_ring_key, log_ring_release) != 0)
+		fprintf(stderr, "log ring key create failed\n");
+}
+
+/**
+ * @brief
+ *	Get the calling thread's ring buffer, allocating it on first use.
+ *
+ * @return struct log_ring *
+ * @retval NULL - out of memory
+ */
+static struct log_ring *
+log_ring_get(void)
+{
+	struct log_ring *ring;
+	sigset_t block_mask;
+	sigset_t old_mask;
+
+	if ((ring = pthread_getspecific(log_ring_key)) != NULL)
+		return ring;
+
+	if ((ring = calloc(1, sizeof(struct log_ring))) == NULL)
+		return NULL;
+
+	/* a signal handler logging now must not find the mutex held */
+	sigfillset(&block_mask);
+	pthread_sigmask(SIG_BLOCK, &block_mask, &old_mask);
+	if (log_mutex_lock() == 0) {
+		ring->lr_next = log_rings;
+		log_rings = ring;
+		pthread_setspecific(log_ring_key, ring);
+		log_mutex_unlock();
+	} else {
+		free(ring);
+		ring = NULL;
+	}
+	pthread_sigmask(SIG_SETMASK, &old_mask, NULL);
+	return ring;
+}
+
+/**
+ * @brief
+ *	Copy data into or out of a ring buffer, wrapping around its end.
+ *
+ * @param[in] ring - ring buffer
+ * @param[in] pos - free running position in the ring
+ * @param[in,out] buf - data to copy in, or where to copy it out to
+ * @param[in] n - number of bytes
+ * @param[in] in - copy into the ring if set, out of it otherwise
+ */
+static void
+log_ring_copy(struct log_ring *ring, size_t pos, void *buf, size_t n, int in)
+{
+	size_t off = pos & (LOG_ASYNC_RING_SIZE - 1);
+	size_t first = LOG_ASYNC_RING_SIZE - off;
+
+	if (first > n)
+		first = n;
+	if (in) {
+		memcpy(ring->lr_data + off, buf, first);
+		memcpy(ring->lr_data, (char *) buf + first, n - first);
+	} else {
+		memcpy(buf, ring->lr_data + off, first);
+		memcpy((char *) buf + first, ring->lr_data, n - first);
+	}
+}
+
+/**
+ * @brief
+ *	Wake up the writer thread.
+ */
+static void
+log_async_wake(void)
+{
+	pthread_mutex_lock(&log_async_wake_mutex);
+	log_async_wakeup = 1;
+	pthread_cond_signal(&log_async_wake_cond);
+	pthread_mutex_unlock(&log_async_wake_mutex);
+}
+
+/**
+ * @brief
+ *	Asynchronous counterpart of log_record(), formats the record into the
+ *	calling thread's ring buffer for the writer thread to write out.
+ *	If the ring is full, the record is dropped and counted.
+ *
+ * @par
+ *	Errors and worse are left to log_record() to write out at once, after
+ *	everything logged before them, so they are in the log if the daemon
+ *	dies right after.
+ *
+ * @param[in] eventtype - event type
+ * @param[in] objclass - event object class
+ * @param[in] sev - syslog severity
+ * @param[in] objname - object name stating log msg related to which object
+ * @param[in] text - log msg to be logged.
+ *
+ * @return int
+ * @retval 0 - the record was taken care of
+ * @retval -1 - the caller must log the record synchronously
+ */
+static int
+log_record_async(int eventtype, int objclass, int sev, const char *objname, const char *text)
+{
+	struct log_ring *ring;
+	ms_time mst;
+	char buf[LOG_BUF_SIZE + 512];
+	unsigned int len;
+	size_t head;
+	size_t tail;
+	int rc;
+
+	if (sev <= LOG_ERR)
+		return -1;
+
+	/* a signal handler interrupting the thread while it puts a record */
+	if ((ring = log_ring_get()) == NULL || ring->lr_busy)
+		return -1;
+	ring->lr_busy = 1;
+
+	if ((text == NULL) || (objname == NULL)) {
+		ring->lr_busy = 0;
+		return 0;
+	}
+
+	get_timestamp(&mst);
+	rc = snprintf(buf, sizeof(buf),
+			"%02d/%02d/%04d %02d:%02d:%02d%s;%04x;%s;%s;%s;%s\n",
+			mst.ptm.tm_mon + 1, mst.ptm.tm_mday, mst.ptm.tm_year + 1900,
+			mst.ptm.tm_hour, mst.ptm.tm_min, mst.ptm.tm_sec, mst.microsec_buf,
+			eventtype & ~PBSEVENT_FORCE, msg_daemonname,
+			class_names[objclass], objname, text);
+	if ((rc < 0) || (rc >= (int) sizeof(buf))) {
+		ring->lr_busy = 0;
+		return -1;
+	}
+	len = rc;
+
+#if SYSLOG
+	if (syslogopen != 0)
+		syslog(sev, "%s;%s;%s\n", class_names[objclass], objname, text);
+#endif  /* SYSLOG */
+
+	if ((log_opened > 0) && (locallog != 0 || syslogfac == 0)) {
+		head = ring->lr_head;
+		tail = __atomic_load_n(&ring->lr_tail, __ATOMIC_ACQUIRE);
+		if (LOG_ASYNC_RING_SIZE - (head - tail) < sizeof(len) + len) {
+			__atomic_add_fetch(&log_async_drops, 1, __ATOMIC_RELAXED);
+			log_async_wake();
+		} else {
+			log_ring_copy(ring, head, &len, sizeof(len), 1);
+			log_ring_copy(ring, head + sizeof(len), buf, len, 1);
+			__atomic_store_n(&ring->lr_head, head + sizeof(len) + len, __ATOMIC_RELEASE);
+
+			if (head - tail + sizeof(len) + len > LOG_ASYNC_RING_SIZE / 2)
+				log_async_wake();
+		}
+	}
+	ring->lr_busy = 0;
+	return 0;
+}
+
+/**
+ * @brief
+ *	Write out the records in all ring buffers, with the log mutex held.
+ *	Rings of exited threads are freed once empty.
+ */
+static int log_async_draining = 0;	/* in log_async_drain(), see log_async_crash() */
+
+static void
+log_async_drain(void)
+{
+	static char batch[LOG_ASYNC_BATCH];
+	struct log_ring *ring;
+	struct log_ring **prev;
+	size_t used = 0;
+	size_t head;
+	size_t tail;
+	unsigned int len;
+	unsigned long drops;
+	int dowrite;
+	char dmsg[128];
+	ms_time mst;
+
+	if (log_async_draining)
+		return;
+	log_async_draining = 1;
+	dowrite = (log_opened > 0) && (locallog != 0 || syslogfac == 0);
+
+	prev = &log_rings;
+	while ((ring = *prev) != NULL) {
+		head = __atomic_load_n(&ring->lr_head, __ATOMIC_ACQUIRE);
+		tail = ring->lr_tail;
+		while (tail != head) {
+			log_ring_copy(ring, tail, &len, sizeof(len), 0);
+			if (used + len > sizeof(batch)) {
+				if (dowrite)
+					fwrite(batch, 1, used, logfile);
+				used = 0;
+			}
+			log_ring_copy(ring, tail + sizeof(len), batch + used, len, 0);
+			used += len;
+			tail += sizeof(len) + len;
+		}
+		__atomic_store_n(&ring->lr_tail, tail, __ATOMIC_RELEASE);
+
+		if (__atomic_load_n(&ring->lr_orphan, __ATOMIC_ACQUIRE) &&
+			__atomic_load_n(&ring->lr_head, __ATOMIC_ACQUIRE) == tail) {
+			*prev = ring->lr_next;
+			free(ring);
+		} else
+			prev = &ring->lr_next;
+	}
+
+	if (dowrite) {
+		if (used > 0)
+			fwrite(batch, 1, used, logfile);
+		drops = __atomic_load_n(&log_async_drops, __ATOMIC_RELAXED);
+		if (drops != log_async_drops_logged) {
+			snprintf(dmsg, sizeof(dmsg), "%lu log records dropped, log buffer full",
+				drops - log_async_drops_logged);
+			log_async_drops_logged = drops;
+			get_timestamp(&mst);
+			log_record_inner(PBSEVENT_ERROR | PBSEVENT_FORCE, PBS_EVENTCLASS_SERVER,
+				LOG_WARNING, msg_daemonname, dmsg, &mst);
+		}
+		if (fflush(logfile) != 0)
+			log_console_error("PBS cannot write to its log");
+	}
+	log_async_draining = 0;
+}
+
+/**
+ * @brief
+ *	The writer thread, writes out the ring buffers every LOG_ASYNC_INTERVAL
+ *	ms or sooner when woken up, and switches the log at midnight.
+ *
+ * @param[in] arg - unused
+ *
+ * @return void *
+ */
+static void *
+log_async_writer(void *arg)
+{
+	sigset_t block_mask;
+	struct timespec ts;
+	struct timeval tv;
+	ms_time mst;
+
+	/* signals are for the daemon's own threads */
+	sigfillset(&block_mask);
+	pthread_sigmask(SIG_BLOCK, &block_mask, NULL);
+
+	for (;;) {
+		pthread_mutex_lock(&log_async_wake_mutex);
+		if (!log_async_wakeup) {
+			gettimeofday(&tv, NULL);
+			ts.tv_sec = tv.tv_sec;
+			ts.tv_nsec = (tv.tv_usec + LOG_ASYNC_INTERVAL * 1000) * 1000;
+			if (ts.tv_nsec >= 1000000000) {
+				ts.tv_sec++;
+				ts.tv_nsec -= 1000000000;
+			}
+			pthread_cond_timedwait(&log_async_wake_cond, &log_async_wake_mutex, &ts);
+		}
+		log_async_wakeup = 0;
+		pthread_mutex_unlock(&log_async_wake_mutex);
+
+		if (log_mutex_lock() != 0)
+			continue;
+		log_async_drain();
+		if (log_auto_switch && log_opened > 0) {
+			get_timestamp(&mst);
+			if (mst.ptm.tm_yday != log_open_day) {
+				log_close(1);
+				log_open(NULL, log_directory);
+				if (log_opened < 1)
+					log_console_error("PBS cannot open its log");
+			}
+		}
+		log_mutex_unlock();
+	}
+	return NULL;
+}
+
+/**
+ * @brief
+ *	Start logging asynchronously.  log_record() then only formats the
+ *	record into a per thread ring buffer, which a background thread writes
+ *	out in batches.  Records are dropped, and counted, when a thread logs
+ *	faster than they can be written.
+ *
+ * @par
+ *	Must be called after the daemon forked into the background, a child
+ *	process logs synchronously.  The buffered records are written out by
+ *	log_close(), log_async_flush(), at exit, and with any error logged.
+ *	See log_async_flush_on_crash() for crashes.
+ *
+ * @return int
+ * @retval 0 - success, or already started
+ * @retval -1 - the log could not be locked
+ * @retval >0 - error number, the writer thread could not be started
+ */
+int
+log_async_start(void)
+{
+	static int atexit_set = 0;
+	int rc = 0;
+
+	pthread_once(&log_once_ctl, log_init); /* initialize mutex once */
+	pthread_once(&log_ring_key_once, log_ring_key_init);
+
+	if (log_mutex_lock() != 0)
+		return -1;
+	if (!log_async) {
+		if ((rc = pthread_create(&log_async_tid, NULL, log_async_writer, NULL)) == 0) {
+			pthread_detach(log_async_tid);
+			log_async = 1;
+			if (!atexit_set && atexit(log_async_flush) == 0)
+				atexit_set = 1;
+		}
+	}
+	log_mutex_unlock();
+	return rc;
+}
+
+/**
+ * @brief
+ *	Write out everything logged so far when logging asynchronously.
+ */
+void
+log_async_flush(void)
+{
+	if (!log_async)
+		return;
+	if (log_mutex_lock() == 0) {
+		log_async_drain();
+		log_mutex_unlock();
+	}
+}
+
+/**
+ * @brief
+ *	Fatal signal handler installed by log_async_flush_on_crash().  The
+ *	handler is reset on entry, so returning lets the signal take its
+ *	default action, a core dump, once the rings are written out.
+ *
+ * @par
+ *	The crash may have happened anywhere, with the log mutex or the
+ *	malloc locks held, so only async-signal-safe calls are made here.
+ *	The rings are left alone if the log mutex is busy or this thread was
+ *	draining them, and written straight to the log descriptor otherwise,
+ *	bypassing stdio.  Losing the last records beats hanging without a core.
+ *
+ * @param[in] sig - signal number
+ */
+static void
+log_async_crash(int sig)
+{
+	struct log_ring *ring;
+	size_t head;
+	size_t tail;
+	size_t off;
+	size_t first;
+	unsigned int len;
+	int fd;
+
+	if (!log_async || pthread_mutex_trylock(&log_write_mutex) != 0)
+		return;
+	fd = logfile_fd;
+	if (!log_async_draining && fd >= 0 && (log_opened > 0) && (locallog != 0 || syslogfac == 0)) {
+		for (ring = log_rings; ring != NULL; ring = ring->lr_next) {
+			head = __atomic_load_n(&ring->lr_head, __ATOMIC_ACQUIRE);
+			tail = ring->lr_tail;
+			while (tail != head) {
+				log_ring_copy(ring, tail, &len, sizeof(len), 0);
+				off = (tail + sizeof(len)) & (LOG_ASYNC_RING_SIZE - 1);
+				first = LOG_ASYNC_RING_SIZE - off;
+				if (first > len)
+					first = len;
+				if (write(fd, ring->lr_data + off, first) < 0 ||
+					(len > first && write(fd, ring->lr_data, len - first) < 0))
+					break;
+				tail += sizeof(len) + len;
+			}
+			ring->lr_tail = tail;
+		}
+	}
+	pthread_mutex_unlock(&log_write_mutex);
+}
+
+/**
+ * @brief
+ *	Write out the rings when the daemon crashes, for daemons that have
+ *	no handler of their own for the fatal signals.  Otherwise the last
+ *	records before the crash, which tell most about it, would be lost.
+ */
+void
+log_async_flush_on_crash(void)
+{
+	struct sigaction act;
+	static int fatal_sigs[] = {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT, 0};
+	int i;
+
+	sigemptyset(&act.sa_mask);
+	act.sa_handler = log_async_crash;
+	act.sa_flags = SA_RESETHAND;
+	for (i = 0; fatal_sigs[i] != 0; i++)
+		sigaction(fatal_sigs[i], &act, NULL);
+}
+
+/**
+ * @brief
+ *	Number of records dropped by asynchronous logging because a ring
+ *	buffer was full.
+ *
+ * @return unsigned long
+ */
+unsigned long
+log_async_dropped(void)
+{
+	return __atomic_load_n(&log_async_drops, __ATOMIC_RELAXED);
+}
+#endif /* WIN32 */
+
 /**
  * @brief
  * 	log_close - close the current open log file
@@ -1095,6 +1651,14 @@ log_record_inner(int eventtype, int objclass, int sev, const char *objname, cons
 void
 log_close(int msg)
 {
+	pthread_once(&log_once_ctl, log_init); /* initialize mutex once */
+
+	log_mutex_lock();
+#ifndef WIN32
+	/* write out what the threads logged before closing */
+	if (log_async)
+		log_async_drain();
+#endif
 	if (log_opened == 1) {
 		log_auto_switch = 0;
 		if (msg) {
@@ -1102,6 +1666,7 @@ log_close(int msg)
 			get_timestamp(&mst);
 			log_record_inner(PBSEVENT_SYSTEM, PBS_EVENTCLASS_SERVER, LOG_INFO, "Log", "Log closed", &mst);
 		}
+		logfile_fd = -1;
 		(void)fclose(logfile);
 		log_opened = 0;
 	}
@@ -1111,6 +1676,7 @@ log_close(int msg)
 		syslogopen = 0;
 	}
 #endif	/* SYSLOG */
+	log_mutex_unlock();
 }
 
 /**
@@ -170,6 +170,10 @@ extern PyObject *pbsv1mod_meth_event_param_mod_allow(void);
 extern char pbsv1mod_meth_event_param_mod_disallow_doc[];
 extern PyObject *pbsv1mod_meth_event_param_mod_disallow(void);
 
+extern char pbsv1mod_meth_event_param_load_doc[];
+extern PyObject *pbsv1mod_meth_event_param_load(PyObject *self,
+	PyObject *args, PyObject *kwds);
+
 extern char pbsv1mod_meth_event_doc[];
 extern PyObject *pbsv1mod_meth_event(void);
 
@@ -537,6 +541,9 @@ static PyMethodDef pbs_v1_module_methods[] = {
 	{"_event_param_mod_disallow",
 		(PyCFunction) pbsv1mod_meth_event_param_mod_disallow,
 		METH_NOARGS, pbsv1mod_meth_event_param_mod_disallow_doc},
+	{"_event_param_load",
+		(PyCFunction) pbsv1mod_meth_event_param_load,
+		METH_VARARGS | METH_KEYWORDS, pbsv1mod_meth_event_param_load_doc},
 	{"is_attrib_val_settable", (PyCFunction) pbsv1mod_meth_is_attrib_val_settable,
 		METH_VARARGS | METH_KEYWORDS, pbsv1mod_meth_is_attrib_val_settable_doc},
 	{"get_queue", (PyCFunction) pbsv1mod_meth_get_queue,
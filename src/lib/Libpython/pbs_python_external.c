@@ -88,6 +88,11 @@ extern int pbs_python_setup_namespace_dict(PyObject *globals);
 /* TODO make it autoconf? */
 char *pbs_python_daemon_name;
 
+#ifdef	PYTHON
+/* bumped on each interpreter start, see struct python_script.interp_gen */
+static int interp_generation = 0;
+#endif
+
 /*
  * ===================   BEGIN   EXTERNAL ROUTINES  ===================
  */
@@ -195,6 +200,7 @@ pbs_python_ext_start_interpreter(struct python_interpreter_data *interp_data)
 		char *msgbuf;
 
 		interp_data->interp_started = 1; /* mark python as initialized */
+		interp_generation++;
 		/* print only the first five characters, TODO check for NULL? */
 		pbs_asprintf(&msgbuf,
 			"--> Python Interpreter started, compiled with version:'%s' <--",
@@ -451,6 +457,11 @@ pbs_python_ext_free_python_script(
 			free(py_script->path);
 
 #ifdef PYTHON                 /* --- BEGIN PYTHON BLOCK --- */
+		if (py_script->interp_gen != interp_generation) {
+			/* objects went away with an earlier interpreter */
+			py_script->py_code_obj = NULL;
+			py_script->global_dict = NULL;
+		}
 		if (py_script->py_code_obj)
 			Py_CLEAR(py_script->py_code_obj);
 		if (py_script->global_dict) {
@@ -590,6 +601,49 @@ ERROR_EXIT:
 
 }
 
+#ifdef	PYTHON
+/**
+ * @brief
+ *	Tells whether the compiled code of 'py_script' cannot be used as is.
+ *
+ * @par
+ *	Code compiled by an interpreter that has since been shut down is
+ *	dropped without being released, as its objects went away with the
+ *	interpreter.  Otherwise, if check_for_recompile is set, the script
+ *	file is compared with what was compiled.
+ *
+ * @param[in,out] py_script - the script
+ *
+ * @return	int
+ * @retval	1	script must be compiled
+ * @retval	0	compiled code can be run
+ */
+static int
+script_needs_compile(struct python_script *py_script)
+{
+	struct stat nbuf; /* new stat buf */
+	struct stat *obuf = &py_script->cur_sbuf; /* old buf */
+
+	if (!py_script->py_code_obj)
+		return 1;
+	if (py_script->interp_gen != interp_generation) {
+		py_script->py_code_obj = NULL;
+		py_script->global_dict = NULL;
+		return 1;
+	}
+	if (!py_script->check_for_recompile)
+		return 0;
+	if ((stat(py_script->path, &nbuf) != -1) &&
+		(nbuf.st_ino   == obuf->st_ino)    &&
+		(nbuf.st_size  == obuf->st_size)   &&
+		(nbuf.st_mtime == obuf->st_mtime))
+		return 0;
+	(void) memcpy(obuf, &nbuf, sizeof(py_script->cur_sbuf));
+	Py_CLEAR(py_script->py_code_obj); /* we are rebuilding */
+	return 1;
+}
+#endif	/* PYTHON */
+
 /**
  *
  * @brief
@@ -612,34 +666,14 @@ pbs_python_check_and_compile_script(struct python_interpreter_data *interp_data,
 {
 
 #ifdef	PYTHON           /* -- BEGIN ONLY IF PYTHON IS CONFIGURED -- */
-	struct stat nbuf; /* new stat buf */
-	struct stat obuf; /* old buf */
-	int recompile = 1;
+	int recompile;
 
 	if (!interp_data || !py_script) {
 		log_err(-1, __func__, "Either interp_data or py_script is NULL");
 		return -1;
 	}
 
-	/* ok, first time go straight to compile */
-	do {
-		if (!py_script->py_code_obj)
-			break;
-		(void) memcpy(&obuf, &(py_script->cur_sbuf), sizeof(obuf));
-		if (py_script->check_for_recompile) {
-			if ((stat(py_script->path, &nbuf) != 1) &&
-				(nbuf.st_ino   == obuf.st_ino) &&
-				(nbuf.st_size  == obuf.st_size) &&
-				(nbuf.st_mtime == obuf.st_mtime)) {
-				recompile = 0;
-			} else {
-				recompile = 1;
-				(void) memcpy(&(py_script->cur_sbuf), &nbuf,
-					sizeof(py_script->cur_sbuf));
-				Py_CLEAR(py_script->py_code_obj); /* we are rebuilding */
-			}
-		}
-	} while (0);
+	recompile = script_needs_compile(py_script);
 
 	if (recompile) {
 		snprintf(log_buffer, LOG_BUF_SIZE,
@@ -659,6 +693,7 @@ pbs_python_check_and_compile_script(struct python_interpreter_data *interp_data,
 			pbs_python_write_error_to_log("Failed to compile script");
 			return -2;
 		}
+		py_script->interp_gen = interp_generation;
 	}
 
 	/* set dict to null during compilation, clearing previous global/local */
@@ -697,9 +732,7 @@ pbs_python_run_code_in_namespace(struct python_interpreter_data *interp_data,
 #ifdef	PYTHON           /* -- BEGIN ONLY IF PYTHON IS CONFIGURED -- */
 
 	PyObject *pdict;
-	struct stat nbuf; /* new stat buf */
-	struct stat obuf; /* old buf */
-	int recompile = 1;
+	int recompile;
 	PyObject *ptype;
 	PyObject *pvalue;
 	PyObject *ptraceback;
@@ -714,26 +747,7 @@ pbs_python_run_code_in_namespace(struct python_interpreter_data *interp_data,
 		return -1;
 	}
 
-	/* ok, first time go straight to compile */
-	do {
-		if (!py_script->py_code_obj)
-			break;
-		(void) memcpy(&obuf, &(py_script->cur_sbuf), sizeof(obuf));
-		if (py_script->check_for_recompile) {
-			if ((stat(py_script->path, &nbuf) != -1) &&
-				(nbuf.st_ino   == obuf.st_ino)    &&
-				(nbuf.st_size  == obuf.st_size)   &&
-				(nbuf.st_mtime == obuf.st_mtime)
-				) {
-				recompile = 0;
-			} else {
-				recompile = 1;
-				(void) memcpy(&(py_script->cur_sbuf), &nbuf,
-					sizeof(py_script->cur_sbuf));
-				Py_CLEAR(py_script->py_code_obj); /* we are rebuilding */
-			}
-		}
-	} while (0);
+	recompile = script_needs_compile(py_script);
 
 	if (recompile) {
 		snprintf(log_buffer, LOG_BUF_SIZE-1,
@@ -753,6 +767,7 @@ pbs_python_run_code_in_namespace(struct python_interpreter_data *interp_data,
 			pbs_python_write_error_to_log("Failed to compile script");
 			return -2;
 		}
+		py_script->interp_gen = interp_generation;
 	}
 
 	/* make new namespace dictionary, NOTE new reference */
@@ -68,6 +68,8 @@
 #ifdef PYTHON
 extern void _pbs_python_set_mode(int mode);
 
+extern void _pbs_python_set_event_param_loader(pbs_list_head *(*loader)(int));
+
 extern int _pbs_python_event_mark_readonly(void);
 
 extern int _pbs_python_event_set(unsigned int hook_event, char *req_user,
@@ -190,6 +192,27 @@ pbs_python_set_mode(int mode)
 
 }
 
+/**
+ * @brief
+ * 	Sets the function that returns the data of the event parameters that
+ *	are only built when the hook script first uses them
+ *	(pbs.event().vnode_list and pbs.event().resv_list of periodic hooks).
+ *
+ * @param[in] loader - given HOOK_REFS_VNODE_LIST or HOOK_REFS_RESV_LIST,
+ *			returns the list of attributes to build the
+ *			parameter from.
+ *
+ */
+void
+pbs_python_set_event_param_loader(pbs_list_head *(*loader)(int))
+{
+
+#ifdef PYTHON
+	_pbs_python_set_event_param_loader(loader);
+#endif
+
+}
+
 /**
  * @brief
  * 	Makes the Python PBS event object read-only, meaning none of its
@@ -270,6 +270,9 @@ static int      hook_pbsevent_stop_processing = FALSE; /* flag to stop */
 static char	hook_pbsevent_reject_msg[HOOK_MSG_SIZE];
 static int	hook_set_mode = C_MODE;			/* in C_MODE, can set*/
 /* anything */
+/* event params built only when the hook script first uses them */
+static int	event_param_lazy = 0;	/* HOOK_REFS_* not yet built */
+static pbs_list_head *(*event_param_loader)(int) = NULL;
 static int      hook_reboot_host = FALSE; 	/* flag to reboot host or not */
 static int      hook_reboot_host_cmd[HOOK_BUF_SIZE];   /* cmdline to use */
 /* to reboot host */
@@ -4040,6 +4043,23 @@ _pbs_python_set_mode(int mode)
 	hook_set_mode = mode;
 }
 
+/**
+ * @brief
+ * 	Sets the function that returns the data of the event parameters that
+ *	are only built when the hook script first uses them.
+ *
+ * @param[in] loader - given HOOK_REFS_VNODE_LIST or HOOK_REFS_RESV_LIST,
+ *			returns the list of attributes to build the
+ *			parameter from.
+ *
+ * @see pbsv1mod_meth_event_param_load
+ */
+void
+_pbs_python_set_event_param_loader(pbs_list_head *(*loader)(int))
+{
+	event_param_loader = loader;
+}
+
 
 /**
  *
@@ -5265,6 +5285,7 @@ _pbs_python_event_set(unsigned int hook_event, char *req_user, char *req_host,
 	}
 
 	hook_set_mode = C_MODE;
+	event_param_lazy = 0;
 
 	/*
 	 * First things first create a Python event object.
@@ -5630,21 +5651,26 @@ _pbs_python_event_set(unsigned int hook_event, char *req_user, char *req_host,
 		/* SET VNODE_LIST param */
 		(void)PyDict_SetItemString(py_event_param, PY_EVENT_PARAM_VNODELIST,
 			Py_None);
-		py_vnodelist = create_py_vnodelist(vnlist, perf_label, HOOK_PERF_POPULATE_VNODELIST);
-		if (py_vnodelist == NULL) {
-			LOG_ERROR_ARG2("%s: failed to create a Python vnodelist object for param['%s']",
-				PY_TYPE_EVENT, PY_EVENT_PARAM_VNODELIST);
-			goto event_set_exit;
-		}
+		if ((vnlist == NULL) && (event_param_loader != NULL)) {
+			/* built on first use by pbsv1mod_meth_event_param_load() */
+			event_param_lazy |= HOOK_REFS_VNODE_LIST;
+		} else {
+			py_vnodelist = create_py_vnodelist(vnlist, perf_label, HOOK_PERF_POPULATE_VNODELIST);
+			if (py_vnodelist == NULL) {
+				LOG_ERROR_ARG2("%s: failed to create a Python vnodelist object for param['%s']",
+					PY_TYPE_EVENT, PY_EVENT_PARAM_VNODELIST);
+				goto event_set_exit;
+			}
 
-		/* set vnode list: py_vnodelist given to py_event_param so ref count */
-		/* auto incremented */
-		rc = PyDict_SetItemString(py_event_param, PY_EVENT_PARAM_VNODELIST,
-			py_vnodelist);
-		if (rc == -1) {
-			LOG_ERROR_ARG2("%s: partially set remaining param['%s'] attributes",
-				PY_TYPE_EVENT, PY_EVENT_PARAM_VNODELIST);
-			goto event_set_exit;
+			/* set vnode list: py_vnodelist given to py_event_param so ref count */
+			/* auto incremented */
+			rc = PyDict_SetItemString(py_event_param, PY_EVENT_PARAM_VNODELIST,
+				py_vnodelist);
+			if (rc == -1) {
+				LOG_ERROR_ARG2("%s: partially set remaining param['%s'] attributes",
+					PY_TYPE_EVENT, PY_EVENT_PARAM_VNODELIST);
+				goto event_set_exit;
+			}
 		}
 
 		/* SET RESV_LIST param */
@@ -5652,20 +5678,25 @@ _pbs_python_event_set(unsigned int hook_event, char *req_user, char *req_host,
 
 		(void)PyDict_SetItemString(py_event_param, PY_EVENT_PARAM_RESVLIST,
 			Py_None);
-		py_resvlist = create_py_resvlist(resvlist, perf_label, HOOK_PERF_POPULATE_RESVLIST);
-		if (py_resvlist == NULL) {
-			LOG_ERROR_ARG2("%s: failed to create a Python resvlist object for param['%s']",
-				PY_TYPE_EVENT, PY_EVENT_PARAM_RESVLIST);
-			goto event_set_exit;
-		}
-		/* set resv list: py_resvlist given to py_event_param so ref count */
-		/* auto incremented */
-		rc = PyDict_SetItemString(py_event_param, PY_EVENT_PARAM_RESVLIST,
-			py_resvlist);
-		if (rc == -1) {
-			LOG_ERROR_ARG2("%s: partially set remaining param['%s'] attributes",
-				PY_TYPE_EVENT, PY_EVENT_PARAM_RESVLIST);
-			goto event_set_exit;
+		if ((resvlist == NULL) && (event_param_loader != NULL)) {
+			/* built on first use by pbsv1mod_meth_event_param_load() */
+			event_param_lazy |= HOOK_REFS_RESV_LIST;
+		} else {
+			py_resvlist = create_py_resvlist(resvlist, perf_label, HOOK_PERF_POPULATE_RESVLIST);
+			if (py_resvlist == NULL) {
+				LOG_ERROR_ARG2("%s: failed to create a Python resvlist object for param['%s']",
+					PY_TYPE_EVENT, PY_EVENT_PARAM_RESVLIST);
+				goto event_set_exit;
+			}
+			/* set resv list: py_resvlist given to py_event_param so ref count */
+			/* auto incremented */
+			rc = PyDict_SetItemString(py_event_param, PY_EVENT_PARAM_RESVLIST,
+				py_resvlist);
+			if (rc == -1) {
+				LOG_ERROR_ARG2("%s: partially set remaining param['%s'] attributes",
+					PY_TYPE_EVENT, PY_EVENT_PARAM_RESVLIST);
+				goto event_set_exit;
+			}
 		}
 	} else if (hook_event == HOOK_EVENT_RUNJOB) {
 		struct rq_runjob	*rqj = req_params->rq_run;
@@ -6827,149 +6858,154 @@ _pbs_python_event_to_request(unsigned int hook_event, hook_output_param_t *req_p
 
 			break;
 		case HOOK_EVENT_PERIODIC:
-			py_vnodelist = _pbs_python_event_get_param(PY_EVENT_PARAM_VNODELIST);
-			if (!py_vnodelist) {
-				log_err(PBSE_INTERNAL, __func__,
-					"No vnode list parameter found for event!");
-				goto event_to_request_exit;
-			}
-
-			if (!PyDict_Check(py_vnodelist)) {
-				log_err(PBSE_INTERNAL, __func__,
-					"vnode list parameter not a dictionary!");
-				goto event_to_request_exit;
-			}
-
-			py_attr_keys = PyDict_Keys(py_vnodelist); /* NEW ref */
-
-			if (py_attr_keys == NULL) {
-				snprintf(log_buffer, sizeof(log_buffer),
-					"Failed to obtain object's '%s' keys",
-					PY_EVENT_PARAM_VNODE);
-				log_err(PBSE_INTERNAL, __func__, log_buffer);
-				goto event_to_request_exit;
-			}
-
-			if (!PyList_Check(py_attr_keys)) {
-				snprintf(log_buffer, sizeof(log_buffer),
-					"object's '%s' keys is not a list!",
-					PY_EVENT_PARAM_VNODE);
-				log_err(PBSE_INTERNAL, __func__, log_buffer);
-				Py_CLEAR(py_attr_keys);
-				goto event_to_request_exit;
-			}
-
-			num_attrs = PyList_Size(py_attr_keys);
-			for (i = 0; i < num_attrs; i++) {
-
-				key_str = strdup(pbs_python_list_get_item_string_value(
-							py_attr_keys, i));
+			/* a vnode_list or resv_list never built was not changed */
+			if (!(event_param_lazy & HOOK_REFS_VNODE_LIST)) {
+				py_vnodelist = _pbs_python_event_get_param(PY_EVENT_PARAM_VNODELIST);
+				if (!py_vnodelist) {
+					log_err(PBSE_INTERNAL, __func__,
+						"No vnode list parameter found for event!");
+					goto event_to_request_exit;
+				}
 
-				if ((key_str == NULL) || (key_str[0] == '\0')) {
-					if (key_str != NULL) {
-						free(key_str);
-						key_str = NULL;
-					}
-					continue;
+				if (!PyDict_Check(py_vnodelist)) {
+					log_err(PBSE_INTERNAL, __func__,
+						"vnode list parameter not a dictionary!");
+					goto event_to_request_exit;
 				}
 
-				py_vnode = PyDict_GetItemString(py_vnodelist, key_str);
+				py_attr_keys = PyDict_Keys(py_vnodelist); /* NEW ref */
 
-				if (py_vnode == NULL) {
+				if (py_attr_keys == NULL) {
 					snprintf(log_buffer, sizeof(log_buffer),
-						"failed to get attribute '%s' value", key_str);
+						"Failed to obtain object's '%s' keys",
+						PY_EVENT_PARAM_VNODE);
 					log_err(PBSE_INTERNAL, __func__, log_buffer);
-					Py_CLEAR(py_attr_keys);
-					free(key_str);
-					key_str = NULL;
 					goto event_to_request_exit;
 				}
 
-				if (pbs_python_populate_svrattrl_from_python_class(py_vnode,
-					(pbs_list_head *)(req_params->vns_list), key_str, 1) == -1) {
+				if (!PyList_Check(py_attr_keys)) {
 					snprintf(log_buffer, sizeof(log_buffer),
-						"failed to populate svrattrl with key '%s' value", key_str);
+						"object's '%s' keys is not a list!",
+						PY_EVENT_PARAM_VNODE);
 					log_err(PBSE_INTERNAL, __func__, log_buffer);
 					Py_CLEAR(py_attr_keys);
-					free(key_str);
-					key_str = NULL;
 					goto event_to_request_exit;
 				}
-				free(key_str);
-			}
-			Py_CLEAR(py_attr_keys);
 
-			py_resvlist = _pbs_python_event_get_param(PY_EVENT_PARAM_RESVLIST);
-			if (!py_resvlist) {
-				log_err(PBSE_INTERNAL, __func__,
-					"No reservation list parameter found for event!");
-				goto event_to_request_exit;
-			}
+				num_attrs = PyList_Size(py_attr_keys);
+				for (i = 0; i < num_attrs; i++) {
 
-			if (!PyDict_Check(py_resvlist)) {
-				log_err(PBSE_INTERNAL, __func__,
-					"reservation list parameter not a dictionary!");
-				goto event_to_request_exit;
-			}
+					key_str = strdup(pbs_python_list_get_item_string_value(
+								py_attr_keys, i));
 
-			py_attr_keys = PyDict_Keys(py_resvlist); /* NEW ref */
+					if ((key_str == NULL) || (key_str[0] == '\0')) {
+						if (key_str != NULL) {
+							free(key_str);
+							key_str = NULL;
+						}
+						continue;
+					}
 
-			if (py_attr_keys == NULL) {
-				snprintf(log_buffer, sizeof(log_buffer),
-					"Failed to obtain object's '%s' keys",
-					PY_EVENT_PARAM_RESVLIST);
-				log_err(PBSE_INTERNAL, __func__, log_buffer);
-				goto event_to_request_exit;
-			}
+					py_vnode = PyDict_GetItemString(py_vnodelist, key_str);
 
-			if (!PyList_Check(py_attr_keys)) {
-				snprintf(log_buffer, sizeof(log_buffer),
-					"object's '%s' keys is not a list!",
-					PY_EVENT_PARAM_RESVLIST);
-				log_err(PBSE_INTERNAL, __func__, log_buffer);
+					if (py_vnode == NULL) {
+						snprintf(log_buffer, sizeof(log_buffer),
+							"failed to get attribute '%s' value", key_str);
+						log_err(PBSE_INTERNAL, __func__, log_buffer);
+						Py_CLEAR(py_attr_keys);
+						free(key_str);
+						key_str = NULL;
+						goto event_to_request_exit;
+					}
+
+					if (pbs_python_populate_svrattrl_from_python_class(py_vnode,
+						(pbs_list_head *)(req_params->vns_list), key_str, 1) == -1) {
+						snprintf(log_buffer, sizeof(log_buffer),
+							"failed to populate svrattrl with key '%s' value", key_str);
+						log_err(PBSE_INTERNAL, __func__, log_buffer);
+						Py_CLEAR(py_attr_keys);
+						free(key_str);
+						key_str = NULL;
+						goto event_to_request_exit;
+					}
+					free(key_str);
+				}
 				Py_CLEAR(py_attr_keys);
-				goto event_to_request_exit;
 			}
 
-			num_attrs = PyList_Size(py_attr_keys);
-
-			for (i = 0; i < num_attrs; i++) {
-
-				key_str = strdup(pbs_python_list_get_item_string_value(\
-							py_attr_keys, i));
+			if (!(event_param_lazy & HOOK_REFS_RESV_LIST)) {
+				py_resvlist = _pbs_python_event_get_param(PY_EVENT_PARAM_RESVLIST);
+				if (!py_resvlist) {
+					log_err(PBSE_INTERNAL, __func__,
+						"No reservation list parameter found for event!");
+					goto event_to_request_exit;
+				}
 
-				if ((key_str == NULL) || (key_str[0] == '\0')) {
-					if (key_str != NULL) {
-						free(key_str);
-					}
-					continue;
+				if (!PyDict_Check(py_resvlist)) {
+					log_err(PBSE_INTERNAL, __func__,
+						"reservation list parameter not a dictionary!");
+					goto event_to_request_exit;
 				}
 
-				py_job = PyDict_GetItemString(py_resvlist,
-					key_str); /* borrowed */
+				py_attr_keys = PyDict_Keys(py_resvlist); /* NEW ref */
 
-				if (py_job == NULL) {
-					snprintf(log_buffer, sizeof(log_buffer)-1,
-						"failed to get attribute '%s' value", key_str);
+				if (py_attr_keys == NULL) {
+					snprintf(log_buffer, sizeof(log_buffer),
+						"Failed to obtain object's '%s' keys",
+						PY_EVENT_PARAM_RESVLIST);
 					log_err(PBSE_INTERNAL, __func__, log_buffer);
-					Py_CLEAR(py_attr_keys);
-					free(key_str);
 					goto event_to_request_exit;
 				}
 
-				if (pbs_python_populate_svrattrl_from_python_class(py_job,
-					(pbs_list_head *)(req_params->resv_list), key_str, 1) == -1) {
-					snprintf(log_buffer, sizeof(log_buffer)-1,
-						"failed to populate svrattrl with key '%s' value", key_str);
+				if (!PyList_Check(py_attr_keys)) {
+					snprintf(log_buffer, sizeof(log_buffer),
+						"object's '%s' keys is not a list!",
+						PY_EVENT_PARAM_RESVLIST);
 					log_err(PBSE_INTERNAL, __func__, log_buffer);
 					Py_CLEAR(py_attr_keys);
-					free(key_str);
 					goto event_to_request_exit;
 				}
 
-				free(key_str);
+				num_attrs = PyList_Size(py_attr_keys);
+
+				for (i = 0; i < num_attrs; i++) {
+
+					key_str = strdup(pbs_python_list_get_item_string_value(\
+								py_attr_keys, i));
+
+					if ((key_str == NULL) || (key_str[0] == '\0')) {
+						if (key_str != NULL) {
+							free(key_str);
+						}
+						continue;
+					}
+
+					py_job = PyDict_GetItemString(py_resvlist,
+						key_str); /* borrowed */
+
+					if (py_job == NULL) {
+						snprintf(log_buffer, sizeof(log_buffer)-1,
+							"failed to get attribute '%s' value", key_str);
+						log_err(PBSE_INTERNAL, __func__, log_buffer);
+						Py_CLEAR(py_attr_keys);
+						free(key_str);
+						goto event_to_request_exit;
+					}
+
+					if (pbs_python_populate_svrattrl_from_python_class(py_job,
+						(pbs_list_head *)(req_params->resv_list), key_str, 1) == -1) {
+						snprintf(log_buffer, sizeof(log_buffer)-1,
+							"failed to populate svrattrl with key '%s' value", key_str);
+						log_err(PBSE_INTERNAL, __func__, log_buffer);
+						Py_CLEAR(py_attr_keys);
+						free(key_str);
+						goto event_to_request_exit;
+					}
+
+					free(key_str);
+				}
+				Py_CLEAR(py_attr_keys);
 			}
-			Py_CLEAR(py_attr_keys);
 
 			break;
 		default:
@@ -8228,6 +8264,89 @@ pbsv1mod_meth_event_param_mod_disallow(PyObject *self)
 	Py_RETURN_NONE;
 }
 
+const char pbsv1mod_meth_event_param_load_doc[] =
+"_event_param_load(name)\n\
+\n\
+         Build the event parameter 'name' if it is only built on first\n\
+         use, and return it.  Returns None otherwise.\n\
+";
+
+/**
+ * @brief
+ *	Build the event parameter 'name' (vnode_list or resv_list) if it was
+ *	left to be built on first use, and store it in the event's param.
+ *
+ * @return	PyObject *
+ * @retval	the built parameter
+ * @retval	Py_None	parameter already built, or not built on first use
+ * @retval	NULL	error, exception set
+ */
+PyObject *
+pbsv1mod_meth_event_param_load(PyObject *self, PyObject *args, PyObject *kwds)
+{
+	static char *kwlist[] = {"name", NULL};
+	char		*name = NULL;
+	int		which;
+	int		mode_orig;
+	pbs_list_head	*plist;
+	PyObject	*py_list = NULL;
+	PyObject	*py_param;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds,
+		"s:_event_param_load",
+		kwlist,
+		&name
+		)) {
+		return NULL;
+	}
+
+	if (strcmp(name, PY_EVENT_PARAM_VNODELIST) == 0)
+		which = HOOK_REFS_VNODE_LIST;
+	else if (strcmp(name, PY_EVENT_PARAM_RESVLIST) == 0)
+		which = HOOK_REFS_RESV_LIST;
+	else
+		which = 0;
+	if (!(event_param_lazy & which) || (event_param_loader == NULL) ||
+		(py_hook_pbsevent == NULL))
+		Py_RETURN_NONE;
+	event_param_lazy &= ~which;
+
+	plist = event_param_loader(which);
+	if (plist == NULL) {
+		PyErr_Format(PyExc_RuntimeError, "failed to get event %s", name);
+		return NULL;
+	}
+
+	/* loading PBS data, not values set by the hook script */
+	mode_orig = hook_set_mode;
+	hook_set_mode = C_MODE;
+	if (which == HOOK_REFS_VNODE_LIST)
+		py_list = create_py_vnodelist(plist, NULL, NULL);
+	else
+		py_list = create_py_resvlist(plist, NULL, NULL);
+	hook_set_mode = mode_orig;
+	if (py_list == NULL) {
+		if (!PyErr_Occurred())
+			PyErr_Format(PyExc_RuntimeError,
+				"failed to create event %s", name);
+		return NULL;
+	}
+
+	py_param = PyObject_GetAttrString(py_hook_pbsevent, PY_EVENT_PARAM); /* NEW */
+	if ((py_param == NULL) || !PyDict_Check(py_param) ||
+		(PyDict_SetItemString(py_param, name, py_list) == -1)) {
+		Py_XDECREF(py_param);
+		Py_DECREF(py_list);
+		if (!PyErr_Occurred())
+			PyErr_Format(PyExc_RuntimeError,
+				"failed to set event %s", name);
+		return NULL;
+	}
+	Py_DECREF(py_param);
+
+	return py_list;
+}
+
 /*
  * Create an event object and stuff the fixed attributes
  */
@@ -620,7 +620,7 @@ tpp_init(struct tpp_config *cnf)
 	TPP_QUE_CLEAR(&strm_action_queue);
 	TPP_QUE_CLEAR(&freed_sd_queue);
 
-	streams_idx = pbs_idx_create(PBS_IDX_DUPS_OK, sizeof(tpp_addr_t));
+	streams_idx = pbs_idx_create(PBS_IDX_DUPS_OK | PBS_IDX_HASH, sizeof(tpp_addr_t));
 	if (streams_idx == NULL) {
 		tpp_log(LOG_CRIT, __func__, "Failed to create index for leaves");
 		return -1;
@@ -370,6 +370,23 @@ tpp_sock_send(int s, const char *buf, int len, int flags)
 	return ret;
 }
 
+/*
+ * wrapper to emulate writev() on windows, only the first
+ * non-empty buffer is sent, callers must handle partial
+ * writes anyway
+ */
+int
+tpp_sock_writev(int s, const struct iovec *iov, int iovcnt)
+{
+	int i;
+
+	for (i = 0; i < iovcnt; i++) {
+		if (iov[i].iov_len > 0)
+			return tpp_sock_send(s, iov[i].iov_base, iov[i].iov_len, 0);
+	}
+	return 0;
+}
+
 /*
  * wrapper to call windows select() and map windows
  * error code to errno and massage the return value
@@ -0,0 +1,368 @@
+/*
+ * Copyright (C) 1994-2021 Altair Engineering, Inc.
+ * For more information, contact Altair at www.altair.com.
+ *
+ * This file is part of both the OpenPBS software ("OpenPBS")
+ * and the PBS Professional ("PBS Pro") software.
+ *
+ * Open Source License Information:
+ *
+ * OpenPBS is free software. You can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * OpenPBS is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Commercial License Information:
+ *
+ * PBS Pro is commercially licensed software that shares a common core with
+ * the OpenPBS software.  For a copy of the commercial license terms and
+ * conditions, go to: (http://www.pbspro.com/agreement.html) or contact the
+ * Altair Legal Department.
+ *
+ * Altair's dual-license business model allows companies, individuals, and
+ * organizations to create proprietary derivative works of OpenPBS and
+ * distribute them - whether embedded or bundled with other software -
+ * under a commercial license agreement.
+ *
+ * Use of Altair's trademarks, including but not limited to "PBS™",
+ * "OpenPBS®", "PBS Professional®", and "PBS Pro™" and Altair's logos is
+ * subject to Altair's trademark licensing policies.
+ */
+
+
+/**
+ * @file	tpp_send_bench.c
+ *
+ * @brief
+ *	Microbenchmark of the TPP transport send path.  Sends N small data
+ *	packets (200000 by default), each a tpp_data_pkt_hdr_t chunk and a
+ *	payload chunk (64 bytes by default) as tpp_send() queues them, over a
+ *	loopback TCP connection to a thread that reads them back.  This is
+ *	done with a copy of the old send_data() loop, one send() per chunk,
+ *	and with a copy of the current one, which gathers the chunks of up to
+ *	TPP_MAX_SEND_PKTS packets into one writev().  Reports messages per
+ *	second for both.  Not installed, run it from the build tree:
+ *
+ *		src/lib/Libtpp/tpp_send_bench [N [payload bytes]]
+ */
+
+#include <pbs_config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "tpp_internal.h"
+
+/* as in tpp_transport.c */
+#define TPP_MAX_SEND_PKTS	64 /* max packets gathered into one writev */
+#define TPP_MAX_IOV		128 /* max chunks gathered into one writev */
+
+/* the packets waiting to be sent, stands in for a connection's send_mbox */
+static tpp_packet_t **queue;
+static int queue_len;
+static int queue_pos;
+
+/* the packets being sent by the gathering loop, as in phy_conn_t */
+static tpp_packet_t *send_pkts[TPP_MAX_SEND_PKTS];
+static int num_send_pkts;
+
+/* what the reader thread reads */
+struct reader_arg {
+	int fd;		/* receiving end of the connection */
+	size_t len;	/* bytes to read */
+};
+
+/**
+ * @brief	monotonic time in seconds
+ *
+ * @return	double
+ */
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * @brief	the reader thread, reads until all bytes sent have arrived
+ *
+ * @param[in]	arg - struct reader_arg
+ *
+ * @return	void *
+ */
+static void *
+reader(void *arg)
+{
+	int fd = ((struct reader_arg *) arg)->fd;
+	size_t left = ((struct reader_arg *) arg)->len;
+	char buf[64 * 1024];
+	ssize_t rc;
+
+	while (left > 0) {
+		rc = read(fd, buf, left < sizeof(buf) ? left : sizeof(buf));
+		if (rc <= 0) {
+			fprintf(stderr, "read failed\n");
+			break;
+		}
+		left -= rc;
+	}
+	return NULL;
+}
+
+/**
+ * @brief	old send_data(): send the queued packets one chunk at a time
+ *
+ * @param[in]	fd - socket to send on
+ *
+ * @return	int
+ * @retval	0 - success
+ * @retval	-1 - send failed
+ */
+static int
+old_send_data(int fd)
+{
+	tpp_packet_t *pkt;
+	tpp_chunk_t *p;
+	ssize_t rc;
+	size_t tosend;
+
+	while (queue_pos < queue_len) {
+		pkt = queue[queue_pos++];
+		for (p = pkt->curr_chunk; p; p = GET_NEXT(p->chunk_link)) {
+			tosend = p->len - (p->pos - p->data);
+			while (tosend > 0) {
+				if ((rc = tpp_sock_send(fd, p->pos, tosend, 0)) < 0)
+					return -1;
+				p->pos += rc;
+				tosend -= rc;
+			}
+		}
+		tpp_free_pkt(pkt);
+	}
+	return 0;
+}
+
+/**
+ * @brief	consume_sent_data() of tpp_transport.c
+ *
+ * @param[in]	sent - number of bytes written to the socket
+ */
+static void
+consume_sent_data(size_t sent)
+{
+	tpp_packet_t *pkt;
+	tpp_chunk_t *p;
+	size_t len;
+
+	while (num_send_pkts > 0) {
+		pkt = send_pkts[0];
+		for (p = pkt->curr_chunk; p; p = GET_NEXT(p->chunk_link)) {
+			len = p->len - (p->pos - p->data);
+			if (len > sent) {
+				p->pos += sent;
+				break;
+			}
+			p->pos += len;
+			sent -= len;
+		}
+		if (p) {
+			pkt->curr_chunk = p;
+			return;
+		}
+		tpp_free_pkt(pkt);
+		num_send_pkts--;
+		memmove(&send_pkts[0], &send_pkts[1], num_send_pkts * sizeof(tpp_packet_t *));
+	}
+}
+
+/**
+ * @brief	send_data() of tpp_transport.c: gather the queued packets
+ *		into one writev() at a time
+ *
+ * @param[in]	fd - socket to send on
+ *
+ * @return	int
+ * @retval	0 - success
+ * @retval	-1 - send failed
+ */
+static int
+new_send_data(int fd)
+{
+	struct iovec iov[TPP_MAX_IOV];
+	tpp_chunk_t *p;
+	ssize_t rc;
+	int niov;
+	int i;
+
+	for (;;) {
+		while (num_send_pkts < TPP_MAX_SEND_PKTS && queue_pos < queue_len)
+			send_pkts[num_send_pkts++] = queue[queue_pos++];
+		if (num_send_pkts == 0)
+			return 0;
+
+		niov = 0;
+		for (i = 0; i < num_send_pkts && niov < TPP_MAX_IOV; i++) {
+			for (p = send_pkts[i]->curr_chunk; p && niov < TPP_MAX_IOV; p = GET_NEXT(p->chunk_link)) {
+				if (p->len == (size_t)(p->pos - p->data))
+					continue;
+				iov[niov].iov_base = p->pos;
+				iov[niov].iov_len = p->len - (p->pos - p->data);
+				niov++;
+			}
+		}
+		rc = 0;
+		if (niov > 0 && (rc = tpp_sock_writev(fd, iov, niov)) < 0)
+			return -1;
+		consume_sent_data((size_t) rc);
+	}
+}
+
+/**
+ * @brief	open a loopback TCP connection
+ *
+ * @param[out]	fds - sending and receiving ends
+ *
+ * @return	int
+ * @retval	0 - success
+ * @retval	-1 - failure
+ */
+static int
+open_conn(int fds[2])
+{
+	struct sockaddr_in addr;
+	socklen_t alen = sizeof(addr);
+	int lfd;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	if ((lfd = socket(AF_INET, SOCK_STREAM, 0)) < 0)
+		return -1;
+	if (bind(lfd, (struct sockaddr *) &addr, sizeof(addr)) < 0 ||
+		listen(lfd, 1) < 0 ||
+		getsockname(lfd, (struct sockaddr *) &addr, &alen) < 0 ||
+		(fds[0] = socket(AF_INET, SOCK_STREAM, 0)) < 0) {
+		close(lfd);
+		return -1;
+	}
+	if (connect(fds[0], (struct sockaddr *) &addr, sizeof(addr)) < 0 ||
+		(fds[1] = accept(lfd, NULL, NULL)) < 0) {
+		close(fds[0]);
+		close(lfd);
+		return -1;
+	}
+	close(lfd);
+	return 0;
+}
+
+/**
+ * @brief	time one implementation and print the result
+ *
+ * @param[in]	old - 1 for the old send loop, 0 for the gathering one
+ * @param[in]	n - number of packets
+ * @param[in]	payload - payload bytes per packet
+ *
+ * @return	int
+ * @retval	0 - success
+ * @retval	1 - failure
+ */
+static int
+bench(int old, int n, int payload)
+{
+	tpp_data_pkt_hdr_t hdr;
+	char *data;
+	pthread_t tid;
+	struct reader_arg rarg;
+	size_t total = (size_t) n * (sizeof(hdr) + payload);
+	int fds[2];
+	double t0, t1;
+	int rc;
+	int i;
+
+	if (open_conn(fds) != 0) {
+		fprintf(stderr, "loopback connection failed\n");
+		return 1;
+	}
+	if ((data = calloc(1, payload)) == NULL) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	memset(&hdr, 0, sizeof(hdr));
+	hdr.type = TPP_DATA;
+	hdr.totlen = htonl(sizeof(hdr) + payload);
+
+	/* build the packets the way tpp_send() does, a header and a data chunk */
+	for (i = 0; i < n; i++) {
+		queue[i] = tpp_bld_pkt(NULL, &hdr, sizeof(hdr), 1, NULL);
+		if (queue[i] == NULL || tpp_bld_pkt(queue[i], data, payload, 1, NULL) == NULL) {
+			fprintf(stderr, "tpp_bld_pkt failed\n");
+			return 1;
+		}
+	}
+	queue_len = n;
+	queue_pos = 0;
+
+	rarg.fd = fds[1];
+	rarg.len = total;
+	if (pthread_create(&tid, NULL, reader, &rarg) != 0) {
+		fprintf(stderr, "pthread_create failed\n");
+		return 1;
+	}
+
+	t0 = now();
+	rc = old ? old_send_data(fds[0]) : new_send_data(fds[0]);
+	pthread_join(tid, NULL);
+	t1 = now();
+
+	close(fds[0]);
+	close(fds[1]);
+	free(data);
+	if (rc != 0) {
+		fprintf(stderr, "send failed\n");
+		return 1;
+	}
+
+	printf("%-6s n=%d payload=%d %.0f msgs/sec, %.1f MB/sec\n",
+		old ? "send" : "writev", n, payload,
+		n / (t1 - t0), total / (t1 - t0) / 1e6);
+	return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+	int n = 200000;
+	int payload = 64;
+
+	if (argc > 3 || (argc > 1 && (n = atoi(argv[1])) <= 0) ||
+		(argc > 2 && (payload = atoi(argv[2])) <= 0)) {
+		fprintf(stderr, "usage: %s [number of messages [payload bytes]]\n", argv[0]);
+		return 2;
+	}
+
+	if ((queue = malloc(n * sizeof(tpp_packet_t *))) == NULL) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	if (bench(1, n, payload) || bench(0, n, payload))
+		return 1;
+	return 0;
+}
@@ -81,6 +81,9 @@
 #define TPP_CONN_CONNECTING     3 /* Channel is connecting */
 #define TPP_CONN_CONNECTED      4 /* Channel is connected */
 
+#define TPP_MAX_SEND_PKTS	64 /* max packets gathered into one writev */
+#define TPP_MAX_IOV		128 /* max chunks gathered into one writev */
+
 int tpp_going_down = 0;
 
 /*
@@ -186,7 +189,8 @@ typedef struct {
 
 	tpp_mbox_t send_mbox;     /* mbox of pkts to send */
 	tpp_chunk_t scratch;      /* scratch to work on incoming data */
-	tpp_packet_t *curr_send_pkt; /* current packet dequed from send_mbox to be sent out  */
+	tpp_packet_t *send_pkts[TPP_MAX_SEND_PKTS]; /* pkts dequed from send_mbox, being sent out */
+	int num_send_pkts;        /* number of pkts in send_pkts */
 	thrd_data_t *td;          /* connections controller thread */
 
 	tpp_context_t *ctx;       /* upper layers context information */
@@ -1897,9 +1901,63 @@ add_pkt(phy_conn_t *conn)
 
 /**
  * @brief
- *	Loop over the list of queued data and send out packet by packet
+ *	Account for data written out on a connection. Advance the chunk
+ *	positions of the packets being sent, freeing every packet that
+ *	has been sent out completely.
+ *
+ * @param[in] conn - The physical connection
+ * @param[in] sent - Number of bytes written to the socket
+ *
+ * @par Side Effects:
+ *	None
+ *
+ * @par MT-safe: No
+ *
+ */
+static void
+consume_sent_data(phy_conn_t *conn, size_t sent)
+{
+	tpp_packet_t *pkt;
+	tpp_chunk_t *p;
+	size_t len;
+
+	while (conn->num_send_pkts > 0) {
+		pkt = conn->send_pkts[0];
+		for (p = pkt->curr_chunk; p; p = GET_NEXT(p->chunk_link)) {
+			len = p->len - (p->pos - p->data);
+			if (len > sent) {
+				p->pos += sent;
+				break;
+			}
+			p->pos += len;
+			sent -= len;
+		}
+
+		if (p) {
+			/* rest of this packet is still to be sent */
+			pkt->curr_chunk = p;
+			return;
+		}
+
+		/*
+		 * all data in this packet has been sent or done with.
+		 * delete this packet and move to the next one
+		 */
+		tpp_free_pkt(pkt);
+		conn->num_send_pkts--;
+		memmove(&conn->send_pkts[0], &conn->send_pkts[1], conn->num_send_pkts * sizeof(tpp_packet_t *));
+	}
+}
+
+/**
+ * @brief
+ *	Loop over the list of queued data and send it out, gathering the
+ *	chunks of as many queued packets as possible into a single writev.
  *	Stop if sending would block.
  *
+ *	The presend handler of a packet is called when the packet is
+ *	dequeued from send_mbox, before any of its data is gathered.
+ *
  * @param[in] conn - The physical connection
  *
  * @par Side Effects:
@@ -1911,11 +1969,13 @@ add_pkt(phy_conn_t *conn)
 static void
 send_data(phy_conn_t *conn)
 {
+	struct iovec iov[TPP_MAX_IOV];
 	tpp_chunk_t *p = NULL;
 	tpp_packet_t *pkt = NULL;
 	ssize_t rc;
-	int curr_pkt_done = 0;
 	size_t tosend;
+	int niov;
+	int i;
 
 	/*
 	 * if a socket is still connecting, we will wait to send out data,
@@ -1925,70 +1985,68 @@ send_data(phy_conn_t *conn)
 		return;
 
 	while ((conn->ev_mask & EM_OUT) == 0) {
-		rc = 0;
-		curr_pkt_done = 0;
 
-		pkt = conn->curr_send_pkt;
-		if (!pkt) {
-			/* get the next packet from send_mbox */
-			if (tpp_mbox_read(&conn->send_mbox, NULL, NULL, (void **) &conn->curr_send_pkt) != 0) {
+		/* top up the packets being sent from send_mbox */
+		while (conn->num_send_pkts < TPP_MAX_SEND_PKTS) {
+			if (tpp_mbox_read(&conn->send_mbox, NULL, NULL, (void **) &pkt) != 0) {
 				if (!(errno == EAGAIN || errno == EWOULDBLOCK))
 					tpp_log(LOG_ERR, __func__, "tpp_mbox_read failed");
-				return;
+				break;
+			}
+			p = pkt->curr_chunk;
+
+			/* data available, first byte, presend handler present, call handler */
+			if (p && (p == GET_NEXT(pkt->chunks)) && (p->pos == p->data) && the_pkt_presend_handler) {
+				if (the_pkt_presend_handler(conn->sock_fd, pkt, conn->ctx, conn->extra) == 0)
+					p = pkt->curr_chunk; /* presend handler could change pkt contents */
+				else
+					p = NULL;
 			}
-			pkt = conn->curr_send_pkt;
+
+			if (p == NULL) {
+				/* nothing to send in this packet */
+				tpp_free_pkt(pkt);
+				continue;
+			}
+			conn->send_pkts[conn->num_send_pkts++] = pkt;
 		}
-		p = pkt->curr_chunk;
 
-		/* data available, first byte, presend handler present, call handler */
-		if ((p == GET_NEXT(pkt->chunks)) && (p->pos == p->data) && the_pkt_presend_handler) {
-			if ((rc = the_pkt_presend_handler(conn->sock_fd, pkt, conn->ctx, conn->extra)) == 0) {
-				p = pkt->curr_chunk; /* presend handler could change pkt contents */
+		if (conn->num_send_pkts == 0)
+			return;
+
+		niov = 0;
+		tosend = 0;
+		for (i = 0; i < conn->num_send_pkts && niov < TPP_MAX_IOV; i++) {
+			for (p = conn->send_pkts[i]->curr_chunk; p && niov < TPP_MAX_IOV; p = GET_NEXT(p->chunk_link)) {
+				if (p->len == (size_t)(p->pos - p->data))
+					continue;
+				iov[niov].iov_base = p->pos;
+				iov[niov].iov_len = p->len - (p->pos - p->data);
+				tosend += iov[niov].iov_len;
+				niov++;
 			}
 		}
 
-		if (p && (rc == 0)) {
-			tosend = p->len - (p->pos - p->data);
-			while (tosend > 0) {
-				rc = tpp_sock_send(conn->sock_fd, p->pos, tosend, 0);
-				if (rc < 0) {
-					if (errno == EWOULDBLOCK || errno == EAGAIN) {
-						/* set this socket in POLLOUT */
-						conn->ev_mask |= EM_OUT;
-						TPP_DBPRT("EWOULDBLOCK, added EM_OUT to ev_mask, now=%x", conn->ev_mask);
-						if (tpp_em_mod_fd(conn->td->em_context, conn->sock_fd, conn->ev_mask)	== -1) {
-							tpp_log(LOG_ERR, __func__, "Multiplexing failed");
-							return;
-						}
-					} else {
-						handle_disconnect(conn);
+		rc = 0;
+		if (niov > 0) {
+			rc = tpp_sock_writev(conn->sock_fd, iov, niov);
+			if (rc < 0) {
+				if (errno == EWOULDBLOCK || errno == EAGAIN) {
+					/* set this socket in POLLOUT */
+					conn->ev_mask |= EM_OUT;
+					TPP_DBPRT("EWOULDBLOCK, added EM_OUT to ev_mask, now=%x", conn->ev_mask);
+					if (tpp_em_mod_fd(conn->td->em_context, conn->sock_fd, conn->ev_mask) == -1) {
+						tpp_log(LOG_ERR, __func__, "Multiplexing failed");
 						return;
 					}
-					break;
-				}
-				TPP_DBPRT("tfd=%d, tosend=%d, sent=%d bytes", conn->sock_fd, tosend, rc);
-				p->pos += rc;
-				tosend -= rc;
-			}
-
-			if (tosend == 0) {
-				p = GET_NEXT(p->chunk_link);
-				if (p)
-					pkt->curr_chunk = p;
-				else
-					curr_pkt_done = 1;
+				} else
+					handle_disconnect(conn);
+				return;
 			}
-		} else
-			curr_pkt_done = 1;
-
-		if (pkt && curr_pkt_done) {
-			/*
-			* all data in this packet has been sent or done with.
-			* delete this node and get next node in queue
-			*/
-			tpp_free_pkt(pkt);
-			conn->curr_send_pkt = NULL;
+			TPP_DBPRT("tfd=%d, niov=%d, tosend=%d, sent=%d bytes", conn->sock_fd, niov, tosend, rc);
 		}
+
+		consume_sent_data(conn, (size_t) rc);
 	}
 }
 
@@ -2025,6 +2083,9 @@ free_phy_conn(phy_conn_t *conn)
 			tpp_free_pkt(pkt);
 	}
 
+	while (conn->num_send_pkts > 0)
+		tpp_free_pkt(conn->send_pkts[--conn->num_send_pkts]);
+
 	tpp_mbox_destroy(&conn->send_mbox);
 
 	free(conn->ctx);
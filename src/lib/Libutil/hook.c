@@ -2558,6 +2558,12 @@ hook_init(hook *phook, void (*pyfree_func)(struct python_script *))
 	phook->hook_control_checksum = 0;
 	phook->hook_script_checksum = 0;
 	phook->hook_config_checksum = 0;
+	phook->run_count = 0;
+	phook->run_walltime = 0;
+	phook->run_walltime_max = 0;
+	phook->run_cputime = 0;
+	phook->run_start_walltime = 0;
+	phook->run_start_cputime = 0;
 }
 
 /**
@@ -4259,3 +4265,56 @@ hook_perf_stat_stop(char *label, char *action, int print_end_msg)
 
 	log_event(PBSEVENT_DEBUG4, PBS_EVENTCLASS_HOOK, LOG_INFO, "hook_perf_stat", log_buffer);
 }
+
+/**
+ *
+ * @brief
+ * 	Mark the start of a run of hook 'phook', for the run statistics
+ *	reported as the hook's run_* attributes.
+ *
+ * @param[in]	phook - the hook about to run
+ *
+ * @return void
+ *
+ */
+void
+hook_run_stat_start(hook *phook)
+{
+	if (phook == NULL)
+		return;
+	perf_stat_times(&phook->run_start_walltime, &phook->run_start_cputime);
+}
+
+/**
+ *
+ * @brief
+ * 	Add the run of hook 'phook' started by hook_run_stat_start() to the
+ *	hook's run statistics.
+ *
+ * @param[in]	phook - the hook that ran
+ * @param[in]	cputime - if 0, the run did not take place in this process,
+ *			  so only its walltime is counted.
+ *
+ * @return void
+ *
+ */
+void
+hook_run_stat_stop(hook *phook, int cputime)
+{
+	double	walltime;
+	double	cpu;
+
+	if ((phook == NULL) || (phook->run_start_walltime == 0))
+		return;
+	perf_stat_times(&walltime, &cpu);
+	walltime -= phook->run_start_walltime;
+	if (walltime < 0)
+		walltime = 0;
+	phook->run_count++;
+	phook->run_walltime += walltime;
+	if (walltime > phook->run_walltime_max)
+		phook->run_walltime_max = walltime;
+	if (cputime && (cpu > phook->run_start_cputime))
+		phook->run_cputime += cpu - phook->run_start_cputime;
+	phook->run_start_walltime = 0;
+}
@@ -1890,6 +1890,25 @@ perf_stat_stop(char *instance)
 	return (stat_summary);
 }
 
+/**
+ * @brief
+ *	Returns the current wall clock and processor times, as measured by
+ *	perf_stat_start() and perf_stat_stop().
+ *
+ * @param[out] walltime - number of seconds of wall clock time
+ * @param[out] cputime - number of seconds of processor time
+ *
+ * @return void
+ */
+void
+perf_stat_times(double *walltime, double *cputime)
+{
+	if (walltime != NULL)
+		*walltime = get_walltime();
+	if (cputime != NULL)
+		*cputime = get_cputime();
+}
+
 /**
  * @brief
  *	creates an empty file in /tmp/ and saves timestamp of that file
@@ -42,18 +42,366 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
+#include <ctype.h>
+
+#define HASH_IDX_INIT 64 /* initial number of slots in hash index (power of 2) */
+
+/* marks a slot whose entry was deleted, so that probing goes on past it */
+static char hash_deleted;
+#define HASH_SLOT_DELETED ((void *) &hash_deleted)
+
+/* slot of hash index, free if key is NULL */
+typedef struct _hash_slot {
+	void *key;	    /* copy of key, or HASH_SLOT_DELETED */
+	void *data;	    /* data of entry */
+	unsigned int hval;  /* hash of key */
+} hash_slot;
+
+/* open addressing (linear probing) hash index */
+typedef struct _hash_idx {
+	hash_slot *slots;   /* table of slots */
+	unsigned int size;  /* number of slots (power of 2) */
+	unsigned int count; /* number of entries */
+	unsigned int used;  /* number of entries plus deleted slots */
+} hash_idx;
+
+/* index structure, opaque to application */
+typedef struct _pbs_idx {
+	int flags;  /* PBS_IDX_* flags */
+	int keylen; /* length of key, 0 for null-terminated strings */
+	union {
+		AVL_IX_DESC avl; /* AVL tree index */
+		hash_idx hash;	 /* PBS_IDX_HASH index */
+	} u;
+} pbs_idx_t;
 
 /* iteration context structure, opaque to application */
 typedef struct _iter_ctx {
-	AVL_IX_DESC *idx; /* pointer to idx */
+	pbs_idx_t *idx;	  /* pointer to idx */
 	AVL_IX_REC *pkey; /* pointer to key used while iteration */
+	unsigned int slot; /* slot of current entry in hash index */
+	void *hkey;	  /* hash index: key iterated on, NULL to iterate all */
+	unsigned int hval; /* hash of hkey */
 } iter_ctx;
 
+/**
+ * @brief
+ *	hash the given key of hash index
+ *
+ * @param[in] - idx - pointer to index
+ * @param[in] - key - key to hash
+ *
+ * @return unsigned int
+ * @retval hash value of key (FNV-1a)
+ *
+ */
+static unsigned int
+hash_key(pbs_idx_t *idx, void *key)
+{
+	unsigned int h = 2166136261U;
+	unsigned char *p = (unsigned char *) key;
+	int i;
+
+	if (idx->keylen) {
+		for (i = 0; i < idx->keylen; i++) {
+			h ^= p[i];
+			h *= 16777619U;
+		}
+	} else if (idx->flags & PBS_IDX_ICASE_CMP) {
+		for (; *p; p++) {
+			h ^= (unsigned char) tolower(*p);
+			h *= 16777619U;
+		}
+	} else {
+		for (; *p; p++) {
+			h ^= *p;
+			h *= 16777619U;
+		}
+	}
+
+	return h;
+}
+
+/**
+ * @brief
+ *	compare whether given slot of hash index holds given key
+ *
+ * @param[in] - idx  - pointer to index
+ * @param[in] - slot - slot to compare
+ * @param[in] - key  - key to compare with
+ * @param[in] - hval - hash of key
+ *
+ * @return int
+ * @retval 1 - slot holds key
+ * @retval 0 - slot is free, deleted or holds other key
+ *
+ */
+static int
+hash_slot_match(pbs_idx_t *idx, hash_slot *slot, void *key, unsigned int hval)
+{
+	if (slot->key == NULL || slot->key == HASH_SLOT_DELETED || slot->hval != hval)
+		return 0;
+
+	if (idx->keylen)
+		return memcmp(slot->key, key, idx->keylen) == 0;
+	if (idx->flags & PBS_IDX_ICASE_CMP)
+		return strcasecmp(slot->key, key) == 0;
+	return strcmp(slot->key, key) == 0;
+}
+
+/**
+ * @brief
+ *	resize the table of hash index, dropping deleted slots
+ *
+ * @param[in] - h       - pointer to hash index
+ * @param[in] - newsize - new number of slots (power of 2)
+ *
+ * @return int
+ * @retval PBS_IDX_RET_OK   - success
+ * @retval PBS_IDX_RET_FAIL - failure, the old table is kept
+ *
+ */
+static int
+hash_resize(hash_idx *h, unsigned int newsize)
+{
+	hash_slot *newslots;
+	unsigned int i;
+	unsigned int j;
+
+	newslots = (hash_slot *) calloc(newsize, sizeof(hash_slot));
+	if (newslots == NULL)
+		return PBS_IDX_RET_FAIL;
+
+	for (i = 0; i < h->size; i++) {
+		if (h->slots[i].key == NULL || h->slots[i].key == HASH_SLOT_DELETED)
+			continue;
+		for (j = h->slots[i].hval & (newsize - 1); newslots[j].key != NULL; j = (j + 1) & (newsize - 1))
+			;
+		newslots[j] = h->slots[i];
+	}
+	free(h->slots);
+	h->slots = newslots;
+	h->size = newsize;
+	h->used = h->count;
+
+	return PBS_IDX_RET_OK;
+}
+
+/**
+ * @brief
+ *	add entry in hash index
+ *
+ * @param[in] - idx  - pointer to index
+ * @param[in] - key  - key of entry
+ * @param[in] - data - data of entry
+ *
+ * @return int
+ * @retval PBS_IDX_RET_OK   - success
+ * @retval PBS_IDX_RET_FAIL - failure, or key (key and data if
+ *                            duplicates are allowed) already in index
+ *
+ */
+static int
+hash_insert(pbs_idx_t *idx, void *key, void *data)
+{
+	hash_idx *h = &idx->u.hash;
+	hash_slot *free_slot = NULL;
+	unsigned int hval;
+	unsigned int i;
+	size_t len;
+
+	/* keep the load, counting deleted slots, under 3/4 */
+	if ((h->used + 1) * 4 > h->size * 3) {
+		unsigned int newsize = h->size;
+
+		if ((h->count + 1) * 2 > h->size)
+			newsize = h->size * 2;
+		if (hash_resize(h, newsize) != PBS_IDX_RET_OK)
+			return PBS_IDX_RET_FAIL;
+	}
+
+	hval = hash_key(idx, key);
+	for (i = hval & (h->size - 1); h->slots[i].key != NULL; i = (i + 1) & (h->size - 1)) {
+		if (h->slots[i].key == HASH_SLOT_DELETED) {
+			if (free_slot == NULL)
+				free_slot = &h->slots[i];
+		} else if (hash_slot_match(idx, &h->slots[i], key, hval)) {
+			if (!(idx->flags & PBS_IDX_DUPS_OK) || h->slots[i].data == data)
+				return PBS_IDX_RET_FAIL;
+		}
+	}
+	if (free_slot == NULL) {
+		free_slot = &h->slots[i];
+		h->used++;
+	}
+
+	len = idx->keylen ? (size_t) idx->keylen : strlen(key) + 1;
+	free_slot->key = malloc(len);
+	if (free_slot->key == NULL) {
+		if (free_slot == &h->slots[i])
+			h->used--;
+		else
+			free_slot->key = HASH_SLOT_DELETED;
+		return PBS_IDX_RET_FAIL;
+	}
+	memcpy(free_slot->key, key, len);
+	free_slot->data = data;
+	free_slot->hval = hval;
+	h->count++;
+
+	return PBS_IDX_RET_OK;
+}
+
+/**
+ * @brief
+ *	delete entry in given slot of hash index
+ *
+ * @param[in] - h    - pointer to hash index
+ * @param[in] - slot - slot number of entry
+ *
+ * @return void
+ *
+ */
+static void
+hash_delete_slot(hash_idx *h, unsigned int slot)
+{
+	free(h->slots[slot].key);
+	h->slots[slot].data = NULL;
+	h->count--;
+	/* no probe goes past a free slot, so this one can be free too */
+	if (h->slots[(slot + 1) & (h->size - 1)].key == NULL) {
+		h->slots[slot].key = NULL;
+		h->used--;
+	} else
+		h->slots[slot].key = HASH_SLOT_DELETED;
+}
+
+/**
+ * @brief
+ *	find the next slot of hash index holding an entry
+ *
+ * @param[in] - idx   - pointer to index
+ * @param[in] - key   - key of the entry, NULL to find any entry
+ * @param[in] - hval  - hash of key
+ * @param[in] - start - slot to start search from
+ *
+ * @return int
+ * @retval >=0 - slot number of entry
+ * @retval -1  - no more entries
+ *
+ */
+static int
+hash_find_slot(pbs_idx_t *idx, void *key, unsigned int hval, unsigned int start)
+{
+	hash_idx *h = &idx->u.hash;
+	unsigned int i;
+
+	if (h->count == 0)
+		return -1;
+
+	if (key == NULL) {
+		for (i = start; i < h->size; i++) {
+			if (h->slots[i].key != NULL && h->slots[i].key != HASH_SLOT_DELETED)
+				return (int) i;
+		}
+		return -1;
+	}
+
+	for (i = start; h->slots[i].key != NULL; i = (i + 1) & (h->size - 1)) {
+		if (hash_slot_match(idx, &h->slots[i], key, hval))
+			return (int) i;
+	}
+	return -1;
+}
+
+/**
+ * @brief
+ *	find or iterate entry in hash index, see pbs_idx_find()
+ *
+ * @param[in]     - idx  - pointer to index
+ * @param[in/out] - key  - key of the entry
+ * @param[in/out] - data - data of the entry
+ * @param[in/out] - ctx  - context to be set for iteration
+ *
+ * @return int
+ * @retval PBS_IDX_RET_OK   - success
+ * @retval PBS_IDX_RET_FAIL - failure
+ *
+ */
+static int
+hash_find(pbs_idx_t *idx, void **key, void **data, void **ctx)
+{
+	hash_idx *h = &idx->u.hash;
+	iter_ctx *pctx;
+	unsigned int hval = 0;
+	void *fkey = NULL;
+	size_t len = 0;
+	int slot;
+
+	*data = NULL;
+	if (ctx != NULL && *ctx != NULL) {
+		pctx = (iter_ctx *) *ctx;
+
+		if (key)
+			*key = NULL;
+
+		if (pctx->idx != idx || pctx->slot >= h->size)
+			return PBS_IDX_RET_FAIL;
+
+		if (pctx->hkey != NULL)
+			slot = hash_find_slot(idx, pctx->hkey, pctx->hval, (pctx->slot + 1) & (h->size - 1));
+		else
+			slot = hash_find_slot(idx, NULL, 0, pctx->slot + 1);
+		if (slot < 0)
+			return PBS_IDX_RET_FAIL;
+
+		pctx->slot = (unsigned int) slot;
+		*data = h->slots[slot].data;
+		if (key)
+			*key = h->slots[slot].key;
+
+		return PBS_IDX_RET_OK;
+	}
+
+	if (key != NULL && *key != NULL) {
+		fkey = *key;
+		hval = hash_key(idx, fkey);
+		slot = hash_find_slot(idx, fkey, hval, hval & (h->size - 1));
+	} else
+		slot = hash_find_slot(idx, NULL, 0, 0);
+	if (slot < 0)
+		return PBS_IDX_RET_FAIL;
+
+	*data = h->slots[slot].data;
+	if (key != NULL && *key == NULL)
+		*key = h->slots[slot].key;
+	if (ctx != NULL) {
+		/* iterating from a key returns the other entries with that key, keep a copy of it */
+		if (fkey != NULL)
+			len = idx->keylen ? (size_t) idx->keylen : strlen(fkey) + 1;
+		pctx = (iter_ctx *) calloc(1, sizeof(iter_ctx) + len);
+		if (pctx == NULL)
+			return PBS_IDX_RET_FAIL;
+		pctx->idx = idx;
+		pctx->slot = (unsigned int) slot;
+		if (fkey != NULL) {
+			pctx->hkey = (void *) (pctx + 1);
+			memcpy(pctx->hkey, fkey, len);
+			pctx->hval = hval;
+		}
+		*ctx = (void *) pctx;
+	}
+
+	return PBS_IDX_RET_OK;
+}
+
 /**
  * @brief
  *	Create an empty index
  *
- * @param[in] - flags  - index flags like duplicates allowed, or case insensitive compare
+ * @param[in] - flags  - index flags like duplicates allowed, case insensitive
+ *                       compare or hash index
  * @param[in] - keylen - length of key in index (can be 0 for default size)
  *
  * @return void *
@@ -64,13 +412,25 @@ typedef struct _iter_ctx {
 void *
 pbs_idx_create(int flags, int keylen)
 {
-	void *idx = NULL;
+	pbs_idx_t *idx = NULL;
 
-	idx = malloc(sizeof(AVL_IX_DESC));
+	if (keylen < 0)
+		return NULL;
+
+	idx = (pbs_idx_t *) calloc(1, sizeof(pbs_idx_t));
 	if (idx == NULL)
 		return NULL;
 
-	if (avl_create_index(idx, flags, keylen)) {
+	idx->flags = flags;
+	idx->keylen = keylen;
+	if (flags & PBS_IDX_HASH) {
+		idx->u.hash.slots = (hash_slot *) calloc(HASH_IDX_INIT, sizeof(hash_slot));
+		if (idx->u.hash.slots == NULL) {
+			free(idx);
+			return NULL;
+		}
+		idx->u.hash.size = HASH_IDX_INIT;
+	} else if (avl_create_index(&idx->u.avl, flags, keylen)) {
 		free(idx);
 		return NULL;
 	}
@@ -90,9 +450,20 @@ pbs_idx_create(int flags, int keylen)
 void
 pbs_idx_destroy(void *idx)
 {
-	if (idx != NULL) {
-		avl_destroy_index(idx);
-		free(idx);
+	pbs_idx_t *pidx = (pbs_idx_t *) idx;
+
+	if (pidx != NULL) {
+		if (pidx->flags & PBS_IDX_HASH) {
+			unsigned int i;
+
+			for (i = 0; i < pidx->u.hash.size; i++) {
+				if (pidx->u.hash.slots[i].key != HASH_SLOT_DELETED)
+					free(pidx->u.hash.slots[i].key);
+			}
+			free(pidx->u.hash.slots);
+		} else
+			avl_destroy_index(&pidx->u.avl);
+		free(pidx);
 		idx = NULL;
 	}
 }
@@ -113,17 +484,21 @@ pbs_idx_destroy(void *idx)
 int
 pbs_idx_insert(void *idx, void *key, void *data)
 {
+	pbs_idx_t *pidx = (pbs_idx_t *) idx;
 	AVL_IX_REC *pkey;
 
-	if (idx == NULL || key == NULL)
+	if (pidx == NULL || key == NULL)
 		return PBS_IDX_RET_FAIL;
 
-	pkey = avlkey_create(idx, key);
+	if (pidx->flags & PBS_IDX_HASH)
+		return hash_insert(pidx, key, data);
+
+	pkey = avlkey_create(&pidx->u.avl, key);
 	if (pkey == NULL)
 		return PBS_IDX_RET_FAIL;
 
 	pkey->recptr = data;
-	if (avl_add_key(pkey, idx) != AVL_IX_OK) {
+	if (avl_add_key(pkey, &pidx->u.avl) != AVL_IX_OK) {
 		free(pkey);
 		return PBS_IDX_RET_FAIL;
 	}
@@ -146,17 +521,27 @@ pbs_idx_insert(void *idx, void *key, void *data)
 int
 pbs_idx_delete(void *idx, void *key)
 {
+	pbs_idx_t *pidx = (pbs_idx_t *) idx;
 	AVL_IX_REC *pkey;
 
-	if (idx == NULL || key == NULL)
+	if (pidx == NULL || key == NULL)
 		return PBS_IDX_RET_FAIL;
 
-	pkey = avlkey_create(idx, key);
+	if (pidx->flags & PBS_IDX_HASH) {
+		unsigned int hval = hash_key(pidx, key);
+		int slot = hash_find_slot(pidx, key, hval, hval & (pidx->u.hash.size - 1));
+
+		if (slot >= 0)
+			hash_delete_slot(&pidx->u.hash, (unsigned int) slot);
+		return PBS_IDX_RET_OK;
+	}
+
+	pkey = avlkey_create(&pidx->u.avl, key);
 	if (pkey == NULL)
 		return PBS_IDX_RET_FAIL;
 
 	pkey->recptr = NULL;
-	avl_delete_key(pkey, idx);
+	avl_delete_key(pkey, &pidx->u.avl);
 	free(pkey);
 	return PBS_IDX_RET_OK;
 }
@@ -178,10 +563,22 @@ pbs_idx_delete_byctx(void *ctx)
 {
 	iter_ctx *pctx = (iter_ctx *) ctx;
 
-	if (pctx == NULL || pctx->idx == NULL || pctx->pkey == NULL)
+	if (pctx == NULL || pctx->idx == NULL)
+		return PBS_IDX_RET_FAIL;
+
+	if (pctx->idx->flags & PBS_IDX_HASH) {
+		hash_idx *h = &pctx->idx->u.hash;
+
+		if (pctx->slot >= h->size || h->slots[pctx->slot].key == NULL || h->slots[pctx->slot].key == HASH_SLOT_DELETED)
+			return PBS_IDX_RET_FAIL;
+		hash_delete_slot(h, pctx->slot);
+		return PBS_IDX_RET_OK;
+	}
+
+	if (pctx->pkey == NULL)
 		return PBS_IDX_RET_FAIL;
 
-	avl_delete_key(pctx->pkey, pctx->idx);
+	avl_delete_key(pctx->pkey, &pctx->idx->u.avl);
 	return PBS_IDX_RET_OK;
 }
 
@@ -211,13 +608,17 @@ pbs_idx_delete_byctx(void *ctx)
 int
 pbs_idx_find(void *idx, void **key, void **data, void **ctx)
 {
+	pbs_idx_t *pidx = (pbs_idx_t *) idx;
 	iter_ctx *pctx;
 	AVL_IX_REC *pkey;
 	int rc = AVL_IX_FAIL;
 
-	if (idx == NULL || data == NULL)
+	if (pidx == NULL || data == NULL)
 		return PBS_IDX_RET_FAIL;
 
+	if (pidx->flags & PBS_IDX_HASH)
+		return hash_find(pidx, key, data, ctx);
+
 	if (ctx != NULL && *ctx != NULL) {
 		pctx = (iter_ctx *) *ctx;
 
@@ -225,10 +626,10 @@ pbs_idx_find(void *idx, void **key, void **data, void **ctx)
 		if (key)
 			*key = NULL;
 
-		if (pctx->idx != idx || pctx->pkey == NULL)
+		if (pctx->idx != pidx || pctx->pkey == NULL)
 			return PBS_IDX_RET_FAIL;
 
-		if (avl_next_key(pctx->pkey, pctx->idx) != AVL_IX_OK)
+		if (avl_next_key(pctx->pkey, &pctx->idx->u.avl) != AVL_IX_OK)
 			return PBS_IDX_RET_FAIL;
 
 		*data = pctx->pkey->recptr;
@@ -238,15 +639,15 @@ pbs_idx_find(void *idx, void **key, void **data, void **ctx)
 		return PBS_IDX_RET_OK;
 	} else {
 		*data = NULL;
-		pkey = avlkey_create(idx, key ? *key : NULL);
+		pkey = avlkey_create(&pidx->u.avl, key ? *key : NULL);
 		if (pkey == NULL)
 			return PBS_IDX_RET_FAIL;
 
 		if (key != NULL && *key != NULL) {
-			rc = avl_find_key(pkey, idx);
+			rc = avl_find_key(pkey, &pidx->u.avl);
 		} else {
-			avl_first_key(idx);
-			rc = avl_next_key(pkey, idx);
+			avl_first_key(&pidx->u.avl);
+			rc = avl_next_key(pkey, &pidx->u.avl);
 		}
 
 		if (rc == AVL_IX_OK) {
@@ -254,12 +655,12 @@ pbs_idx_find(void *idx, void **key, void **data, void **ctx)
 			if (key != NULL && *key == NULL)
 				*key = &pkey->key;
 			if (ctx != NULL) {
-				pctx = (iter_ctx *) malloc(sizeof(iter_ctx));
+				pctx = (iter_ctx *) calloc(1, sizeof(iter_ctx));
 				if (pctx == NULL) {
 					free(pkey);
 					return PBS_IDX_RET_FAIL;
 				}
-				pctx->idx = idx;
+				pctx->idx = pidx;
 				pctx->pkey = pkey;
 				*ctx = (void *) pctx;
 
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 1994-2021 Altair Engineering, Inc.
+ * For more information, contact Altair at www.altair.com.
+ *
+ * This file is part of both the OpenPBS software ("OpenPBS")
+ * and the PBS Professional ("PBS Pro") software.
+ *
+ * Open Source License Information:
+ *
+ * OpenPBS is free software. You can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * OpenPBS is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Commercial License Information:
+ *
+ * PBS Pro is commercially licensed software that shares a common core with
+ * the OpenPBS software.  For a copy of the commercial license terms and
+ * conditions, go to: (http://www.pbspro.com/agreement.html) or contact the
+ * Altair Legal Department.
+ *
+ * Altair's dual-license business model allows companies, individuals, and
+ * organizations to create proprietary derivative works of OpenPBS and
+ * distribute them - whether embedded or bundled with other software -
+ * under a commercial license agreement.
+ *
+ * Use of Altair's trademarks, including but not limited to "PBS™",
+ * "OpenPBS®", "PBS Professional®", and "PBS Pro™" and Altair's logos is
+ * subject to Altair's trademark licensing policies.
+ */
+
+
+/**
+ * @file	pbs_idx_bench.c
+ *
+ * @brief
+ *	Microbenchmark of the pbs_idx backends.  Inserts, looks up and
+ *	deletes N job id like keys (1M by default) in an AVL and in a
+ *	PBS_IDX_HASH index and prints the time per operation and the heap
+ *	used by the index.  Not installed, run it from the build tree:
+ *
+ *		src/lib/Libutil/pbs_idx_bench [N]
+ */
+
+#include <pbs_config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <malloc.h>
+#include "pbs_idx.h"
+
+/**
+ * @brief	monotonic time in seconds
+ *
+ * @return	double
+ */
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * @brief	bytes of heap in use, including mmapped blocks
+ *
+ * @return	size_t
+ */
+static size_t
+heap_used(void)
+{
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 33)
+	struct mallinfo2 mi = mallinfo2();
+#else
+	struct mallinfo mi = mallinfo();
+#endif
+
+	return (size_t) mi.uordblks + (size_t) mi.hblkhd;
+}
+
+/**
+ * @brief	time one backend and print the results
+ *
+ * @param[in]	flags - index flags, 0 or PBS_IDX_HASH
+ * @param[in]	keys - the keys
+ * @param[in]	n - number of keys
+ *
+ * @return	int
+ * @retval	0 - success
+ * @retval	1 - the index lost a key
+ */
+static int
+bench(int flags, char **keys, int n)
+{
+	void *idx;
+	void *key;
+	void *data;
+	double t0, t1, t2, t3;
+	size_t m0, m1;
+	int i, j;
+
+	m0 = heap_used();
+	t0 = now();
+	if ((idx = pbs_idx_create(flags, 0)) == NULL) {
+		fprintf(stderr, "pbs_idx_create failed\n");
+		return 1;
+	}
+	for (i = 0; i < n; i++) {
+		if (pbs_idx_insert(idx, keys[i], keys[i]) != PBS_IDX_RET_OK) {
+			fprintf(stderr, "insert of %s failed\n", keys[i]);
+			return 1;
+		}
+	}
+	t1 = now();
+	m1 = heap_used();
+
+	/* look the keys up in a scattered order */
+	for (i = 0; i < n; i++) {
+		j = (int) ((i * 2654435761u) % n);
+		key = keys[j];
+		if (pbs_idx_find(idx, &key, &data, NULL) != PBS_IDX_RET_OK || data != keys[j]) {
+			fprintf(stderr, "lookup of %s failed\n", keys[j]);
+			return 1;
+		}
+	}
+	t2 = now();
+
+	for (i = 0; i < n; i++)
+		pbs_idx_delete(idx, keys[i]);
+	t3 = now();
+	pbs_idx_destroy(idx);
+
+	printf("%-4s n=%d insert %.0f ns/op, lookup %.0f ns/op, delete %.0f ns/op, memory %.1f MB (%.0f B/key)\n",
+		flags & PBS_IDX_HASH ? "hash" : "avl", n,
+		(t1 - t0) * 1e9 / n, (t2 - t1) * 1e9 / n, (t3 - t2) * 1e9 / n,
+		(m1 - m0) / 1048576.0, (double) (m1 - m0) / n);
+	return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+	int n = 1000000;
+	char **keys;
+	int i;
+
+	if (argc > 2 || (argc == 2 && (n = atoi(argv[1])) <= 0)) {
+		fprintf(stderr, "usage: %s [number of keys]\n", argv[0]);
+		return 2;
+	}
+
+	if ((keys = malloc(n * sizeof(char *))) == NULL) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	for (i = 0; i < n; i++) {
+		if ((keys[i] = malloc(24)) == NULL) {
+			fprintf(stderr, "out of memory\n");
+			return 1;
+		}
+		snprintf(keys[i], 24, "%d.pbsserver", i);
+	}
+
+	if (bench(0, keys, n) || bench(PBS_IDX_HASH, keys, n))
+		return 1;
+	return 0;
+}
@@ -41,6 +41,13 @@
  * @file	work_task.c
  * @brief
  * work_task.c - contains functions to deal with the server's task list
+ *
+ * @par
+ * Timed tasks are not kept on task_list_timed.  They are kept in a binary
+ * min-heap ordered by (wt_event, wt_seq) so that insertion and removal are
+ * O(log n).  Every task is also hashed by its wt_parm1 so that lookups and
+ * deletions by object (job, reservation, hook, mom) only look at that
+ * object's tasks instead of walking every task list.
  */
 #include <pbs_config.h>   /* the master config generated by configure */
 
@@ -64,6 +71,294 @@ extern pbs_list_head task_list_event; /* list of tasks responding to an event */
 extern int svr_delay_entry;
 extern time_t	time_now;
 
+#define WT_PARM_HASH_INIT	1024	/* initial number of parm1 hash buckets */
+
+/* min-heap of timed tasks */
+static struct work_task **timed_heap = NULL;
+static int timed_heap_size = 0;
+static int timed_heap_alloc = 0;
+static unsigned long task_seq = 0;
+
+/* wt_parm1 hash: buckets of tasks linked through wt_linkparm */
+static pbs_list_head *parm_hash = NULL;
+static unsigned int parm_hash_size = 0;
+static unsigned int parm_hash_count = 0;
+
+/**
+ * @brief
+ *	Hash a wt_parm1 pointer value into a bucket index
+ *
+ * @param[in]	parm1	- pointer to hash
+ * @param[in]	size	- number of buckets (power of 2)
+ *
+ * @return bucket index
+ */
+static unsigned int
+parm_hash_idx(void *parm1, unsigned int size)
+{
+	unsigned long h = (unsigned long) parm1;
+
+	/* objects are at least 8 byte aligned, mix the higher bits down */
+	h ^= h >> 17;
+	h *= 0x9E3779B1UL;
+	h ^= h >> 15;
+	return (unsigned int) (h & (size - 1));
+}
+
+/**
+ * @brief
+ *	Grow the wt_parm1 hash table and rehash every task into it
+ *
+ * @param[in]	newsize	- new number of buckets (power of 2)
+ *
+ * @return int
+ * @retval 0	- success
+ * @retval -1	- malloc failure, the old table is kept
+ */
+static int
+parm_hash_resize(unsigned int newsize)
+{
+	pbs_list_head *newhash;
+	unsigned int i;
+
+	newhash = (pbs_list_head *) malloc(newsize * sizeof(pbs_list_head));
+	if (newhash == NULL)
+		return -1;
+	for (i = 0; i < newsize; i++)
+		CLEAR_HEAD(newhash[i]);
+
+	for (i = 0; i < parm_hash_size; i++) {
+		struct work_task *ptask;
+
+		while ((ptask = (struct work_task *) GET_NEXT(parm_hash[i])) != NULL) {
+			delete_link(&ptask->wt_linkparm);
+			append_link(&newhash[parm_hash_idx(ptask->wt_parm1, newsize)], &ptask->wt_linkparm, ptask);
+		}
+	}
+	free(parm_hash);
+	parm_hash = newhash;
+	parm_hash_size = newsize;
+
+	return 0;
+}
+
+/**
+ * @brief
+ *	Add a task to the wt_parm1 hash.  Tasks without a wt_parm1 are not hashed.
+ *
+ * @param[in]	ptask	- task to add
+ */
+static void
+parm_hash_add(struct work_task *ptask)
+{
+	if (ptask->wt_parm1 == NULL)
+		return;
+
+	if (parm_hash == NULL) {
+		if (parm_hash_resize(WT_PARM_HASH_INIT) != 0)
+			return;
+	} else if (parm_hash_count >= parm_hash_size * 2)
+		(void) parm_hash_resize(parm_hash_size * 2);
+
+	append_link(&parm_hash[parm_hash_idx(ptask->wt_parm1, parm_hash_size)], &ptask->wt_linkparm, ptask);
+	parm_hash_count++;
+}
+
+/**
+ * @brief
+ *	Remove a task from the wt_parm1 hash
+ *
+ * @param[in]	ptask	- task to remove
+ */
+static void
+parm_hash_del(struct work_task *ptask)
+{
+	if (ptask->wt_linkparm.ll_next == &ptask->wt_linkparm)
+		return;
+
+	delete_link(&ptask->wt_linkparm);
+	parm_hash_count--;
+}
+
+/**
+ * @brief
+ *	Compare two timed tasks by time and then by creation order
+ *
+ * @return int
+ * @retval 1	- a runs before b
+ * @retval 0	- b runs before a
+ */
+static int
+timed_before(struct work_task *a, struct work_task *b)
+{
+	if (a->wt_event != b->wt_event)
+		return (a->wt_event < b->wt_event);
+	return (a->wt_seq < b->wt_seq);
+}
+
+/**
+ * @brief
+ *	Place a task at a heap index and record the index in the task
+ */
+static void
+timed_heap_set(int idx, struct work_task *ptask)
+{
+	timed_heap[idx] = ptask;
+	ptask->wt_heap_idx = idx;
+}
+
+/**
+ * @brief
+ *	Restore the heap property by moving the task at idx up or down
+ *
+ * @param[in]	idx	- heap index of the task which may be out of place
+ */
+static void
+timed_heap_fix(int idx)
+{
+	struct work_task *ptask = timed_heap[idx];
+
+	while (idx > 0) {
+		int parent = (idx - 1) / 2;
+
+		if (!timed_before(ptask, timed_heap[parent]))
+			break;
+		timed_heap_set(idx, timed_heap[parent]);
+		idx = parent;
+	}
+
+	for (;;) {
+		int child = 2 * idx + 1;
+
+		if (child >= timed_heap_size)
+			break;
+		if (child + 1 < timed_heap_size && timed_before(timed_heap[child + 1], timed_heap[child]))
+			child++;
+		if (!timed_before(timed_heap[child], ptask))
+			break;
+		timed_heap_set(idx, timed_heap[child]);
+		idx = child;
+	}
+	timed_heap_set(idx, ptask);
+}
+
+/**
+ * @brief
+ *	Add a task to the timed task heap
+ *
+ * @param[in]	ptask	- task to add
+ *
+ * @return int
+ * @retval 0	- success
+ * @retval -1	- malloc failure
+ */
+static int
+timed_heap_add(struct work_task *ptask)
+{
+	if (timed_heap_size == timed_heap_alloc) {
+		struct work_task **tmp;
+		int newalloc = timed_heap_alloc ? timed_heap_alloc * 2 : 1024;
+
+		tmp = (struct work_task **) realloc(timed_heap, newalloc * sizeof(struct work_task *));
+		if (tmp == NULL)
+			return -1;
+		timed_heap = tmp;
+		timed_heap_alloc = newalloc;
+	}
+	timed_heap_set(timed_heap_size, ptask);
+	timed_heap_size++;
+	timed_heap_fix(ptask->wt_heap_idx);
+
+	return 0;
+}
+
+/**
+ * @brief
+ *	Remove a task from the timed task heap
+ *
+ * @param[in]	ptask	- task to remove
+ */
+static void
+timed_heap_del(struct work_task *ptask)
+{
+	int idx = ptask->wt_heap_idx;
+
+	if (idx < 0)
+		return;
+
+	ptask->wt_heap_idx = -1;
+	timed_heap_size--;
+	if (idx != timed_heap_size) {
+		timed_heap_set(idx, timed_heap[timed_heap_size]);
+		timed_heap_fix(idx);
+	}
+}
+
+/**
+ * @brief
+ *	Unlink a task from its task list (or the timed heap) and the parm1 hash
+ *
+ * @param[in]	ptask	- task to unlink
+ */
+static void
+unlink_task(struct work_task *ptask)
+{
+	timed_heap_del(ptask);
+	parm_hash_del(ptask);
+	delete_link(&ptask->wt_linkevent);
+	delete_link(&ptask->wt_linkobj);
+	delete_link(&ptask->wt_linkobj2);
+	ptask->wt_tlist = NULL;
+}
+
+/**
+ * @brief
+ *	Queue a task on a task list.  Tasks queued on task_list_timed go into
+ *	the timed task heap instead.
+ *
+ * @param[in]	ptask	- task to queue
+ * @param[in]	list	- task list
+ *
+ * @return int
+ * @retval 0	- success
+ * @retval -1	- failure
+ */
+static int
+queue_task(struct work_task *ptask, pbs_list_head *list)
+{
+	if (list == &task_list_timed) {
+		if (timed_heap_add(ptask) != 0)
+			return -1;
+	} else
+		append_link(list, &ptask->wt_linkevent, ptask);
+	ptask->wt_tlist = list;
+
+	return 0;
+}
+
+/**
+ * @brief
+ *	Is the task still queued on a task list?  Callers may unlink a
+ *	deferred task from its event list directly (e.g. for TPP replies),
+ *	those tasks are no longer on any list.
+ *
+ * @param[in]	ptask	- task to check
+ * @param[in]	list	- task list
+ *
+ * @return int
+ * @retval 1	- the task is on list
+ * @retval 0	- it is not
+ */
+static int
+task_on_list(struct work_task *ptask, pbs_list_head *list)
+{
+	if (ptask->wt_tlist != list)
+		return 0;
+	if (list == &task_list_timed)
+		return (ptask->wt_heap_idx >= 0);
+	return (ptask->wt_linkevent.ll_next != &ptask->wt_linkevent);
+}
+
 /**
  *
  * @brief
@@ -85,7 +380,7 @@ extern time_t	time_now;
 struct work_task *set_task(enum work_type type, long event_id, void (*func)(struct work_task *) , void *parm)
 {
 	struct work_task *pnew;
-	struct work_task *pold;
+	pbs_list_head *list;
 
 	pnew = (struct work_task *)malloc(sizeof(struct work_task));
 	if (pnew == NULL)
@@ -93,6 +388,7 @@ struct work_task *set_task(enum work_type type, long event_id, void (*func)(stru
 	CLEAR_LINK(pnew->wt_linkevent);
 	CLEAR_LINK(pnew->wt_linkobj);
 	CLEAR_LINK(pnew->wt_linkobj2);
+	CLEAR_LINK(pnew->wt_linkparm);
 	pnew->wt_event = event_id;
 	pnew->wt_event2 = NULL;
 	pnew->wt_type  = type;
@@ -102,25 +398,25 @@ struct work_task *set_task(enum work_type type, long event_id, void (*func)(stru
 	pnew->wt_parm3 = NULL;
 	pnew->wt_aux   = 0;
 	pnew->wt_aux2  = 0;
+	pnew->wt_tlist = NULL;
+	pnew->wt_heap_idx = -1;
+	pnew->wt_seq = task_seq++;
 
 	if (type == WORK_Immed)
-		append_link(&task_list_immed, &pnew->wt_linkevent, pnew);
+		list = &task_list_immed;
 	else if (type == WORK_Interleave)
-		append_link(&task_list_interleave, &pnew->wt_linkevent, pnew);
-	else if (type == WORK_Timed) {
-		pold = (struct work_task *)GET_NEXT(task_list_timed);
-		while (pold) {
-			if (pold->wt_event > pnew->wt_event)
-				break;
-			pold = (struct work_task *)GET_NEXT(pold->wt_linkevent);
-		}
-		if (pold)
-			insert_link(&pold->wt_linkevent, &pnew->wt_linkevent, pnew,
-				LINK_INSET_BEFORE);
-		else
-			append_link(&task_list_timed, &pnew->wt_linkevent, pnew);
-	} else
-		append_link(&task_list_event, &pnew->wt_linkevent, pnew);
+		list = &task_list_interleave;
+	else if (type == WORK_Timed)
+		list = &task_list_timed;
+	else
+		list = &task_list_event;
+
+	if (queue_task(pnew, list) != 0) {
+		free(pnew);
+		return NULL;
+	}
+	parm_hash_add(pnew);
+
 	return (pnew);
 }
 
@@ -155,10 +451,10 @@ convert_work_task(struct work_task *ptask, enum work_type wtype)
 		list = &task_list_event;
 	}
 
+	timed_heap_del(ptask);
 	delete_link(&ptask->wt_linkevent);
-	append_link(list, &ptask->wt_linkevent, ptask);
 
-	return 0;
+	return (queue_task(ptask, list));
 }
 
 /**
@@ -177,9 +473,7 @@ convert_work_task(struct work_task *ptask, enum work_type wtype)
 void
 dispatch_task(struct work_task *ptask)
 {
-	delete_link(&ptask->wt_linkevent);
-	delete_link(&ptask->wt_linkobj);
-	delete_link(&ptask->wt_linkobj2);
+	unlink_task(ptask);
 	if (ptask->wt_func)
 		ptask->wt_func(ptask);		/* dispatch process function */
 	(void)free(ptask);
@@ -196,9 +490,7 @@ dispatch_task(struct work_task *ptask)
 void
 delete_task(struct work_task *ptask)
 {
-	delete_link(&ptask->wt_linkobj);
-	delete_link(&ptask->wt_linkobj2);
-	delete_link(&ptask->wt_linkevent);
+	unlink_task(ptask);
 	(void)free(ptask);
 }
 
@@ -208,25 +500,59 @@ delete_task(struct work_task *ptask)
  *	has a wt_parm1 matching 'parm1'
  *	and wt_func matching 'func'
  *
- * @param[in]	task_list - header of task list to be searched
+ * @param[in]	task_list - task list to be searched
  * @param[in]	parm1	- parameter being matched.
  * @param[in]	func	- function being matched.
  *
  * @return work task
  * @retval	!NULL if 'parm1' and 'func' was matched
  * @retval	NULL otherwise
+ *
+ * @par
+ *	If parm1 is set, only the tasks hashed with parm1 are looked at.
+ *	If more than one task matches, the one queued first is returned
+ *	(for timed tasks, the one which runs first).
  */
 static struct work_task *
-find_worktask_by_parm_func(pbs_list_head task_list, void *parm1, void *func)
+find_worktask_by_parm_func(pbs_list_head *task_list, void *parm1, void *func)
 {
 	struct work_task *ptask;
-	struct work_task *ptask_next;
+	struct work_task *found = NULL;
+
+	if (parm1 != NULL) {
+		if (parm_hash == NULL)
+			return NULL;
+		for (ptask = GET_NEXT(parm_hash[parm_hash_idx(parm1, parm_hash_size)]); ptask;
+				ptask = GET_NEXT(ptask->wt_linkparm)) {
+			if (ptask->wt_parm1 != parm1)
+				continue;
+			if (func && (ptask->wt_func != func))
+				continue;
+			if (!task_on_list(ptask, task_list))
+				continue;
+			/* the hash chain is in creation order, that is list order for untimed tasks */
+			if (task_list != &task_list_timed)
+				return ptask;
+			if (found == NULL || timed_before(ptask, found))
+				found = ptask;
+		}
+		return found;
+	}
 
-	for (ptask = GET_NEXT(task_list); ptask; ptask = ptask_next) {
-		ptask_next = GET_NEXT(ptask->wt_linkevent);
+	if (task_list == &task_list_timed) {
+		int i;
 
-		if (parm1 && (ptask->wt_parm1 != parm1))
-			continue;
+		for (i = 0; i < timed_heap_size; i++) {
+			ptask = timed_heap[i];
+			if (func && (ptask->wt_func != func))
+				continue;
+			if (found == NULL || timed_before(ptask, found))
+				found = ptask;
+		}
+		return found;
+	}
+
+	for (ptask = GET_NEXT(*task_list); ptask; ptask = GET_NEXT(ptask->wt_linkevent)) {
 		if (func && (ptask->wt_func != func))
 			continue;
 
@@ -257,19 +583,19 @@ find_work_task(enum work_type wtype, void *parm1, void *func)
 	struct work_task  *ptask;
 
 	if (wtype == -1 || wtype == WORK_Immed) {
-		ptask = find_worktask_by_parm_func(task_list_immed, parm1, func);
+		ptask = find_worktask_by_parm_func(&task_list_immed, parm1, func);
 		if (ptask)
 			return ptask;
 	}
 
 	if (wtype == -1 || wtype == WORK_Timed) {
-		ptask = find_worktask_by_parm_func(task_list_timed, parm1, func);
+		ptask = find_worktask_by_parm_func(&task_list_timed, parm1, func);
 		if (ptask)
 			return ptask;
 	}
 
 	if (wtype == -1 || (wtype != WORK_Timed && wtype != WORK_Immed)) {
-		ptask = find_worktask_by_parm_func(task_list_event, parm1, func);
+		ptask = find_worktask_by_parm_func(&task_list_event, parm1, func);
 		if (ptask)
 			return ptask;
 	}
@@ -297,22 +623,14 @@ void
 delete_task_by_parm1_func(void *parm1, void (*func)(struct work_task *), enum wtask_delete_option option)
 {
 	struct work_task  *ptask;
-	struct work_task  *ptask_next;
-	pbs_list_head task_lists[] = {task_list_event, task_list_timed, task_list_immed};
+	pbs_list_head *task_lists[] = {&task_list_event, &task_list_timed, &task_list_immed};
 	int i;
 
 	if (parm1 == NULL && func == NULL)
 		return;
 
 	for (i = 0; i < 3; i++) {
-		for (ptask = (struct work_task *) GET_NEXT(task_lists[i]); ptask; ptask = ptask_next) {
-			ptask_next = (struct work_task *) GET_NEXT(ptask->wt_linkevent);
-
-			if ((parm1 != NULL) && (ptask->wt_parm1 != parm1))
-				continue;
-			if ((func != NULL) && (ptask->wt_func != func))
-				continue;
-
+		while ((ptask = find_worktask_by_parm_func(task_lists[i], parm1, (void *) func)) != NULL) {
 			delete_task(ptask);
 			if (option == DELETE_ONE)
 				return;
@@ -402,7 +720,8 @@ default_next_task(void)
 	}
 
 
-	while ((ptask=(struct work_task *)GET_NEXT(task_list_timed))!=NULL) {
+	while (timed_heap_size > 0) {
+		ptask = timed_heap[0];
 		if ((delay = ptask->wt_event - time_now) > 0) {
 			if (tilwhen > delay)
 				tilwhen = delay;
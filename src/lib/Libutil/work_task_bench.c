@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 1994-2021 Altair Engineering, Inc.
+ * For more information, contact Altair at www.altair.com.
+ *
+ * This file is part of both the OpenPBS software ("OpenPBS")
+ * and the PBS Professional ("PBS Pro") software.
+ *
+ * Open Source License Information:
+ *
+ * OpenPBS is free software. You can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * OpenPBS is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Commercial License Information:
+ *
+ * PBS Pro is commercially licensed software that shares a common core with
+ * the OpenPBS software.  For a copy of the commercial license terms and
+ * conditions, go to: (http://www.pbspro.com/agreement.html) or contact the
+ * Altair Legal Department.
+ *
+ * Altair's dual-license business model allows companies, individuals, and
+ * organizations to create proprietary derivative works of OpenPBS and
+ * distribute them - whether embedded or bundled with other software -
+ * under a commercial license agreement.
+ *
+ * Use of Altair's trademarks, including but not limited to "PBS™",
+ * "OpenPBS®", "PBS Professional®", and "PBS Pro™" and Altair's logos is
+ * subject to Altair's trademark licensing policies.
+ */
+
+
+/**
+ * @file	work_task_bench.c
+ *
+ * @brief
+ *	Microbenchmark of the server's timed work tasks.  Creates N timed
+ *	tasks (20000 by default) with scattered times, each for its own
+ *	object, then looks every one up by (parm1, func) and cancels it.
+ *	This is done with set_task(), find_work_task() and
+ *	delete_task_by_parm1_func() from work_task.c and with a copy of the
+ *	time sorted list walk they replaced.  Not installed, run it from the
+ *	build tree:
+ *
+ *		src/lib/Libutil/work_task_bench [N]
+ */
+
+#include <pbs_config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "list_link.h"
+#include "work_task.h"
+
+/* the task lists and globals work_task.c expects from the server */
+pbs_list_head task_list_immed;
+pbs_list_head task_list_interleave;
+pbs_list_head task_list_timed;
+pbs_list_head task_list_event;
+int svr_delay_entry = 0;
+time_t time_now = 0;
+
+/* the time sorted list of the old implementation */
+static pbs_list_head old_list_timed;
+
+/**
+ * @brief	monotonic time in seconds
+ *
+ * @return	double
+ */
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * @brief	the task function, never called
+ */
+static void
+bench_func(struct work_task *ptask)
+{
+}
+
+/**
+ * @brief	old set_task(WORK_Timed): walk the list to the insert point
+ *
+ * @param[in]	event_id - time of the task
+ * @param[in]	parm - wt_parm1 of the task
+ *
+ * @return	struct work_task *
+ */
+static struct work_task *
+old_set_task(long event_id, void *parm)
+{
+	struct work_task *pnew;
+	struct work_task *pold;
+
+	if ((pnew = calloc(1, sizeof(struct work_task))) == NULL)
+		return NULL;
+	CLEAR_LINK(pnew->wt_linkevent);
+	pnew->wt_event = event_id;
+	pnew->wt_type = WORK_Timed;
+	pnew->wt_func = bench_func;
+	pnew->wt_parm1 = parm;
+
+	pold = (struct work_task *) GET_NEXT(old_list_timed);
+	while (pold) {
+		if (pold->wt_event > pnew->wt_event)
+			break;
+		pold = (struct work_task *) GET_NEXT(pold->wt_linkevent);
+	}
+	if (pold)
+		insert_link(&pold->wt_linkevent, &pnew->wt_linkevent, pnew, LINK_INSET_BEFORE);
+	else
+		append_link(&old_list_timed, &pnew->wt_linkevent, pnew);
+	return pnew;
+}
+
+/**
+ * @brief	old find_worktask_by_parm_func(): scan the whole list
+ *
+ * @param[in]	parm1 - wt_parm1 to match
+ *
+ * @return	struct work_task *
+ */
+static struct work_task *
+old_find_task(void *parm1)
+{
+	struct work_task *ptask;
+
+	for (ptask = GET_NEXT(old_list_timed); ptask; ptask = GET_NEXT(ptask->wt_linkevent)) {
+		if (ptask->wt_parm1 == parm1 && ptask->wt_func == bench_func)
+			return ptask;
+	}
+	return NULL;
+}
+
+/**
+ * @brief	time one implementation and print the results
+ *
+ * @param[in]	old - 1 for the old list walk, 0 for work_task.c
+ * @param[in]	objs - the objects the tasks are for
+ * @param[in]	times - the task times
+ * @param[in]	n - number of tasks
+ *
+ * @return	int
+ * @retval	0 - success
+ * @retval	1 - a task was lost
+ */
+static int
+bench(int old, long *objs, long *times, int n)
+{
+	struct work_task *ptask;
+	double t0, t1, t2, t3;
+	int i, j;
+
+	t0 = now();
+	for (i = 0; i < n; i++) {
+		if (old)
+			ptask = old_set_task(times[i], &objs[i]);
+		else
+			ptask = set_task(WORK_Timed, times[i], bench_func, &objs[i]);
+		if (ptask == NULL) {
+			fprintf(stderr, "set_task failed\n");
+			return 1;
+		}
+	}
+	t1 = now();
+
+	/* look the tasks up in a scattered order */
+	for (i = 0; i < n; i++) {
+		j = (int) ((i * 2654435761u) % n);
+		if (old)
+			ptask = old_find_task(&objs[j]);
+		else
+			ptask = find_work_task(WORK_Timed, &objs[j], bench_func);
+		if (ptask == NULL || ptask->wt_parm1 != &objs[j]) {
+			fprintf(stderr, "lookup of task %d failed\n", j);
+			return 1;
+		}
+	}
+	t2 = now();
+
+	for (i = 0; i < n; i++) {
+		if (old) {
+			if ((ptask = old_find_task(&objs[i])) != NULL) {
+				delete_link(&ptask->wt_linkevent);
+				free(ptask);
+			}
+		} else
+			delete_task_by_parm1_func(&objs[i], bench_func, DELETE_ONE);
+	}
+	t3 = now();
+
+	if (GET_NEXT(old_list_timed) != NULL || find_work_task(-1, NULL, bench_func) != NULL) {
+		fprintf(stderr, "tasks left after cancel\n");
+		return 1;
+	}
+
+	printf("%-4s n=%d insert %.0f ns/op, lookup %.0f ns/op, cancel %.0f ns/op\n",
+		old ? "list" : "heap", n,
+		(t1 - t0) * 1e9 / n, (t2 - t1) * 1e9 / n, (t3 - t2) * 1e9 / n);
+	return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+	int n = 20000;
+	long *objs;
+	long *times;
+	int i;
+
+	if (argc > 2 || (argc == 2 && (n = atoi(argv[1])) <= 0)) {
+		fprintf(stderr, "usage: %s [number of tasks]\n", argv[0]);
+		return 2;
+	}
+
+	CLEAR_HEAD(task_list_immed);
+	CLEAR_HEAD(task_list_interleave);
+	CLEAR_HEAD(task_list_timed);
+	CLEAR_HEAD(task_list_event);
+	CLEAR_HEAD(old_list_timed);
+
+	objs = malloc(n * sizeof(long));
+	times = malloc(n * sizeof(long));
+	if (objs == NULL || times == NULL) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	/* times spread over a day, as for job hold and execution timers */
+	srandom(1);
+	for (i = 0; i < n; i++)
+		times[i] = 1000000000L + random() % 86400;
+
+	if (bench(1, objs, times, n) || bench(0, objs, times, n))
+		return 1;
+	return 0;
+}
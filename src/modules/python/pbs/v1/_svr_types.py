@@ -52,7 +52,7 @@ from ._base_types import (PbsAttributeDescriptor, PbsReadOnlyDescriptor,
 import _pbs_v1
 from _pbs_v1 import (_event_accept, _event_reject,
                      _event_param_mod_allow, _event_param_mod_disallow,
-                     iter_nextfunc)
+                     _event_param_load, iter_nextfunc)
 
 from ._exc_types import *
 
@@ -914,7 +914,14 @@ class _event():
 
     def __getattr__(self, key):
         if self._param.__contains__(key):
-            return self._param[key]
+            value = self._param[key]
+            if value is None:
+                # some params (e.g. a periodic hook's vnode_list) are
+                # only built when first used
+                loaded = _event_param_load(key)
+                if loaded is not None:
+                    return loaded
+            return value
         # did not find <key>
         raise EventIncompatibleError
     #: m(__getattr__)
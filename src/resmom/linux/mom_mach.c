@@ -141,6 +141,29 @@ proc_stat_t	*proc_info = NULL;
 int		nproc = 0;
 int		max_proc = 0;
 
+/*
+ * Index of proc_info[] by session id, rebuilt by each mom_get_sample():
+ * sess_tab[] is an open addressing hash table of the sessions, holding the
+ * first process of each, and sess_next[] chains the other processes of the
+ * session in proc_info[] order.
+ */
+typedef struct sess_ent {
+	pid_t	se_sid;
+	int	se_first;	/* -1 if the slot is empty */
+	int	se_last;
+} sess_ent_t;
+static sess_ent_t	*sess_tab = NULL;
+static int		sess_tsize = 0;
+static int		*sess_next = NULL;
+static int		sess_nsize = 0;
+static int		sess_valid = 0;	/* index matches proc_info[] */
+
+#define	FOR_EACH_SESS_PROC(i, sid) \
+	for ((i) = sess_first(sid); (i) >= 0; (i) = sess_after((i), (sid)))
+
+static int	sess_first(pid_t);
+static int	sess_after(int, pid_t);
+
 extern	char	*ret_string;
 extern	char	extra_parm[];
 extern	char	no_parm[];
@@ -487,27 +510,149 @@ dep_cleanup(void)
 
 /**
  * @brief
- *	 Scan a list of tasks and return true if one of them matches sid
+ *	Find the slot of a session in sess_tab[].
+ *
+ * @param[in] sid - session id
+ *
+ * @return	sess_ent_t *
+ * @retval	the slot of the session, or the empty slot where it would go
+ *
+ */
+static sess_ent_t *
+sess_slot(pid_t sid)
+{
+	unsigned int	h;
+
+	h = (unsigned int)sid * 2654435761U;
+	for (h &= sess_tsize - 1; ; h = (h + 1) & (sess_tsize - 1)) {
+		if (sess_tab[h].se_first == -1 || sess_tab[h].se_sid == sid)
+			return &sess_tab[h];
+	}
+}
+
+/**
+ * @brief
+ *	Rebuild the session index of the processes in proc_info[].
+ *
+ * @return	int
+ * @retval	0	Success
+ * @retval	-1	Error, the index is empty
+ *
+ */
+static int
+index_sessions(void)
+{
+	int		i;
+	int		size;
+	void		*hold;
+	sess_ent_t	*se;
+
+	for (size = 64; size < nproc * 2; size *= 2)
+		;
+	if (size > sess_tsize) {
+		hold = realloc(sess_tab, size * sizeof(sess_ent_t));
+		if (hold == NULL)
+			goto err;
+		sess_tab = (sess_ent_t *)hold;
+		sess_tsize = size;
+	}
+	if (max_proc > sess_nsize) {
+		hold = realloc(sess_next, max_proc * sizeof(int));
+		if (hold == NULL)
+			goto err;
+		sess_next = (int *)hold;
+		sess_nsize = max_proc;
+	}
+
+	for (i = 0; i < sess_tsize; i++)
+		sess_tab[i].se_first = -1;
+	for (i = 0; i < nproc; i++) {
+		se = sess_slot(proc_info[i].session);
+		if (se->se_first == -1) {
+			se->se_sid = proc_info[i].session;
+			se->se_first = i;
+		} else
+			sess_next[se->se_last] = i;
+		se->se_last = i;
+		sess_next[i] = -1;
+	}
+
+	sess_valid = 1;
+	return 0;
+
+err:
+	log_err(errno, __func__, "realloc");
+	return -1;
+}
+
+/**
+ * @brief
+ *	Return the first process of a session in proc_info[].
  *
- * @param[in] pjob - job pointer
  * @param[in] sid - session id
  *
+ * @return	int
+ * @retval	index of the process in proc_info[]
+ * @retval	-1	no process in the session
+ *
+ * @par
+ *	Falls back to a scan of proc_info[] if the index could not be built.
+ *
+ */
+static int
+sess_first(pid_t sid)
+{
+	if (!sess_valid)
+		return sess_after(-1, sid);
+	return sess_slot(sid)->se_first;
+}
+
+/**
+ * @brief
+ *	Return the next process of a session in proc_info[].
+ *
+ * @param[in] i - index of the previous process of the session, or -1
+ * @param[in] sid - session id
+ *
+ * @return	int
+ * @retval	index of the next process in proc_info[]
+ * @retval	-1	no more processes in the session
+ *
+ */
+static int
+sess_after(int i, pid_t sid)
+{
+	if (sess_valid)
+		return sess_next[i];
+	for (i++; i < nproc; i++) {
+		if (proc_info[i].session == sid)
+			return i;
+	}
+	return -1;
+}
+
+/**
+ * @brief
+ *	Check whether an earlier live task of the job has the session of ptask,
+ *	so that the processes of a session are only counted once.
+ *
+ * @param[in] pjob - job pointer
+ * @param[in] ptask - task of the job
+ *
  * @return	Bool
- * @retval	TRUE
- * @retval	FALSE	Error
+ * @retval	TRUE	the session was seen with an earlier task
+ * @retval	FALSE	otherwise
  *
  */
 static int
-injob(job *pjob, pid_t sid)
+sess_seen(job *pjob, task *ptask)
 {
-	task	*ptask;
+	task	*pt;
 
-	for (ptask = (task *)GET_NEXT(pjob->ji_tasks);
-		ptask;
-		ptask = (task *)GET_NEXT(ptask->ti_jobtask)) {
-		if (ptask->ti_qs.ti_sid <= 1)
-			continue;
-		if (ptask->ti_qs.ti_sid == sid)
+	for (pt = (task *)GET_NEXT(pjob->ji_tasks);
+		pt != ptask;
+		pt = (task *)GET_NEXT(pt->ti_jobtask)) {
+		if (pt->ti_qs.ti_sid == ptask->ti_qs.ti_sid)
 			return TRUE;
 	}
 	return FALSE;
@@ -549,13 +694,9 @@ cput_sum(job *pjob)
 		active_tasks++;
 		tcput = 0;
 		taskprocs = 0;
-		for (i=0; i<nproc; i++) {
+		FOR_EACH_SESS_PROC(i, ptask->ti_qs.ti_sid) {
 			ps = &proc_info[i];
 
-			/* is this process part of the task? */
-			if (ptask->ti_qs.ti_sid != ps->session)
-				continue;
-
 			nps++;
 			taskprocs++;
 
@@ -695,18 +836,21 @@ mem_sum(job *pjob)
 	int		i;
 	ulong		segadd;
 	proc_stat_t	*ps;
+	task		*ptask;
 
 	segadd = 0;
 
-	for (i=0; i<nproc; i++) {
-
-		ps = &proc_info[i];
-
-		if (!injob(pjob, ps->session))
+	for (ptask = (task *)GET_NEXT(pjob->ji_tasks);
+		ptask != NULL;
+		ptask = (task *)GET_NEXT(ptask->ti_jobtask)) {
+		if (ptask->ti_qs.ti_sid <= 1 || sess_seen(pjob, ptask))
 			continue;
-		segadd += ps->vsize;
-		DBPRT(("%s: pid: %d  pr_size: %lu  total: %lu\n",
-			__func__, ps->pid, (ulong)ps->vsize, segadd))
+		FOR_EACH_SESS_PROC(i, ptask->ti_qs.ti_sid) {
+			ps = &proc_info[i];
+			segadd += ps->vsize;
+			DBPRT(("%s: pid: %d  pr_size: %lu  total: %lu\n",
+				__func__, ps->pid, (ulong)ps->vsize, segadd))
+		}
 	}
 
 	return (segadd);
@@ -729,16 +873,18 @@ resi_sum(job *pjob)
 	int		i;
 	ulong		resisize;
 	proc_stat_t	*ps;
+	task		*ptask;
 
 	resisize = 0;
-	for (i=0; i<nproc; i++) {
-
-		ps = &proc_info[i];
-
-		if (!injob(pjob, ps->session))
+	for (ptask = (task *)GET_NEXT(pjob->ji_tasks);
+		ptask != NULL;
+		ptask = (task *)GET_NEXT(ptask->ti_jobtask)) {
+		if (ptask->ti_qs.ti_sid <= 1 || sess_seen(pjob, ptask))
 			continue;
-
-		resisize += ps->rss * pagesize;
+		FOR_EACH_SESS_PROC(i, ptask->ti_qs.ti_sid) {
+			ps = &proc_info[i];
+			resisize += ps->rss * pagesize;
+		}
 	}
 
 	return (resisize);
@@ -981,6 +1127,7 @@ mom_get_sample(void)
 
 	rewinddir(pdir);
 	nproc = 0;
+	sess_valid = 0;
 	fd = NULL;
 	if (hz == 0)
 		hz = sysconf(_SC_CLK_TCK);
@@ -1088,6 +1235,7 @@ mom_get_sample(void)
 	}
 	if (errno != 0 && errno != ENOENT)
 		log_err(errno, __func__, "readdir");
+	(void)index_sessions();
 	sampletime_ceil = time_last_sample;
 	sprintf(log_buffer,
 		"nprocs:  %d, cantstat:  %d, nomem:  %d, skipped:  %d, "
@@ -1261,25 +1409,23 @@ bld_ptree(pid_t sid)
 	 */
 
 	myproc_ct = 0;
-	for (i = 0; i < nproc; i++) {
+	FOR_EACH_SESS_PROC(i, sid) {
 		if (PBS_PROC_PID(i) <= 1)
 			continue;
-		if ((int)PBS_PROC_SID(i) == sid) {
-			Proc_lnks[myproc_ct].pl_pid = PBS_PROC_PID(i);
-			Proc_lnks[myproc_ct].pl_ppid = PBS_PROC_PPID(i);
-			Proc_lnks[myproc_ct].pl_parent = -1;
-			Proc_lnks[myproc_ct].pl_sib = -1;
-			Proc_lnks[myproc_ct].pl_child = -1;
-			Proc_lnks[myproc_ct].pl_done = 0;
-			if (++myproc_ct == myproc_max) {
-				void * hold;
-
-				myproc_max += TBL_INC;
-				hold = realloc((void *)Proc_lnks,
-					myproc_max*sizeof(pbs_plinks));
-				assert(hold != NULL);
-				Proc_lnks = (pbs_plinks *)hold;
-			}
+		Proc_lnks[myproc_ct].pl_pid = PBS_PROC_PID(i);
+		Proc_lnks[myproc_ct].pl_ppid = PBS_PROC_PPID(i);
+		Proc_lnks[myproc_ct].pl_parent = -1;
+		Proc_lnks[myproc_ct].pl_sib = -1;
+		Proc_lnks[myproc_ct].pl_child = -1;
+		Proc_lnks[myproc_ct].pl_done = 0;
+		if (++myproc_ct == myproc_max) {
+			void * hold;
+
+			myproc_max += TBL_INC;
+			hold = realloc((void *)Proc_lnks,
+				myproc_max*sizeof(pbs_plinks));
+			assert(hold != NULL);
+			Proc_lnks = (pbs_plinks *)hold;
 		}
 	}
 
@@ -1436,6 +1582,13 @@ mom_close_poll(void)
 		proc_info = NULL;
 		max_proc = 0;
 	}
+	free(sess_tab);
+	sess_tab = NULL;
+	sess_tsize = 0;
+	free(sess_next);
+	sess_next = NULL;
+	sess_nsize = 0;
+	sess_valid = 0;
 
 	return (PBSE_NONE);
 }
@@ -1517,11 +1670,8 @@ cput_job(pid_t jobid)
 	proc_stat_t	*ps;
 
 	cputime = 0.0;
-	for (i=0; i<nproc; i++) {
-
+	FOR_EACH_SESS_PROC(i, jobid) {
 		ps = &proc_info[i];
-		if (jobid != ps->session)
-			continue;
 
 		found = 1;
 		addtime = dsecs(ps->cutime) + dsecs(ps->cstime);
@@ -1638,12 +1788,8 @@ mem_job(pid_t sid)
 	memsize = 0;
 
 	mom_get_sample();
-	for (i=0; i<nproc; i++) {
-
+	FOR_EACH_SESS_PROC(i, sid) {
 		ps = &proc_info[i];
-
-		if (sid != ps->session)
-			continue;
 		memsize += ps->vsize;
 	}
 
@@ -1754,13 +1900,9 @@ resi_job(pid_t jobid)
 	resisize = 0;
 	mom_get_sample();
 
-	for (i=0; i<nproc; i++) {
-
+	FOR_EACH_SESS_PROC(i, jobid) {
 		ps = &proc_info[i];
 
-		if (jobid != ps->session)
-			continue;
-
 		found = 1;
 		resisize += ps->rss;
 	}
@@ -49,6 +49,11 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/wait.h>
+#ifndef WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/file.h>
+#endif
 #include <ctype.h>
 #include <errno.h>
 #include <assert.h>
@@ -129,6 +134,7 @@ extern	pbs_list_head       task_list_event;
 extern	pbs_list_head	svr_alljobs;
 
 extern	char		*msg_err_malloc;
+extern	int		hook_preload;
 
 extern	time_t		time_now;
 
@@ -679,6 +685,193 @@ mom_process_hooks_params_t
 	return new_php;
 }
 
+#ifndef WIN32
+/**
+ * @brief
+ *	Check whether the preloaded pbs_python is running.  It holds an
+ *	flock() on HOOK_PRELOAD_LOCK for as long as it runs, with its pid
+ *	written in the file.
+ *
+ * @param[out] ppid - pid of the preloaded pbs_python, 0 if not known yet
+ *
+ * @return int
+ * @retval 1 - running
+ * @retval 0 - not running
+ *
+ */
+static int
+hook_preload_running(pid_t *ppid)
+{
+	char	lockpath[MAXPATHLEN + 1];
+	char	buf[32];
+	ssize_t	n;
+	int	fd;
+	int	running = 0;
+
+	*ppid = 0;
+	snprintf(lockpath, sizeof(lockpath), "%s%s", path_hooks_workdir, HOOK_PRELOAD_LOCK);
+	if ((fd = open(lockpath, O_RDONLY)) == -1)
+		return 0;
+	if (flock(fd, LOCK_SH | LOCK_NB) == -1 && errno == EWOULDBLOCK) {
+		running = 1;
+		if ((n = read(fd, buf, sizeof(buf) - 1)) > 0) {
+			buf[n] = '\0';
+			*ppid = (pid_t)atol(buf);
+		}
+	}
+	close(fd);	/* drops the lock, if we got it */
+	return running;
+}
+
+/**
+ * @brief
+ *	Start the preloaded pbs_python if $hook_preload is set and it is not
+ *	running, or stop it if $hook_preload was turned off.
+ *
+ * @par
+ *	The preloaded pbs_python exits by itself when MoM exits.  Of two
+ *	started at the same time, the one not getting the lock exits.
+ *
+ * @return void
+ *
+ */
+static void
+hook_preload_check(void)
+{
+	char	pypath[MAXPATHLEN + 1];
+	char	sockpath[MAXPATHLEN + 1];
+	char	logmask[32];
+	pid_t	pid;
+
+	if (hook_preload_running(&pid)) {
+		if (!hook_preload && pid > 0)
+			(void)kill(pid, SIGTERM);
+		return;
+	}
+	if (!hook_preload)
+		return;
+
+	snprintf(pypath, sizeof(pypath), "%s/bin/pbs_python", pbs_conf.pbs_exec_path);
+	snprintf(sockpath, sizeof(sockpath), "%s%s", path_hooks_workdir, HOOK_PRELOAD_SOCKET);
+	snprintf(logmask, sizeof(logmask), "%ld", *log_event_mask);
+
+	pid = fork();
+	if (pid == -1) {
+		log_err(errno, __func__, "fork failed");
+		return;
+	}
+	if (pid > 0) {
+		log_eventf(PBSEVENT_DEBUG2, PBS_EVENTCLASS_HOOK, LOG_INFO, __func__,
+			   "started preloaded pbs_python pid=%d", pid);
+		return;
+	}
+
+	/* child */
+	tpp_terminate();
+	net_close(-1);
+	(void)setsid();
+	if (chdir(path_hooks_workdir) != 0)
+		log_err(errno, __func__, "unable to go to hooks tmp directory");
+	if (pbs_conf.pbs_conf_file != NULL)
+		(void)setenv("PBS_CONF_FILE", pbs_conf.pbs_conf_file, 1);
+	execl(pypath, pypath, HOOK_PRELOAD_MODE, sockpath, "-L", path_log,
+		"-e", logmask, (char *)NULL);
+	log_err(errno, __func__, "execl of preloaded pbs_python");
+	exit(255);
+}
+
+/**
+ * @brief
+ *	Have the preloaded pbs_python run a hook event, instead of executing
+ *	a new pbs_python with the same arguments.
+ *
+ * @par
+ *	Called in the child forked by run_hook() in place of its execve().
+ *	The child then waits for the hook event to finish and exits with its
+ *	status, so that MoM sees the same exit status and timeout handling
+ *	as with a pbs_python of its own.  Killing the child makes the
+ *	preloaded pbs_python kill the hook event.
+ *
+ * @param[in] arg - pbs_python arguments
+ * @param[in] hook_config_path - hook config file, "" if none
+ *
+ * @return void
+ * @note
+ *	Returns only if the preloaded pbs_python could not be asked to run
+ *	the hook event.
+ *
+ */
+static void
+hook_preload_run(char **arg, char *hook_config_path)
+{
+	struct sockaddr_un sa;
+	char	cwd[MAXPATHLEN + 1];
+	char	*buf;
+	char	*p;
+	uint32_t len;
+	size_t	got;
+	ssize_t	n;
+	int	status;
+	int	fd;
+	int	i;
+
+	if (getcwd(cwd, sizeof(cwd)) == NULL)
+		return;
+	len = strlen(cwd) + 1 + strlen(hook_config_path) + 1;
+	for (i = 0; arg[i] != NULL; i++)
+		len += strlen(arg[i]) + 1;
+	if (len > HOOK_PRELOAD_MAXREQ)
+		return;
+	if ((buf = malloc(sizeof(len) + len)) == NULL)
+		return;
+	memcpy(buf, &len, sizeof(len));
+	p = buf + sizeof(len);
+	p += sprintf(p, "%s", cwd) + 1;
+	p += sprintf(p, "%s", hook_config_path) + 1;
+	for (i = 0; arg[i] != NULL; i++)
+		p += sprintf(p, "%s", arg[i]) + 1;
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sun_family = AF_UNIX;
+	if (snprintf(sa.sun_path, sizeof(sa.sun_path), "%s%s", path_hooks_workdir,
+		HOOK_PRELOAD_SOCKET) >= (int)sizeof(sa.sun_path) ||
+		(fd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1) {
+		free(buf);
+		return;
+	}
+	if (connect(fd, (struct sockaddr *)&sa, sizeof(sa)) == -1 ||
+		send(fd, buf, sizeof(len) + len, MSG_NOSIGNAL) != (ssize_t)(sizeof(len) + len)) {
+		close(fd);
+		free(buf);
+		return;
+	}
+	free(buf);
+
+	/* from here on the hook event may have run, so it is not run again */
+	for (got = 0; got < sizeof(status); got += n) {
+		n = read(fd, (char *)&status + got, sizeof(status) - got);
+		if (n == -1 && errno == EINTR) {
+			n = 0;
+			continue;
+		}
+		if (n <= 0) {
+			log_err(errno, __func__, "lost preloaded pbs_python");
+			exit(255);
+		}
+	}
+	if (WIFSIGNALED(status)) {
+		sigset_t sigs;
+
+		(void)signal(WTERMSIG(status), SIG_DFL);
+		sigemptyset(&sigs);
+		sigaddset(&sigs, WTERMSIG(status));
+		(void)sigprocmask(SIG_UNBLOCK, &sigs, NULL);
+		(void)kill(getpid(), WTERMSIG(status));
+	}
+	exit(WIFEXITED(status) ? WEXITSTATUS(status) : 255);
+}
+#endif
+
 /**
  * @brief
  *	Runs the hook 'phook' in a child process in response to 'event_type'
@@ -834,6 +1027,9 @@ run_hook(hook *phook, unsigned int event_type, mom_hook_input_t *hook_input,
 	if ((phook->user == HOOK_PBSUSER) && (event_type & USER_MOM_EVENTS))
 		runas_jobuser = 1;
 
+#ifndef WIN32
+	hook_preload_check();
+#endif
 	child = fork();
 	if (child > 0) { /* parent */
 
@@ -1304,6 +1500,8 @@ run_hook(hook *phook, unsigned int event_type, mom_hook_input_t *hook_input,
 			}
 		}
 
+		if (!child && !runas_jobuser && hook_preload)
+			hook_preload_run(arg, hook_config_path);
 		execve(pypath, arg, environ);
 run_hook_exit:
 		if (fp != NULL) {
@@ -280,6 +280,7 @@ static resource_def *rdcput;
 static resource_def *rdwall;
 int restart_background = FALSE;
 int reject_root_scripts = FALSE;
+int hook_preload = FALSE;
 int report_hook_checksums = TRUE;
 int restart_transmogrify = FALSE;
 int attach_allow = TRUE;
@@ -481,6 +482,7 @@ static handler_ret_t set_vnode_additive(char *);
 static handler_ret_t setidealload(char *);
 static handler_ret_t setlogevent(char *);
 static handler_ret_t set_reject_root_scripts(char *);
+static handler_ret_t set_hook_preload(char *);
 static handler_ret_t set_report_hook_checksums(char *);
 static handler_ret_t setmaxload(char *);
 static handler_ret_t set_max_poll_downtime(char *);
@@ -556,6 +558,7 @@ static struct	specials {
 	{ "wallmult",			wallmult },
 	{ "reject_root_scripts",	set_reject_root_scripts },
 	{ "report_hook_checksums",	set_report_hook_checksums },
+	{ "hook_preload",		set_hook_preload },
 	{ NULL,				NULL }
 };
 
@@ -1672,6 +1675,23 @@ set_reject_root_scripts(char *value)
 	return (set_boolean(__func__, value, &reject_root_scripts));
 }
 
+/**
+ * @brief
+ *	Set the configuration flag that defines whether hooks run as root are
+ *	run by a preloaded pbs_python instead of a new pbs_python per event.
+ *
+ * @param[in] value - boolean value
+ *
+ * @retval 0 failure
+ * @retval 1 success
+ *
+ */
+static handler_ret_t
+set_hook_preload(char *value)
+{
+	return (set_boolean(__func__, value, &hook_preload));
+}
+
 /**
  * @brief
  *	Set the configuration flag that tells the mom to send the checksums
@@ -4000,6 +4020,7 @@ read_config(char *file)
 	resume_signal	     = SIGCONT;
 	restart_background   = FALSE;
 	reject_root_scripts  = FALSE;
+	hook_preload = FALSE;
 	report_hook_checksums = TRUE;
 	restart_transmogrify = FALSE;
 	attach_allow	     = TRUE;
@@ -7785,6 +7806,14 @@ main(int argc, char *argv[])
 #ifndef	WIN32 /* ------------------------------------------------------------*/
 
 	daemon_protect(0, PBS_DAEMON_PROTECT_ON);
+	/* log through a background writer thread from here on */
+	if (pbs_conf.pbs_log_async) {
+		if ((rc = log_async_start()) != 0)
+			log_err(rc, msg_daemonname, "failed to start asynchronous logging");
+		else
+			log_async_flush_on_crash();
+	}
+
 #ifdef _POSIX_MEMLOCK
 	if (do_mlockall == 1) {
 		if (mlockall(MCL_CURRENT|MCL_FUTURE) == -1) {
@@ -55,6 +55,7 @@
 #include "sort.h"
 #include "node_partition.h"
 #include "check.h"
+#include "multi_threading.h"
 #include <log.h>
 #include "pbs_internal.h"
 
@@ -628,7 +629,7 @@ bucket_match(chunk_map **cmap, resource_resv *resresv, schd_error *err)
 	int i;
 	int j;
 	int k;
-	static pbs_bitmap *zeromap = NULL;
+	static thread_local pbs_bitmap *zeromap = NULL;
 	server_info *sinfo;
 
 	if (cmap == NULL || resresv == NULL || resresv->select == NULL)
@@ -949,7 +950,7 @@ find_correct_buckets(status *policy, node_bucket **buckets, resource_resv *resre
 	int i, j;
 	int can_run = 1;
 	chunk_map **cb_map;
-	static struct schd_error *failerr = NULL;
+	static thread_local struct schd_error *failerr = NULL;
 
 	if (policy == NULL || buckets == NULL || resresv == NULL || resresv->select == NULL || resresv->select->chunks == NULL || err == NULL)
 		return NULL;
@@ -1041,6 +1042,181 @@ find_correct_buckets(status *policy, node_bucket **buckets, resource_resv *resre
 	return cb_map;
 }
 
+/*
+ * @brief find the chunk to bucket mapping for a resresv and allocate
+ *	  nodes to it in the buckets' working pools.
+ *
+ * @par MT-safe: Yes, as long as no two threads use the same buckets
+ *
+ * @param[in] policy - policy info
+ * @param[in] bkts - buckets to search
+ * @param[in] resresv - resresv to see if it can fit
+ * @param[out] err - error structure to return failure
+ *
+ * @return chunk map with the nodes to allocate, or NULL if it can't fit
+ */
+static chunk_map **
+match_buckets(status *policy, node_bucket **bkts, resource_resv *resresv, schd_error *err)
+{
+	chunk_map **cmap;
+
+	cmap = find_correct_buckets(policy, bkts, resresv, err);
+	if (cmap == NULL)
+		return NULL;
+
+	clear_schd_error(err);
+	if (bucket_match(cmap, resresv, err) == 0) {
+		if (err->status_code == SCHD_UNKWN)
+			set_schd_error_codes(err, NOT_RUN, NO_NODE_RESOURCES);
+
+		free_chunk_map_array(cmap);
+		return NULL;
+	}
+
+	return cmap;
+}
+
+/*
+ * @brief check to see if a resresv can fit on the nodes using buckets
+ *
+ * @param[in] policy - policy info
+ * @param[in] bkts - buckets to search
+ * @param[in] resresv - resresv to see if it can fit
+ * @param[out] err - error structure to return failure
+ *
+ * @return place resresv can run or NULL if it can't
+ */
+nspec **
+map_buckets(status *policy, node_bucket **bkts, resource_resv *resresv, schd_error *err)
+{
+	chunk_map **cmap;
+	nspec **ns_arr;
+
+	if (policy == NULL || bkts == NULL || resresv == NULL || err == NULL)
+		return NULL;
+
+	cmap = match_buckets(policy, bkts, resresv, err);
+	if (cmap == NULL)
+		return NULL;
+
+	ns_arr = bucket_to_nspecs(policy, cmap, resresv);
+
+	free_chunk_map_array(cmap);
+	return ns_arr;
+}
+
+/* placement sets being matched by the thread pool in map_buckets_psets() */
+struct pset_bucket_match {
+	status *policy;
+	node_partition **nodepart;
+	resource_resv *resresv;
+	chunk_map ***cmaps;
+	schd_error **errs;
+};
+
+/**
+ * @brief thread pool callback to match a range of placement sets' buckets
+ * @param[in,out] arg - pset_bucket_match for this wave
+ * @param[in] sidx - first placement set of the range
+ * @param[in] eidx - last placement set of the range
+ */
+static void
+match_buckets_chunk(void *arg, int sidx, int eidx)
+{
+	pset_bucket_match *pm = static_cast<pset_bucket_match *>(arg);
+	int i;
+
+	for (i = sidx; i <= eidx; i++)
+		pm->cmaps[i] = match_buckets(pm->policy, pm->nodepart[i]->bkts, pm->resresv, pm->errs[i]);
+}
+
+/**
+ * @brief map a resresv onto the buckets of each placement set using the
+ *	  thread pool.  Placement sets are matched in waves of num_threads and
+ *	  the results are looked at in placement set order, so the placement
+ *	  set picked and the error returned are the same as a serial search.
+ *	  Only the winner is converted into nspecs, since that hands out
+ *	  sequence numbers.
+ *
+ * @param[in] policy - policy info
+ * @param[in] nodepart - placement sets to search
+ * @param[in] resresv - the job
+ * @param[in,out] failerr - first NOT_RUN error seen
+ * @param[out] can_run - set to 1 if the job could run in a placement set later
+ * @param[out] err - error from the last placement set looked at
+ *
+ * @return nspec **
+ * @retval place job can run
+ * @retval NULL if it can't run in any placement set
+ */
+static nspec **
+map_buckets_psets(status *policy, node_partition **nodepart, resource_resv *resresv,
+	schd_error *failerr, int *can_run, schd_error *err)
+{
+	int num_parts;
+	int i;
+	int j;
+	nspec **nspecs = NULL;
+	pset_bucket_match pm;
+	std::vector<chunk_map **> cmaps(num_threads);
+	std::vector<schd_error *> errs(num_threads);
+
+	for (j = 0; j < num_threads; j++) {
+		errs[j] = new_schd_error();
+		if (errs[j] == NULL) {
+			for (j--; j >= 0; j--)
+				free_schd_error(errs[j]);
+			set_schd_error_codes(err, NOT_RUN, SCHD_ERROR);
+			return NULL;
+		}
+	}
+
+	pm.policy = policy;
+	pm.resresv = resresv;
+	pm.cmaps = cmaps.data();
+	pm.errs = errs.data();
+
+	num_parts = count_array(nodepart);
+	for (i = 0; i < num_parts && nspecs == NULL; i += num_threads) {
+		int n = (num_parts - i < num_threads) ? num_parts - i : num_threads;
+
+		for (j = 0; j < n; j++)
+			clear_schd_error(errs[j]);
+		pm.nodepart = nodepart + i;
+		mt_parallel_for(n, 1, match_buckets_chunk, &pm);
+
+		for (j = 0; j < n; j++) {
+			log_eventf(PBSEVENT_DEBUG3, PBS_EVENTCLASS_JOB, LOG_DEBUG, resresv->name,
+				"Evaluating placement set: %s", nodepart[i + j]->name);
+
+			clear_schd_error(err);
+			copy_schd_error(err, errs[j]);
+			if (cmaps[j] != NULL) {
+				nspecs = bucket_to_nspecs(policy, cmaps[j], resresv);
+				free_chunk_map_array(cmaps[j]);
+				cmaps[j] = NULL;
+			}
+			if (nspecs != NULL)
+				break;
+			if (err->status_code == NOT_RUN) {
+				if (failerr->status_code == SCHD_UNKWN)
+					copy_schd_error(failerr, err);
+				*can_run = 1;
+			}
+		}
+		/* Throw away the work done on placement sets after the winner */
+		for (; j < n; j++) {
+			free_chunk_map_array(cmaps[j]);
+			cmaps[j] = NULL;
+		}
+	}
+
+	for (j = 0; j < num_threads; j++)
+		free_schd_error(errs[j]);
+
+	return nspecs;
+}
+
 /**
  * @brief entry point into the node bucket algorithm.  If placement sets are
  * 	in use, choose the right pool and call map_buckets() on each.  If placement
@@ -1094,6 +1270,7 @@ check_node_buckets(status *policy, server_info *sinfo, queue_info *qinfo, resour
 	}
 	if (nodepart != NULL) {
 		int i;
+		int tid;
 		int can_run = 0;
 		static schd_error *failerr = NULL;
 		if (failerr == NULL) {
@@ -1103,20 +1280,29 @@ check_node_buckets(status *policy, server_info *sinfo, queue_info *qinfo, resour
 		} else
 			clear_schd_error(failerr);
 
-		for (i = 0; nodepart[i] != NULL; i++) {
+		tid = *((int *) pthread_getspecific(th_id_key));
+		if (tid != 0 || num_threads <= 1 || nodepart[1] == NULL) {
+			for (i = 0; nodepart[i] != NULL; i++) {
+				nspec **nspecs;
+				log_eventf(PBSEVENT_DEBUG3, PBS_EVENTCLASS_JOB, LOG_DEBUG, resresv->name,
+					"Evaluating placement set: %s", nodepart[i]->name);
+
+				clear_schd_error(err);
+				nspecs = map_buckets(policy, nodepart[i]->bkts, resresv, err);
+				if (nspecs != NULL)
+					return nspecs;
+				if (err->status_code == NOT_RUN) {
+					if (failerr->status_code == SCHD_UNKWN)
+						copy_schd_error(failerr, err);
+					can_run = 1;
+				}
+			}
+		} else {
 			nspec **nspecs;
-			log_eventf(PBSEVENT_DEBUG3, PBS_EVENTCLASS_JOB, LOG_DEBUG, resresv->name,
-				"Evaluating placement set: %s", nodepart[i]->name);
 
-			clear_schd_error(err);
-			nspecs = map_buckets(policy, nodepart[i]->bkts, resresv, err);
+			nspecs = map_buckets_psets(policy, nodepart, resresv, failerr, &can_run, err);
 			if (nspecs != NULL)
 				return nspecs;
-			if (err->status_code == NOT_RUN) {
-				if (failerr->status_code == SCHD_UNKWN)
-					copy_schd_error(failerr, err);
-				can_run = 1;
-			}
 		}
 		/* If we can't fit in any placement set, span over all of them */
 		if (can_run == 0) {
@@ -1149,41 +1335,3 @@ check_node_buckets(status *policy, server_info *sinfo, queue_info *qinfo, resour
 
 	return map_buckets(policy, sinfo->buckets, resresv, err);
 }
-
-/*
- * @brief check to see if a resresv can fit on the nodes using buckets
- *
- * @param[in] policy - policy info
- * @param[in] bkts - buckets to search
- * @param[in] resresv - resresv to see if it can fit
- * @param[out] err - error structure to return failure
- *
- * @return place resresv can run or NULL if it can't
- */
-nspec **
-map_buckets(status *policy, node_bucket **bkts, resource_resv *resresv, schd_error *err)
-{
-	chunk_map **cmap;
-	nspec **ns_arr;
-
-	if (policy == NULL || bkts == NULL || resresv == NULL || err == NULL)
-		return NULL;
-
-	cmap = find_correct_buckets(policy, bkts, resresv, err);
-	if (cmap == NULL)
-		return NULL;
-
-	clear_schd_error(err);
-	if (bucket_match(cmap, resresv, err) == 0) {
-		if (err->status_code == SCHD_UNKWN)
-			set_schd_error_codes(err, NOT_RUN, NO_NODE_RESOURCES);
-
-		free_chunk_map_array(cmap);
-		return NULL;
-	}
-
-	ns_arr = bucket_to_nspecs(policy, cmap, resresv);
-
-	free_chunk_map_array(cmap);
-	return ns_arr;
-}
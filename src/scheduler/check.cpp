@@ -1566,6 +1566,7 @@ check_normal_node_path(status *policy, server_info *sinfo, queue_info *qinfo, re
 	nspec **nspec_arr = NULL;
 	selspec *spec = NULL;
 	place *pl = NULL;
+	place place_buf;		/* pl may point here, see get_resresv_spec() */
 	int rc = 0;
 	np_cache *npc = NULL;
 	int error = 0;
@@ -1593,7 +1594,7 @@ check_normal_node_path(status *policy, server_info *sinfo, queue_info *qinfo, re
 			return NULL;
 	}
 
-	get_resresv_spec(resresv, &spec, &pl);
+	get_resresv_spec(resresv, &spec, &pl, &place_buf);
 
 	/* Sets of nodes:
 	   * 1. job is in a reservation - use reservation nodes
@@ -1867,12 +1868,12 @@ check_prime_boundary(status *policy, resource_resv  *resresv, struct schd_error
  *
  * @return	schd_resource * (set to False)
  *
- * @par MT-safe: No
+ * @par MT-safe: Yes, each thread has its own copy
  */
 schd_resource *
 false_res()
 {
-	static schd_resource *res = NULL;
+	static thread_local schd_resource *res = NULL;
 
 	if (res == NULL) {
 		res = new_resource();
@@ -1900,12 +1901,12 @@ false_res()
  * @return	schd_resource *
  * @retval	NULL	: fail
  *
- * @par MT-safe: No
+ * @par MT-safe: Yes, each thread has its own copy
  */
 schd_resource *
 unset_str_res()
 {
-	static schd_resource *res = NULL;
+	static thread_local schd_resource *res = NULL;
 
 	if (res == NULL) {
 		res = new_resource();
@@ -1944,7 +1945,7 @@ unset_str_res()
 schd_resource *
 zero_res()
 {
-	static schd_resource *res = NULL;
+	static thread_local schd_resource *res = NULL;
 
 	if (res == NULL) {
 		res = new_resource();
@@ -1970,25 +1971,25 @@ zero_res()
  * @param[in]  *resresv resources reservation object
  * @param[out] **spec output select specification
  * @param[out] **pl  output placement specification
+ * @param[out] *place_buf  caller's buffer, *pl may be set to point to it
  *
- * @par MT-Safe: No
+ * @par MT-Safe: Yes
  * @return void
  */
-void get_resresv_spec(resource_resv *resresv, selspec **spec, place **pl)
+void get_resresv_spec(resource_resv *resresv, selspec **spec, place **pl, place *place_buf)
 {
-	static place place_spec;
 	if (resresv->is_job && resresv->job != NULL) {
 		if (resresv->execselect != NULL) {
-			*spec = resresv->execselect;
-			place_spec = *resresv->place_spec;
+			*spec = resresv->execselect.get();
+			*place_buf = *resresv->place_spec;
 
 			/* Placement was handled the first time.  Don't let it get in the way */
-			place_spec.scatter = place_spec.vscatter = place_spec.pack = 0;
-			place_spec.free = 1;
-			*pl = &place_spec;
+			place_buf->scatter = place_buf->vscatter = place_buf->pack = 0;
+			place_buf->free = 1;
+			*pl = place_buf;
 		} else {
 			*pl = resresv->place_spec;
-			*spec = resresv->select;
+			*spec = resresv->select.get();
 		}
 	} else if (resresv->is_resv && resresv->resv != NULL) {
 		/* The execselect should be used when the resv is running.  We can't
@@ -1997,10 +1998,10 @@ void get_resresv_spec(resource_resv *resresv, selspec **spec, place **pl)
 		 */
 		if (resresv->resv->is_running)
 
-			*spec = resresv->execselect;
+			*spec = resresv->execselect.get();
 		else
-			*spec = resresv->select;
-		place_spec = *resresv->place_spec;
-		*pl = &place_spec;
+			*spec = resresv->select.get();
+		*place_buf = *resresv->place_spec;
+		*pl = place_buf;
 	}
 }
@@ -224,5 +224,5 @@ schd_resource *unset_str_res(void);
  *
  *	returns void
  */
-void get_resresv_spec(resource_resv *resresv, selspec **spec, place **pl);
+void get_resresv_spec(resource_resv *resresv, selspec **spec, place **pl, place *place_buf);
 #endif	/* _CHECK_H */
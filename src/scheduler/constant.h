@@ -93,6 +93,12 @@ enum select_job_status
 
 #define INIT_ARR_SIZE 2048
 
+/* counts lists longer than this are looked up through a hash index */
+#define COUNTS_INDEX_MIN 16
+
+/* resource lists at least this long are looked up through an ordinal index */
+#define RESOURCE_INDEX_MIN 8
+
 /* We need two sets of UNSPECIFIED/SCHD_INFINITY constants.  One for resources
  * which can be negative, and one for positive integer values.  While we could
  * use some numbers near -LONG_MAX, that would mean every integer used in the
@@ -176,7 +182,8 @@ enum thread_task_type
 	TS_FREE_ND_INFO,
 	TS_DUP_RESRESV,
 	TS_QUERY_JOB_INFO,
-	TS_FREE_RESRESV
+	TS_FREE_RESRESV,
+	TS_GENERIC
 };
 
 /* return codes for is_ok_to_run_* functions
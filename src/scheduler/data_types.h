@@ -52,6 +52,8 @@
 #ifndef	_DATA_TYPES_H
 #define	_DATA_TYPES_H
 
+#include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -79,6 +81,8 @@ struct prev_job_info;
 class group_info;
 struct usage_info;
 struct counts;
+struct counts_index;
+struct res_ord_index;
 struct nspec;
 struct node_partition;
 struct range;
@@ -114,6 +118,8 @@ typedef struct resource_count resource_count;
 typedef struct usage_info usage_info;
 typedef struct resv_info resv_info;
 typedef struct counts counts;
+typedef struct counts_index counts_index;
+typedef struct res_ord_index res_ord_index;
 typedef struct nspec nspec;
 typedef struct node_partition node_partition;
 typedef struct place place;
@@ -138,6 +144,7 @@ typedef struct th_data_free_ninfo th_data_free_ninfo;
 typedef struct th_data_dup_resresv th_data_dup_resresv;
 typedef struct th_data_query_jinfo th_data_query_jinfo;
 typedef struct th_data_free_resresv th_data_free_resresv;
+typedef struct th_data_generic th_data_generic;
 
 
 #ifdef NAS
@@ -245,6 +252,14 @@ struct th_data_free_resresv
 	int eidx;
 };
 
+struct th_data_generic
+{
+	void (*func)(void *arg, int sidx, int eidx);	/* called on [sidx, eidx] */
+	void *arg;
+	int sidx;
+	int eidx;
+};
+
 struct schd_error
 {
 	enum sched_error_code error_code;	/* scheduler error code (see constant.h) */
@@ -664,6 +679,7 @@ struct node_info
 	bool power_provisioning:1;	/* can this node can power provision */
 	bool is_sleeping:1;		/* node put to sleep through power on/off or ramp rate limit */
 	bool has_ghost_job:1;	/* race condition occurred: recalculate resources_assigned */
+	bool res_indirect:1;	/* res has or is the target of an indirect resource */
 
 	/* sharing */
 	enum vnode_sharing sharing;	/* deflt or forced sharing/excl of the node */
@@ -699,6 +715,11 @@ struct node_info
 	int max_group_run;		/* max number of jobs running by a UNIX group */
 
 	schd_resource *res;		/* list of resources max/current usage */
+	/* res is shared copy-on-write between duplicated universes unless
+	 * res_indirect is set.  When shared, res_share owns res.
+	 * Call unshare_node_res() before modifying res.
+	 */
+	std::shared_ptr<schd_resource> res_share;
 
 	int rank;			/* unique numeric identifier for node */
 
@@ -793,8 +814,15 @@ class resource_resv
 	time_t min_duration;		/* minimum duration of STF job */
 
 	resource_req *resreq;		/* list of resources requested */
-	selspec *select;		/* select spec */
-	selspec *execselect;		/* select spec from exec_vnode and resv_nodes */
+	/* resreq is never modified once queried.  It is shared between
+	 * duplicated universes and owned by resreq_share once shared.
+	 */
+	std::shared_ptr<resource_req> resreq_share;
+	/* select specs are shared between duplicated universes.  They are never
+	 * modified once parsed.  If one needs to change, it is replaced.
+	 */
+	std::shared_ptr<selspec> select;	/* select spec */
+	std::shared_ptr<selspec> execselect;	/* select spec from exec_vnode and resv_nodes */
 	place *place_spec;		/* placement spec */
 
 	server_info *server;		/* pointer to server which owns res resv */
@@ -856,6 +884,7 @@ struct schd_resource
 	resdef *def;			/* resource definition */
 
 	struct schd_resource *next;	/* next resource in list */
+	res_ord_index *index;		/* ordinal index, only kept on the head of a list */
 };
 
 struct resource_req
@@ -875,7 +904,8 @@ class resdef
 	const std::string name;	/* name of resource */
 	resource_type type;	/* resource type */
 	unsigned int flags;	/* resource flags (see pbs_ifl.h) */
-	resdef(char *rname, unsigned int rflags, resource_type rtype) : name(rname), type(rtype), flags(rflags) {}
+	int ord;		/* position among the queried definitions, indexes resource lists */
+	resdef(char *rname, unsigned int rflags, resource_type rtype, int rord) : name(rname), type(rtype), flags(rflags), ord(rord) {}
 };
 
 class prev_job_info
@@ -897,6 +927,7 @@ struct counts
 	int running;			/* count of running jobs in object */
 	int soft_limit_preempt_bit;	/* Place to store preempt bit if entity is over limits */
 	resource_count *rescts;		/* resources used */
+	counts_index *index;		/* name index, only kept on the head of a list */
 	counts *next;
 };
 
@@ -923,6 +954,14 @@ class fairshare_head
 	~fairshare_head();
 };
 
+/* name index and change tracking kept on the root of a fairshare tree */
+struct fairshare_index
+{
+	std::unordered_map<std::string, group_info *> names;	/* every node by name */
+	std::vector<group_info *> bumped;	/* entities whose temp_usage was raised this cycle */
+	bool changed;				/* usage or shape changed since usage factors were calculated */
+};
+
 class group_info
 {
 	public:
@@ -947,6 +986,7 @@ class group_info
 	group_info *parent;			/* parent node */
 	group_info *sibling;			/* sibling node */
 	group_info *child;			/* child node */
+	std::unique_ptr<fairshare_index> fs_index;	/* only set on the root of the tree */
 	group_info(const std::string& gname);
 	group_info(group_info&);
 };
@@ -1136,6 +1176,7 @@ struct config
 	bool node_sort_unused:1;	/* node sorting by unused/assigned is used */
 	bool resv_conf_ignore:1;	/* if we want to ignore dedicated time when confirming reservations.  Move to enum if ever expanded */
 	bool allow_aoe_calendar:1;	/* allow jobs requesting aoe in calendar*/
+	bool incr_job_query:1;		/* only query jobs changed since the last cycle */
 #ifdef NAS /* localmod 034 */
 	bool prime_sto:1;	/* shares_track_only--no enforce shares */
 	bool non_prime_sto:1;
@@ -1199,9 +1240,14 @@ struct event_list
 {
 	bool eol:1;		/* we've reached the end of time */
 	timed_event *events;		/* the calendar of events */
+	timed_event *last_event;	/* the last event in the calendar */
 	timed_event *next_event;	/* the next event to be performed */
 	timed_event *first_run_event;	/* The first run event in the calendar */
 	time_t *current_time;		/* [reference] current time in the calendar */
+	/* first event in the calendar at each distinct event time */
+	std::map<time_t, timed_event *> time_index;
+	/* all events in the calendar keyed by event name */
+	std::unordered_multimap<std::string, timed_event *> name_index;
 };
 
 struct timed_event
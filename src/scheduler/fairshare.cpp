@@ -117,9 +117,34 @@ add_child(group_info *ginfo, group_info *parent)
 		ginfo->parent = parent;
 		ginfo->resgroup = parent->cresgroup;
 		ginfo->gpath = create_group_path(ginfo);
+
+		auto idx = ginfo->gpath[0]->fs_index.get();
+		if (idx != NULL) {
+			idx->names.emplace(ginfo->name, ginfo);
+			idx->changed = true;
+		}
 	}
 }
 
+/**
+ * @brief
+ *		index_fairshare_root - give the root of a fairshare tree its
+ *			  name index.  Nodes added below it with add_child()
+ *			  are indexed as they are added.
+ *
+ * @param[in,out]	root	-	root of the fairshare tree
+ *
+ * @return	nothing
+ *
+ */
+static void
+index_fairshare_root(group_info *root)
+{
+	root->fs_index.reset(new fairshare_index());
+	root->fs_index->names.emplace(root->name, root);
+	root->fs_index->changed = true;
+}
+
 /**
  * @brief
  * 		add a ginfo to the "unknown" group
@@ -142,8 +167,9 @@ add_unknown(group_info *ginfo, group_info *root)
 
 /**
  * @brief
- *		find_group_info - recursive function to find a group_info in the
- *			  resgroup tree
+ *		find_group_info - find a group_info in the resgroup tree.  The root
+ *			  of a whole tree is searched through its name index,
+ *			  any other sub-tree is searched recursively.
  *
  * @param[in]	name	-	name of the ginfo to find
  * @param[in]	root	-	the root of the current sub-tree
@@ -158,6 +184,13 @@ find_group_info(const std::string& name, group_info *root)
 	if (root == NULL || name == root->name)
 		return root;
 
+	if (root->fs_index != NULL) {
+		auto it = root->fs_index->names.find(name);
+		if (it == root->fs_index->names.end())
+			return NULL;
+		return it->second;
+	}
+
 	ginfo = find_group_info(name, root->sibling);
 	if (ginfo == NULL)
 		ginfo = find_group_info(name, root->child);
@@ -351,6 +384,7 @@ preload_tree()
 
 
 	head->root = root;
+	index_fairshare_root(root);
 
 	root->resgroup = -1;
 	root->cresgroup = 0;
@@ -462,12 +496,42 @@ update_usage_on_run(resource_resv *resresv)
 	if (resresv->job->ginfo !=NULL) {
 		for (auto& g : resresv->job->ginfo->gpath)
 			g->temp_usage += u;
+
+		if (!resresv->job->ginfo->gpath.empty()) {
+			auto idx = resresv->job->ginfo->gpath[0]->fs_index.get();
+			if (idx != NULL)
+				idx->bumped.push_back(resresv->job->ginfo);
+		}
 	}
 	else
 		log_event(PBSEVENT_JOB, PBS_EVENTCLASS_JOB, LOG_INFO, resresv->name,
 			"Job doesn't have a group_info ptr set, usage not updated.");
 }
 
+/**
+ * @brief
+ *		add_usage_to_path - add usage to a fairshare entity and every group
+ *			    on the path from the root of the tree to it
+ *
+ * @param[in]	ginfo	-	the entity accruing usage
+ * @param[in]	delta	-	the usage to add
+ *
+ * @return nothing
+ *
+ */
+void
+add_usage_to_path(group_info *ginfo, usage_t delta)
+{
+	if (ginfo == NULL || ginfo->gpath.empty())
+		return;
+
+	for (auto& g : ginfo->gpath)
+		g->usage += delta;
+
+	if (ginfo->gpath[0]->fs_index != NULL)
+		ginfo->gpath[0]->fs_index->changed = true;
+}
+
 /**
  * @brief
  *		decay_fairshare_tree - decay the usage information kept in the fair
@@ -484,6 +548,9 @@ decay_fairshare_tree(group_info *root)
 	if (root == NULL)
 		return;
 
+	if (root->fs_index != NULL)
+		root->fs_index->changed = true;
+
 	decay_fairshare_tree(root->sibling);
 	decay_fairshare_tree(root->child);
 
@@ -691,6 +758,9 @@ read_usage(const char *filename, int flags, fairshare_head *fhead)
 	}
 
 	fclose(fp);
+
+	if (fhead->root->fs_index != NULL)
+		fhead->root->fs_index->changed = true;
 }
 
 /**
@@ -872,7 +942,10 @@ dup_fairshare_tree(group_info *root, group_info *nparent)
 	if (nroot == NULL)
 		return NULL;
 
-	add_child(nroot, nparent);
+	if (nparent == NULL)
+		index_fairshare_root(nroot);
+	else
+		add_child(nroot, nparent);
 
 
 	nroot->sibling = dup_fairshare_tree(root->sibling, nparent);
@@ -954,15 +1027,45 @@ fairshare_head::~fairshare_head()
  *
  * @return	void
  */
+static void
+reset_temp_usage_rec(group_info *head)
+{
+	if (head == NULL)
+		return;
+
+	head->temp_usage = head->usage;
+	reset_temp_usage_rec(head->sibling);
+	reset_temp_usage_rec(head->child);
+}
+
+/**
+ * @brief
+ * 		reset temp_usage = usage in the fairshare tree.  If the usage of
+ *		the tree has not changed since usage factors were last calculated,
+ *		only the paths of entities whose temp_usage was raised are reset.
+ *
+ * @param[in]	head	-	fairshare node to reset
+ *
+ * @return	void
+ */
 void
 reset_temp_usage(group_info *head)
 {
 	if (head == NULL)
 		return;
 
-	head->temp_usage = head->usage;
-	reset_temp_usage(head->sibling);
-	reset_temp_usage(head->child);
+	auto idx = head->fs_index.get();
+	if (idx != NULL && !idx->changed) {
+		for (auto& ginfo : idx->bumped)
+			for (auto& g : ginfo->gpath)
+				g->temp_usage = g->usage;
+		idx->bumped.clear();
+		return;
+	}
+
+	if (idx != NULL)
+		idx->bumped.clear();
+	reset_temp_usage_rec(head);
 }
 
 /**
@@ -1005,16 +1108,23 @@ calc_usage_factor(fairshare_head *tree)
 	group_info *ginfo;
 	group_info *root;
 
-	if (tree == NULL)
+	if (tree == NULL || tree->root == NULL)
 		return;
 
 	root = tree->root;
+	/* nothing has moved since the last calculation */
+	if (root->fs_index != NULL && !root->fs_index->changed)
+		return;
+
 	/* Root's children use their real usage as their arbitrary usage */
 	for (ginfo = root->child; ginfo != NULL; ginfo = ginfo->sibling) {
 		ginfo->usage_factor = ginfo->usage / root->usage;
 		calc_usage_factor_rec(root, ginfo->child);
 	}
 
+	if (root->fs_index != NULL)
+		root->fs_index->changed = false;
+
 }
 
 /**
@@ -1026,6 +1136,8 @@ calc_usage_factor(fairshare_head *tree)
 void reset_usage(group_info *node) {
 	if(node == NULL)
 		return;
+	if (node->fs_index != NULL)
+		node->fs_index->changed = true;
 	reset_usage(node->sibling);
 	reset_usage(node->child);
 	node->usage = 1;
@@ -116,6 +116,12 @@ void update_usage_on_run(resource_resv *resresv);
  */
 void decay_fairshare_tree(group_info *root);
 
+/*
+ *      add_usage_to_path - add usage to an entity and every group on the
+ *                          path from the root of the tree to it
+ */
+void add_usage_to_path(group_info *ginfo, usage_t delta);
+
 /*
  *      write_usage - write the usage information to the usage file
  *                    This fuction uses a recursive helper function
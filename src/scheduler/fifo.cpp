@@ -350,9 +350,7 @@ init_scheduling_cycle(status *policy, int pbs_sd, server_info *sinfo)
 
 						delta = IF_NEG_THEN_ZERO(delta);
 
-						;
-						for (auto& g : user->gpath)
-							g->usage += delta;
+						add_usage_to_path(user, delta);
 
 						resort = true;
 					}
@@ -412,6 +410,11 @@ init_scheduling_cycle(status *policy, int pbs_sd, server_info *sinfo)
 		}
 	}
 	if (sinfo->jobs != NULL) {
+		std::vector<sch_resource_t> formula_values;
+
+		if (sinfo->job_sort_formula != NULL)
+			formula_values = formula_evaluate_jobs(sinfo->job_sort_formula, sinfo->jobs, count_array(sinfo->jobs));
+
 		for (int i = 0; sinfo->jobs[i] != NULL; i++) {
 			resource_resv *resresv = sinfo->jobs[i];
 			if (resresv->job != NULL) {
@@ -425,7 +428,7 @@ init_scheduling_cycle(status *policy, int pbs_sd, server_info *sinfo)
 				}
 				if (sinfo->job_sort_formula != NULL) {
 					double threshold = sc_attrs.job_sort_formula_threshold;
-					resresv->job->formula_value = formula_evaluate(sinfo->job_sort_formula, resresv, resresv->resreq);
+					resresv->job->formula_value = formula_values[i];
 					log_eventf(PBSEVENT_DEBUG2, PBS_EVENTCLASS_JOB, LOG_DEBUG, resresv->name, "Formula Evaluation = %.*f",
 						   float_digits(resresv->job->formula_value, FLOAT_NUM_DIGITS), resresv->job->formula_value);
 
@@ -671,6 +674,9 @@ scheduling_cycle(int sd, const sched_cmd *cmd)
 	if (error == 0)
 		rc = main_sched_loop(policy, sd, sinfo, &err);
 
+	/* the jobs have to be run before the qrun request is answered */
+	flush_run_jobs();
+
 	if (cmd->jid != NULL) {
 		int def_rc = -1;
 		int i;
@@ -1119,6 +1125,10 @@ main_sched_loop(status *policy, int sd, server_info *sinfo, schd_error **rerr)
 void
 end_cycle_tasks(server_info *sinfo)
 {
+	/* send the run requests and then the attribute updates still held back */
+	flush_run_jobs();
+	flush_attr_updates();
+
 	/* keep track of update used resources for fairshare */
 	if (sinfo != NULL && sinfo->policy->fair_share)
 		create_prev_job_info(sinfo->running_jobs);
@@ -1864,7 +1874,8 @@ add_job_to_calendar(int pbs_sd, status *policy, server_info *sinfo,
 		 * Note: We only ever look from now into the future
 		 */
 		auto nexte = get_next_event(sinfo->calendar);
-		if (find_timed_event(nexte, topjob->name, IGNORE_DISABLED_EVENTS, TIMED_NOEVENT, 0) != NULL)
+		if (nexte != NULL &&
+		    find_timed_event(sinfo->calendar, nexte, topjob->name, IGNORE_DISABLED_EVENTS, TIMED_NOEVENT, 0) != NULL)
 			return 1;
 	}
 	if ((nsinfo = dup_server_info(sinfo)) == NULL)
@@ -1891,6 +1902,7 @@ add_job_to_calendar(int pbs_sd, status *policy, server_info *sinfo,
 	if (start_time > 0) {
 		char *exec;	       /* used to hold execvnode for topjob */
 		char log_buf[MAX_LOG_SIZE];
+		int est_unchanged;	/* estimate is the one the server holds */
 
 		/* If our top job is a job array, we don't backfill around the
 		 * parent array... rather a subjob.  Normally subjobs don't actually
@@ -1942,8 +1954,7 @@ add_job_to_calendar(int pbs_sd, status *policy, server_info *sinfo,
 					create_node_array_from_nspec(bjob->nspec_arr);
 				selectspec = create_select_from_nspec(bjob->nspec_arr);
 				if (!selectspec.empty()) {
-					delete bjob->execselect;
-					bjob->execselect = parse_selspec(selectspec);
+					bjob->execselect.reset(parse_selspec(selectspec));
 				}
 			} else {
 				free_server(nsinfo);
@@ -1955,6 +1966,11 @@ add_job_to_calendar(int pbs_sd, status *policy, server_info *sinfo,
 		}
 
 
+		/* the server already holds this estimate if it has not moved */
+		est_unchanged = bjob->job->est_start_time == start_time &&
+			bjob->job->est_execvnode != NULL &&
+			strcmp(bjob->job->est_execvnode, exec) == 0;
+
 		if (bjob->job->est_execvnode != NULL)
 			free(bjob->job->est_execvnode);
 		bjob->job->est_execvnode = string_dup(exec);
@@ -1976,7 +1992,7 @@ add_job_to_calendar(int pbs_sd, status *policy, server_info *sinfo,
 		}
 		add_event(sinfo->calendar, te_end);
 
-		if (update_estimated_attrs(pbs_sd, bjob, bjob->job->est_start_time,
+		if (!est_unchanged && update_estimated_attrs(pbs_sd, bjob, bjob->job->est_start_time,
 			bjob->job->est_execvnode, 0) <0) {
 			log_event(PBSEVENT_SCHED, PBS_EVENTCLASS_SCHED, LOG_WARNING,
 				bjob->name, "Failed to update estimated attrs.");
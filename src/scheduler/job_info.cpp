@@ -44,6 +44,9 @@
  * 		job_info.c - This file contains functions related to job_info structure.
  *
  * Functions included are:
+ * 	free_job_stat_cache()
+ * 	query_jobs_full()
+ * 	query_jobs_incr()
  * 	query_jobs()
  * 	query_job()
  * 	new_job_info()
@@ -72,6 +75,8 @@
  * 	modify_job_array_for_qrun()
  * 	queue_subjob()
  * 	formula_evaluate()
+ * 	formula_evaluate_jobs()
+ * 	clear_formula_cache()
  * 	make_eligible()
  * 	make_ineligible()
  * 	update_accruetype()
@@ -98,6 +103,10 @@
 #include <unistd.h>
 #include <sys/types.h>
 #include <math.h>
+#include <limits.h>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <pbs_ifl.h>
 #include <log.h>
 #include <libutil.h>
@@ -608,9 +617,9 @@ query_jobs_chunk(th_data_query_jinfo *data)
 			resresv->job->nodect = 999999;
 #endif /* localmod 040 */
 
-		if ((resresv->aoename = getaoename(resresv->select)) != NULL)
+		if ((resresv->aoename = getaoename(resresv->select.get())) != NULL)
 			resresv->is_prov_needed = 1;
-		if ((resresv->eoename = geteoename(resresv->select)) != NULL) {
+		if ((resresv->eoename = geteoename(resresv->select.get())) != NULL) {
 			/* job with a power profile can't be checkpointed or suspended */
 			resresv->job->can_checkpoint = 0;
 			resresv->job->can_suspend = 0;
@@ -656,7 +665,7 @@ query_jobs_chunk(th_data_query_jinfo *data)
 			selectspec = create_select_from_nspec(resresv->nspec_arr);
 
 		if (resresv->nspec_arr != NULL)
-			resresv->execselect = parse_selspec(selectspec);
+			resresv->execselect.reset(parse_selspec(selectspec));
 
 		/* Find out if it is a shrink-to-fit job.
 		 * If yes, set the duration to max walltime.
@@ -875,6 +884,236 @@ alloc_tdata_jquery(status *policy, int pbs_sd, struct batch_status *jobs, queue_
 	return tdata;
 }
 
+/*
+ * Job status replies of the previous cycle kept per queue for
+ * incremental_job_query.  Each job carries the server's chgseq stamp, which
+ * changes whenever any of the job's attributes change.
+ */
+struct job_stat_cache {
+	struct batch_status *jobs;	/* cached replies in server order */
+	long max_chgseq;		/* highest chgseq in jobs */
+	time_t query_time;		/* when jobs were queried */
+};
+static std::unordered_map<std::string, job_stat_cache> jstat_cache;
+
+/**
+ * @brief	return the chgseq value in a job status reply
+ *
+ * @param[in]	bs	-	job status reply
+ *
+ * @return	long
+ * @retval	chgseq of the job
+ * @retval	-1	: chgseq was not returned
+ */
+static long
+get_bs_chgseq(struct batch_status *bs)
+{
+	for (struct attrl *attrp = bs->attribs; attrp != NULL; attrp = attrp->next) {
+		if (!strcmp(attrp->name, ATTR_chgseq))
+			return strtol(attrp->value, NULL, 10);
+	}
+	return -1;
+}
+
+/**
+ * @brief	advance the eligible_time in a cached job status reply of a job
+ *		accruing eligible time.  The server calculates it on the fly when
+ *		the job is queried, which does not restamp the job's chgseq.
+ *
+ * @param[in,out]	bs	-	job status reply
+ * @param[in]	elapsed	-	seconds since the reply was queried
+ *
+ * @return	void
+ */
+static void
+age_eligible_time(struct batch_status *bs, time_t elapsed)
+{
+	struct attrl *elig = NULL;
+	bool eligible = false;
+	char timebuf[128];
+	char *value;
+
+	for (struct attrl *attrp = bs->attribs; attrp != NULL; attrp = attrp->next) {
+		if (!strcmp(attrp->name, ATTR_accrue_type))
+			eligible = (atoi(attrp->value) == JOB_ELIGIBLE);
+		else if (!strcmp(attrp->name, ATTR_eligible_time))
+			elig = attrp;
+	}
+	if (!eligible || elig == NULL)
+		return;
+
+	convert_duration_to_str((time_t) res_to_num(elig->value, NULL) + elapsed, timebuf, sizeof(timebuf));
+	if ((value = strdup(timebuf)) == NULL)
+		return;
+	free(elig->value);
+	elig->value = value;
+}
+
+/**
+ * @brief	free the job status replies kept for incremental_job_query
+ *
+ * @return	void
+ */
+static void
+free_job_stat_cache(void)
+{
+	for (auto &qc : jstat_cache)
+		pbs_statfree(qc.second.jobs);
+	jstat_cache.clear();
+}
+
+/**
+ * @brief	select-status all jobs of a queue and start a new cache entry for it
+ *
+ * @param[in]	pbs_sd	-	connection to pbs_server
+ * @param[in]	opl	-	selection criteria for the queue's jobs
+ * @param[in]	attrib	-	attributes to query, must include ATTR_chgseq
+ * @param[in]	queue_name	-	name of the queue
+ *
+ * @return	struct batch_status *
+ * @retval	status of the queue's jobs, owned by the cache
+ * @retval	NULL	: no jobs or error
+ */
+static struct batch_status *
+query_jobs_full(int pbs_sd, struct attropl *opl, struct attrl *attrib, const std::string& queue_name)
+{
+	struct batch_status *jobs;
+
+	if ((jobs = send_selstat(pbs_sd, opl, attrib, const_cast<char *>("S"))) == NULL)
+		return NULL;
+
+	job_stat_cache &qc = jstat_cache[queue_name];
+	qc.jobs = jobs;
+	qc.max_chgseq = 0;
+	qc.query_time = time(NULL);
+	for (struct batch_status *bs = jobs; bs != NULL; bs = bs->next) {
+		long seq = get_bs_chgseq(bs);
+		if (seq > qc.max_chgseq)
+			qc.max_chgseq = seq;
+	}
+
+	return jobs;
+}
+
+/**
+ * @brief	select-status the jobs of a queue, only transferring the jobs
+ *		which changed since the previous call for the same queue.
+ *
+ * @par
+ *		The server is first asked for the chgseq of every job in the queue,
+ *		which gives the current membership and order.  The full status of
+ *		jobs stamped after the highest chgseq we hold is then requested and
+ *		merged with the cached replies of the unchanged jobs.  If the two
+ *		queries and the cache do not agree, all jobs are queried again.
+ *
+ * @param[in]	pbs_sd	-	connection to pbs_server
+ * @param[in]	opl	-	selection criteria for the queue's jobs
+ * @param[in]	attrib	-	attributes to query, must include ATTR_chgseq
+ * @param[in]	queue_name	-	name of the queue
+ *
+ * @return	struct batch_status *
+ * @retval	status of the queue's jobs, owned by the cache: do not free
+ * @retval	NULL	: no jobs or error (pbs_errno is set on error)
+ */
+static struct batch_status *
+query_jobs_incr(int pbs_sd, struct attropl *opl, struct attrl *attrib, const std::string& queue_name)
+{
+	static struct attrl seq_attr = { NULL, const_cast<char *>(ATTR_chgseq), NULL, const_cast<char *>(""), SET };
+	char seqbuf[32];
+	struct attropl seq_opl = { NULL, const_cast<char *>(ATTR_chgseq), NULL, seqbuf, GT };
+	struct attropl q_opl = *opl;
+	struct batch_status *ids;
+	struct batch_status *changed;
+	struct batch_status *bs;
+	struct batch_status *head = NULL;
+	struct batch_status **tail = &head;
+	std::unordered_map<std::string, struct batch_status *> changed_map;
+	std::unordered_map<std::string, struct batch_status *> cached_map;
+	int nchanged = 0;
+	bool mismatch = false;
+	time_t now = time(NULL);
+	time_t elapsed;
+
+	auto qc = jstat_cache.find(queue_name);
+	if (qc == jstat_cache.end())
+		return query_jobs_full(pbs_sd, opl, attrib, queue_name);
+	elapsed = now - qc->second.query_time;
+
+	if ((ids = send_selstat(pbs_sd, opl, &seq_attr, const_cast<char *>("S"))) == NULL) {
+		pbs_statfree(qc->second.jobs);
+		jstat_cache.erase(qc);
+		return NULL;
+	}
+
+	snprintf(seqbuf, sizeof(seqbuf), "%ld", qc->second.max_chgseq);
+	q_opl.next = &seq_opl;
+	changed = send_selstat(pbs_sd, &q_opl, attrib, const_cast<char *>("S"));
+	if (changed == NULL && pbs_errno > 0) {
+		pbs_statfree(ids);
+		pbs_statfree(qc->second.jobs);
+		jstat_cache.erase(qc);
+		return NULL;
+	}
+
+	for (bs = changed; bs != NULL; bs = bs->next)
+		changed_map[bs->name] = bs;
+	for (bs = qc->second.jobs; bs != NULL; bs = bs->next)
+		cached_map[bs->name] = bs;
+
+	/* rebuild the list in the server's order from the changed and cached replies */
+	for (bs = ids; bs != NULL; bs = bs->next) {
+		auto c = changed_map.find(bs->name);
+		if (c != changed_map.end()) {
+			*tail = c->second;
+			changed_map.erase(c);
+			nchanged++;
+		} else {
+			auto o = cached_map.find(bs->name);
+			if (o == cached_map.end() || get_bs_chgseq(o->second) != get_bs_chgseq(bs)) {
+				mismatch = true;
+				break;
+			}
+			*tail = o->second;
+			cached_map.erase(o);
+			if (elapsed > 0)
+				age_eligible_time(*tail, elapsed);
+		}
+		tail = &(*tail)->next;
+	}
+	*tail = NULL;
+	pbs_statfree(ids);
+
+	/* free the replies which were not taken into the new list */
+	for (auto &c : changed_map) {
+		c.second->next = NULL;
+		pbs_statfree(c.second);
+	}
+	for (auto &o : cached_map) {
+		o.second->next = NULL;
+		pbs_statfree(o.second);
+	}
+
+	if (mismatch) {
+		log_event(PBSEVENT_DEBUG2, PBS_EVENTCLASS_QUEUE, LOG_DEBUG, queue_name.c_str(),
+			"Job status cache out of date, querying all jobs");
+		pbs_statfree(head);
+		jstat_cache.erase(qc);
+		return query_jobs_full(pbs_sd, opl, attrib, queue_name);
+	}
+
+	qc->second.jobs = head;
+	qc->second.query_time = now;
+	for (bs = head; bs != NULL; bs = bs->next) {
+		long seq = get_bs_chgseq(bs);
+		if (seq > qc->second.max_chgseq)
+			qc->second.max_chgseq = seq;
+	}
+	log_eventf(PBSEVENT_DEBUG3, PBS_EVENTCLASS_QUEUE, LOG_DEBUG, queue_name.c_str(),
+		"Queried %d changed jobs incrementally", nchanged);
+
+	return head;
+}
+
 /**
  * @brief
  * 		create an array of jobs in a specified queue
@@ -904,10 +1143,14 @@ query_jobs(status *policy, int pbs_sd, queue_info *qinfo, resource_resv **pjobs,
 	static struct attropl opl2[2] = { { &opl2[1], const_cast<char *>(ATTR_state), NULL, const_cast<char *>("Q"), EQ},
 		{ NULL, const_cast<char *>(ATTR_array), NULL, const_cast<char *>("True"), NE} };
 	static struct attrl *attrib = NULL;
+	static struct attrl seq_attrib = { NULL, const_cast<char *>(ATTR_chgseq), NULL, const_cast<char *>(""), SET };
 
 	/* linked list of jobs returned from pbs_selstat() */
 	struct batch_status *jobs;
 
+	/* jobs to free when done, NULL if they are kept in the job status cache */
+	struct batch_status *free_jobs;
+
 	/* current job in jobs linked list */
 	struct batch_status *cur_job;
 
@@ -924,7 +1167,6 @@ query_jobs(status *policy, int pbs_sd, queue_info *qinfo, resource_resv **pjobs,
 	int jidx;
 	th_data_query_jinfo *tdata = NULL;
 	th_task_info *task = NULL;
-	resource_resv ***jinfo_arrs_tasks;
 	int tid;
 
 	if (policy == NULL || qinfo == NULL || queue_name.empty())
@@ -987,7 +1229,17 @@ query_jobs(status *policy, int pbs_sd, queue_info *qinfo, resource_resv **pjobs,
 	}
 
 	/* get jobs from PBS server */
-	if ((jobs = send_selstat(pbs_sd, &opl, attrib, const_cast<char *>("S"))) == NULL) {
+	if (conf.incr_job_query && !qinfo->is_peer_queue && get_num_servers() == 1) {
+		seq_attrib.next = attrib;
+		jobs = query_jobs_incr(pbs_sd, &opl, &seq_attrib, queue_name);
+		free_jobs = NULL;
+	} else {
+		if (!jstat_cache.empty())
+			free_job_stat_cache();
+		jobs = send_selstat(pbs_sd, &opl, attrib, const_cast<char *>("S"));
+		free_jobs = jobs;
+	}
+	if (jobs == NULL) {
 		if (pbs_errno > 0) {
 			const char *errmsg = pbs_geterrmsg(pbs_sd);
 			if (errmsg == NULL)
@@ -1016,7 +1268,7 @@ query_jobs(status *policy, int pbs_sd, queue_info *qinfo, resource_resv **pjobs,
 
 	if (resresv_arr == NULL) {
 		log_err(errno, __func__, MEM_ERR_MSG);
-		pbs_statfree(jobs);
+		pbs_statfree(free_jobs);
 		return NULL;
 	}
 	resresv_arr[num_prev_jobs] = NULL;
@@ -1027,14 +1279,14 @@ query_jobs(status *policy, int pbs_sd, queue_info *qinfo, resource_resv **pjobs,
 		tdata = alloc_tdata_jquery(policy, pbs_sd, jobs, qinfo, 0, num_new_jobs - 1);
 		if (tdata == NULL) {
 			free_resource_resv_array(resresv_arr);
-			pbs_statfree(jobs);
+			pbs_statfree(free_jobs);
 			return NULL;
 		}
 		query_jobs_chunk(tdata);
 
 		if (tdata->error || tdata->oarr == NULL) {
 			free_resource_resv_array(resresv_arr);
-			pbs_statfree(jobs);
+			pbs_statfree(free_jobs);
 			free(tdata->oarr);
 			free(tdata);
 			return NULL;
@@ -1048,14 +1300,11 @@ query_jobs(status *policy, int pbs_sd, queue_info *qinfo, resource_resv **pjobs,
 		free(tdata);
 		resresv_arr[jidx] = NULL;
 	} else {
-		int chunk_size = num_new_jobs / num_threads;
+		int chunk_size = mt_chunk_size(num_new_jobs);
 		int th_err = 0;
-		int num_tasks = 0;
+		std::vector<th_task_info *> tasks;
 
-		chunk_size = (chunk_size > MT_CHUNK_SIZE_MIN) ? chunk_size : MT_CHUNK_SIZE_MIN;
-		chunk_size = (chunk_size < MT_CHUNK_SIZE_MAX) ? chunk_size : MT_CHUNK_SIZE_MAX;
-		for (int j = 0; num_new_jobs > 0;
-				num_tasks++, j += chunk_size, num_new_jobs -= chunk_size) {
+		for (int j = 0; num_new_jobs > 0; j += chunk_size, num_new_jobs -= chunk_size) {
 			tdata = alloc_tdata_jquery(policy, pbs_sd, jobs, qinfo, j, j + chunk_size - 1);
 			if (tdata == NULL) {
 				th_err = 1;
@@ -1068,58 +1317,38 @@ query_jobs(status *policy, int pbs_sd, queue_info *qinfo, resource_resv **pjobs,
 				th_err = 1;
 				break;
 			}
-			task->task_id = num_tasks;
+			task->task_id = tasks.size();
 			task->task_type = TS_QUERY_JOB_INFO;
 			task->thread_data = (void*) tdata;
 
-			pthread_mutex_lock(&work_lock);
-			ds_enqueue(work_queue, (void*) task);
-			pthread_cond_signal(&work_cond);
-			pthread_mutex_unlock(&work_lock);
-		}
-		jinfo_arrs_tasks = static_cast<resource_resv ***>(malloc(num_tasks * sizeof(resource_resv**)));
-		if (jinfo_arrs_tasks == NULL) {
-			log_err(errno, __func__, MEM_ERR_MSG);
-			th_err = 1;
+			tasks.push_back(task);
 		}
-		/* Get results from worker threads */
-		for (int i = 0; i < num_tasks;) {
-			pthread_mutex_lock(&result_lock);
-			while (ds_queue_is_empty(result_queue))
-				pthread_cond_wait(&result_cond, &result_lock);
-			while (!ds_queue_is_empty(result_queue)) {
-				task = static_cast<th_task_info *>(ds_dequeue(result_queue));
-				tdata = static_cast<th_data_query_jinfo *>(task->thread_data);
-				if (tdata->error)
-					th_err = 1;
-				jinfo_arrs_tasks[task->task_id] = tdata->oarr;
-				free(tdata);
-				free(task);
-				i++;
+
+		execute_tasks(tasks);
+
+		/* Assemble job info objects from the tasks into the resresv_arr in task order */
+		jidx = num_prev_jobs;
+		for (auto t : tasks) {
+			tdata = static_cast<th_data_query_jinfo *>(t->thread_data);
+			if (tdata->error)
+				th_err = 1;
+			if (tdata->oarr != NULL) {
+				for (int j = 0; tdata->oarr[j] != NULL; j++)
+					resresv_arr[jidx++] = tdata->oarr[j];
+				free(tdata->oarr);
 			}
-			pthread_mutex_unlock(&result_lock);
+			free(tdata);
+			free(t);
 		}
+		resresv_arr[jidx] = NULL;
 		if (th_err) {
-			pbs_statfree(jobs);
+			pbs_statfree(free_jobs);
 			free_resource_resv_array(resresv_arr);
-			free(jinfo_arrs_tasks);
 			return NULL;
 		}
-		/* Assemble job info objects from various threads into the resresv_arr */
-		jidx = num_prev_jobs;
-		for (int i = 0; i < num_tasks; i++) {
-			if (jinfo_arrs_tasks[i] != NULL) {
-				for (int j = 0; jinfo_arrs_tasks[i][j] != NULL; j++) {
-					resresv_arr[jidx++] = jinfo_arrs_tasks[i][j];
-				}
-				free(jinfo_arrs_tasks[i]);
-			}
-		}
-		resresv_arr[jidx] = NULL;
-		free(jinfo_arrs_tasks);
 	}
 
-	pbs_statfree(jobs);
+	pbs_statfree(free_jobs);
 
 	return resresv_arr;
 }
@@ -1280,7 +1509,7 @@ query_job(struct batch_status *job, server_info *sinfo, schd_error *err)
 			resresv->job->schedsel = string_dup(attrp->value);
 #endif /* localmod 031 */
 
-			resresv->select = parse_selspec(attrp->value);
+			resresv->select.reset(parse_selspec(attrp->value));
 #ifdef NAS /* localmod 031 */
 		}
 #endif /* localmod 031 */
@@ -1383,7 +1612,7 @@ query_job(struct batch_status *job, server_info *sinfo, schd_error *err)
 				resresv->job->est_start_time =
 					(time_t) res_to_num(attrp->value, NULL);
 			}
-			else if (!strcmp(attrp->resource, "execvnode"))
+			else if (!strcmp(attrp->resource, "exec_vnode"))
 				resresv->job->est_execvnode = string_dup(attrp->value);
 		}
 		else if (!strcmp(attrp->name, ATTR_c)) { /* checkpoint allowed? */
@@ -1771,17 +2000,17 @@ update_job_attr(int pbs_sd, resource_resv *resresv, const char *attr_name,
 
 /**
  * @brief
- * 		send delayed job attribute updates for job using send_attr_updates().
+ * 		send delayed job attribute updates for job using queue_attr_updates().
  *
  * @par
  * 		The main reason to use this function over a direct send_attr_update()
- *      call is so that the job's attr_updates list gets free'd and NULL'd.
+ *      call is so that the job's attr_updates list gets handed over and NULL'd.
  *      We don't want to send the attr updates multiple times
  *
  * @param[in]	pbs_sd	-	server connection descriptor
  * @param[in]	job	-	job to send attributes to
  *
- * @return	int(ret val from send_attr_updates)
+ * @return	int(ret val from queue_attr_updates)
  * @retval	1	- success
  * @retval	0	- failure to update
  */
@@ -1805,9 +2034,9 @@ int send_job_updates(int pbs_sd, resource_resv *job)
 			return 0;
 	}
 
-	rc = send_attr_updates(pbs_sd, job, job->job->attr_updates);
+	/* sent with the updates of other jobs, see flush_attr_updates() */
+	rc = queue_attr_updates(pbs_sd, job, job->job->attr_updates);
 
-	free_attrl_list(job->job->attr_updates);
 	job->job->attr_updates = NULL;
 	return rc;
 }
@@ -2451,9 +2680,9 @@ resresv_set_which_selspec(resource_resv *resresv)
 		return NULL;
 
 	if (resresv->job != NULL && !resresv->job->is_running && resresv->execselect != NULL)
-		return resresv->execselect;
+		return resresv->execselect.get();
 
-	return resresv->select;
+	return resresv->select.get();
 }
 
 /**
@@ -4172,10 +4401,887 @@ queue_subjob(resource_resv *array, server_info *sinfo,
 	return rresv;
 }
 
+/*
+ * Native formula evaluation
+ *
+ * A formula is compiled once per cycle into a postfix program over doubles.
+ * Only the arithmetic subset of Python which can be matched exactly is
+ * accepted: numeric literals, the formula variables, + - * / // % **, unary
+ * + and -, parentheses and a handful of math functions.  Anything else is
+ * left to the embedded interpreter.  At evaluation time, anything Python
+ * would raise an exception for (division by zero, domain errors, overflow)
+ * or compute differently (integers beyond a double's precision) makes the
+ * job fall back to the interpreter as well.
+ */
+
+/* integers up to this magnitude are exact in a double */
+#define FORMULA_INT_MAX 9007199254740992.0
+
+/* deepest value stack a native formula may need */
+#define FORMULA_STACK_MAX 64
+
+/* fewest jobs worth evaluating on the thread pool */
+#define FORMULA_CHUNK_MIN 256
+
+enum formula_op {
+	FOP_CONST,
+	FOP_RES,
+	FOP_VAR,
+	FOP_NEG,
+	FOP_ADD,
+	FOP_SUB,
+	FOP_MUL,
+	FOP_DIV,
+	FOP_FLOORDIV,
+	FOP_MOD,
+	FOP_POW,
+	FOP_CALL
+};
+
+enum formula_var {
+	FVAR_ELIGIBLE_TIME,
+	FVAR_QUEUE_PRIO,
+	FVAR_JOB_PRIO,
+	FVAR_FSPERC,
+	FVAR_TREE_USAGE,
+	FVAR_FSFACTOR,
+	FVAR_ACCRUE_TYPE
+};
+
+enum formula_func {
+	FFN_SQRT,
+	FFN_EXP,
+	FFN_LOG,
+	FFN_LOG10,
+	FFN_LOG2,
+	FFN_POW,
+	FFN_FABS,
+	FFN_CEIL,
+	FFN_FLOOR,
+	FFN_TRUNC,
+	FFN_ABS,
+	FFN_MIN,
+	FFN_MAX,
+	FFN_INT,
+	FFN_FLOAT,
+	FFN_ROUND
+};
+
+struct formula_instr {
+	formula_op op;
+	int arg;		/* formula_var, formula_func or argument count */
+	double val;		/* FOP_CONST */
+	bool is_int;		/* FOP_CONST */
+	resdef *def;		/* FOP_RES */
+};
+
+struct formula_prog {
+	std::vector<formula_instr> code;
+	int max_depth;		/* deepest the value stack gets */
+};
+
+/* value on the evaluation stack, Python int or float */
+struct formula_val {
+	double v;
+	bool is_int;
+};
+
+/*
+ * names visible to the formula ahead of its variables: the names in
+ * Python's __main__, where fifo.cpp imports math, and the keywords.
+ * Filled in by load_formula_shadowed() when a formula is compiled.
+ */
+static std::unordered_set<std::string> formula_shadowed;
+
+/* names formula_evaluate() defines in __main__ once it has run */
+static const char *formula_eval_names[] = {
+	"_err", "ex", "globals_dict", "_FORMANS_", "_PBS_PYTHON_EXCEPTIONSTR_", NULL
+};
+
+/* Parser state for compile_formula() */
+struct formula_parser {
+	const char *p;
+	formula_prog *prog;
+	int depth;
+};
+
+static bool parse_formula_expr(formula_parser *fp);
+
+/**
+ * @brief	skip blanks in the formula
+ *
+ * @param[in,out]	fp - parser state
+ *
+ * @return	the next character
+ */
+static char
+formula_peek(formula_parser *fp)
+{
+	while (*fp->p == ' ' || *fp->p == '\t')
+		fp->p++;
+	return *fp->p;
+}
+
+/**
+ * @brief	append an instruction to a formula program and track the stack depth
+ *
+ * @param[in,out]	fp - parser state
+ * @param[in]	ins - the instruction
+ * @param[in]	pushed - net change of the stack depth
+ *
+ * @return	void
+ */
+static void
+formula_emit(formula_parser *fp, const formula_instr& ins, int pushed)
+{
+	fp->prog->code.push_back(ins);
+	fp->depth += pushed;
+	if (fp->depth > fp->prog->max_depth)
+		fp->prog->max_depth = fp->depth;
+}
+
+/**
+ * @brief	compile a name used as a value
+ *
+ * @param[in,out]	fp - parser state
+ * @param[in]	name - the name
+ *
+ * @return	bool
+ * @retval	true - compiled
+ * @retval	false - not something the native evaluator handles
+ */
+static bool
+formula_name(formula_parser *fp, const std::string& name)
+{
+	static const std::unordered_map<std::string, formula_var> vars = {
+		{FORMULA_ELIGIBLE_TIME, FVAR_ELIGIBLE_TIME},
+		{FORMULA_QUEUE_PRIO, FVAR_QUEUE_PRIO},
+		{FORMULA_JOB_PRIO, FVAR_JOB_PRIO},
+		{FORMULA_FSPERC, FVAR_FSPERC},
+		{FORMULA_FSPERC_DEP, FVAR_FSPERC},
+		{FORMULA_TREE_USAGE, FVAR_TREE_USAGE},
+		{FORMULA_FSFACTOR, FVAR_FSFACTOR},
+		{FORMULA_ACCRUE_TYPE, FVAR_ACCRUE_TYPE}
+	};
+	formula_instr ins = {FOP_CONST, 0, 0, false, NULL};
+
+	/* math constants win over the formula variables */
+	if (name == "pi" || name == "e" || name == "tau") {
+		ins.val = name == "pi" ? M_PI : name == "e" ? M_E : 2 * M_PI;
+		formula_emit(fp, ins, 1);
+		return true;
+	}
+	if (formula_shadowed.find(name) != formula_shadowed.end())
+		return false;
+
+	auto v = vars.find(name);
+	if (v != vars.end()) {
+		ins.op = FOP_VAR;
+		ins.arg = v->second;
+		formula_emit(fp, ins, 1);
+		return true;
+	}
+
+	auto r = allres.find(name);
+	if (r == allres.end() || consres.find(r->second) == consres.end())
+		return false;
+	ins.op = FOP_RES;
+	ins.def = r->second;
+	formula_emit(fp, ins, 1);
+	return true;
+}
+
+/**
+ * @brief	compile a function call, the name has been consumed
+ *
+ * @param[in,out]	fp - parser state
+ * @param[in]	name - the function name
+ *
+ * @return	bool
+ * @retval	true - compiled
+ * @retval	false - not something the native evaluator handles
+ */
+static bool
+formula_call(formula_parser *fp, const std::string& name)
+{
+	/* name, function, least and most arguments, Python builtin */
+	static const struct {
+		const char *name;
+		formula_func fn;
+		int min_args;
+		int max_args;
+		bool builtin;
+	} funcs[] = {
+		{"sqrt", FFN_SQRT, 1, 1, false},
+		{"exp", FFN_EXP, 1, 1, false},
+		{"log", FFN_LOG, 1, 2, false},
+		{"log10", FFN_LOG10, 1, 1, false},
+		{"log2", FFN_LOG2, 1, 1, false},
+		{"pow", FFN_POW, 2, 2, false},
+		{"fabs", FFN_FABS, 1, 1, false},
+		{"ceil", FFN_CEIL, 1, 1, false},
+		{"floor", FFN_FLOOR, 1, 1, false},
+		{"trunc", FFN_TRUNC, 1, 1, false},
+		{"abs", FFN_ABS, 1, 1, true},
+		{"min", FFN_MIN, 2, INT_MAX, true},
+		{"max", FFN_MAX, 2, INT_MAX, true},
+		{"int", FFN_INT, 1, 1, true},
+		{"float", FFN_FLOAT, 1, 1, true},
+		{"round", FFN_ROUND, 1, 1, true}
+	};
+	formula_instr ins = {FOP_CALL, 0, 0, false, NULL};
+	int nargs = 0;
+	size_t i;
+
+	for (i = 0; i < sizeof(funcs) / sizeof(funcs[0]); i++)
+		if (name == funcs[i].name)
+			break;
+	if (i == sizeof(funcs) / sizeof(funcs[0]))
+		return false;
+
+	/* builtins are found after the formula variables */
+	if (funcs[i].builtin) {
+		auto r = allres.find(name);
+		if (r != allres.end() && consres.find(r->second) != consres.end())
+			return false;
+	}
+
+	fp->p++;	/* '(' */
+	if (formula_peek(fp) != ')') {
+		while (1) {
+			if (!parse_formula_expr(fp))
+				return false;
+			nargs++;
+			if (formula_peek(fp) != ',')
+				break;
+			fp->p++;
+		}
+	}
+	if (formula_peek(fp) != ')')
+		return false;
+	fp->p++;
+
+	if (nargs < funcs[i].min_args || nargs > funcs[i].max_args)
+		return false;
+
+	ins.arg = funcs[i].fn;
+	ins.val = nargs;
+	formula_emit(fp, ins, 1 - nargs);
+	return true;
+}
+
+/**
+ * @brief	compile a primary: number, name, call or parenthesized expression
+ *
+ * @param[in,out]	fp - parser state
+ *
+ * @return	bool
+ * @retval	true - compiled
+ * @retval	false - not something the native evaluator handles
+ */
+static bool
+parse_formula_primary(formula_parser *fp)
+{
+	formula_instr ins = {FOP_CONST, 0, 0, false, NULL};
+	char c = formula_peek(fp);
+	const char *s = fp->p;
+
+	if (c == '(') {
+		fp->p++;
+		if (!parse_formula_expr(fp) || formula_peek(fp) != ')')
+			return false;
+		fp->p++;
+		return true;
+	}
+
+	if (isdigit(static_cast<unsigned char>(c)) || c == '.') {
+		const char *digits = s;
+		bool is_int = true;
+		char *end;
+
+		while (isdigit(static_cast<unsigned char>(*fp->p)))
+			fp->p++;
+		if (*fp->p == '.') {
+			is_int = false;
+			fp->p++;
+			while (isdigit(static_cast<unsigned char>(*fp->p)))
+				fp->p++;
+		}
+		if (fp->p == digits || (fp->p == digits + 1 && *digits == '.'))
+			return false;
+		if (*fp->p == 'e' || *fp->p == 'E') {
+			is_int = false;
+			fp->p++;
+			if (*fp->p == '+' || *fp->p == '-')
+				fp->p++;
+			if (!isdigit(static_cast<unsigned char>(*fp->p)))
+				return false;
+			while (isdigit(static_cast<unsigned char>(*fp->p)))
+				fp->p++;
+		}
+		/* suffixes, underscores and leading zeros are Python's business */
+		if (isalnum(static_cast<unsigned char>(*fp->p)) || *fp->p == '_' || *fp->p == '.')
+			return false;
+		if (is_int && *s == '0' && fp->p - s > 1)
+			return false;
+
+		ins.val = strtod(s, &end);
+		if (end != fp->p)
+			return false;
+		ins.is_int = is_int;
+		if (is_int && ins.val > FORMULA_INT_MAX)
+			return false;
+		formula_emit(fp, ins, 1);
+		return true;
+	}
+
+	if (isalpha(static_cast<unsigned char>(c)) || c == '_') {
+		while (isalnum(static_cast<unsigned char>(*fp->p)) || *fp->p == '_')
+			fp->p++;
+		std::string name(s, fp->p - s);
+
+		if (*fp->p == '.')
+			return false;
+		if (formula_peek(fp) == '(')
+			return formula_call(fp, name);
+		return formula_name(fp, name);
+	}
+
+	return false;
+}
+
+/**
+ * @brief	compile a unary expression: [+-]* primary [** unary]
+ *
+ * @param[in,out]	fp - parser state
+ *
+ * @return	bool
+ * @retval	true - compiled
+ * @retval	false - not something the native evaluator handles
+ */
+static bool
+parse_formula_unary(formula_parser *fp)
+{
+	formula_instr ins = {FOP_NEG, 0, 0, false, NULL};
+	char c = formula_peek(fp);
+
+	if (c == '-' || c == '+') {
+		fp->p++;
+		if (!parse_formula_unary(fp))
+			return false;
+		if (c == '-')
+			formula_emit(fp, ins, 0);
+		return true;
+	}
+
+	if (!parse_formula_primary(fp))
+		return false;
+
+	if (formula_peek(fp) == '*' && fp->p[1] == '*') {
+		fp->p += 2;
+		if (!parse_formula_unary(fp))
+			return false;
+		ins.op = FOP_POW;
+		formula_emit(fp, ins, -1);
+	}
+	return true;
+}
+
+/**
+ * @brief	compile a term: unary [(* / // %) unary]*
+ *
+ * @param[in,out]	fp - parser state
+ *
+ * @return	bool
+ * @retval	true - compiled
+ * @retval	false - not something the native evaluator handles
+ */
+static bool
+parse_formula_term(formula_parser *fp)
+{
+	formula_instr ins = {FOP_MUL, 0, 0, false, NULL};
+
+	if (!parse_formula_unary(fp))
+		return false;
+
+	while (1) {
+		char c = formula_peek(fp);
+
+		if (c == '*' && fp->p[1] != '*') {
+			ins.op = FOP_MUL;
+			fp->p++;
+		} else if (c == '/' && fp->p[1] == '/') {
+			ins.op = FOP_FLOORDIV;
+			fp->p += 2;
+		} else if (c == '/') {
+			ins.op = FOP_DIV;
+			fp->p++;
+		} else if (c == '%') {
+			ins.op = FOP_MOD;
+			fp->p++;
+		} else
+			return true;
+
+		/* augmented assignment and the like */
+		if (*fp->p == '=')
+			return false;
+		if (!parse_formula_unary(fp))
+			return false;
+		formula_emit(fp, ins, -1);
+	}
+}
+
+/**
+ * @brief	compile an expression: term [(+ -) term]*
+ *
+ * @param[in,out]	fp - parser state
+ *
+ * @return	bool
+ * @retval	true - compiled
+ * @retval	false - not something the native evaluator handles
+ */
+static bool
+parse_formula_expr(formula_parser *fp)
+{
+	formula_instr ins = {FOP_ADD, 0, 0, false, NULL};
+
+	if (!parse_formula_term(fp))
+		return false;
+
+	while (1) {
+		char c = formula_peek(fp);
+
+		if (c == '+')
+			ins.op = FOP_ADD;
+		else if (c == '-')
+			ins.op = FOP_SUB;
+		else
+			return true;
+		fp->p++;
+		if (*fp->p == '=')
+			return false;
+		if (!parse_formula_term(fp))
+			return false;
+		formula_emit(fp, ins, -1);
+	}
+}
+
+/**
+ * @brief	collect the names Python would resolve ahead of the formula
+ *		variables, so that the native program never disagrees with it
+ *
+ * @return	void
+ */
+static void
+load_formula_shadowed(void)
+{
+	formula_shadowed.clear();
+	for (int i = 0; formula_eval_names[i] != NULL; i++)
+		formula_shadowed.insert(formula_eval_names[i]);
+#ifdef PYTHON
+	PyObject *module;
+	PyObject *dict;
+	PyObject *key;
+	PyObject *kwlist;
+	Py_ssize_t pos = 0;
+	const char *str;
+
+	module = PyImport_AddModule("__main__");
+	dict = PyModule_GetDict(module);
+	while (dict != NULL && PyDict_Next(dict, &pos, &key, NULL)) {
+		if ((str = PyUnicode_AsUTF8(key)) != NULL)
+			formula_shadowed.insert(str);
+	}
+
+	if ((module = PyImport_ImportModule("keyword")) != NULL) {
+		if ((kwlist = PyObject_GetAttrString(module, "kwlist")) != NULL) {
+			for (Py_ssize_t i = 0; i < PySequence_Size(kwlist); i++) {
+				if ((key = PySequence_GetItem(kwlist, i)) == NULL)
+					continue;
+				if ((str = PyUnicode_AsUTF8(key)) != NULL)
+					formula_shadowed.insert(str);
+				Py_DECREF(key);
+			}
+			Py_DECREF(kwlist);
+		}
+		Py_DECREF(module);
+	}
+	PyErr_Clear();
+#endif
+}
+
+/**
+ * @brief	compile a formula into a native program
+ *
+ * @param[in]	formula - the formula
+ *
+ * @return	formula_prog *
+ * @retval	the program
+ * @retval	NULL - the formula needs the embedded interpreter
+ */
+static formula_prog *
+compile_formula(const char *formula)
+{
+	formula_parser fp;
+
+	load_formula_shadowed();
+
+	fp.p = formula;
+	fp.prog = new formula_prog();
+	fp.prog->max_depth = 0;
+	fp.depth = 0;
+
+	if (!parse_formula_expr(&fp) || formula_peek(&fp) != '\0' || fp.depth != 1 ||
+		fp.prog->max_depth > FORMULA_STACK_MAX) {
+		delete fp.prog;
+		return NULL;
+	}
+
+	return fp.prog;
+}
+
+/* compiled formulas, keyed by the formula text. NULL if not compilable */
+static std::unordered_map<std::string, std::unique_ptr<formula_prog>> formula_cache;
+
 /**
  * @brief
- * 		evaluate a math formula for jobs based on their resources
- *		NOTE: currently done through embedded python interpreter
+ * 		find or compile the native program for a formula
+ *
+ * @param[in]	formula	-	the formula
+ *
+ * @return	formula_prog *
+ * @retval	the program
+ * @retval	NULL	: the formula needs the embedded interpreter
+ *
+ * @par MT-Safe:	no
+ */
+static formula_prog *
+get_formula_prog(const char *formula)
+{
+	auto f = formula_cache.find(formula);
+	if (f != formula_cache.end())
+		return f->second.get();
+
+	auto prog = compile_formula(formula);
+	if (prog == NULL)
+		log_eventf(PBSEVENT_DEBUG2, PBS_EVENTCLASS_SCHED, LOG_DEBUG, __func__,
+			"Formula will be evaluated by Python: %s", formula);
+	formula_cache[formula].reset(prog);
+
+	return prog;
+}
+
+/**
+ * @brief
+ * 		forget the compiled formulas.  They refer to the resource
+ *		definitions, so this has to be called whenever those are replaced.
+ *
+ * @return	void
+ *
+ * @par MT-Safe:	no
+ */
+void
+clear_formula_cache(void)
+{
+	formula_cache.clear();
+}
+
+/**
+ * @brief	the value Python sees for a number the scheduler prints into
+ *		the formula's globals
+ *
+ * @param[in]	fmt - printf format for a single double
+ * @param[in]	digits - precision for fmt
+ * @param[in]	v - the value
+ *
+ * @return	the printed and reparsed value
+ */
+static double
+formula_printed(const char *fmt, int digits, double v)
+{
+	char buf[512];
+
+	snprintf(buf, sizeof(buf), fmt, digits, v);
+	return strtod(buf, NULL);
+}
+
+/**
+ * @brief	Python's float floor division and modulo
+ *
+ * @param[in]	a - dividend
+ * @param[in]	b - divisor, not 0
+ * @param[out]	div - a // b
+ * @param[out]	mod - a % b
+ *
+ * @return	void
+ */
+static void
+formula_divmod(double a, double b, double *div, double *mod)
+{
+	double m = fmod(a, b);
+	double d = (a - m) / b;
+
+	if (m != 0) {
+		if ((b < 0) != (m < 0)) {
+			m += b;
+			d -= 1.0;
+		}
+	} else
+		m = copysign(0.0, b);
+
+	if (d != 0) {
+		double fd = floor(d);
+		if (d - fd > 0.5)
+			fd += 1.0;
+		d = fd;
+	} else
+		d = copysign(0.0, a / b);
+
+	*div = d;
+	*mod = m;
+}
+
+/**
+ * @brief
+ * 		evaluate a compiled formula for a job
+ *
+ * @param[in]	prog	-	the compiled formula
+ * @param[in]	resresv	-	job for special case key words
+ * @param[in]	resreq	-	resources to use when evaluating
+ * @param[out]	ans	-	the answer
+ *
+ * @return	bool
+ * @retval	true	: evaluated
+ * @retval	false	: the job needs the embedded interpreter
+ *
+ * @par MT-Safe:	yes
+ */
+static bool
+formula_evaluate_prog(const formula_prog *prog, resource_resv *resresv, resource_req *resreq, sch_resource_t *ans)
+{
+	formula_val stack[FORMULA_STACK_MAX];
+	int sp = 0;
+	job_info *job = resresv->job;
+
+	for (const auto& ins : prog->code) {
+		formula_val *a;
+		formula_val *b;
+		double div;
+		double mod;
+
+		switch (ins.op) {
+			case FOP_CONST:
+				stack[sp].v = ins.val;
+				stack[sp++].is_int = ins.is_int;
+				continue;
+
+			case FOP_RES: {
+				resource_req *req = find_resource_req(resreq, ins.def);
+				a = &stack[sp++];
+				a->v = 0;
+				a->is_int = true;
+				if (req != NULL) {
+					if (!std::isfinite(req->amount))
+						return false;
+					if (req->amount == trunc(req->amount) && fabs(req->amount) <= FORMULA_INT_MAX)
+						a->v = req->amount;
+					else {
+						int digits = float_digits(req->amount, FLOAT_NUM_DIGITS);
+						a->v = formula_printed("%.*f", digits, req->amount);
+						a->is_int = digits == 0;
+					}
+				}
+				continue;
+			}
+
+			case FOP_VAR:
+				a = &stack[sp++];
+				a->is_int = true;
+				switch (ins.arg) {
+					case FVAR_ELIGIBLE_TIME:
+						a->v = job->eligible_time;
+						break;
+					case FVAR_QUEUE_PRIO:
+						a->v = job->queue->priority;
+						break;
+					case FVAR_JOB_PRIO:
+						a->v = job->priority;
+						break;
+					case FVAR_ACCRUE_TYPE:
+						a->v = job->accrue_type;
+						break;
+					case FVAR_FSPERC:
+						a->v = formula_printed("%.*f", 6, job->ginfo->tree_percentage);
+						a->is_int = false;
+						break;
+					case FVAR_TREE_USAGE:
+						a->v = formula_printed("%.*f", 6, job->ginfo->usage_factor);
+						a->is_int = false;
+						break;
+					case FVAR_FSFACTOR:
+						a->v = formula_printed("%.*f", 6, job->ginfo->tree_percentage == 0 ? 0 :
+							pow(2, -(job->ginfo->usage_factor / job->ginfo->tree_percentage)));
+						a->is_int = false;
+						break;
+				}
+				if (!std::isfinite(a->v))
+					return false;
+				continue;
+
+			case FOP_NEG:
+				stack[sp - 1].v = -stack[sp - 1].v;
+				/* Python ints have no negative zero */
+				if (stack[sp - 1].is_int)
+					stack[sp - 1].v += 0.0;
+				continue;
+
+			case FOP_CALL:
+				break;
+
+			default:
+				sp--;
+				a = &stack[sp - 1];
+				b = &stack[sp];
+				switch (ins.op) {
+					case FOP_ADD:
+						a->v += b->v;
+						break;
+					case FOP_SUB:
+						a->v -= b->v;
+						break;
+					case FOP_MUL:
+						a->v *= b->v;
+						break;
+					case FOP_DIV:
+						if (b->v == 0)
+							return false;
+						a->v /= b->v;
+						a->is_int = false;
+						break;
+					case FOP_FLOORDIV:
+					case FOP_MOD:
+						if (b->v == 0)
+							return false;
+						formula_divmod(a->v, b->v, &div, &mod);
+						a->v = (ins.op == FOP_FLOORDIV) ? div : mod;
+						break;
+					case FOP_POW:
+						/* complex results and ZeroDivisionError */
+						if (a->v < 0 && b->v != trunc(b->v))
+							return false;
+						if (a->v == 0 && b->v < 0)
+							return false;
+						if (b->is_int && b->v < 0)
+							a->is_int = false;
+						a->v = pow(a->v, b->v);
+						break;
+					default:
+						return false;
+				}
+				a->is_int = a->is_int && b->is_int;
+				if (!std::isfinite(a->v) || (a->is_int && fabs(a->v) > FORMULA_INT_MAX))
+					return false;
+				if (a->is_int)
+					a->v += 0.0;
+				continue;
+		}
+
+		/* FOP_CALL */
+		int nargs = static_cast<int>(ins.val);
+		sp -= nargs;
+		a = &stack[sp++];
+		switch (ins.arg) {
+			case FFN_SQRT:
+				if (a->v < 0)
+					return false;
+				a->v = sqrt(a->v);
+				a->is_int = false;
+				break;
+			case FFN_EXP:
+				a->v = exp(a->v);
+				a->is_int = false;
+				break;
+			case FFN_LOG:
+				if (a->v <= 0)
+					return false;
+				a->v = log(a->v);
+				if (nargs == 2) {
+					if (a[1].v <= 0 || a[1].v == 1)
+						return false;
+					a->v /= log(a[1].v);
+				}
+				a->is_int = false;
+				break;
+			case FFN_LOG10:
+				if (a->v <= 0)
+					return false;
+				a->v = log10(a->v);
+				a->is_int = false;
+				break;
+			case FFN_LOG2:
+				if (a->v <= 0)
+					return false;
+				a->v = log2(a->v);
+				a->is_int = false;
+				break;
+			case FFN_POW:
+				if (a->v < 0 && a[1].v != trunc(a[1].v))
+					return false;
+				if (a->v == 0 && a[1].v < 0)
+					return false;
+				a->v = pow(a->v, a[1].v);
+				a->is_int = false;
+				break;
+			case FFN_FABS:
+				a->v = fabs(a->v);
+				a->is_int = false;
+				break;
+			case FFN_CEIL:
+				a->v = ceil(a->v);
+				a->is_int = true;
+				break;
+			case FFN_FLOOR:
+				a->v = floor(a->v);
+				a->is_int = true;
+				break;
+			case FFN_TRUNC:
+			case FFN_INT:
+				a->v = trunc(a->v);
+				a->is_int = true;
+				break;
+			case FFN_ABS:
+				a->v = fabs(a->v);
+				break;
+			case FFN_MIN:
+			case FFN_MAX:
+				for (int i = 1; i < nargs; i++) {
+					if ((ins.arg == FFN_MIN) ? (a[i].v < a->v) : (a[i].v > a->v))
+						*a = a[i];
+				}
+				break;
+			case FFN_FLOAT:
+				a->is_int = false;
+				break;
+			case FFN_ROUND:
+				/* round half to even, as Python does */
+				a->v = nearbyint(a->v);
+				a->is_int = true;
+				break;
+		}
+		if (!std::isfinite(a->v))
+			return false;
+		if (a->is_int)
+			a->v += 0.0;
+	}
+
+	*ans = stack[0].v;
+	return true;
+}
+
+/**
+ * @brief
+ * 		evaluate a math formula for a job through the embedded python
+ *		interpreter
  *
  * @param[in]	formula	-	formula to evaluate
  * @param[in]	resresv	-	job for special case key words
@@ -4186,8 +5292,8 @@ queue_subjob(resource_resv *array, server_info *sinfo,
  */
 
 #ifdef PYTHON
-sch_resource_t
-formula_evaluate(const char *formula, resource_resv *resresv, resource_req *resreq)
+static sch_resource_t
+formula_evaluate_python(const char *formula, resource_resv *resresv, resource_req *resreq)
 {
 	char buf[1024];
 	char *globals;
@@ -4282,6 +5388,13 @@ formula_evaluate(const char *formula, resource_resv *resresv, resource_req *resr
 	if (obj != NULL) {
 		ans = PyFloat_AsDouble(obj);
 		Py_XDECREF(obj);
+		/* e.g. a complex answer or an int too large for a float */
+		if (PyErr_Occurred()) {
+			PyErr_Clear();
+			log_event(PBSEVENT_DEBUG2, PBS_EVENTCLASS_JOB, LOG_DEBUG, resresv->name,
+				"Formula evaluation for job is not a real number.  Zero value will be used");
+			ans = 0;
+		}
 	}
 
 	obj = PyMapping_GetItemString(dict, "_PBS_PYTHON_EXCEPTIONSTR_");
@@ -4301,13 +5414,112 @@ formula_evaluate(const char *formula, resource_resv *resresv, resource_req *resr
 
 	return ans;
 }
-#else
+#endif
+
+/**
+ * @brief
+ * 		evaluate a math formula for jobs based on their resources
+ *		The formula is evaluated natively where possible, otherwise
+ *		through the embedded python interpreter.
+ *
+ * @param[in]	formula	-	formula to evaluate
+ * @param[in]	resresv	-	job for special case key words
+ * @param[in]	resreq	-	resources to use when evaluating
+ *
+ * @return	evaluated formula answer or 0 on exception
+ *
+ */
 sch_resource_t
-formula_evaluate(char *formula, resource_resv *resresv, resource_req *resreq)
+formula_evaluate(const char *formula, resource_resv *resresv, resource_req *resreq)
 {
+	formula_prog *prog;
+	sch_resource_t ans;
+
+	if (formula == NULL || resresv == NULL ||
+		resresv->job == NULL)
+		return 0;
+
+	prog = get_formula_prog(formula);
+	if (prog != NULL && formula_evaluate_prog(prog, resresv, resreq, &ans))
+		return ans;
+
+#ifdef PYTHON
+	return formula_evaluate_python(formula, resresv, resreq);
+#else
 	return 0;
-}
 #endif
+}
+
+/* formula_evaluate_jobs() arguments and results for the thread pool */
+struct formula_jobs {
+	formula_prog *prog;
+	resource_resv **jobs;
+	sch_resource_t *ans;
+	char *done;
+};
+
+/**
+ * @brief	thread pool callback to evaluate a formula natively for a range of jobs
+ *
+ * @param[in,out]	arg - formula_jobs
+ * @param[in]	sidx - first job
+ * @param[in]	eidx - last job
+ *
+ * @return	void
+ */
+static void
+formula_evaluate_jobs_chunk(void *arg, int sidx, int eidx)
+{
+	formula_jobs *fj = static_cast<formula_jobs *>(arg);
+
+	for (int i = sidx; i <= eidx; i++) {
+		resource_resv *resresv = fj->jobs[i];
+
+		if (resresv->job != NULL)
+			fj->done[i] = formula_evaluate_prog(fj->prog, resresv, resresv->resreq, &fj->ans[i]);
+	}
+}
+
+/**
+ * @brief
+ * 		evaluate a math formula on the resources requested by each job
+ *		of an array.  Jobs the native evaluator can handle are done on the
+ *		thread pool, the rest through the embedded python interpreter.
+ *
+ * @param[in]	formula	-	formula to evaluate
+ * @param[in]	jobs	-	the jobs
+ * @param[in]	njobs	-	number of jobs
+ *
+ * @return	std::vector<sch_resource_t>
+ * @retval	the answer for each job, 0 for anything which is not a job
+ *
+ * @par MT-Safe:	no
+ */
+std::vector<sch_resource_t>
+formula_evaluate_jobs(const char *formula, resource_resv **jobs, int njobs)
+{
+	std::vector<sch_resource_t> ans(njobs, 0);
+	std::vector<char> done(njobs, 0);
+	formula_jobs fj;
+
+	if (formula == NULL || jobs == NULL || njobs <= 0)
+		return ans;
+
+	fj.prog = get_formula_prog(formula);
+	if (fj.prog != NULL) {
+		fj.jobs = jobs;
+		fj.ans = ans.data();
+		fj.done = done.data();
+		mt_parallel_for(njobs, FORMULA_CHUNK_MIN, formula_evaluate_jobs_chunk, &fj);
+	}
+
+	for (int i = 0; i < njobs; i++) {
+		if (!done[i] && jobs[i]->job != NULL)
+			ans[i] = formula_evaluate(formula, jobs[i], jobs[i]->resreq);
+	}
+
+	return ans;
+}
 
 /**
  * @brief
@@ -4835,8 +6047,7 @@ void create_res_released(status *policy, resource_resv *pjob)
 		pjob->job->resreq_rel = create_resreq_rel_list(policy, pjob);
 	}
 	selectspec = create_select_from_nspec(pjob->job->resreleased);
-	delete pjob->execselect;
-	pjob->execselect = parse_selspec(selectspec);
+	pjob->execselect.reset(parse_selspec(selectspec));
 	return;
 }
 
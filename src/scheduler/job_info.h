@@ -83,12 +83,18 @@ int
 update_job_attr(int pbs_sd, resource_resv *resresv, const char *attr_name,
 	const char *attr_resc, const char *attr_value, struct attrl *extra, unsigned int flags );
 
-/* send delayed job attribute updates for job using send_attr_updates() */
+/* send delayed job attribute updates for job using queue_attr_updates() */
 int send_job_updates(int pbs_sd, resource_resv *job);
 
 /* send delayed attributes to the server for a job */
 int send_attr_updates(int virtual_fd, resource_resv *resresv, struct attrl *pattr);
 
+/* hold attribute updates for a job to be sent with those of other jobs */
+int queue_attr_updates(int virtual_fd, resource_resv *resresv, struct attrl *pattr);
+
+/* send the attribute updates held by queue_attr_updates() as one request */
+void flush_attr_updates(void);
+
 preempt_job_info *send_preempt_jobs(int virtual_sd, char **preempt_jobs_list);
 
 int send_sigjob(int virtual_sd, resource_resv *resresv, const char *signal, char *extend);
@@ -246,11 +252,21 @@ queue_subjob(resource_resv *array, server_info *sinfo,
 	queue_info *qinfo);
 /*
  *	formula_evaluate - evaluate a math formula for jobs based on their resources
- *		NOTE: currently done through embedded python interpreter
+ *		NOTE: done natively where possible, else through embedded python interpreter
  */
 
 sch_resource_t formula_evaluate(const char *formula, resource_resv *resresv, resource_req *resreq);
 
+/*
+ *	formula_evaluate_jobs - evaluate a math formula for an array of jobs
+ */
+std::vector<sch_resource_t> formula_evaluate_jobs(const char *formula, resource_resv **jobs, int njobs);
+
+/*
+ *	clear_formula_cache - forget the compiled formulas
+ */
+void clear_formula_cache(void);
+
 /*
  *
  *      update_accruetype - Updates accrue_type of job on server.
@@ -37,7 +37,6 @@
  * subject to Altair's trademark licensing policies.
  */
 
-
 #include <pbs_config.h>
 
 #include <stdio.h>
@@ -46,6 +45,9 @@
 #include <pthread.h>
 #include <errno.h>
 #include <signal.h>
+#include <atomic>
+#include <deque>
+#include <vector>
 
 #include "log.h"
 #include "pbs_idx.h"
@@ -55,11 +57,36 @@
 #include "data_types.h"
 #include "globals.h"
 #include "node_info.h"
-#include "queue.h"
 #include "fifo.h"
 #include "resource_resv.h"
 #include "multi_threading.h"
 
+/*
+ * Each worker owns a deque of tasks.  The owner pops from the front while
+ * idle threads (including the main thread while it waits for a batch) steal
+ * from the back of somebody else's deque.  Every deque has its own lock, so
+ * threads only contend when they touch the same deque.
+ */
+struct mt_deque {
+	pthread_mutex_t lock;
+	std::deque<th_task_info *> tasks;
+};
+
+static mt_deque *deques = NULL;
+
+/* number of tasks sitting in the deques, used by idle workers to decide to sleep */
+static std::atomic<int> tasks_queued(0);
+static pthread_mutex_t idle_lock;
+static pthread_cond_t idle_cond;
+
+/* completion latch for the batch currently being run by execute_tasks() */
+static std::atomic<int> tasks_pending(0);
+static pthread_mutex_t latch_lock;
+static pthread_cond_t latch_cond;
+
+/* set while the main thread is helping out with a batch */
+static int main_helping = 0;
+
 /**
  * @brief	create the thread id key & set it for the main thread
  *
@@ -99,26 +126,28 @@ kill_threads(void)
 				"", "Killing worker threads");
 
 	threads_die = 1;
-	pthread_mutex_lock(&work_lock);
-	pthread_cond_broadcast(&work_cond);
-	pthread_mutex_unlock(&work_lock);
+	pthread_mutex_lock(&idle_lock);
+	pthread_cond_broadcast(&idle_cond);
+	pthread_mutex_unlock(&idle_lock);
 
 	/* Wait until all threads to finish */
 	for (i = 0; i < num_threads; i++) {
 		pthread_join(threads[i], NULL);
 	}
-	pthread_mutex_destroy(&work_lock);
-	pthread_cond_destroy(&work_cond);
-	pthread_mutex_destroy(&result_lock);
-	pthread_cond_destroy(&result_cond);
+	for (i = 0; i < num_threads; i++)
+		pthread_mutex_destroy(&deques[i].lock);
+	pthread_mutex_destroy(&idle_lock);
+	pthread_cond_destroy(&idle_cond);
+	pthread_mutex_destroy(&latch_lock);
+	pthread_cond_destroy(&latch_cond);
 	pthread_mutex_destroy(&general_lock);
 	free(threads);
-	free_ds_queue(work_queue);
-	free_ds_queue(result_queue);
+	delete[] deques;
 	threads = NULL;
+	deques = NULL;
 	num_threads = 0;
-	work_queue = NULL;
-	result_queue = NULL;
+	tasks_queued = 0;
+	tasks_pending = 0;
 }
 
 /**
@@ -142,12 +171,12 @@ init_multi_threading(int nthreads)
 		kill_threads();
 
 	threads_die = 0;
-	if (pthread_cond_init(&work_cond, NULL) != 0) {
+	if (pthread_cond_init(&idle_cond, NULL) != 0) {
 		log_event(PBSEVENT_ERROR, PBS_EVENTCLASS_SCHED, LOG_ERR, __func__,
 				"pthread_cond_init failed");
 		return 0;
 	}
-	if (pthread_cond_init(&result_cond, NULL) != 0) {
+	if (pthread_cond_init(&latch_cond, NULL) != 0) {
 		log_event(PBSEVENT_ERROR, PBS_EVENTCLASS_SCHED, LOG_ERR, __func__,
 				"pthread_cond_init failed");
 		return 0;
@@ -159,8 +188,8 @@ init_multi_threading(int nthreads)
 		return 0;
 	}
 
-	pthread_mutex_init(&work_lock, &attr);
-	pthread_mutex_init(&result_lock, &attr);
+	pthread_mutex_init(&idle_lock, NULL);
+	pthread_mutex_init(&latch_lock, NULL);
 	pthread_mutex_init(&general_lock, &attr);
 
 	num_cores = sysconf(_SC_NPROCESSORS_ONLN);
@@ -184,19 +213,10 @@ init_multi_threading(int nthreads)
 		return 0;
 	}
 
-	/* Create task and result queues */
-	work_queue = new_ds_queue();
-	if (work_queue == NULL) {
-		free(threads);
-		return 0;
-	}
-	result_queue = new_ds_queue();
-	if (result_queue == NULL) {
-		free(threads);
-		free_ds_queue(work_queue);
-		work_queue = NULL;
-		return 0;
-	}
+	/* Create the per-thread task deques */
+	deques = new mt_deque[num_threads];
+	for (i = 0; i < num_threads; i++)
+		pthread_mutex_init(&deques[i].lock, NULL);
 
 	pthread_once(&key_once, create_id_key);
 	for (i = 0; i < num_threads; i++) {
@@ -204,12 +224,10 @@ init_multi_threading(int nthreads)
 
 		thid = static_cast<int *>(malloc(sizeof(int)));
 		if (thid == NULL) {
-			free(threads);
-			free_ds_queue(work_queue);
-			free_ds_queue(result_queue);
-			work_queue = NULL;
-			result_queue = NULL;
 			log_err(errno, __func__, MEM_ERR_MSG);
+			threads_die = 1;
+			num_threads = i;
+			kill_threads();
 			return 0;
 		}
 		*thid = i + 1;
@@ -219,6 +237,131 @@ init_multi_threading(int nthreads)
 	return 1;
 }
 
+/**
+ * @brief	run a single task on the calling thread
+ *
+ * @param[in]	work - the task to run
+ * @param[in]	ntid - id of the calling thread, used for logging
+ *
+ * @return void
+ */
+static void
+do_task(th_task_info *work, int ntid)
+{
+	char buf[1024];
+
+	switch (work->task_type) {
+		case TS_IS_ND_ELIGIBLE:
+			snprintf(buf, sizeof(buf), "Thread %d calling check_node_eligibility_chunk()", ntid);
+			log_event(PBSEVENT_DEBUG3, PBS_EVENTCLASS_SCHED, LOG_DEBUG, __func__, buf);
+			check_node_eligibility_chunk(static_cast<th_data_nd_eligible *>(work->thread_data));
+			break;
+		case TS_DUP_ND_INFO:
+			snprintf(buf, sizeof(buf), "Thread %d calling dup_node_info_chunk()", ntid);
+			log_event(PBSEVENT_DEBUG3, PBS_EVENTCLASS_SCHED, LOG_DEBUG, __func__, buf);
+			dup_node_info_chunk(static_cast<th_data_dup_nd_info *>(work->thread_data));
+			break;
+		case TS_QUERY_ND_INFO:
+			snprintf(buf, sizeof(buf), "Thread %d calling query_node_info_chunk()", ntid);
+			log_event(PBSEVENT_DEBUG3, PBS_EVENTCLASS_SCHED, LOG_DEBUG, __func__, buf);
+			query_node_info_chunk(static_cast<th_data_query_ninfo *>(work->thread_data));
+			break;
+		case TS_FREE_ND_INFO:
+			snprintf(buf, sizeof(buf), "Thread %d calling free_node_info_chunk()", ntid);
+			log_event(PBSEVENT_DEBUG3, PBS_EVENTCLASS_SCHED, LOG_DEBUG, __func__, buf);
+			free_node_info_chunk(static_cast<th_data_free_ninfo *>(work->thread_data));
+			break;
+		case TS_DUP_RESRESV:
+			snprintf(buf, sizeof(buf), "Thread %d calling dup_resource_resv_array_chunk()", ntid);
+			log_event(PBSEVENT_DEBUG3, PBS_EVENTCLASS_SCHED, LOG_DEBUG, __func__, buf);
+			dup_resource_resv_array_chunk(static_cast<th_data_dup_resresv *>(work->thread_data));
+			break;
+		case TS_QUERY_JOB_INFO:
+			snprintf(buf, sizeof(buf), "Thread %d calling query_jobs_chunk()", ntid);
+			log_event(PBSEVENT_DEBUG3, PBS_EVENTCLASS_SCHED, LOG_DEBUG, __func__, buf);
+			query_jobs_chunk(static_cast<th_data_query_jinfo *>(work->thread_data));
+			break;
+		case TS_FREE_RESRESV:
+			snprintf(buf, sizeof(buf), "Thread %d calling free_resource_resv_array_chunk()", ntid);
+			log_event(PBSEVENT_DEBUG3, PBS_EVENTCLASS_SCHED, LOG_DEBUG, __func__, buf);
+			free_resource_resv_array_chunk(static_cast<th_data_free_resresv *>(work->thread_data));
+			break;
+		case TS_GENERIC: {
+			th_data_generic *gdata = static_cast<th_data_generic *>(work->thread_data);
+
+			gdata->func(gdata->arg, gdata->sidx, gdata->eidx);
+			break;
+		}
+		default:
+			log_event(PBSEVENT_ERROR, PBS_EVENTCLASS_SCHED, LOG_ERR, __func__,
+					"Invalid task type passed to worker thread");
+	}
+}
+
+/**
+ * @brief	grab the next task for a thread: first from its own deque,
+ *		then by stealing from the back of the other threads' deques
+ *
+ * @param[in]	own - index of the caller's own deque, or -1 if it has none
+ *
+ * @return	th_task_info *
+ * @retval	the task to run
+ * @retval	NULL if all deques are empty
+ */
+static th_task_info *
+get_task(int own)
+{
+	th_task_info *work = NULL;
+	int i;
+
+	if (tasks_queued.load() == 0)
+		return NULL;
+
+	if (own >= 0) {
+		pthread_mutex_lock(&deques[own].lock);
+		if (!deques[own].tasks.empty()) {
+			work = deques[own].tasks.front();
+			deques[own].tasks.pop_front();
+		}
+		pthread_mutex_unlock(&deques[own].lock);
+	}
+
+	/* Nothing of our own left, try to steal some work */
+	for (i = 1; work == NULL && i <= num_threads; i++) {
+		int victim = (own + i) % num_threads;
+
+		if (victim == own)
+			continue;
+		pthread_mutex_lock(&deques[victim].lock);
+		if (!deques[victim].tasks.empty()) {
+			work = deques[victim].tasks.back();
+			deques[victim].tasks.pop_back();
+		}
+		pthread_mutex_unlock(&deques[victim].lock);
+	}
+
+	if (work != NULL)
+		tasks_queued--;
+
+	return work;
+}
+
+/**
+ * @brief	mark a task of the current batch as done and release the
+ *		main thread if it was the last one
+ *
+ * @return void
+ */
+static void
+task_done(void)
+{
+	if (--tasks_pending == 0) {
+		pthread_mutex_lock(&latch_lock);
+		pthread_cond_signal(&latch_cond);
+		pthread_mutex_unlock(&latch_lock);
+	}
+}
+
 /**
  * @brief	Main pthread routine for worker threads
  *
@@ -232,7 +375,6 @@ worker(void *tid)
 	th_task_info *work = NULL;
 	sigset_t set;
 	int ntid;
-	char buf[1024];
 
 	pthread_setspecific(th_id_key, tid);
 	ntid = *(int *)tid;
@@ -248,80 +390,166 @@ worker(void *tid)
 	}
 
 	while (!threads_die) {
-		/* Get the next work task from work queue */
-		pthread_mutex_lock(&work_lock);
-		while (ds_queue_is_empty(work_queue) && !threads_die) {
-			pthread_cond_wait(&work_cond, &work_lock);
-		}
-		work = static_cast<th_task_info *>(ds_dequeue(work_queue));
-		pthread_mutex_unlock(&work_lock);
-
-		/* find out what task we need to do */
-		if (work != NULL) {
-			switch (work->task_type) {
-			case TS_IS_ND_ELIGIBLE:
-				snprintf(buf, sizeof(buf), "Thread %d calling check_node_eligibility_chunk()", ntid);
-				log_event(PBSEVENT_DEBUG3, PBS_EVENTCLASS_SCHED, LOG_DEBUG, __func__, buf);
-				check_node_eligibility_chunk(static_cast<th_data_nd_eligible *>(work->thread_data));
-				break;
-			case TS_DUP_ND_INFO:
-				snprintf(buf, sizeof(buf), "Thread %d calling dup_node_info_chunk()", ntid);
-				log_event(PBSEVENT_DEBUG3, PBS_EVENTCLASS_SCHED, LOG_DEBUG, __func__, buf);
-				dup_node_info_chunk(static_cast<th_data_dup_nd_info *>(work->thread_data));
-				break;
-			case TS_QUERY_ND_INFO:
-				snprintf(buf, sizeof(buf), "Thread %d calling query_node_info_chunk()", ntid);
-				log_event(PBSEVENT_DEBUG3, PBS_EVENTCLASS_SCHED, LOG_DEBUG, __func__, buf);
-				query_node_info_chunk(static_cast<th_data_query_ninfo *>(work->thread_data));
-				break;
-			case TS_FREE_ND_INFO:
-				snprintf(buf, sizeof(buf), "Thread %d calling free_node_info_chunk()", ntid);
-				log_event(PBSEVENT_DEBUG3, PBS_EVENTCLASS_SCHED, LOG_DEBUG, __func__, buf);
-				free_node_info_chunk(static_cast<th_data_free_ninfo *>(work->thread_data));
-				break;
-			case TS_DUP_RESRESV:
-				snprintf(buf, sizeof(buf), "Thread %d calling dup_resource_resv_array_chunk()", ntid);
-				log_event(PBSEVENT_DEBUG3, PBS_EVENTCLASS_SCHED, LOG_DEBUG, __func__, buf);
-				dup_resource_resv_array_chunk(static_cast<th_data_dup_resresv *>(work->thread_data));
-				break;
-			case TS_QUERY_JOB_INFO:
-				snprintf(buf, sizeof(buf), "Thread %d calling query_jobs_chunk()", ntid);
-				log_event(PBSEVENT_DEBUG3, PBS_EVENTCLASS_SCHED, LOG_DEBUG, __func__, buf);
-				query_jobs_chunk(static_cast<th_data_query_jinfo *>(work->thread_data));
-				break;
-			case TS_FREE_RESRESV:
-				snprintf(buf, sizeof(buf), "Thread %d calling free_resource_resv_array_chunk()", ntid);
-				log_event(PBSEVENT_DEBUG3, PBS_EVENTCLASS_SCHED, LOG_DEBUG, __func__, buf);
-				free_resource_resv_array_chunk(static_cast<th_data_free_resresv *>(work->thread_data));
-				break;
-			default:
-				log_event(PBSEVENT_ERROR, PBS_EVENTCLASS_SCHED, LOG_ERR, __func__,
-						"Invalid task type passed to worker thread");
-			}
-
-			/* Post results */
-			pthread_mutex_lock(&result_lock);
-			ds_enqueue(result_queue, (void *) work);
-			pthread_cond_signal(&result_cond);
-			pthread_mutex_unlock(&result_lock);
+		work = get_task(ntid - 1);
+		if (work == NULL) {
+			/* Nothing to do, sleep until more work is queued */
+			pthread_mutex_lock(&idle_lock);
+			while (tasks_queued.load() == 0 && !threads_die)
+				pthread_cond_wait(&idle_cond, &idle_lock);
+			pthread_mutex_unlock(&idle_lock);
+			continue;
 		}
+
+		do_task(work, ntid);
+		task_done();
 	}
 
 	pthread_exit(NULL);
 }
 
 /**
- * @brief	Convenience function to queue up work for worker threads
+ * @brief	work out the chunk size to split an array of items into tasks.
+ *		We aim for a few tasks per thread so work can be stolen from
+ *		threads which are handed the expensive chunks.
+ *
+ * @param[in]	nitems - number of items to split
+ *
+ * @return	int
+ * @retval	number of items per task
+ */
+int
+mt_chunk_size(int nitems)
+{
+	int chunk_size;
+
+	chunk_size = nitems / (num_threads * MT_TASKS_PER_THREAD);
+	chunk_size = (chunk_size > MT_CHUNK_SIZE_MIN) ? chunk_size : MT_CHUNK_SIZE_MIN;
+	chunk_size = (chunk_size < MT_CHUNK_SIZE_MAX) ? chunk_size : MT_CHUNK_SIZE_MAX;
+
+	return chunk_size;
+}
+
+/**
+ * @brief	Run a batch of tasks on the worker threads and wait for all of
+ *		them to finish.  The tasks are dealt out round-robin to the
+ *		workers' deques and the main thread steals tasks while it waits.
+ *		Results are left in each task's thread_data for the caller.
  *
- * @param[in]	task - the task to queue up
+ * @param[in]	tasks - the tasks to run
  *
  * @return void
  */
 void
-queue_work_for_threads(th_task_info *task)
+execute_tasks(std::vector<th_task_info *> &tasks)
 {
-	pthread_mutex_lock(&work_lock);
-	ds_enqueue(work_queue, (void *) task);
-	pthread_cond_signal(&work_cond);
-	pthread_mutex_unlock(&work_lock);
+	th_task_info *work;
+	int i;
+
+	if (tasks.empty())
+		return;
+
+	/* No workers, or a nested batch from a task the main thread is running */
+	if (num_threads <= 1 || deques == NULL || main_helping) {
+		for (auto t : tasks)
+			do_task(t, 0);
+		return;
+	}
+
+	tasks_pending = tasks.size();
+
+	for (i = 0; i < num_threads; i++)
+		pthread_mutex_lock(&deques[i].lock);
+	i = 0;
+	for (auto t : tasks) {
+		deques[i].tasks.push_back(t);
+		i = (i + 1) % num_threads;
+	}
+	tasks_queued += tasks.size();
+	for (i = 0; i < num_threads; i++)
+		pthread_mutex_unlock(&deques[i].lock);
+
+	pthread_mutex_lock(&idle_lock);
+	pthread_cond_broadcast(&idle_cond);
+	pthread_mutex_unlock(&idle_lock);
+
+	/* Help out while we wait */
+	main_helping = 1;
+	while ((work = get_task(-1)) != NULL) {
+		do_task(work, 0);
+		task_done();
+	}
+	main_helping = 0;
+
+	pthread_mutex_lock(&latch_lock);
+	while (tasks_pending.load() > 0)
+		pthread_cond_wait(&latch_cond, &latch_lock);
+	pthread_mutex_unlock(&latch_lock);
+}
+
+/**
+ * @brief	Split the index range [0, nitems) into chunks and call func on
+ *		each chunk from the thread pool.  func must only touch the
+ *		items in the range it is handed.  Runs serially if called from
+ *		a worker thread or if multi-threading is off.
+ *
+ * @param[in]	nitems - number of items
+ * @param[in]	min_chunk - smallest number of items worth handing to a thread
+ * @param[in]	func - function to call with (arg, sidx, eidx), eidx inclusive
+ * @param[in]	arg - opaque argument passed to func
+ *
+ * @return void
+ */
+void
+mt_parallel_for(int nitems, int min_chunk, void (*func)(void *arg, int sidx, int eidx), void *arg)
+{
+	std::vector<th_task_info *> tasks;
+	int chunk_size;
+	int tid;
+	int i;
+
+	if (nitems <= 0 || func == NULL)
+		return;
+
+	if (min_chunk < 1)
+		min_chunk = 1;
+
+	tid = *((int *) pthread_getspecific(th_id_key));
+	if (tid != 0 || num_threads <= 1 || nitems <= min_chunk) {
+		func(arg, 0, nitems - 1);
+		return;
+	}
+
+	chunk_size = nitems / (num_threads * MT_TASKS_PER_THREAD);
+	chunk_size = (chunk_size > min_chunk) ? chunk_size : min_chunk;
+	chunk_size = (chunk_size < MT_CHUNK_SIZE_MAX) ? chunk_size : MT_CHUNK_SIZE_MAX;
+	for (i = 0; i < nitems; i += chunk_size) {
+		th_task_info *task;
+		th_data_generic *gdata;
+
+		gdata = static_cast<th_data_generic *>(malloc(sizeof(th_data_generic)));
+		task = static_cast<th_task_info *>(malloc(sizeof(th_task_info)));
+		if (gdata == NULL || task == NULL) {
+			log_err(errno, __func__, MEM_ERR_MSG);
+			free(gdata);
+			free(task);
+			/* do the rest ourselves */
+			func(arg, i, nitems - 1);
+			break;
+		}
+		gdata->func = func;
+		gdata->arg = arg;
+		gdata->sidx = i;
+		gdata->eidx = (i + chunk_size < nitems) ? i + chunk_size - 1 : nitems - 1;
+		task->task_id = tasks.size();
+		task->task_type = TS_GENERIC;
+		task->thread_data = (void *) gdata;
+		tasks.push_back(task);
+	}
+
+	execute_tasks(tasks);
+
+	for (auto t : tasks) {
+		free(t->thread_data);
+		free(t);
+	}
 }
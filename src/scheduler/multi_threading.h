@@ -41,14 +41,19 @@
 #ifndef SRC_SCHEDULER_MULTI_THREADING_H_
 #define SRC_SCHEDULER_MULTI_THREADING_H_
 
+#include <vector>
 #include "data_types.h"
 
-#define MT_CHUNK_SIZE_MIN 1024
+#define MT_CHUNK_SIZE_MIN 256
 #define MT_CHUNK_SIZE_MAX 8192
+/* number of tasks to aim for per thread so idle threads have work to steal */
+#define MT_TASKS_PER_THREAD 4
 
 int init_multi_threading(int nthreads);
 void kill_threads(void);
 void *worker(void *);
-void queue_work_for_threads(th_task_info *task);
+int mt_chunk_size(int nitems);
+void execute_tasks(std::vector<th_task_info *> &tasks);
+void mt_parallel_for(int nitems, int min_chunk, void (*func)(void *arg, int sidx, int eidx), void *arg);
 
 #endif /* SRC_SCHEDULER_MULTI_THREADING_H_ */
@@ -56,6 +56,7 @@
  * 	find_node_by_host()
  * 	dup_nodes()
  * 	dup_node_info()
+ * 	unshare_node_res()
  * 	copy_node_ptr_array()
  * 	collect_resvs_on_nodes()
  * 	collect_jobs_on_nodes()
@@ -258,7 +259,6 @@ query_nodes(int pbs_sd, server_info *sinfo)
 	static struct attrl *attrib = NULL;
 	th_data_query_ninfo *tdata = NULL;
 	th_task_info *task = NULL;
-	node_info ***ninfo_arrs_tasks = NULL;
 	int tid;
 
 	if (attrib == NULL) {
@@ -332,19 +332,17 @@ query_nodes(int pbs_sd, server_info *sinfo)
 
 		ninfo_arr[nidx] = NULL;
 	} else {
-		int chunk_size = num_nodes / num_threads;
+		int chunk_size = mt_chunk_size(num_nodes);
 		int th_err = 0;
 		int j;
-		int num_tasks;
+		std::vector<th_task_info *> tasks;
 		if ((ninfo_arr = static_cast<node_info **>(malloc((num_nodes + 1) * sizeof(node_info *)))) == NULL) {
 			log_err(errno, __func__, MEM_ERR_MSG);
 			pbs_statfree(nodes);
 			return NULL;
 		}
 		ninfo_arr[0] = NULL;
-		chunk_size = (chunk_size > MT_CHUNK_SIZE_MIN) ? chunk_size : MT_CHUNK_SIZE_MIN;
-		for (j = 0, num_tasks = 0; num_nodes > 0;
-				j += chunk_size, num_tasks++, num_nodes -= chunk_size) {
+		for (j = 0; num_nodes > 0; j += chunk_size, num_nodes -= chunk_size) {
 			tdata = alloc_tdata_nd_query(nodes, sinfo, j, j + chunk_size - 1);
 			if (tdata == NULL) {
 				th_err = 1;
@@ -357,53 +355,38 @@ query_nodes(int pbs_sd, server_info *sinfo)
 				th_err = 1;
 				break;
 			}
-			task->task_id = num_tasks;
+			task->task_id = tasks.size();
 			task->task_type = TS_QUERY_ND_INFO;
 			task->thread_data = (void *) tdata;
 
-			queue_work_for_threads(task);
+			tasks.push_back(task);
 		}
-		ninfo_arrs_tasks = static_cast<node_info ***>(malloc(num_tasks * sizeof(node_info **)));
-		if (ninfo_arrs_tasks == NULL) {
-			log_err(errno, __func__, MEM_ERR_MSG);
-			th_err = 1;
-		}
-		/* Get results from worker threads */
-		for (int i = 0; i < num_tasks;) {
-			pthread_mutex_lock(&result_lock);
-			while (ds_queue_is_empty(result_queue))
-				pthread_cond_wait(&result_cond, &result_lock);
-			while (!ds_queue_is_empty(result_queue)) {
-				task = static_cast<th_task_info *>(ds_dequeue(result_queue));
-				tdata = static_cast<th_data_query_ninfo *>(task->thread_data);
-				if (tdata->error)
-					th_err = 1;
-				ninfo_arrs_tasks[task->task_id] = tdata->oarr;
-				free(tdata);
-				free(task);
-				i++;
-			}
-			pthread_mutex_unlock(&result_lock);
-		}
-		if (th_err) {
-			pbs_statfree(nodes);
-			free_nodes(ninfo_arr);
-			return NULL;
-		}
-		/* Assemble node info objects from various threads into the ninfo_arr */
-		for (int i = 0; i < num_tasks; i++) {
-			if (ninfo_arrs_tasks[i] != NULL) {
+
+		execute_tasks(tasks);
+
+		/* Assemble node info objects from the tasks into the ninfo_arr in task order */
+		for (auto t : tasks) {
+			tdata = static_cast<th_data_query_ninfo *>(t->thread_data);
+			if (tdata->error)
+				th_err = 1;
+			if (tdata->oarr != NULL) {
 				node_info *ninfo;
 
-				for (int j = 0; (ninfo = ninfo_arrs_tasks[i][j]) != NULL; j++) {
+				for (j = 0; (ninfo = tdata->oarr[j]) != NULL; j++) {
 					ninfo->rank = get_sched_rank();
 					ninfo_arr[nidx++] = ninfo;
 				}
-				free(ninfo_arrs_tasks[i]);
+				free(tdata->oarr);
 			}
+			free(tdata);
+			free(t);
 		}
 		ninfo_arr[nidx] = NULL;
-		free(ninfo_arrs_tasks);
+		if (th_err) {
+			pbs_statfree(nodes);
+			free_nodes(ninfo_arr);
+			return NULL;
+		}
 	}
 
 	if (nidx == 0) {
@@ -616,6 +599,9 @@ query_node_info(struct batch_status *node, server_info *sinfo)
 	if (ninfo->lic_lock != 1)
 		ninfo->nscr |= NSCR_CYCLE_INELIGIBLE;
 
+	/* fit checks look up the node's resources once per chunk */
+	index_resource_list(ninfo->res);
+
 	return ninfo;
 }
 
@@ -642,6 +628,7 @@ node_info::node_info(const std::string& nname): name(nname)
 	is_sleeping = 0;
 	is_multivnoded = 0;
 	has_ghost_job = 0;
+	res_indirect = 0;
 
 	lic_lock = 0;
 
@@ -770,7 +757,7 @@ free_nodes(node_info **ninfo_arr)
 	int chunk_size;
 	th_data_free_ninfo *tdata = NULL;
 	th_task_info *task = NULL;
-	int num_tasks;
+	std::vector<th_task_info *> tasks;
 	int num_nodes;
 	int tid;
 
@@ -791,10 +778,8 @@ free_nodes(node_info **ninfo_arr)
 		free(ninfo_arr);
 		return;
 	}
-	chunk_size = num_nodes / num_threads;
-	chunk_size = (chunk_size > MT_CHUNK_SIZE_MIN) ? chunk_size : MT_CHUNK_SIZE_MIN;
-	for (i = 0, num_tasks = 0; num_nodes > 0;
-			num_tasks++, i += chunk_size, num_nodes -= chunk_size) {
+	chunk_size = mt_chunk_size(num_nodes);
+	for (i = 0; num_nodes > 0; i += chunk_size, num_nodes -= chunk_size) {
 		tdata = alloc_tdata_free_nodes(ninfo_arr, i, i + chunk_size - 1);
 		if (tdata == NULL)
 			break;
@@ -805,25 +790,18 @@ free_nodes(node_info **ninfo_arr)
 			log_err(errno, __func__, MEM_ERR_MSG);
 			break;
 		}
+		task->task_id = tasks.size();
 		task->task_type = TS_FREE_ND_INFO;
 		task->thread_data = (void *) tdata;
 
-		queue_work_for_threads(task);
+		tasks.push_back(task);
 	}
 
-	/* Get results from worker threads */
-	for (i = 0; i < num_tasks;) {
-		pthread_mutex_lock(&result_lock);
-		while (ds_queue_is_empty(result_queue))
-			pthread_cond_wait(&result_cond, &result_lock);
-		while (!ds_queue_is_empty(result_queue)) {
-			task = static_cast<th_task_info *>(ds_dequeue(result_queue));
-			tdata = static_cast<th_data_free_ninfo *>(task->thread_data);
-			free(tdata);
-			free(task);
-			i++;
-		}
-		pthread_mutex_unlock(&result_lock);
+	execute_tasks(tasks);
+
+	for (auto t : tasks) {
+		free(t->thread_data);
+		free(t);
 	}
 	free(ninfo_arr);
 }
@@ -839,7 +817,8 @@ node_info::~node_info()
 	free_string_array(resvs);
 	free(job_arr);
 	free(run_resvs_arr);
-	free_resource_list(res);
+	if (res_share == nullptr)
+		free_resource_list(res);
 	free_counts_list(group_counts);
 	free_counts_list(user_counts);
 	free(current_aoe);
@@ -1272,11 +1251,10 @@ dup_nodes(node_info **onodes, server_info *nsinfo, unsigned int flags)
 		free(tdata);
 	} else { /* We are multithreading */
 		int j;
-		int num_tasks;
-		int chunk_size = num_nodes / num_threads;
-		chunk_size = (chunk_size > MT_CHUNK_SIZE_MIN) ? chunk_size : MT_CHUNK_SIZE_MIN;
-		for (j = 0, num_tasks = 0; thread_node_ct_left > 0;
-				num_tasks++, j+= chunk_size, thread_node_ct_left -= chunk_size) {
+		int chunk_size = mt_chunk_size(num_nodes);
+		std::vector<th_task_info *> tasks;
+		for (j = 0; thread_node_ct_left > 0;
+				j += chunk_size, thread_node_ct_left -= chunk_size) {
 			tdata = alloc_tdata_dup_nodes(flags, nsinfo, onodes, nnodes, j, j + chunk_size - 1);
 			if (tdata == NULL) {
 				th_err = 1;
@@ -1290,27 +1268,21 @@ dup_nodes(node_info **onodes, server_info *nsinfo, unsigned int flags)
 				break;
 
 			}
+			task->task_id = tasks.size();
 			task->task_type = TS_DUP_ND_INFO;
 			task->thread_data = (void *) tdata;
 
-			queue_work_for_threads(task);
+			tasks.push_back(task);
 		}
 
-		/* Get results from worker threads */
-		for (int i = 0; i < num_tasks;) {
-			pthread_mutex_lock(&result_lock);
-			while (ds_queue_is_empty(result_queue))
-				pthread_cond_wait(&result_cond, &result_lock);
-			while (!ds_queue_is_empty(result_queue)) {
-				task = static_cast<th_task_info *>(ds_dequeue(result_queue));
-				tdata = static_cast<th_data_dup_nd_info *>(task->thread_data);
-				if (tdata->error)
-					th_err = 1;
-				free(tdata);
-				free(task);
-				i++;
-			}
-			pthread_mutex_unlock(&result_lock);
+		execute_tasks(tasks);
+
+		for (auto t : tasks) {
+			tdata = static_cast<th_data_dup_nd_info *>(t->thread_data);
+			if (tdata->error)
+				th_err = 1;
+			free(tdata);
+			free(t);
 		}
 	}
 
@@ -1439,10 +1411,18 @@ dup_node_info(node_info *onode, server_info *nsinfo, unsigned int flags)
 
 	nnode->jobs = dup_string_arr(onode->jobs);
 	nnode->resvs = dup_string_arr(onode->resvs);
+	nnode->res_indirect = onode->res_indirect;
 	if (flags & DUP_INDIRECT)
 		nnode->res = dup_ind_resource_list(onode->res);
-	else
+	else if (onode->res_indirect || onode->res == NULL)
 		nnode->res = dup_resource_list(onode->res);
+	else {
+		/* share the resource list until one of the universes modifies it */
+		if (onode->res_share == nullptr)
+			onode->res_share = std::shared_ptr<schd_resource>(onode->res, free_resource_list);
+		nnode->res_share = onode->res_share;
+		nnode->res = onode->res;
+	}
 
 	nnode->max_running = onode->max_running;
 	nnode->max_user_run = onode->max_user_run;
@@ -1492,6 +1472,40 @@ dup_node_info(node_info *onode, server_info *nsinfo, unsigned int flags)
 	return nnode;
 }
 
+/**
+ * @brief
+ *		unshare_node_res - give a node its own copy of its resource list
+ *		if it is shared with another universe.  Must be called before
+ *		the node's resources are modified.
+ *
+ * @param[in,out]	ninfo	-	the node
+ *
+ * @return	int
+ * @retval	1	: the node's resource list is its own
+ * @retval	0	: on error
+ *
+ * @par MT-Safe:	no
+ */
+int
+unshare_node_res(node_info *ninfo)
+{
+	schd_resource *nres;
+
+	if (ninfo == NULL)
+		return 0;
+
+	if (ninfo->res_share == nullptr || ninfo->res_share.use_count() == 1)
+		return 1;
+
+	if ((nres = dup_resource_list(ninfo->res)) == NULL)
+		return 0;
+
+	ninfo->res_share.reset();
+	ninfo->res = nres;
+
+	return 1;
+}
+
 /**
  * @brief
  *		copy_node_ptr_array - copy an array of jobs using a different set of
@@ -1761,6 +1775,9 @@ update_node_on_run(nspec *ns, resource_resv *resresv, const char *job_state)
 		}
 	}
 
+	if (unshare_node_res(ninfo) == 0)
+		return;
+
 	resreq = ns->resreq;
 	if ((job_state != NULL) && (*job_state == 'S')) {
 		if (resresv->job->resreleased != NULL) {
@@ -1919,6 +1936,9 @@ update_node_on_end(node_info *ninfo, resource_resv *resresv, const char *job_sta
 		}
 	}
 
+	if (unshare_node_res(ninfo) == 0)
+		return;
+
 	for (i = 0; resresv->nspec_arr[i] != NULL; i++) {
 		if (resresv->nspec_arr[i]->ninfo == ninfo) {
 			ns = resresv->nspec_arr[i];
@@ -2316,9 +2336,23 @@ eval_selspec(status *policy, selspec *spec, place *placespec,
 
 	/* Otherwise we're node grouping... */
 
+	/* With many placement sets, check them all up front on the thread pool.
+	 * The walk below still goes in order, so the result doesn't change.
+	 */
+	std::vector<int> np_fit;
+	std::vector<schd_error *> np_errs;
+	int have_fits = resresv_can_fit_nodeparts(policy, nodepart, resresv, flags, np_fit, np_errs);
+
 	for (i = 0; nodepart[i] != NULL && rc == 0; i++) {
+		int np_rc;
+
 		clear_schd_error(err);
-		if (resresv_can_fit_nodepart(policy, nodepart[i], resresv, flags, err)) {
+		if (have_fits) {
+			np_rc = np_fit[i];
+			copy_schd_error(err, np_errs[i]);
+		} else
+			np_rc = resresv_can_fit_nodepart(policy, nodepart[i], resresv, flags, err);
+		if (np_rc) {
 			log_eventf(PBSEVENT_DEBUG3, PBS_EVENTCLASS_JOB, LOG_DEBUG, resresv->name,
 				"Evaluating placement set: %s", nodepart[i]->name);
 			if (nodepart[i]->ok_break)
@@ -2364,6 +2398,8 @@ eval_selspec(status *policy, selspec *spec, place *placespec,
 		}
 		pass_flags = NO_FLAGS;
 	}
+	for (auto e : np_errs)
+		free_schd_error(e);
 
 	if (!can_fit) {
 		if (flags & SPAN_PSETS) {
@@ -2719,7 +2755,9 @@ eval_placement(status *policy, selspec *spec, node_info **ninfo_arr, place *pl,
 									dselspec->chunks[c]->num_chunks--;
 
 									for (; *nsa != NULL; nsa++) {
-										req = (*nsa)->resreq;
+										req = NULL;
+										if (unshare_node_res((*nsa)->ninfo))
+											req = (*nsa)->resreq;
 										while (req != NULL) {
 											if (req->type.is_consumable) {
 												res = find_resource((*nsa)->ninfo->res,
@@ -2905,7 +2943,9 @@ eval_complex_selspec(status *policy, selspec *spec, node_info **ninfo_arr, place
 				if (pl->scatter || pl->vscatter)
 					(*nsa)->ninfo->nscr |= NSCR_SCATTERED;
 				else {
-					req = (*nsa)->resreq;
+					req = NULL;
+					if (unshare_node_res((*nsa)->ninfo))
+						req = (*nsa)->resreq;
 					while (req != NULL) {
 						res = find_resource((*nsa)->ninfo->res, req->def);
 						if (res != NULL)
@@ -3578,6 +3618,9 @@ resources_avail_on_vnode(resource_req *specreq_cons, node_info *node,
 					 */
 					req->amount -= num_chunks;
 
+					if (unshare_node_res(node) == 0)
+						return 0;
+
 					auto res = find_resource(node->res, req->def);
 					if (res != NULL) {
 						if (res->indirect_res != NULL)
@@ -5556,11 +5599,9 @@ check_node_array_eligibility(node_info **ninfo_arr, resource_resv *resresv, plac
 		free(tdata);
 	} else {	 /* We are multithreading */
 		int j;
-		int num_tasks;
-		int chunk_size = num_nodes / num_threads;
-		chunk_size = (chunk_size > MT_CHUNK_SIZE_MIN) ? chunk_size : MT_CHUNK_SIZE_MIN;
-		for (j = 0, num_tasks = 0; num_nodes > 0;
-				num_tasks++, j += chunk_size, num_nodes -= chunk_size) {
+		int chunk_size = mt_chunk_size(num_nodes);
+		std::vector<th_task_info *> tasks;
+		for (j = 0; num_nodes > 0; j += chunk_size, num_nodes -= chunk_size) {
 			tdata = alloc_tdata_nd_eligible(pl, resresv, ninfo_arr, j, j + chunk_size - 1);
 			if (tdata == NULL)
 				break;
@@ -5571,29 +5612,24 @@ check_node_array_eligibility(node_info **ninfo_arr, resource_resv *resresv, plac
 				log_err(errno, __func__, MEM_ERR_MSG);
 				break;
 			}
+			task->task_id = tasks.size();
 			task->task_type = TS_IS_ND_ELIGIBLE;
 			task->thread_data = (void *) tdata;
 
-			queue_work_for_threads(task);
+			tasks.push_back(task);
 		}
 
-		/* Get results from worker threads */
-		for (int i = 0; i < num_tasks;) {
-			pthread_mutex_lock(&result_lock);
-			while (ds_queue_is_empty(result_queue))
-				pthread_cond_wait(&result_cond, &result_lock);
-			while (!ds_queue_is_empty(result_queue)) {
-				task = static_cast<th_task_info *>(ds_dequeue(result_queue));
-				tdata = static_cast<th_data_nd_eligible *>(task->thread_data);
-				if (err->status_code == SCHD_UNKWN && tdata->err->status_code != SCHD_UNKWN)
-					copy_schd_error(err, tdata->err);
-
-				free_schd_error(tdata->err);
-				free(tdata);
-				free(task);
-				i++;
-			}
-			pthread_mutex_unlock(&result_lock);
+		execute_tasks(tasks);
+
+		/* Report the error from the first chunk which has one, like a serial walk would */
+		for (auto t : tasks) {
+			tdata = static_cast<th_data_nd_eligible *>(t->thread_data);
+			if (err->status_code == SCHD_UNKWN && tdata->err->status_code != SCHD_UNKWN)
+				copy_schd_error(err, tdata->err);
+
+			free_schd_error(tdata->err);
+			free(tdata);
+			free(t);
 		}
 	}
 }
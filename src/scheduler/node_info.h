@@ -238,6 +238,11 @@ update_nodes_for_resvs(node_info **ninfo_arr, server_info *sinfo,
  */
 node_info *dup_node_info(node_info *onode, server_info *nsinfo, unsigned int flags);
 
+/*
+ *      unshare_node_res - give a node its own copy of a shared resource list
+ */
+int unshare_node_res(node_info *ninfo);
+
 /*
  *      find_nspec_by_name - find an nspec in an array by nodename
  */
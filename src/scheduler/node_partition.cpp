@@ -92,6 +92,7 @@
 #include "globals.h"
 #include "sort.h"
 #include "buckets.h"
+#include "multi_threading.h"
 
 #include <vector>
 
@@ -754,6 +755,7 @@ node_partition_update(status *policy, node_partition *np)
 			break;
 		}
 	}
+	index_resource_list(np->res);
 
 	if (!policy->node_sort->empty() && conf.node_sort_unused) {
 		/* Resort the nodes in the partition so that selection works correctly. */
@@ -1010,6 +1012,7 @@ resresv_can_fit_nodepart(status *policy, node_partition *np, resource_resv *resr
 	resource_req *req;
 	selspec *spec = NULL;
 	place *pl = NULL;
+	place place_buf;
 
 
 	if (policy == NULL || np == NULL || resresv == NULL || err == NULL)
@@ -1108,7 +1111,7 @@ resresv_can_fit_nodepart(status *policy, node_partition *np, resource_resv *resr
 	 * get_resresv_spec sets the spec value to execselect/select depending on whether execselect
 	 * was set or not.
 	 */
-	get_resresv_spec(resresv, &spec, &pl);
+	get_resresv_spec(resresv, &spec, &pl, &place_buf);
 	for (i = 0; spec->chunks[i] != NULL; i++) {
 		if (check_avail_resources(np->res, spec->chunks[i]->req,
 					pass_flags | CHECK_ALL_BOOLS, policy->resdef_to_check,
@@ -1134,6 +1137,102 @@ resresv_can_fit_nodepart(status *policy, node_partition *np, resource_resv *resr
 	return 1;
 }
 
+/* fewest placement sets worth checking on the thread pool */
+#define NP_FIT_CHUNK_MIN 32
+
+/* resresv_can_fit_nodepart() arguments and results for the thread pool */
+struct np_fit_check {
+	status *policy;
+	node_partition **nodepart;
+	resource_resv *resresv;
+	int flags;
+	int *fit;
+	schd_error **errs;
+};
+
+/**
+ * @brief	thread pool callback to check a range of node partitions
+ *
+ * @param[in,out]	arg - np_fit_check
+ * @param[in]	sidx - first node partition to check
+ * @param[in]	eidx - last node partition to check
+ *
+ * @return	void
+ */
+static void
+resresv_can_fit_nodepart_chunk(void *arg, int sidx, int eidx)
+{
+	np_fit_check *fc = static_cast<np_fit_check *>(arg);
+	int i;
+
+	for (i = sidx; i <= eidx; i++)
+		fc->fit[i] = resresv_can_fit_nodepart(fc->policy, fc->nodepart[i],
+			fc->resresv, fc->flags, fc->errs[i]);
+}
+
+/**
+ * @brief
+ * 		check a resresv against the meta data of all node partitions in an
+ *		array using the thread pool.  The result and error of partition i
+ *		are what resresv_can_fit_nodepart() would have returned for it.
+ *
+ * @param[in]	policy	-	policy info
+ * @param[in]	nodepart	-	node partitions to check
+ * @param[in]	resresv	-	job/resv to see if it can fit
+ * @param[in]	flags	-	check_flags (@see resresv_can_fit_nodepart()),
+ *					RETURN_ALL_ERR is not supported
+ * @param[out]	fit	-	return value of resresv_can_fit_nodepart() per partition
+ * @param[out]	errs	-	error per partition, caller frees with free_schd_error()
+ *
+ * @return	int
+ * @retval	1	: results filled in
+ * @retval	0	: not worth doing in parallel or on error, caller
+ *			  should call resresv_can_fit_nodepart() itself
+ */
+int
+resresv_can_fit_nodeparts(status *policy, node_partition **nodepart, resource_resv *resresv,
+	int flags, std::vector<int> &fit, std::vector<schd_error *> &errs)
+{
+	np_fit_check fc;
+	int num_parts;
+	int tid;
+	int i;
+
+	if (policy == NULL || nodepart == NULL || resresv == NULL || (flags & RETURN_ALL_ERR))
+		return 0;
+
+	tid = *((int *) pthread_getspecific(th_id_key));
+	if (tid != 0 || num_threads <= 1)
+		return 0;
+
+	num_parts = count_array(nodepart);
+	if (num_parts <= NP_FIT_CHUNK_MIN)
+		return 0;
+
+	fit.assign(num_parts, 0);
+	errs.assign(num_parts, NULL);
+	for (i = 0; i < num_parts; i++) {
+		errs[i] = new_schd_error();
+		if (errs[i] == NULL) {
+			for (auto e : errs)
+				free_schd_error(e);
+			errs.clear();
+			fit.clear();
+			return 0;
+		}
+	}
+
+	fc.policy = policy;
+	fc.nodepart = nodepart;
+	fc.resresv = resresv;
+	fc.flags = flags;
+	fc.fit = fit.data();
+	fc.errs = errs.data();
+	mt_parallel_for(num_parts, NP_FIT_CHUNK_MIN, resresv_can_fit_nodepart_chunk, &fc);
+
+	return 1;
+}
+
 /**
  * @brief
  * 		create_specific_nodepart - create a node partition with specific
@@ -209,6 +209,14 @@ int add_np_cache(np_cache ***npc_arr, np_cache *npc);
  */
 int resresv_can_fit_nodepart(status *policy, node_partition *np, resource_resv *resresv, int total, schd_error *err);
 
+/*
+ * run resresv_can_fit_nodepart() over an array of node partitions on the
+ * thread pool.  Returns 1 if the results were filled in, 0 if the caller
+ * should do the checks itself.
+ */
+int resresv_can_fit_nodeparts(status *policy, node_partition **nodepart, resource_resv *resresv,
+	int flags, std::vector<int> &fit, std::vector<schd_error *> &errs);
+
 /*
  *	create_specific_nodepart - create a node partition with specific
  *				   nodes, rather than from a placement
@@ -101,6 +101,7 @@ config::config() : fairshare_res("cput"), fairshare_ent("euser")
 	node_sort_unused = 0;
 	resv_conf_ignore = 0;
 	allow_aoe_calendar = 0;
+	incr_job_query = 0;
 #ifdef NAS /* localmod 034 */
 	prime_sto = 0;
 	non_prime_sto = 0;
@@ -291,6 +292,8 @@ parse_config(const char *fname)
 					tmpconf.enforce_no_shares = num ? 1 : 0;
 				else if (!strcmp(config_name, PARSE_ALLOW_AOE_CALENDAR))
 					tmpconf.allow_aoe_calendar = 1;
+				else if (!strcmp(config_name, PARSE_INCR_JOB_QUERY))
+					tmpconf.incr_job_query = num ? 1 : 0;
 				else if (!strcmp(config_name, PARSE_PRIME_SPILL)) {
 					if (prime == PRIME || prime == PT_ALL)
 						tmpconf.prime_spill = res_to_num(config_value, &type);
@@ -157,6 +157,7 @@ on_segv(int sig)
 	if ((segv_last_time - segv_start_time) < 300) {
 		log_record(PBSEVENT_SYSTEM, PBS_EVENTCLASS_SERVER, LOG_INFO, __func__,
 			   "received a sigsegv within 5 minutes of start: aborting.");
+		log_async_flush();
 
 		/* Not unlocking mutex on purpose, we need to hold on to it until the process is killed */
 		abort();
@@ -164,6 +165,7 @@ on_segv(int sig)
 
 	log_record(PBSEVENT_SYSTEM, PBS_EVENTCLASS_SERVER, LOG_INFO, __func__,
 		   "received segv and restarting");
+	log_async_flush();
 
 	if (fork() > 0) {  /* the parent rexec's itself */
 		sleep(10); /* allow the child to die */
@@ -910,6 +912,7 @@ sched_main(int argc, char *argv[], schedule_func sched_ptr)
 	int go;
 	int c;
 	int errflg = 0;
+	int rc;
 	int lockfds;
 	pid_t pid;
 	char host[PBS_MAXHOSTNAME + 1];
@@ -1198,6 +1201,10 @@ sched_main(int argc, char *argv[], schedule_func sched_ptr)
 #endif
 	pid = getpid();
 	daemon_protect(0, PBS_DAEMON_PROTECT_ON);
+
+	/* log through a background writer thread from here on */
+	if (pbs_conf.pbs_log_async && (rc = log_async_start()) != 0)
+		log_err(rc, msg_daemonname, "failed to start asynchronous logging");
 	freopen("/dev/null", "r", stdin);
 
 	/* write schedulers pid into lockfile */
@@ -126,7 +126,8 @@ query_resources(int pbs_sd)
 				flags = strtol(attrp->value, &endp, 10);
 			}
 		}
-		tmpres[cur_bs->name] = new resdef(cur_bs->name, flags, rtype);
+		int ord = tmpres.size();
+		tmpres[cur_bs->name] = new resdef(cur_bs->name, flags, rtype, ord);
 	}
 	pbs_statfree(bs);
 
@@ -404,6 +405,8 @@ update_resource_defs(int pbs_sd)
 
 	clear_limres();
 
+	clear_formula_cache();
+
 	return true;
 }
 
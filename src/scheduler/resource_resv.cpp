@@ -246,7 +246,7 @@ free_resource_resv_array(resource_resv **resresv_arr)
 	int chunk_size;
 	th_data_free_resresv *tdata = NULL;
 	th_task_info *task = NULL;
-	int num_tasks;
+	std::vector<th_task_info *> tasks;
 	int num_jobs;
 	int tid;
 
@@ -268,35 +268,30 @@ free_resource_resv_array(resource_resv **resresv_arr)
 		return;
 	}
 
-	chunk_size = num_jobs / num_threads;
-	chunk_size = (chunk_size > MT_CHUNK_SIZE_MIN) ? chunk_size : MT_CHUNK_SIZE_MIN;
-	chunk_size = (chunk_size < MT_CHUNK_SIZE_MAX) ? chunk_size : MT_CHUNK_SIZE_MAX;
-	for (i = 0, num_tasks = 0; num_jobs > 0;
-			num_tasks++, i += chunk_size, num_jobs -= chunk_size) {
+	chunk_size = mt_chunk_size(num_jobs);
+	for (i = 0; num_jobs > 0; i += chunk_size, num_jobs -= chunk_size) {
 		tdata = alloc_tdata_free_rr_arr(resresv_arr, i, i + chunk_size - 1);
 		if (tdata == NULL)
 			break;
 
 		task = static_cast<th_task_info *>(malloc(sizeof(th_task_info)));
+		if (task == NULL) {
+			free(tdata);
+			log_err(errno, __func__, MEM_ERR_MSG);
+			break;
+		}
+		task->task_id = tasks.size();
 		task->task_type = TS_FREE_RESRESV;
 		task->thread_data = (void *) tdata;
 
-		queue_work_for_threads(task);
+		tasks.push_back(task);
 	}
 
-	/* Get results from worker threads */
-	for (i = 0; i < num_tasks;) {
-		pthread_mutex_lock(&result_lock);
-		while (ds_queue_is_empty(result_queue))
-			pthread_cond_wait(&result_cond, &result_lock);
-		while (!ds_queue_is_empty(result_queue)) {
-			task = static_cast<th_task_info *>(ds_dequeue(result_queue));
-			tdata = static_cast<th_data_free_resresv *>(task->thread_data);
-			free(tdata);
-			free(task);
-			i++;
-		}
-		pthread_mutex_unlock(&result_lock);
+	execute_tasks(tasks);
+
+	for (auto t : tasks) {
+		free(t->thread_data);
+		free(t);
 	}
 
 	free(resresv_arr);
@@ -313,10 +308,9 @@ resource_resv::~resource_resv()
 	free(group);
 	free(project);
 	free(nodepart_name);
-	delete select;
-	delete execselect;
 	free_place(place_spec);
-	free_resource_req_list(resreq);
+	if (resreq_share == nullptr)
+		free_resource_req_list(resreq);
 	free(ninfo_arr);
 	free_nspecs(nspec_arr);
 	free_job_info(job);
@@ -461,40 +455,37 @@ dup_resource_resv_array(resource_resv **oresresv_arr,
 			free(tdata);
 		}
 	} else { /* We are multithreading */
-		int num_tasks = 0;
-		int chunk_size = num_resresv / num_threads;
-		chunk_size = (chunk_size > MT_CHUNK_SIZE_MIN)? chunk_size: MT_CHUNK_SIZE_MIN;
-		chunk_size = (chunk_size < MT_CHUNK_SIZE_MAX)? chunk_size: MT_CHUNK_SIZE_MAX;
+		int chunk_size = mt_chunk_size(num_resresv);
+		std::vector<th_task_info *> tasks;
 		for (int j = 0; thread_job_ct_left > 0;
-				num_tasks++, j += chunk_size, thread_job_ct_left -= chunk_size) {
+				j += chunk_size, thread_job_ct_left -= chunk_size) {
 			tdata = alloc_tdata_dup_nodes(oresresv_arr, nresresv_arr, nsinfo, nqinfo, j, j + chunk_size - 1);
 			if (tdata == NULL) {
 				th_err = 1;
 				break;
 			}
 			task = static_cast<th_task_info *>(malloc(sizeof(th_task_info)));
+			if (task == NULL) {
+				free(tdata);
+				log_err(errno, __func__, MEM_ERR_MSG);
+				th_err = 1;
+				break;
+			}
+			task->task_id = tasks.size();
 			task->task_type = TS_DUP_RESRESV;
 			task->thread_data = (void *) tdata;
 
-			queue_work_for_threads(task);
-
+			tasks.push_back(task);
 		}
 
-		/* Get results from worker threads */
-		for (int i = 0; i < num_tasks;) {
-			pthread_mutex_lock(&result_lock);
-			while (ds_queue_is_empty(result_queue))
-				pthread_cond_wait(&result_cond, &result_lock);
-			while (!ds_queue_is_empty(result_queue)) {
-				task = static_cast<th_task_info *>(ds_dequeue(result_queue));
-				tdata = static_cast<th_data_dup_resresv *>(task->thread_data);
-				if (tdata->error)
-					th_err = 1;
-				free(tdata);
-				free(task);
-				i++;
-			}
-			pthread_mutex_unlock(&result_lock);
+		execute_tasks(tasks);
+
+		for (auto t : tasks) {
+			tdata = static_cast<th_data_dup_resresv *>(t->thread_data);
+			if (tdata->error)
+				th_err = 1;
+			free(tdata);
+			free(t);
 		}
 	}
 
@@ -556,10 +547,9 @@ dup_resource_resv(resource_resv *oresresv, server_info *nsinfo, queue_info *nqin
 	nresresv->project = string_dup(oresresv->project);
 
 	nresresv->nodepart_name = string_dup(oresresv->nodepart_name);
-	if (oresresv->select != NULL)
-		nresresv->select = new selspec(*oresresv->select); /* must come before calls to dup_nspecs() below */
-	if (oresresv->execselect != NULL)
-		nresresv->execselect = new selspec(*oresresv->execselect);
+	/* select specs are immutable once parsed, so share them rather than copy */
+	nresresv->select = oresresv->select; /* must come before calls to dup_nspecs() below */
+	nresresv->execselect = oresresv->execselect;
 
 	nresresv->is_invalid = oresresv->is_invalid;
 	nresresv->can_not_fit = oresresv->can_not_fit;
@@ -583,7 +573,11 @@ dup_resource_resv(resource_resv *oresresv, server_info *nsinfo, queue_info *nqin
 	nresresv->hard_duration = oresresv->hard_duration;
 	nresresv->min_duration = oresresv->min_duration;
 
-	nresresv->resreq = dup_resource_req_list(oresresv->resreq);
+	/* resreq is not modified after it is queried, share it */
+	if (oresresv->resreq_share == nullptr && oresresv->resreq != NULL)
+		oresresv->resreq_share = std::shared_ptr<resource_req>(oresresv->resreq, free_resource_req_list);
+	nresresv->resreq_share = oresresv->resreq_share;
+	nresresv->resreq = oresresv->resreq;
 
 	nresresv->place_spec = dup_place(oresresv->place_spec);
 
@@ -621,7 +615,7 @@ dup_resource_resv(resource_resv *oresresv, server_info *nsinfo, queue_info *nqin
 		if (nresresv->resv->select_orig != NULL)
 			sel = nresresv->resv->select_orig;
 		else
-			sel = nresresv->select;
+			sel = nresresv->select.get();
 		nresresv->resv->orig_nspec_arr = dup_nspecs(oresresv->resv->orig_nspec_arr, nsinfo->nodes, sel);
 		nresresv->ninfo_arr = copy_node_ptr_array(oresresv->ninfo_arr, nsinfo->nodes);
 		nresresv->nspec_arr = dup_nspecs(oresresv->nspec_arr, nsinfo->nodes, NULL);
@@ -1527,7 +1521,7 @@ update_resresv_on_run(resource_resv *resresv, nspec **nspec_arr)
 		if (resresv->execselect == NULL) {
 			std::string selectspec;
 			selectspec = create_select_from_nspec(nspec_arr);
-			resresv->execselect = parse_selspec(selectspec);
+			resresv->execselect.reset(parse_selspec(selectspec));
 		}
 		if (resresv->job->dependent_jobs != NULL) {
 			for (int i = 0; resresv->job->dependent_jobs[i] != NULL; i++) {
@@ -1624,8 +1618,7 @@ update_resresv_on_end(resource_resv *resresv, const char *job_state)
 				free(resresv->nodepart_name);
 				resresv->nodepart_name = NULL;
 			}
-			delete resresv->execselect;
-			resresv->execselect = NULL;
+			resresv->execselect.reset();
 		}
 		/* We need to correct our calendar */
 		if (resresv->end_event != NULL)
@@ -40,8 +40,11 @@
 #include <pbs_config.h>
 
 #include <stdlib.h>
+#include <string.h>
+#include <unordered_map>
 #include <pbs_ifl.h>
 #include <libpbs.h>
+#include "attribute.h"
 #include "data_types.h"
 #include "fifo.h"
 #include "globals.h"
@@ -50,6 +53,26 @@
 #include "log.h"
 #include "server_info.h"
 
+/* most asynchronous run requests held back, the most the server takes in one list */
+#define RUNJOB_LIST_MAX PBS_RUNJOBLIST_MAX
+
+/* asynchronous run requests not yet sent to the server, see flush_run_jobs() */
+static struct {
+	int sd;
+	std::vector<std::string> jobids;
+	std::vector<std::string> execvnodes;
+} pending_runs = {-1, {}, {}};
+
+/* most jobs whose attribute updates are held back before they are sent as one list */
+#define MODIFYJOB_LIST_MAX 1000
+
+/* job attribute updates not yet sent to the server, see flush_attr_updates() */
+static struct {
+	int sd;
+	std::vector<std::string> jobids;
+	std::vector<struct attrl *> attribs;
+	std::unordered_map<std::string, size_t> index;	/* position of a job in jobids */
+} pending_updates = {-1, {}, {}, {}};
 
 /**
  * @brief	Handle partition tolerance related issues
@@ -101,8 +124,61 @@ send_run_job(int virtual_sd, int has_runjob_hook, const std::string& jobid, char
 		return pbs_runjob(job_owner_sd, const_cast<char *>(jobid.c_str()), execvnode, NULL);
 	else if (((sc_attrs.runjob_mode == RJ_RUNJOB_HOOK) && has_runjob_hook))
 		return pbs_asyrunjob_ack(job_owner_sd, const_cast<char *>(jobid.c_str()), execvnode, NULL);
-	else
+	else if (job_owner_sd < 0)
 		return pbs_asyrunjob(job_owner_sd, const_cast<char *>(jobid.c_str()), execvnode, NULL);
+
+	/* nobody waits on an asynchronous run, so hold it for a Run Job List */
+	if (pending_runs.sd != job_owner_sd || pending_runs.jobids.size() >= RUNJOB_LIST_MAX)
+		flush_run_jobs();
+	pending_runs.sd = job_owner_sd;
+	pending_runs.jobids.push_back(jobid);
+	pending_runs.execvnodes.push_back(execvnode);
+
+	return 0;
+}
+
+/**
+ * @brief	Send the asynchronous run requests held back by send_run_job()
+ *		to the server as one Run Job List request.
+ *
+ * @par
+ *	Call this at the end of a cycle and before any request whose outcome
+ *	depends on those jobs having been run, e.g. preemption.  Jobs the
+ *	server rejects are logged, like the server would for pbs_asyrunjob().
+ *
+ * @return	void
+ */
+void
+flush_run_jobs(void)
+{
+	std::vector<char *> jids;
+	std::vector<char *> locs;
+	struct batch_deljob_status *failed;
+	struct batch_deljob_status *p;
+	int count = pending_runs.jobids.size();
+
+	if (count == 0)
+		return;
+
+	for (int i = 0; i < count; i++) {
+		jids.push_back(const_cast<char *>(pending_runs.jobids[i].c_str()));
+		locs.push_back(const_cast<char *>(pending_runs.execvnodes[i].c_str()));
+	}
+
+	failed = pbs_runjoblist(pending_runs.sd, jids.data(), locs.data(), count, NULL);
+	if (failed == NULL && pbs_errno != PBSE_NONE)
+		log_eventf(PBSEVENT_SCHED, PBS_EVENTCLASS_SCHED, LOG_WARNING, __func__,
+			   "Run request for %d jobs failed: %d", count, pbs_errno);
+
+	for (p = failed; p != NULL; p = p->next) {
+		const char *err_txt = pbse_to_txt(p->code);
+		log_eventf(PBSEVENT_SCHED, PBS_EVENTCLASS_JOB, LOG_WARNING, p->name,
+			   "Server did not run job: %s (%d)", err_txt == NULL ? "" : err_txt, p->code);
+	}
+	pbs_delstatfree(failed);
+
+	pending_runs.jobids.clear();
+	pending_runs.execvnodes.clear();
 }
 
 /**
@@ -165,6 +241,169 @@ send_attr_updates(int virtual_sd, resource_resv *resresv, struct attrl *pattr)
 	return 0;
 }
 
+/**
+ * @brief
+ * 		remove the entries of an attrl list which set an attribute (and
+ *		resource) already set by an earlier entry of the list
+ *
+ * @param[in,out]	pattr	-	attrl list, newest update first
+ *
+ * @return	void
+ */
+static void
+dedup_attr_updates(struct attrl *pattr)
+{
+	struct attrl *cur;
+	struct attrl *prev;
+	struct attrl *p;
+
+	for (; pattr != NULL; pattr = pattr->next) {
+		prev = pattr;
+		for (cur = pattr->next; cur != NULL; cur = p) {
+			p = cur->next;
+			if (strcmp(cur->name, pattr->name) == 0 &&
+			    ((cur->resource == NULL && pattr->resource == NULL) ||
+			     (cur->resource != NULL && pattr->resource != NULL &&
+			      strcmp(cur->resource, pattr->resource) == 0))) {
+				prev->next = p;
+				free_attrl(cur);
+			} else
+				prev = cur;
+		}
+	}
+}
+
+/**
+ * @brief
+ * 		hold the attribute updates of a job so they are sent to the server
+ *		with those of other jobs in one Modify Job List request
+ *
+ * @par
+ *	If the job's updates are already held, the new ones are merged in and
+ *	replace the held value of any attribute set by both.  An attribute is
+ *	only sent once per job, with the latest value.
+ *
+ * @param[in]	virtual_sd	-	virtual sd for the cluster
+ * @param[in]	resresv	-	resource_resv object for job
+ * @param[in]	pattr	-	attrl list to update on the server, newest first.
+ *				The list is taken over and freed by this function.
+ *
+ * @return	int
+ * @retval	1	success
+ * @retval	0	failure to update
+ */
+int
+queue_attr_updates(int virtual_sd, resource_resv *resresv, struct attrl *pattr)
+{
+	int job_owner_sd;
+	int rc;
+	struct attrl *end;
+
+	if (resresv->name.empty() || pattr == NULL) {
+		free_attrl_list(pattr);
+		return 0;
+	}
+
+	job_owner_sd = get_svr_inst_fd(virtual_sd, resresv->svr_inst_id);
+	if (job_owner_sd < 0) {
+		rc = send_attr_updates(virtual_sd, resresv, pattr);
+		free_attrl_list(pattr);
+		return rc;
+	}
+
+	if (pending_updates.sd != job_owner_sd || pending_updates.jobids.size() >= MODIFYJOB_LIST_MAX) {
+		/* held runs go first, the server must see a run before its job's alters */
+		flush_run_jobs();
+		flush_attr_updates();
+	}
+	pending_updates.sd = job_owner_sd;
+
+	auto it = pending_updates.index.find(resresv->name);
+	if (it != pending_updates.index.end()) {
+		for (end = pattr; end->next != NULL; end = end->next)
+			;
+		end->next = pending_updates.attribs[it->second];
+		pending_updates.attribs[it->second] = pattr;
+	} else {
+		pending_updates.index[resresv->name] = pending_updates.jobids.size();
+		pending_updates.jobids.push_back(resresv->name);
+		pending_updates.attribs.push_back(pattr);
+	}
+	dedup_attr_updates(pattr);
+
+	return 1;
+}
+
+/**
+ * @brief	Send the job attribute updates held back by queue_attr_updates()
+ *		to the server as one Modify Job List request.
+ *
+ * @par
+ *	Call this at the end of a cycle.  Jobs the server could not update are
+ *	logged like send_attr_updates() does.
+ *
+ * @return	void
+ */
+void
+flush_attr_updates(void)
+{
+	std::vector<char *> jids;
+	struct batch_deljob_status *failed;
+	struct batch_deljob_status *p;
+	int count = pending_updates.jobids.size();
+
+	if (count == 0)
+		return;
+
+	for (int i = 0; i < count; i++)
+		jids.push_back(const_cast<char *>(pending_updates.jobids[i].c_str()));
+
+	failed = pbs_alterjoblist(pending_updates.sd, jids.data(), pending_updates.attribs.data(), count, NULL);
+	if (failed == NULL && pbs_errno != PBSE_NONE)
+		log_eventf(PBSEVENT_SCHED, PBS_EVENTCLASS_SCHED, LOG_WARNING, __func__,
+			   "Attribute update for %d jobs failed: %d", count, pbs_errno);
+	else
+		last_attr_updates = time(NULL);
+
+	for (p = failed; p != NULL; p = p->next) {
+		struct attrl *pattr = NULL;
+		const char *err_txt;
+		auto it = pending_updates.index.find(p->name);
+
+		if (it != pending_updates.index.end() && pending_updates.attribs[it->second]->next == NULL)
+			pattr = pending_updates.attribs[it->second];
+
+		if (is_finished_job(p->code) == 1) {
+			if (pattr != NULL)
+				log_eventf(PBSEVENT_SCHED, PBS_EVENTCLASS_JOB, LOG_INFO, p->name,
+					   "Failed to update attr \'%s\' = %s, Job already finished",
+					   pattr->name, pattr->value);
+			else
+				log_event(PBSEVENT_SCHED, PBS_EVENTCLASS_JOB, LOG_INFO, p->name,
+					  "Failed to update job attributes, Job already finished");
+			continue;
+		}
+
+		err_txt = pbse_to_txt(p->code);
+		if (err_txt == NULL)
+			err_txt = "";
+		if (pattr != NULL)
+			log_eventf(PBSEVENT_SCHED, PBS_EVENTCLASS_SCHED, LOG_WARNING, p->name,
+				   "Failed to update attr \'%s\' = %s: %s (%d)",
+				   pattr->name, pattr->value, err_txt, p->code);
+		else
+			log_eventf(PBSEVENT_SCHED, PBS_EVENTCLASS_SCHED, LOG_WARNING, p->name,
+				   "Failed to update job attributes: %s (%d)", err_txt, p->code);
+	}
+	pbs_delstatfree(failed);
+
+	for (auto pattr : pending_updates.attribs)
+		free_attrl_list(pattr);
+	pending_updates.jobids.clear();
+	pending_updates.attribs.clear();
+	pending_updates.index.clear();
+}
+
 /**
  * @brief	Wrapper for pbs_preempt_jobs
  *
@@ -179,6 +418,9 @@ send_preempt_jobs(int virtual_sd, char **preempt_jobs_list)
 {
 	preempt_job_info *ret;
 
+	/* jobs run earlier in the cycle have to be running before others are preempted */
+	flush_run_jobs();
+
     ret = pbs_preempt_jobs(virtual_sd, preempt_jobs_list);
 
 	if (handle_part_tolerance(ret) == NULL) {
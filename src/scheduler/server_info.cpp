@@ -830,6 +830,105 @@ query_server_dyn_res(server_info *sinfo)
 	return 0;
 }
 
+/*
+ * Ordinal index over a resource list.  Slot i holds the first element whose
+ * definition has ordinal i, so a lookup is a single array access instead of
+ * a walk down the list.  It is hung off the head of the list and kept current
+ * by the functions here which append to the list.  If anything else links an
+ * element in behind its back, lookups fall back to walking the list.
+ */
+struct res_ord_index
+{
+	std::vector<schd_resource *> slots;
+	schd_resource *tail;	/* last element of the list */
+	bool usable;		/* false if two definitions share an ordinal */
+};
+
+/**
+ * @brief
+ * 		add_res_ord_index - add a resource to an ordinal index
+ *
+ * @param[in]	idx	- the index
+ * @param[in]	res	- the resource now at the end of the indexed list
+ *
+ * @return	void
+ *
+ * @par MT-Safe:	no
+ */
+static void
+add_res_ord_index(res_ord_index *idx, schd_resource *res)
+{
+	idx->tail = res;
+	if (res->def == NULL)
+		return;
+
+	size_t ord = res->def->ord;
+	if (ord >= idx->slots.size())
+		idx->slots.resize(ord + 1, NULL);
+	if (idx->slots[ord] == NULL)
+		idx->slots[ord] = res;
+	else if (idx->slots[ord]->def != res->def)
+		idx->usable = false;
+}
+
+/**
+ * @brief
+ * 		index_resource_list - index a resource list by resource ordinal so
+ *		find_resource() does not have to walk it.  Lists shorter than
+ *		RESOURCE_INDEX_MIN are left alone.  An existing index is brought
+ *		up to date.
+ *
+ * @param[in]	reslist	- head of the resource list
+ *
+ * @return	void
+ *
+ * @par MT-Safe:	no
+ */
+void
+index_resource_list(schd_resource *reslist)
+{
+	schd_resource *cur;
+	int len = 0;
+
+	if (reslist == NULL)
+		return;
+
+	if (reslist->index == NULL) {
+		for (cur = reslist; cur != NULL && len < RESOURCE_INDEX_MIN; cur = cur->next)
+			len++;
+		if (len < RESOURCE_INDEX_MIN)
+			return;
+
+		reslist->index = new res_ord_index();
+		reslist->index->usable = true;
+		cur = reslist;
+	} else
+		cur = reslist->index->tail->next;
+
+	for (; cur != NULL; cur = cur->next)
+		add_res_ord_index(reslist->index, cur);
+}
+
+/**
+ * @brief
+ * 		link_resource - add a resource to the end of a list
+ *
+ * @param[in]	reslist	- head of the resource list
+ * @param[in]	last	- last element of the list
+ * @param[in]	res	- the resource to add
+ *
+ * @return	void
+ *
+ * @par MT-Safe:	no
+ */
+static void
+link_resource(schd_resource *reslist, schd_resource *last, schd_resource *res)
+{
+	last->next = res;
+	if (reslist->index != NULL && reslist->index->tail == last)
+		add_res_ord_index(reslist->index, res);
+}
+
 /**
  * @brief
  * 		try and find a resource by resdef, and if it is not
@@ -865,7 +964,7 @@ find_alloc_resource(schd_resource *resplist, resdef *def)
 		resp->name = def->name.c_str();
 
 		if (prev != NULL)
-			prev->next = resp;
+			link_resource(resplist, prev, resp);
 	}
 
 	return resp;
@@ -903,7 +1002,7 @@ find_alloc_resource_by_str(schd_resource *resplist, const char *name)
 			return NULL;
 
 		if (prev != NULL)
-			prev->next = resp;
+			link_resource(resplist, prev, resp);
 	}
 
 	return resp;
@@ -956,15 +1055,28 @@ find_resource_by_str(schd_resource *reslist, const std::string& name)
  *
  * @return	the found resource
  * @retval	NULL	: if not found
+ *
+ * @par MT-Safe:	yes, the list is only read
  */
 schd_resource *
 find_resource(schd_resource *reslist, resdef *def)
 {
 	schd_resource *resp;
+	res_ord_index *idx;
 
 	if (reslist == NULL || def == NULL)
 		return NULL;
 
+	idx = reslist->index;
+	if (idx != NULL && idx->usable && idx->tail->next == NULL) {
+		if (static_cast<size_t>(def->ord) >= idx->slots.size())
+			return NULL;
+		resp = idx->slots[def->ord];
+		if (resp != NULL && resp->def != def)
+			return NULL;
+		return resp;
+	}
+
 	resp = reslist;
 
 	while (resp != NULL && resp->def != def)
@@ -1159,6 +1271,8 @@ free_resource(schd_resource *resp)
 	if (resp->str_assigned != NULL)
 		free(resp->str_assigned);
 
+	delete resp->index;
+
 	free(resp);
 }
 
@@ -1281,6 +1395,7 @@ new_resource()
 
 	resp->name = NULL;
 	resp->next = NULL;
+	resp->index = NULL;
 	resp->def = NULL;
 	resp->orig_str_avail = NULL;
 	resp->indirect_vnode_name = NULL;
@@ -1373,10 +1488,11 @@ modify_resource_list(schd_resource *res_list, resource_req *req_list, int type)
 				if (end_res == NULL)
 					for (end_res = res_list; end_res->next != NULL; end_res = end_res->next)
 						;
-				end_res->next = create_resource(cur_req->name, cur_req->res_str, RF_AVAIL);
-				if (end_res->next == NULL)
+				cur_res = create_resource(cur_req->name, cur_req->res_str, RF_AVAIL);
+				if (cur_res == NULL)
 					return 0;
-				end_res = end_res->next;
+				link_resource(res_list, end_res, cur_res);
+				end_res = cur_res;
 			} else {
 				if (type == SCHD_INCR)
 					cur_res->assigned += cur_req->amount;
@@ -1436,10 +1552,11 @@ add_resource_list(status *policy, schd_resource *r1, schd_resource *r2, unsigned
 				if(end_r1 == NULL)
 					for (end_r1 = r1; end_r1->next != NULL; end_r1 = end_r1->next)
 						;
-				end_r1->next = dup_resource(cur_r2);
-				if (end_r1->next == NULL)
+				nres = dup_resource(cur_r2);
+				if (nres == NULL)
 					return 0;
-				end_r1 = end_r1->next;
+				link_resource(r1, end_r1, nres);
+				end_r1 = nres;
 			}
 		} else if (cur_r1->type.is_consumable) {
 			if ((flags & ADD_AVAIL_ASSIGNED)) {
@@ -1478,7 +1595,7 @@ add_resource_list(status *policy, schd_resource *r1, schd_resource *r2, unsigned
 					if (end_r1 == NULL)
 						for (end_r1 = r1; end_r1->next != NULL; end_r1 = end_r1->next)
 							;
-					end_r1->next = nres;
+					link_resource(r1, end_r1, nres);
 					end_r1 = nres;
 				} else {
 					nres = false_res();
@@ -2368,7 +2485,7 @@ dup_server_info(server_info *osinfo)
 		nsinfo->nodes[i]->np_arr =
 			copy_node_partition_ptr_array(osinfo->nodes[i]->np_arr, nsinfo->nodepart);
 		if (nsinfo->calendar != NULL)
-			nsinfo->nodes[i]->node_events = dup_te_lists(osinfo->nodes[i]->node_events, nsinfo->calendar->next_event);
+			nsinfo->nodes[i]->node_events = dup_te_lists(osinfo->nodes[i]->node_events, nsinfo->calendar);
 	}
 	nsinfo->buckets = dup_node_bucket_array(osinfo->buckets, nsinfo);
 	/* Now that all job information has been created, time to associate
@@ -2427,6 +2544,9 @@ dup_resource_list(schd_resource *res)
 		prev = nres;
 	}
 
+	if (res != NULL && res->index != NULL)
+		index_resource_list(head);
+
 	return head;
 }
 /**
@@ -2531,6 +2651,9 @@ dup_ind_resource_list(schd_resource *res)
 		prev = nres;
 	}
 
+	if (res != NULL && res->index != NULL)
+		index_resource_list(head);
+
 	return head;
 }
 
@@ -2600,6 +2723,136 @@ is_unassoc_node(node_info *ninfo, void *arg)
 	return 0;
 }
 
+/* hash and equality on the C string names of counts structures */
+struct counts_name_hash
+{
+	size_t operator()(const char *name) const
+	{
+		size_t h = 5381;
+
+		for (; *name != '\0'; name++)
+			h = (h << 5) + h + static_cast<unsigned char>(*name);
+		return h;
+	}
+};
+
+struct counts_name_equal
+{
+	bool operator()(const char *a, const char *b) const
+	{
+		return strcmp(a, b) == 0;
+	}
+};
+
+/*
+ * Name index over a counts list.  It is hung off the head of the list and
+ * keyed by the name strings owned by the list's own elements, so it never
+ * outlives them.  Small lists never get one.
+ */
+struct counts_index
+{
+	std::unordered_map<const char *, counts *, counts_name_hash, counts_name_equal> names;
+	counts *tail;	/* last element of the list */
+};
+
+/**
+ * @brief
+ * 		build_counts_index - index every element of a counts list by name
+ *
+ * @param[in]	ctslist	- head of the counts list
+ *
+ * @return	new index
+ *
+ * @par MT-Safe:	no
+ */
+static counts_index *
+build_counts_index(counts *ctslist)
+{
+	counts_index *idx;
+	counts *cur;
+
+	idx = new counts_index();
+	idx->tail = NULL;
+	for (cur = ctslist; cur != NULL; cur = cur->next) {
+		if (cur->name != NULL)
+			idx->names.emplace(cur->name, cur);
+		idx->tail = cur;
+	}
+
+	return idx;
+}
+
+/**
+ * @brief
+ * 		lookup_counts - find a counts structure by name.  Short lists are
+ *		searched in order, long ones get a name index on their head.
+ *
+ * @param[in]	ctslist	- the counts list to search (not NULL)
+ * @param[in]	name	- the name to find
+ * @param[out]	last	- last element of the list if name was not found
+ *
+ * @return	found counts structure
+ * @retval	NULL	: not found
+ *
+ * @par MT-Safe:	no
+ */
+static counts *
+lookup_counts(counts *ctslist, const char *name, counts **last)
+{
+	counts *cur;
+	counts *prev = NULL;
+	int i;
+
+	if (ctslist->index == NULL) {
+		for (i = 0, cur = ctslist; cur != NULL && i < COUNTS_INDEX_MIN; cur = cur->next, i++) {
+			if (strcmp(cur->name, name) == 0)
+				return cur;
+			prev = cur;
+		}
+		if (cur == NULL) {
+			*last = prev;
+			return NULL;
+		}
+		ctslist->index = build_counts_index(ctslist);
+	}
+
+	/* catch up with anything linked in behind the index's back */
+	for (cur = ctslist->index->tail; cur->next != NULL; cur = cur->next)
+		if (cur->next->name != NULL)
+			ctslist->index->names.emplace(cur->next->name, cur->next);
+	ctslist->index->tail = cur;
+	*last = cur;
+
+	auto it = ctslist->index->names.find(name);
+	if (it == ctslist->index->names.end())
+		return NULL;
+
+	return it->second;
+}
+
+/**
+ * @brief
+ * 		link_counts - add a counts structure to the end of a list
+ *
+ * @param[in]	ctslist	- head of the counts list
+ * @param[in]	last	- last element of the list
+ * @param[in]	cts	- the counts structure to add
+ *
+ * @return	void
+ *
+ * @par MT-Safe:	no
+ */
+static void
+link_counts(counts *ctslist, counts *last, counts *cts)
+{
+	last->next = cts;
+	if (ctslist->index != NULL) {
+		if (cts->name != NULL)
+			ctslist->index->names.emplace(cts->name, cts);
+		ctslist->index->tail = cts;
+	}
+}
+
 /**
  * @brief
  * 		new_counts - create a new counts structure and return it
@@ -2624,6 +2877,7 @@ new_counts(void)
 	cts->running = 0;
 	cts->rescts = NULL;
 	cts->soft_limit_preempt_bit = 0;
+	cts->index = NULL;
 	cts->next = NULL;
 
 	return cts;
@@ -2651,6 +2905,8 @@ free_counts(counts *cts)
 	if (cts->rescts != NULL)
 		free_resource_count_list(cts->rescts);
 
+	delete cts->index;
+
 	cts->next = NULL;
 
 	free(cts);
@@ -2716,7 +2972,8 @@ dup_counts(counts *octs)
 
 /**
  * @brief
- * 		dup_counts_list - duplicate a counts list
+ * 		dup_counts_list - duplicate a counts list.  If the original list
+ *		was indexed, the copy is indexed as it is built.
  *
  * @param[in]	octs - the counts structure to duplicate
  *
@@ -2739,10 +2996,17 @@ dup_counts_list(counts *ctslist)
 
 	while (cur != NULL) {
 		if ((ncts = dup_counts(cur)) != NULL) {
-			if (nhead == NULL)
+			if (nhead == NULL) {
 				nhead = ncts;
-			else
-				prev->next = ncts;
+				if (ctslist->index != NULL) {
+					nhead->index = new counts_index();
+					nhead->index->names.reserve(ctslist->index->names.size());
+					nhead->index->tail = nhead;
+					if (nhead->name != NULL)
+						nhead->index->names.emplace(nhead->name, nhead);
+				}
+			} else
+				link_counts(nhead, prev, ncts);
 
 			prev = ncts;
 		}
@@ -2767,17 +3031,12 @@ dup_counts_list(counts *ctslist)
 counts *
 find_counts(counts *ctslist, const char *name)
 {
-	counts *cur;
+	counts *last;
 
 	if (ctslist == NULL || name == NULL)
 		return NULL;
 
-	cur = ctslist;
-
-	while (cur != NULL && strcmp(cur->name, name))
-		cur = cur->next;
-
-	return cur;
+	return lookup_counts(ctslist, name, &last);
 }
 
 /**
@@ -2796,31 +3055,26 @@ find_counts(counts *ctslist, const char *name)
 counts *
 find_alloc_counts(counts *ctslist, const char *name)
 {
-	counts *cur, *prev;
+	counts *cur;
+	counts *last = NULL;
 	counts *ncounts;
 
 	if (name == NULL)
 		return NULL;
 
-	prev = cur = ctslist;
-
-	while (cur != NULL && strcmp(cur->name, name)) {
-		prev = cur;
-		cur = cur->next;
-	}
+	if (ctslist != NULL && (cur = lookup_counts(ctslist, name, &last)) != NULL)
+		return cur;
 
-	if (cur == NULL) {
-		ncounts = new_counts();
+	ncounts = new_counts();
+	if (ncounts == NULL)
+		return NULL;
 
-		if (ncounts != NULL)
-			ncounts->name = string_dup(name);
+	ncounts->name = string_dup(name);
 
-		if (prev != NULL)
-			prev->next = ncounts;
+	if (last != NULL)
+		link_counts(ctslist, last, ncounts);
 
-		return ncounts;
-	} else
-		return cur;
+	return ncounts;
 }
 
 /**
@@ -2912,6 +3166,7 @@ counts_max(counts *cmax, counts *ncounts)
 	counts *cur;
 	counts *cur_fmax;
 	counts *cmax_head;
+	counts *last;
 	resource_count *cur_res;
 	resource_count *cur_res_max;
 
@@ -2924,7 +3179,7 @@ counts_max(counts *cmax, counts *ncounts)
 	cmax_head = cmax;
 
 	for (cur = ncounts; cur != NULL; cur = cur->next) {
-		cur_fmax = find_counts(cmax, cur->name);
+		cur_fmax = lookup_counts(cmax_head, cur->name, &last);
 		if (cur_fmax == NULL) {
 			cur_fmax = dup_counts(cur);
 			if (cur_fmax == NULL) {
@@ -2932,8 +3187,7 @@ counts_max(counts *cmax, counts *ncounts)
 				return NULL;
 			}
 
-			cur_fmax->next = cmax_head;
-			cmax_head = cur_fmax;
+			link_counts(cmax_head, last, cur_fmax);
 		} else {
 			if (cur->running > cur_fmax->running)
 				cur_fmax->running = cur->running;
@@ -3240,6 +3494,14 @@ resolve_indirect_resources(node_info **nodes)
 				cur_res->indirect_res = find_indirect_resource(cur_res, nodes);
 				if (cur_res->indirect_res == NULL)
 					error = 1;
+
+				/* both ends of an indirect resource hold pointers into
+				 * this universe, so they can't be shared by dup_node_info()
+				 */
+				nodes[i]->res_indirect = 1;
+				auto tnode = find_node_info(nodes, cur_res->indirect_vnode_name);
+				if (tnode != NULL)
+					tnode->res_indirect = 1;
 			}
 			cur_res = cur_res->next;
 		}
@@ -55,6 +55,7 @@
  * 	find_prev_timed_event()
  * 	set_timed_event_disabled()
  * 	find_timed_event()
+ * 	timed_event_precedes()
  * 	perform_event()
  * 	exists_run_event()
  * 	calc_run_time()
@@ -66,10 +67,11 @@
  * 	new_timed_event()
  * 	dup_timed_event()
  * 	find_event_ptr()
- * 	dup_timed_event_list()
  * 	free_timed_event()
  * 	free_timed_event_list()
  * 	add_event()
+ * 	link_timed_event()
+ * 	unlink_timed_event()
  * 	add_timed_event()
  * 	delete_event()
  * 	create_event()
@@ -558,6 +560,98 @@ timed_event *find_timed_event(timed_event *te_list, time_t event_time)
 	return find_timed_event(te_list, "", 0, TIMED_NOEVENT, event_time);
 }
 
+/**
+ * @brief
+ * 		determine if one event comes before another in a calendar
+ *
+ * @param[in]	a	- first event
+ * @param[in]	b	- second event
+ *
+ * @return	bool
+ * @retval	true	: a is before b in the calendar
+ * @retval	false	: a is b or a comes after b
+ */
+bool
+timed_event_precedes(timed_event *a, timed_event *b)
+{
+	timed_event *te;
+
+	if (a == NULL || b == NULL || a == b)
+		return false;
+
+	if (a->event_time != b->event_time)
+		return a->event_time < b->event_time;
+
+	/* same time: the order is determined by position in the calendar */
+	for (te = a->next; te != NULL && te->event_time == a->event_time; te = te->next)
+		if (te == b)
+			return true;
+
+	return false;
+}
+
+/**
+ * @brief
+ * 		find a timed_event in a calendar by any or all of the following:
+ *		event name, time of event, or event type.  This is the indexed
+ *		version of find_timed_event().  The calendar's name and time
+ *		indexes are used to find candidate events instead of walking
+ *		the entire calendar.
+ *
+ * @param[in]	calendar	- calendar to search in
+ * @param[in]	start		- only search from this event on (NULL for the whole calendar)
+ * @param[in]	name		- name of timed_event to search or empty to ignore
+ * @param[in]	ignore_disabled - ignore disabled events
+ * @param[in]	event_type	- event_type or TIMED_NOEVENT to ignore
+ * @param[in]	event_time	- time or 0 to ignore
+ *
+ * @return	the first matching timed_event in calendar order
+ * @retval	NULL	: no event found
+ */
+timed_event *
+find_timed_event(event_list *calendar, timed_event *start, const std::string &name,
+		 int ignore_disabled, enum timed_event_types event_type, time_t event_time)
+{
+	timed_event *found = NULL;
+
+	if (calendar == NULL)
+		return NULL;
+
+	if (name.empty()) {
+		timed_event *te_list;
+
+		if (event_time == 0)
+			te_list = (start != NULL) ? start : calendar->events;
+		else {
+			auto it = calendar->time_index.find(event_time);
+			if (it == calendar->time_index.end())
+				return NULL;
+			te_list = it->second;
+			if (timed_event_precedes(te_list, start))
+				te_list = start;
+		}
+		return find_timed_event(te_list, name, ignore_disabled, event_type, event_time);
+	}
+
+	auto range = calendar->name_index.equal_range(name);
+	for (auto it = range.first; it != range.second; it++) {
+		timed_event *te = it->second;
+
+		if (ignore_disabled && te->disabled)
+			continue;
+		if (event_type != TIMED_NOEVENT && event_type != te->event_type)
+			continue;
+		if (event_time != 0 && event_time != te->event_time)
+			continue;
+		if (timed_event_precedes(te, start))
+			continue;
+		if (found == NULL || timed_event_precedes(te, found))
+			found = te;
+	}
+
+	return found;
+}
+
 /**
  * @brief
  * 		takes a timed_event and performs any actions
@@ -843,7 +937,10 @@ create_event_list(server_info *sinfo)
 	if (elist == NULL)
 		return NULL;
 
-	elist->events = create_events(sinfo);
+	if (create_events(elist, sinfo) == 0) {
+		free_event_list(elist);
+		return NULL;
+	}
 
 	elist->next_event = elist->events;
 	elist->first_run_event = find_timed_event(elist->events, TIMED_RUN_EVENT);
@@ -855,18 +952,20 @@ create_event_list(server_info *sinfo)
 
 /**
  * @brief
- *		create_events - creates an timed_event list from running jobs
+ *		create_events - adds timed_events to a calendar from running jobs
  *			    and confirmed reservations
  *
+ * @param[in] calendar - calendar to add the events to
  * @param[in] sinfo - server universe to act upon
  *
- * @return	timed_event list
+ * @return	int
+ * @retval	1	: success
+ * @retval	0	: failure
  *
  */
-timed_event *
-create_events(server_info *sinfo)
+int
+create_events(event_list *calendar, server_info *sinfo)
 {
-	timed_event	*events = NULL;
 	timed_event	*te = NULL;
 	resource_resv	**all = NULL;
 	int		errflag = 0;
@@ -901,7 +1000,7 @@ create_events(server_info *sinfo)
 				errflag++;
 				break;
 			}
-			events = add_timed_event(events, te);
+			add_timed_event(calendar, te);
 		}
 
 		if (sinfo->use_hard_duration)
@@ -913,7 +1012,7 @@ create_events(server_info *sinfo)
 			errflag++;
 			break;
 		}
-		events = add_timed_event(events, te);
+		add_timed_event(calendar, te);
 	}
 
 	/* for nodes that are in state=sleep add a timed event */
@@ -926,19 +1025,17 @@ create_events(server_info *sinfo)
 				errflag++;
 				break;
 			}
-			events = add_timed_event(events, te);
+			add_timed_event(calendar, te);
 		}
 	}
 
-	/* A malloc error was encountered, free all allocated memory and return */
-	if (errflag > 0) {
-		free_timed_event_list(events);
-		free(all_resresv_copy);
+	free(all_resresv_copy);
+
+	/* A malloc error was encountered, the caller frees the calendar */
+	if (errflag > 0)
 		return 0;
-	}
 
-	free(all_resresv_copy);
-	return events;
+	return 1;
 }
 
 /**
@@ -953,13 +1050,14 @@ new_event_list()
 {
 	event_list *elist;
 
-	if ((elist = static_cast<event_list *>(malloc(sizeof(event_list)))) == NULL) {
+	if ((elist = new event_list()) == NULL) {
 		log_err(errno, __func__, MEM_ERR_MSG);
 		return NULL;
 	}
 
 	elist->eol = 0;
 	elist->events = NULL;
+	elist->last_event = NULL;
 	elist->next_event = NULL;
 	elist->first_run_event = NULL;
 	elist->current_time = NULL;
@@ -981,6 +1079,7 @@ event_list *
 dup_event_list(event_list *oelist, server_info *nsinfo)
 {
 	event_list *nelist;
+	timed_event *ote;
 
 	if (oelist == NULL || nsinfo == NULL)
 		return NULL;
@@ -993,36 +1092,38 @@ dup_event_list(event_list *oelist, server_info *nsinfo)
 	nelist->eol = oelist->eol;
 	nelist->current_time = &nsinfo->server_time;
 
-	if (oelist->events != NULL) {
-		nelist->events = dup_timed_event_list(oelist->events, nsinfo);
-		if (nelist->events == NULL) {
+	/* The old calendar is already in order, so each event is appended to the
+	 * end of the new calendar.  The next and first run events are mapped
+	 * to their copies as we go rather than searched for afterwards.
+	 */
+	for (ote = oelist->events; ote != NULL; ote = ote->next) {
+		timed_event *nte;
+
+		nte = dup_timed_event(ote, nsinfo);
+		if (nte == NULL) {
 			free_event_list(nelist);
 			return NULL;
 		}
+		link_timed_event(nelist, nte, NULL);
+
+		if (ote == oelist->next_event)
+			nelist->next_event = nte;
+		if (ote == oelist->first_run_event)
+			nelist->first_run_event = nte;
 	}
 
-	if (oelist->next_event != NULL) {
-		nelist->next_event = find_timed_event(nelist->events, oelist->next_event->name,
-						      oelist->next_event->event_type,
-						      oelist->next_event->event_time);
-		if (nelist->next_event == NULL) {
-			log_event(PBSEVENT_SCHED, PBS_EVENTCLASS_SCHED, LOG_WARNING,
+	if (oelist->next_event != NULL && nelist->next_event == NULL) {
+		log_event(PBSEVENT_SCHED, PBS_EVENTCLASS_SCHED, LOG_WARNING,
 			oelist->next_event->name, "can't find next event in duplicated list");
-			free_event_list(nelist);
-			return NULL;
-		}
+		free_event_list(nelist);
+		return NULL;
 	}
 
-	if (oelist->first_run_event != NULL) {
-		nelist->first_run_event =
-			find_timed_event(nelist->events, oelist->first_run_event->name, TIMED_RUN_EVENT,
-					 oelist->first_run_event->event_time);
-		if (nelist->first_run_event == NULL) {
-			log_event(PBSEVENT_SCHED, PBS_EVENTCLASS_SCHED, LOG_WARNING, oelist->first_run_event->name,
-				"can't find first run event event in duplicated list");
-			free_event_list(nelist);
-			return NULL;
-		}
+	if (oelist->first_run_event != NULL && nelist->first_run_event == NULL) {
+		log_event(PBSEVENT_SCHED, PBS_EVENTCLASS_SCHED, LOG_WARNING, oelist->first_run_event->name,
+			"can't find first run event event in duplicated list");
+		free_event_list(nelist);
+		return NULL;
 	}
 
 	return nelist;
@@ -1041,7 +1142,7 @@ free_event_list(event_list *elist)
 		return;
 
 	free_timed_event_list(elist->events);
-	free(elist);
+	delete elist;
 }
 
 /**
@@ -1145,23 +1246,24 @@ free_te_list(te_list *tel) {
 /*
  * @brief te_list copy constructor
  * @param[in] ote - te_list to copy
- * @param[in] new_timed_even_list - new timed events
+ * @param[in] ncalendar - new calendar to find the event in (from its next event on)
  *
  * @return copied te_list
  */
 te_list *
-dup_te_list(te_list *ote, timed_event *new_timed_event_list)
+dup_te_list(te_list *ote, event_list *ncalendar)
 {
 	te_list *nte;
 
-	if(ote == NULL || new_timed_event_list == NULL)
+	if(ote == NULL || ncalendar == NULL || ncalendar->next_event == NULL)
 		return NULL;
 
 	nte = new_te_list();
 	if(nte == NULL)
 		return NULL;
 
-	nte->event = find_timed_event(new_timed_event_list, ote->event->name, ote->event->event_type, ote->event->event_time);
+	nte->event = find_timed_event(ncalendar, ncalendar->next_event, ote->event->name, 0,
+		ote->event->event_type, ote->event->event_time);
 
 	return nte;
 }
@@ -1169,23 +1271,23 @@ dup_te_list(te_list *ote, timed_event *new_timed_event_list)
 /*
  * @brief copy constructor for a list of te_list structures
  * @param[in] ote - te_list to copy
- * @param[in] new_timed_even_list - new timed events
+ * @param[in] ncalendar - new calendar to find the events in
  *
  * @return copied te_list list
  */
 
 te_list *
-dup_te_lists(te_list *ote, timed_event *new_timed_event_list) {
+dup_te_lists(te_list *ote, event_list *ncalendar) {
 	te_list *nte;
 	te_list *end_te = NULL;
 	te_list *cur;
 	te_list *nte_head = NULL;
 
-	if (ote == NULL || new_timed_event_list == NULL)
+	if (ote == NULL || ncalendar == NULL || ncalendar->next_event == NULL)
 		return NULL;
 
 	for(cur = ote; cur != NULL; cur = cur->next) {
-		nte = dup_te_list(cur, new_timed_event_list);
+		nte = dup_te_list(cur, ncalendar);
 		if (nte == NULL) {
 			free_te_list(nte_head);
 			return NULL;
@@ -1330,45 +1432,6 @@ find_event_ptr(timed_event *ote, server_info *nsinfo)
 	return event_ptr;
 }
 
-/**
- * @brief
- *		dup_timed_event_list() - timed_event copy constructor for a list
- *
- * @param[in]	ote_list 	- list of timed_events to copy
- * @param[in]	nsinfo		- "new" universe where to find the event_ptr
- *
- * @return	timed_event *
- * @retval	NULL	: one of the input is null
- */
-timed_event *
-dup_timed_event_list(timed_event *ote_list, server_info *nsinfo)
-{
-	timed_event *ote;
-	timed_event *nte = NULL;
-	timed_event *nte_prev = NULL;
-	timed_event *nte_head = NULL;
-
-	if (ote_list == NULL || nsinfo == NULL)
-		return NULL;
-
-	for (ote = ote_list; ote != NULL; ote = ote->next) {
-		nte = dup_timed_event(ote, nsinfo);
-		if (nte == NULL) {
-			free_timed_event_list(nte_head);
-			return NULL;
-		}
-		if (nte_prev != NULL)
-			nte_prev->next = nte;
-		else
-			nte_head = nte;
-		nte->prev = nte_prev;
-
-		nte_prev = nte;
-	}
-
-	return nte_head;
-}
-
 /**
  * @brief
  * 		free_timed_event - timed_event destructor
@@ -1439,7 +1502,7 @@ add_event(event_list *calendar, timed_event *te)
 	if (calendar->events == NULL)
 		events_is_null = 1;
 
-	calendar->events = add_timed_event(calendar->events, te);
+	add_timed_event(calendar, te);
 
 	/* empty event list - the new event is the only event */
 	if (events_is_null)
@@ -1452,8 +1515,8 @@ add_event(event_list *calendar, timed_event *te)
 			if (te->event_time < calendar->next_event->event_time)
 				calendar->next_event = te;
 			else if (te->event_time == calendar->next_event->event_time) {
-				calendar->next_event =
-					find_timed_event(calendar->events, te->event_time);
+				/* the first event at this time */
+				calendar->next_event = calendar->time_index[te->event_time];
 			}
 		}
 	}
@@ -1476,54 +1539,134 @@ add_event(event_list *calendar, timed_event *te)
 
 /**
  * @brief
- * 		add_timed_event - add an event to a sorted list of events
- *
- * @note
- *		ASSUMPTION: if multiple events are at the same time, all
- *		    end events will come first
+ * 		link_timed_event - link an event into a calendar before another
+ *		event and update the calendar's indexes.  No ordering checks
+ *		are done.  The caller is responsible for choosing the correct
+ *		position.
  *
- * @param	events - event list to add event to
- * @param 	te     - timed_event to add to list
+ * @param[in]	calendar - calendar to link the event into
+ * @param[in]	te       - timed_event to link
+ * @param[in]	before   - event te is linked in front of (NULL for the end)
  *
- * @return	head of timed_event list
+ * @return	void
  */
-timed_event *
-add_timed_event(timed_event *events, timed_event *te)
+void
+link_timed_event(event_list *calendar, timed_event *te, timed_event *before)
 {
-	timed_event *eloop;
-	timed_event *eloop_prev = NULL;
+	if (calendar == NULL || te == NULL)
+		return;
 
-	if (te == NULL)
-		return events;
+	if (before == NULL) {
+		te->prev = calendar->last_event;
+		te->next = NULL;
+		if (calendar->last_event != NULL)
+			calendar->last_event->next = te;
+		else
+			calendar->events = te;
+		calendar->last_event = te;
+	} else {
+		te->prev = before->prev;
+		te->next = before;
+		if (before->prev != NULL)
+			before->prev->next = te;
+		else
+			calendar->events = te;
+		before->prev = te;
+	}
 
-	if (events == NULL)
-		return te;
+	/* te is the first event at its time */
+	if (te->prev == NULL || te->prev->event_time != te->event_time)
+		calendar->time_index[te->event_time] = te;
 
-	for (eloop = events; eloop != NULL; eloop = eloop->next) {
-		if (eloop->event_time > te->event_time)
-			break;
-		if (eloop->event_time == te->event_time &&
-			te->event_type == TIMED_END_EVENT) {
-			break;
-		}
+	calendar->name_index.emplace(te->name, te);
+}
+
+/**
+ * @brief
+ * 		unlink_timed_event - unlink an event from a calendar and update the
+ *		calendar's indexes.  The event is not freed.
+ *
+ * @param[in]	calendar - calendar to unlink the event from
+ * @param[in]	te       - timed_event to unlink
+ *
+ * @return	void
+ */
+void
+unlink_timed_event(event_list *calendar, timed_event *te)
+{
+	if (calendar == NULL || te == NULL)
+		return;
 
-		eloop_prev = eloop;
+	auto it = calendar->time_index.find(te->event_time);
+	if (it != calendar->time_index.end() && it->second == te) {
+		if (te->next != NULL && te->next->event_time == te->event_time)
+			it->second = te->next;
+		else
+			calendar->time_index.erase(it);
 	}
 
-	if (eloop_prev == NULL) {
-		te->next = events;
-		events->prev = te;
-		te->prev = NULL;
-		return te;
+	auto range = calendar->name_index.equal_range(te->name);
+	for (auto nit = range.first; nit != range.second; nit++) {
+		if (nit->second == te) {
+			calendar->name_index.erase(nit);
+			break;
+		}
 	}
 
-	te->next = eloop;
-	eloop_prev->next = te;
-	te->prev = eloop_prev;
-	if (eloop != NULL)
-		eloop->prev = te;
+	if (te->prev == NULL)
+		calendar->events = te->next;
+	else
+		te->prev->next = te->next;
+
+	if (te->next == NULL)
+		calendar->last_event = te->prev;
+	else
+		te->next->prev = te->prev;
 
-	return events;
+	te->next = NULL;
+	te->prev = NULL;
+}
+
+/**
+ * @brief
+ * 		add_timed_event - add an event to a calendar in time order
+ *
+ * @note
+ *		ASSUMPTION: if multiple events are at the same time, all
+ *		    end events will come first
+ *
+ * @par
+ *		The calendar's time index is used to find the insertion point
+ *		so this is O(log n) in the number of distinct event times.
+ *
+ * @param	calendar - calendar to add event to
+ * @param 	te       - timed_event to add to the calendar
+ *
+ * @return	void
+ */
+void
+add_timed_event(event_list *calendar, timed_event *te)
+{
+	timed_event *before;
+
+	if (calendar == NULL || te == NULL)
+		return;
+
+	auto it = calendar->time_index.lower_bound(te->event_time);
+	if (it != calendar->time_index.end() && it->first == te->event_time) {
+		/* end events go before all other events at the same time,
+		 * all other events go after them
+		 */
+		if (te->event_type == TIMED_END_EVENT)
+			before = it->second;
+		else {
+			it++;
+			before = (it != calendar->time_index.end()) ? it->second : NULL;
+		}
+	} else
+		before = (it != calendar->time_index.end()) ? it->second : NULL;
+
+	link_timed_event(calendar, te, before);
 }
 
 /**
@@ -1549,16 +1692,11 @@ delete_event(server_info *sinfo, timed_event *e)
 	if (calendar->next_event == e)
 		calendar->next_event = e->next;
 
+	/* there are no run events between the first run event and e */
 	if (calendar->first_run_event == e)
-		calendar->first_run_event = find_timed_event(calendar->events, TIMED_RUN_EVENT);
-
-	if (e->prev == NULL)
-		calendar->events = e->next;
-	else
-		e->prev->next = e->next;
+		calendar->first_run_event = find_init_timed_event(e->next, 0, TIMED_RUN_EVENT);
 
-	if (e->next != NULL)
-		e->next->prev = e->prev;
+	unlink_timed_event(calendar, e);
 
 	free_timed_event(e);
 }
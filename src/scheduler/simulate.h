@@ -139,6 +139,24 @@ timed_event *find_timed_event(timed_event *te_list, enum timed_event_types event
 timed_event *find_timed_event(timed_event *te_list, const std::string &name, enum timed_event_types event_type, time_t event_time);
 timed_event *find_timed_event(timed_event *te_list, time_t event_time);
 
+/*
+ *	find_timed_event - indexed version of find_timed_event() which uses the
+ *			   calendar's name and time indexes.
+ *
+ *	  calendar - calendar to search in
+ *	  start    - only search from this event on (NULL for the whole calendar)
+ *
+ *	return first matching timed_event in calendar order or NULL
+ */
+timed_event *
+find_timed_event(event_list *calendar, timed_event *start, const std::string &name,
+		 int ignore_disabled, enum timed_event_types event_type, time_t event_time);
+
+/*
+ *	timed_event_precedes - is event a before event b in the calendar
+ */
+bool timed_event_precedes(timed_event *a, timed_event *b);
+
 /*
  *      next_event - move an event_list to the next event and return it
  *
@@ -191,15 +209,15 @@ int exists_resv_event(event_list *calendar, time_t end);
 
 
 /*
- *      create_events - creates an timed_event list from running jobs
+ *      create_events - adds timed_events to a calendar from running jobs
  *                          and confirmed reservations
  *
+ *        \param calendar - calendar to add the events to
  *        \param sinfo - server universe to act upon
- *        \param flags -
  *
- *        \return timed_event list
+ *        \return 1 on success / 0 on failure
  */
-timed_event *create_events(server_info *sinfo);
+int create_events(event_list *calendar, server_info *sinfo);
 
 /*
  * new_event_list() - event_list constructor
@@ -242,14 +260,6 @@ timed_event *new_timed_event();
  */
 timed_event *dup_timed_event(timed_event *ote, server_info *nsinfo);
 
-/*
- *      dup_timed_event_list() - timed_event copy constructor for a list
- *
- *        \param ote_list - list of timed_events to copy
- *        \param nsinfo - "new" universe where to find the event_ptr
- */
-timed_event *dup_timed_event_list(timed_event *ote_list, server_info *nsinfo);
-
 /*
  * free_timed_event - timed_event destructor
  */
@@ -294,17 +304,28 @@ timed_event *find_event_by_name(timed_event *events, char *name);
 
 
 /*
- *      add_timed_event - add an event to a sorted list of events
+ *      add_timed_event - add an event to a calendar in time order
  *
  *      ASSUMPTION: if multiple events are at the same time, all
  *                  end events will come first
  *
- *        \param events - event list to add event to
- *        \param te     - timed_event to add to list
- *
- *      \return head of timed_event list
+ *        \param calendar - calendar to add event to
+ *        \param te       - timed_event to add to the calendar
+ */
+void add_timed_event(event_list *calendar, timed_event *te);
+
+/*
+ *      link_timed_event - link an event into a calendar in front of
+ *                         another event (NULL for the end) and update
+ *                         the calendar's indexes
+ */
+void link_timed_event(event_list *calendar, timed_event *te, timed_event *before);
+
+/*
+ *      unlink_timed_event - unlink an event from a calendar and update
+ *                           the calendar's indexes.  The event is not freed.
  */
-timed_event *add_timed_event(timed_event *events, timed_event *te);
+void unlink_timed_event(event_list *calendar, timed_event *te);
 /*
  *
  *	add_event - add a timed_event to an event list
@@ -447,8 +468,8 @@ generic_sim(event_list *calendar, unsigned int event_mask, time_t end, int defau
 
 te_list *new_te_list();
 
-te_list *dup_te_list(te_list *ote, timed_event *new_timed_event_list);
-te_list *dup_te_lists(te_list *ote, timed_event *new_timed_event_list);
+te_list *dup_te_list(te_list *ote, event_list *ncalendar);
+te_list *dup_te_lists(te_list *ote, event_list *ncalendar);
 
 void free_te_list(te_list *tel);
 
@@ -62,6 +62,7 @@
  * 	resresv_sort_cmp()
  * 	node_sort_cmp()
  * 	cmp_sort()
+ * 	sort_job_array()
  * 	find_nodepart_amount()
  * 	find_node_amount()
  * 	find_resresv_amount()
@@ -74,6 +75,8 @@
  * 	qsort()
  *
  */
+#include <algorithm>
+
 #include <pbs_config.h>
 
 #include <stdio.h>
@@ -93,6 +96,7 @@
 #include "constant.h"
 #include "server_info.h"
 #include "resource.h"
+#include "multi_threading.h"
 
 #ifdef NAS
 #include "site_code.h"
@@ -832,6 +836,177 @@ cmp_sort(const void *v1, const void *v2)
 		}
 	}
 }
+/* fewest jobs worth extracting sort keys for on the thread pool */
+#define SORT_KEY_CHUNK_MIN 512
+
+/*
+ * Everything cmp_sort() looks at for one job, pulled out once per sort.
+ * The job_sort_key resource values live in a shared table, nkeys per job.
+ */
+struct job_sort_key {
+	resource_resv *resresv;
+	bool runnable;
+	unsigned int preempt;
+	time_t time_preempted;
+	float formula_value;
+	long long qrank;
+	int rank;
+	size_t vidx;		/* index of the job's first value in the table */
+};
+
+/* sort key extraction arguments for the thread pool */
+struct job_sort_keys {
+	resource_resv **jobs;
+	job_sort_key *keys;
+	sch_resource_t *vals;
+	size_t nkeys;
+};
+
+/**
+ * @brief	thread pool callback to extract the sort keys for a range of jobs
+ *
+ * @param[in,out]	arg - job_sort_keys
+ * @param[in]	sidx - first job
+ * @param[in]	eidx - last job
+ *
+ * @return	void
+ */
+static void
+extract_sort_keys_chunk(void *arg, int sidx, int eidx)
+{
+	job_sort_keys *jk = static_cast<job_sort_keys *>(arg);
+
+	for (int i = sidx; i <= eidx; i++) {
+		resource_resv *r = jk->jobs[i];
+		job_sort_key& k = jk->keys[i];
+		size_t j = 0;
+
+		k.resresv = r;
+		k.runnable = in_runnable_state(r);
+		k.preempt = r->job->preempt;
+		k.time_preempted = r->job->time_preempted;
+		k.formula_value = r->job->formula_value;
+		k.qrank = r->qrank;
+		k.rank = r->rank;
+		k.vidx = i * jk->nkeys;
+		for (const auto& si : *cstat.sort_by)
+			jk->vals[k.vidx + j++] = find_resresv_amount(r, si.res_name, si.def);
+	}
+}
+
+/**
+ * @brief
+ * 		compare two extracted job sort keys the same way cmp_sort()
+ *		compares the jobs themselves
+ *
+ * @param[in]	k1	-	key of job 1
+ * @param[in]	k2	-	key of job 2
+ * @param[in]	vals	-	resource value table
+ *
+ * @return	-1,0,1 : standard qsort() cmp
+ */
+static int
+cmp_sort_key(const job_sort_key& k1, const job_sort_key& k2, const sch_resource_t *vals)
+{
+	int cmp;
+
+	if (k1.runnable && !k2.runnable)
+		return -1;
+	if (k2.runnable && !k1.runnable)
+		return 1;
+
+	/* sort based on preemption */
+	if (k1.preempt < k2.preempt)
+		return 1;
+	if (k1.preempt > k2.preempt)
+		return -1;
+
+	/* preempted jobs first, oldest preemption first */
+	if (k1.time_preempted != k2.time_preempted) {
+		if (k2.time_preempted == UNSPECIFIED)
+			return -1;
+		if (k1.time_preempted == UNSPECIFIED)
+			return 1;
+		return (k1.time_preempted < k2.time_preempted) ? -1 : 1;
+	}
+
+	/* sort on the basis of job sort formula */
+	if (k1.formula_value < k2.formula_value)
+		return 1;
+	if (k1.formula_value > k2.formula_value)
+		return -1;
+#ifndef NAS /* localmod 041 */
+	if (k1.resresv->server->policy->fair_share) {
+		cmp = cmp_fairshare(&k1.resresv, &k2.resresv);
+		if (cmp != 0)
+			return cmp;
+	}
+#endif /* localmod 041 */
+
+	/* normal resource based sort */
+	size_t i = 0;
+	for (const auto& si : *cstat.sort_by) {
+		sch_resource_t v1 = vals[k1.vidx + i];
+		sch_resource_t v2 = vals[k2.vidx + i];
+
+		i++;
+		if (v1 == v2)
+			continue;
+		if (si.order == ASC)
+			return (v1 < v2) ? -1 : 1;
+		else
+			return (v1 < v2) ? 1 : -1;
+	}
+
+	/* stabilize the sort */
+	if (k1.qrank < k2.qrank)
+		return -1;
+	else if (k1.qrank > k2.qrank)
+		return 1;
+	if (k1.rank < k2.rank)
+		return -1;
+	else if (k1.rank > k2.rank)
+		return 1;
+	return 0;
+}
+
+/**
+ * @brief
+ * 		sort an array of jobs into cmp_sort() order.  The values cmp_sort()
+ *		would look up on every comparison are extracted once per job
+ *		first (on the thread pool for large arrays) and the keys are sorted.
+ *
+ * @param[in,out]	jobs	-	array of jobs to sort
+ * @param[in]	njobs	-	number of jobs in the array
+ *
+ * @return	void
+ */
+void
+sort_job_array(resource_resv **jobs, int njobs)
+{
+	job_sort_keys jk;
+
+	if (jobs == NULL || njobs < 2)
+		return;
+
+	std::vector<job_sort_key> keys(njobs);
+	std::vector<sch_resource_t> vals(njobs * cstat.sort_by->size());
+
+	jk.jobs = jobs;
+	jk.keys = keys.data();
+	jk.vals = vals.data();
+	jk.nkeys = cstat.sort_by->size();
+	mt_parallel_for(njobs, SORT_KEY_CHUNK_MIN, extract_sort_keys_chunk, &jk);
+
+	const sch_resource_t *v = vals.data();
+	std::sort(keys.begin(), keys.end(), [v](const job_sort_key& k1, const job_sort_key& k2) {
+		return cmp_sort_key(k1, k2, v) < 0;
+	});
+
+	for (int i = 0; i < njobs; i++)
+		jobs[i] = keys[i].resresv;
+}
+
 /**
  * @brief
  * 		return resource values based on res_type for node partition
@@ -1210,8 +1385,7 @@ sort_jobs(status *policy, server_info *sinfo)
 			 */
 			for (int i = 0; i < sinfo->num_queues; i++) {
 				if (sinfo->queues[i]->sc.total > 0) {
-					qsort(sinfo->queues[i]->jobs, sinfo->queues[i]->sc.total,
-						sizeof(resource_resv*), cmp_sort);
+					sort_job_array(sinfo->queues[i]->jobs, sinfo->queues[i]->sc.total);
 				}
 			}
 			for (int count = 0; count != sinfo->num_queues; count++) {
@@ -1224,14 +1398,14 @@ sort_jobs(status *policy, server_info *sinfo)
 		}
 		/** Sort on entire complex **/
 		else if (!policy->by_queue && !policy->round_robin) {
-			qsort(sinfo->jobs, count_array(sinfo->jobs), sizeof(resource_resv *), cmp_sort);
+			sort_job_array(sinfo->jobs, count_array(sinfo->jobs));
 		}
 	}
 	else if (policy->by_queue) {
 		for (int i = 0; i < sinfo->num_queues; i++) {
-			qsort(sinfo->queues[i]->jobs, count_array(sinfo->queues[i]->jobs), sizeof(resource_resv *), cmp_sort);
+			sort_job_array(sinfo->queues[i]->jobs, count_array(sinfo->queues[i]->jobs));
 		}
-		qsort(sinfo->jobs, count_array(sinfo->jobs), sizeof(resource_resv*), cmp_sort);
+		sort_job_array(sinfo->jobs, count_array(sinfo->jobs));
 	}
 	else if (policy->round_robin) {
 		if (sinfo -> queue_list != NULL) {
@@ -1241,13 +1415,12 @@ sort_jobs(status *policy, server_info *sinfo)
 				int queue_index_size = count_array(sinfo->queue_list[i]);
 				for (int j = 0; j < queue_index_size; j++)
 				{
-					qsort(sinfo->queue_list[i][j]->jobs, count_array(sinfo->queue_list[i][j]->jobs),
-						sizeof(resource_resv *), cmp_sort);
+					sort_job_array(sinfo->queue_list[i][j]->jobs, count_array(sinfo->queue_list[i][j]->jobs));
 				}
 			}
 
 		}
 	}
 	else
-		qsort(sinfo->jobs, count_array(sinfo->jobs), sizeof(resource_resv*), cmp_sort);
+		sort_job_array(sinfo->jobs, count_array(sinfo->jobs));
 }
@@ -115,6 +115,12 @@ int cmp_job_sort_formula(const void *j1, const void *j2);
  */
 int cmp_sort(const void *v1, const void *v2);
 
+/*
+ *      sort_job_array - sort jobs in cmp_sort() order from keys extracted
+ *                       once per job
+ */
+void sort_job_array(resource_resv **jobs, int njobs);
+
 /*
  *      find_resresv_amount - find resource amount for jobs + special cases
  */
@@ -47,6 +47,7 @@
  * Functions included are:
  *	acct_open()
  *	acct_record()
+ *	acct_flush()
  *	acct_close()
  */
 
@@ -56,12 +57,15 @@
 #include "portability.h"
 #include <sys/param.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <string.h>
 #include <errno.h>
 #include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <unistd.h>
+#include <pthread.h>
 #include "list_link.h"
 #include "attribute.h"
 #include "resource.h"
@@ -87,6 +91,21 @@ static char *acct_buf = 0;
 static int acct_bufsize = PBS_ACCT_MAX_RCD;
 static const char *do_not_emit_alter[] = {ATTR_estimated, ATTR_used, NULL};
 
+/*
+ * When the server attribute acct_sync_interval is set, records are gathered
+ * in acct_wbuf and written out in one go at the end of each iteration of
+ * the server's main loop (acct_flush), or sooner when the buffer fills.
+ */
+#define ACCT_WBUF_SIZE	65536
+#define ACCT_TSTAMP_LEN	19	/* "mm/dd/yyyy hh:mm:ss" */
+static char *acct_wbuf = NULL;
+static size_t acct_wlen = 0;
+static time_t acct_synced;	/* time of the last fsync of acctfile */
+static int acct_unsynced = 0;	/* records written since the last fsync */
+static int acct_inchild = 0;	/* in a child forked by the server */
+static time_t acct_tstamp_sec = -1;
+static char acct_tstamp[ACCT_TSTAMP_LEN + 1];
+
 /* Global Data */
 
 extern char *acctlog_spacechar;
@@ -122,7 +141,10 @@ grow_acct_buf(char **pb, int *avail, int need)
 	size_t ln;
 	char *new;
 
+	/* grow at least twofold so that long records cost few reallocations */
 	ln = acct_bufsize + need + need + PBS_ACCT_LEAVE_EXTRA;
+	if (ln < (size_t) acct_bufsize * 2)
+		ln = (size_t) acct_bufsize * 2;
 	new = realloc(acct_buf, (size_t)(ln+1));
 	if (new == NULL) {
 		log_err(errno, __func__, "realloc failure");
@@ -904,6 +926,74 @@ acct_resv(resc_resv *presv, char *buf, int len)
 	return (pb);
 }
 
+/**
+ * @brief
+ *	Write out a block of accounting data, retrying after short writes.
+ *
+ * @param[in]	iov - the data
+ * @param[in]	iovcnt - number of entries in iov
+ *
+ * @return	void
+ */
+static void
+acct_writev(struct iovec *iov, int iovcnt)
+{
+	ssize_t n;
+
+	while (iovcnt > 0) {
+		n = writev(fileno(acctfile), iov, iovcnt);
+		if (n == -1) {
+			if (errno == EINTR)
+				continue;
+			log_err(errno, __func__, "accounting record write failed");
+			return;
+		}
+		while (iovcnt > 0 && (size_t) n >= iov->iov_len) {
+			n -= iov->iov_len;
+			iov++;
+			iovcnt--;
+		}
+		if (iovcnt > 0) {
+			iov->iov_base = (char *) iov->iov_base + n;
+			iov->iov_len -= n;
+		}
+	}
+	acct_unsynced = 1;
+}
+
+/**
+ * @brief
+ *	Write out the accounting records gathered in acct_wbuf.
+ *
+ * @return	void
+ */
+static void
+acct_write_buffered(void)
+{
+	struct iovec iov;
+
+	if (acct_wlen == 0)
+		return;
+	iov.iov_base = acct_wbuf;
+	iov.iov_len = acct_wlen;
+	acct_wlen = 0;
+	acct_writev(&iov, 1);
+}
+
+/**
+ * @brief
+ *	Child side of fork(): the parent writes out the records that were
+ *	buffered when it forked, the child writes its own records directly.
+ *
+ * @return	void
+ */
+static void
+acct_atfork_child(void)
+{
+	acct_wlen = 0;
+	acct_inchild = 1;
+}
+
 /**
  * @brief
  * acct_open() - open the acct file for append.
@@ -931,6 +1021,12 @@ acct_open(char *filename)
 		if (acct_buf == NULL)
 			return (-1);
 	}
+	if (acct_wbuf == NULL) {
+		acct_wbuf = (char *)malloc(ACCT_WBUF_SIZE);
+		if (acct_wbuf == NULL)
+			return (-1);
+		(void)pthread_atfork(NULL, NULL, acct_atfork_child);
+	}
 
 	if (filename == NULL) {	/* go with default */
 		now = time(0);
@@ -951,13 +1047,15 @@ acct_open(char *filename)
 		return (-1);
 	}
 
-	(void)setvbuf(newacct, NULL, _IOLBF, 0); /* set line buffering */
-
-	if (acct_opened > 0) 		/* if acct was open, close it */
+	if (acct_opened > 0) {		/* if acct was open, close it */
+		acct_write_buffered();
 		(void)fclose(acctfile);
+	}
 
 	acctfile = newacct;
 	acct_opened = 1;			/* note that file is open */
+	acct_synced = time(0);
+	acct_unsynced = 0;
 	(void)sprintf(logmsg, "Account file %s opened", filename);
 	log_event(PBSEVENT_SYSTEM, PBS_EVENTCLASS_SERVER, LOG_INFO,
 		"Act", logmsg);
@@ -965,6 +1063,36 @@ acct_open(char *filename)
 	return (0);
 }
 
+/**
+ * @brief
+ * acct_flush - write out the buffered accounting records and, once every
+ *	acct_sync_interval seconds, sync the accounting file to disk.
+ *
+ * @par
+ *	Called at the end of each iteration of the server's main loop.
+ *
+ * @return	void
+ */
+void
+acct_flush(void)
+{
+	long interval;
+
+	if (acct_opened == 0)
+		return;
+	acct_write_buffered();
+
+	if (!acct_unsynced || !is_sattr_set(SVR_ATR_acct_sync_interval))
+		return;
+	interval = get_sattr_long(SVR_ATR_acct_sync_interval);
+	if (interval <= 0 || time_now - acct_synced < interval)
+		return;
+	if (fsync(fileno(acctfile)) == -1)
+		log_err(errno, __func__, "accounting file sync failed");
+	acct_synced = time_now;
+	acct_unsynced = 0;
+}
+
 /**
  * @brief
  * acct_close - close the current open log file
@@ -975,6 +1103,10 @@ void
 acct_close()
 {
 	if (acct_opened == 1) {
+		acct_write_buffered();
+		if (acct_unsynced && is_sattr_set(SVR_ATR_acct_sync_interval) &&
+			get_sattr_long(SVR_ATR_acct_sync_interval) > 0)
+			(void)fsync(fileno(acctfile));
 		(void)fclose(acctfile);
 		acct_opened = 0;
 	}
@@ -984,6 +1116,11 @@ acct_close()
  * @brief
  * write_account_record - write basic accounting record
  *
+ * @par
+ *	The time stamp is formatted once per second.  If the server attribute
+ *	acct_sync_interval is set, the record is buffered until acct_flush(),
+ *	otherwise it is written out at once.
+ *
  * @param[in]	acctype - accounting record type
  * @param[in]	id - accounting record id
  * @param[in,out]	text - text to log, may be null
@@ -994,26 +1131,70 @@ void
 write_account_record(int acctype, const char *id, char *text)
 {
 	struct tm *ptm;
+	char hdr[ACCT_TSTAMP_LEN + 4];
+	struct iovec iov[5];
+	size_t idlen;
+	size_t textlen;
+	size_t need;
+	char *p;
 
 	if (acct_opened == 0)
 		return;		/* file not open, don't bother */
 
-	ptm = localtime(&time_now);
+	if (time_now != acct_tstamp_sec) {
+		ptm = localtime(&time_now);
 
-	/* Do we need to switch files */
+		/* Do we need to switch files */
 
-	if (acct_auto_switch && (acct_opened_day != ptm->tm_yday)) {
-		acct_close();
-		acct_open(NULL);
+		if (acct_auto_switch && (acct_opened_day != ptm->tm_yday)) {
+			acct_close();
+			acct_open(NULL);
+		}
+		(void)strftime(acct_tstamp, sizeof(acct_tstamp), "%m/%d/%Y %H:%M:%S", ptm);
+		acct_tstamp_sec = time_now;
 	}
 	if (text == NULL)
 		text = "";
 
-	(void)fprintf(acctfile,
-		"%02d/%02d/%04d %02d:%02d:%02d;%c;%s;%s\n",
-		ptm->tm_mon+1, ptm->tm_mday, ptm->tm_year+1900,
-		ptm->tm_hour, ptm->tm_min, ptm->tm_sec,
-		(char)acctype, id, text);
+	memcpy(hdr, acct_tstamp, ACCT_TSTAMP_LEN);
+	hdr[ACCT_TSTAMP_LEN] = ';';
+	hdr[ACCT_TSTAMP_LEN + 1] = (char)acctype;
+	hdr[ACCT_TSTAMP_LEN + 2] = ';';
+	idlen = strlen(id);
+	textlen = strlen(text);
+	need = ACCT_TSTAMP_LEN + 3 + idlen + 1 + textlen + 1;
+
+	if (!acct_inchild && is_sattr_set(SVR_ATR_acct_sync_interval) &&
+		get_sattr_long(SVR_ATR_acct_sync_interval) > 0) {
+		if (acct_wlen + need > ACCT_WBUF_SIZE)
+			acct_write_buffered();
+		if (need <= ACCT_WBUF_SIZE) {
+			p = acct_wbuf + acct_wlen;
+			memcpy(p, hdr, ACCT_TSTAMP_LEN + 3);
+			p += ACCT_TSTAMP_LEN + 3;
+			memcpy(p, id, idlen);
+			p += idlen;
+			*p++ = ';';
+			memcpy(p, text, textlen);
+			p += textlen;
+			*p = '\n';
+			acct_wlen += need;
+			return;
+		}
+	} else
+		acct_write_buffered();
+
+	iov[0].iov_base = hdr;
+	iov[0].iov_len = ACCT_TSTAMP_LEN + 3;
+	iov[1].iov_base = (char *) id;
+	iov[1].iov_len = idlen;
+	iov[2].iov_base = ";";
+	iov[2].iov_len = 1;
+	iov[3].iov_base = text;
+	iov[3].iov_len = textlen;
+	iov[4].iov_base = "\n";
+	iov[4].iov_len = 1;
+	acct_writev(iov, 5);
 }
 
 /**
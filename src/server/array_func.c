@@ -227,6 +227,57 @@ find_arrayparent(char *subjobid)
 	return (find_job(idbuf));
 }
 
+/**
+ * @brief
+ * 		subjob_flags - find the flags of a subjob index in the tracking table
+ *		of its Array Job
+ *
+ * @param[in]	ptbl - tracking table of the Array Job
+ * @param[in]	sjidx - subjob index
+ *
+ * @return	unsigned char *
+ * @retval	pointer to the TKM_SJ_* flags of the index
+ * @retval	NULL	- index is not one of the Array Job
+ */
+static unsigned char *
+subjob_flags(ajinfo_t *ptbl, int sjidx)
+{
+	if (ptbl == NULL || ptbl->tkm_sjflags == NULL)
+		return NULL;
+
+	if (sjidx < ptbl->tkm_start || sjidx > ptbl->tkm_end)
+		return NULL;
+
+	if (((sjidx - ptbl->tkm_start) % ptbl->tkm_step) != 0)
+		return NULL;
+
+	return &ptbl->tkm_sjflags[(sjidx - ptbl->tkm_start) / ptbl->tkm_step];
+}
+
+/**
+ * @brief
+ * 		is_subjob_queued - is a subjob index queued, i.e. in the
+ *		array_indices_remaining of its Array Job
+ *
+ * @param[in]	parent - pointer to the parent job
+ * @param[in]	sjidx - subjob index
+ *
+ * @return	int
+ * @retval	1	- queued
+ * @retval	0	- not queued, or not an index of the Array Job
+ */
+int
+is_subjob_queued(job *parent, int sjidx)
+{
+	unsigned char *pflags;
+
+	if (parent == NULL)
+		return 0;
+
+	pflags = subjob_flags(parent->ji_ajinfo, sjidx);
+	return (pflags != NULL && (*pflags & TKM_SJ_QUEUED));
+}
+
 /**
  * @brief
  * 		update_array_indices_remaining_attr - updates array_indices_remaining attribute
@@ -264,9 +315,7 @@ update_sj_parent(job *parent, job *sj, char *sjid, char oldstate, char newstate)
 	int idx;
 	int ostatenum;
 	int nstatenum;
-
-	if (oldstate == newstate)
-		return;
+	unsigned char *pflags;
 
 	if (parent == NULL || sjid == NULL || sjid[0] == '\0' || (idx = get_index_from_jid(sjid)) == -1)
 		return;
@@ -275,6 +324,13 @@ update_sj_parent(job *parent, job *sj, char *sjid, char oldstate, char newstate)
 	if (ptbl == NULL)
 		return;
 
+	pflags = subjob_flags(ptbl, idx);
+	if (sj && pflags)
+		*pflags |= TKM_SJ_CREATED;	/* also recovered subjobs, see pbsd_init() */
+
+	if (oldstate == newstate)
+		return;
+
 	ostatenum = state_char2int(oldstate);
 	nstatenum = state_char2int(newstate);
 	if (ostatenum == -1 || nstatenum == -1)
@@ -283,10 +339,16 @@ update_sj_parent(job *parent, job *sj, char *sjid, char oldstate, char newstate)
 	ptbl->tkm_subjsct[ostatenum]--;
 	ptbl->tkm_subjsct[nstatenum]++;
 
-	if (oldstate == JOB_STATE_LTR_QUEUED)
+	if (oldstate == JOB_STATE_LTR_QUEUED) {
 		range_remove_value(&ptbl->trm_quelist, idx);
-	if (newstate == JOB_STATE_LTR_QUEUED)
+		if (pflags)
+			*pflags &= ~TKM_SJ_QUEUED;
+	}
+	if (newstate == JOB_STATE_LTR_QUEUED) {
 		range_add_value(&ptbl->trm_quelist, idx, ptbl->tkm_step);
+		if (pflags)
+			*pflags |= TKM_SJ_QUEUED;
+	}
 	update_array_indices_remaining_attr(parent);
 
 	if (sj && newstate != JOB_STATE_LTR_QUEUED) {
@@ -383,7 +445,8 @@ chk_array_doneness(job *parent)
 job *
 get_subjob_and_state(job *parent, int sjidx, char *state, int *substate)
 {
-	job *sj;
+	job *sj = NULL;
+	unsigned char *pflags;
 
 	if (state)
 		*state = JOB_STATE_LTR_UNKNOWN;
@@ -393,15 +456,14 @@ get_subjob_and_state(job *parent, int sjidx, char *state, int *substate)
 	if (parent == NULL || sjidx < 0)
 		return NULL;
 
-	if (sjidx < parent->ji_ajinfo->tkm_start || sjidx > parent->ji_ajinfo->tkm_end)
+	if ((pflags = subjob_flags(parent->ji_ajinfo, sjidx)) == NULL)
 		return NULL;
 
-	if (((sjidx - parent->ji_ajinfo->tkm_start) % parent->ji_ajinfo->tkm_step) != 0)
-		return NULL;
-
-	sj = find_job(create_subjob_id(parent->ji_qs.ji_jobid, sjidx));
+	/* no need to build the id and look it up if the subjob was never created */
+	if (*pflags & TKM_SJ_CREATED)
+		sj = find_job(create_subjob_id(parent->ji_qs.ji_jobid, sjidx));
 	if (sj == NULL) {
-		if (range_contains(parent->ji_ajinfo->trm_quelist, sjidx)) {
+		if (*pflags & TKM_SJ_QUEUED) {
 			if (state)
 				*state = JOB_STATE_LTR_QUEUED;
 			if (substate)
@@ -518,6 +580,7 @@ setup_ajinfo(job *pjob, int mode)
 
 	if (pjob->ji_ajinfo) {
 		free_range_list(pjob->ji_ajinfo->trm_quelist);
+		free(pjob->ji_ajinfo->tkm_sjflags);
 		free(pjob->ji_ajinfo);
 	}
 	pjob->ji_ajinfo = NULL;
@@ -543,15 +606,22 @@ setup_ajinfo(job *pjob, int mode)
 		return PBSE_SYSTEM;
 	for (i = 0; i < PBS_NUMJOBSTATE; i++)
 		trktbl->tkm_subjsct[i] = 0;
+	trktbl->tkm_sjflags = calloc((end - start) / step + 1, sizeof(unsigned char));
+	if (trktbl->tkm_sjflags == NULL) {
+		free(trktbl);
+		return PBSE_SYSTEM;
+	}
 	if (mode == ATR_ACTION_RECOV || mode == ATR_ACTION_ALTER)
 		trktbl->trm_quelist = NULL;
 	else {
 		trktbl->trm_quelist = new_range(start, end, step, count, NULL);
 		if (trktbl->trm_quelist == NULL) {
+			free(trktbl->tkm_sjflags);
 			free(trktbl);
 			return PBSE_SYSTEM;
 		}
 		trktbl->tkm_subjsct[JOB_STATE_QUEUED] = count;
+		memset(trktbl->tkm_sjflags, TKM_SJ_QUEUED, (end - start) / step + 1);
 	}
 	trktbl->tkm_dsubjsct = 0;
 	trktbl->tkm_ct = count;
@@ -628,6 +698,9 @@ fixup_arrayindicies(attribute *pattr, void *pobj, int mode)
 	job *pjob = pobj;
 	char *range;
 	int qcount;
+	int i;
+	struct range *pr;
+	unsigned char *pflags;
 
 	if (!pjob || !(pjob->ji_qs.ji_svrflags & JOB_SVFLG_ArrayJob) || !pjob->ji_ajinfo)
 		return PBSE_BADATVAL;
@@ -650,6 +723,13 @@ fixup_arrayindicies(attribute *pattr, void *pobj, int mode)
 		return PBSE_BADATVAL;
 	}
 
+	for (pr = pjob->ji_ajinfo->trm_quelist; pr != NULL; pr = pr->next) {
+		for (i = pr->start; i <= pr->end; i += pr->step) {
+			if ((pflags = subjob_flags(pjob->ji_ajinfo, i)) != NULL)
+				*pflags |= TKM_SJ_QUEUED;
+		}
+	}
+
 	qcount = range_count(pjob->ji_ajinfo->trm_quelist);
 	pjob->ji_ajinfo->tkm_subjsct[JOB_STATE_QUEUED] = qcount;
 	pjob->ji_ajinfo->tkm_subjsct[JOB_STATE_EXPIRED] = pjob->ji_ajinfo->tkm_ct - qcount;
@@ -683,6 +763,7 @@ create_subjob(job *parent, char *newjid, int *rc)
 	long long time_usec;
 	struct timeval tval;
 	char path[MAXPATHLEN + 1];
+	unsigned char *pflags;
 
 	if (newjid == NULL) {
 		*rc = PBSE_IVALREQ;
@@ -751,6 +832,8 @@ create_subjob(job *parent, char *newjid, int *rc)
 
 	subj->ji_qs.ji_svrflags &= ~JOB_SVFLG_ArrayJob;
 	subj->ji_qs.ji_svrflags |=  JOB_SVFLG_SubJob;
+	if ((pflags = subjob_flags(parent->ji_ajinfo, atoi(index))) != NULL)
+		*pflags |= TKM_SJ_CREATED;
 	set_job_substate(subj, JOB_SUBSTATE_TRANSICM);
 	svr_setjobstate(subj, JOB_STATE_LTR_QUEUED, JOB_SUBSTATE_QUEUED);
 
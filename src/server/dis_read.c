@@ -529,6 +529,10 @@ dis_request_read(int sfds, struct batch_request *request)
 			rc = decode_DIS_Status(sfds, request);
 			break;
 
+		case PBS_BATCH_StatusDelta:
+			rc = decode_DIS_StatusDelta(sfds, request);
+			break;
+
 		case PBS_BATCH_PySpawn:
 			rc = decode_DIS_PySpawn(sfds, request);
 			break;
@@ -568,6 +572,14 @@ dis_request_read(int sfds, struct batch_request *request)
 			rc = decode_DIS_Run(sfds, request);
 			break;
 
+		case PBS_BATCH_RunJobList:
+			rc = decode_DIS_RunJobList(sfds, request);
+			break;
+
+		case PBS_BATCH_ModifyJobList:
+			rc = decode_DIS_ModifyJobList(sfds, request);
+			break;
+
 		case PBS_BATCH_DefSchReply:
 			request->rq_ind.rq_defrpy.rq_cmd = disrsi(sfds, &rc);
 			if (rc) break;
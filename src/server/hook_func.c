@@ -1412,6 +1412,8 @@ mgr_hook_import(struct batch_request *preq)
 			output_path);
 		goto mgr_hook_import_error;
 	}
+	/* the script only changes through import, keep its compiled code */
+	((struct python_script *)phook->script)->check_for_recompile = 0;
 
 	phook->hook_script_checksum = crc_file(output_path);
 
@@ -2268,6 +2270,32 @@ mgr_hook_unset_error:
  ************************************************************************
  */
 
+/**
+ * @brief
+ * 		Returns in 'buf' the value of run statistic 'name' of the hook.
+ *
+ * @param[in]	phook	- the hook
+ * @param[in]	name	- one of the HOOKATT_RUN_* names
+ * @param[out]	buf	- the value
+ * @param[in]	len	- size of 'buf'
+ *
+ * @return void
+ */
+static void
+hook_run_stat_as_string(hook *phook, char *name, char *buf, size_t len)
+{
+	if (strcmp(name, HOOKATT_RUN_COUNT) == 0)
+		snprintf(buf, len, "%lu", phook->run_count);
+	else if (strcmp(name, HOOKATT_RUN_WALLTIME) == 0)
+		snprintf(buf, len, "%.6f", phook->run_walltime);
+	else if (strcmp(name, HOOKATT_RUN_WALLTIME_MAX) == 0)
+		snprintf(buf, len, "%.6f", phook->run_walltime_max);
+	else if (strcmp(name, HOOKATT_RUN_CPUTIME) == 0)
+		snprintf(buf, len, "%.6f", phook->run_cputime);
+	else
+		buf[0] = '\0';
+}
+
 /**
  * @brief
  * 		status_hook - Build the status reply for a single hook.
@@ -2321,6 +2349,7 @@ status_hook(hook *phook, struct batch_request *preq, pbs_list_head *pstathd, cha
 	(void)strcpy(pstat->brp_objname, hookname);
 	CLEAR_LINK(pstat->brp_stlink);
 	CLEAR_HEAD(pstat->brp_attr);
+	pstat->brp_enc = NULL;
 	append_link(pstathd, &pstat->brp_stlink, pstat);
 	preq->rq_reply.brp_count++;
 
@@ -2352,6 +2381,9 @@ status_hook(hook *phook, struct batch_request *preq, pbs_list_head *pstathd, cha
 				strcpy(val_str, hook_debug_as_string(phook->debug));
 			} else if (strcmp(pal->al_name, HOOKATT_FAIL_ACTION) == 0) {
 				strcpy(val_str, hook_fail_action_as_string(phook->fail_action));
+			} else if (IS_HOOK_RUN_STAT(pal->al_name)) {
+				hook_run_stat_as_string(phook, pal->al_name,
+					val_str, sizeof(val_str));
 			} else {
 				snprintf(hook_msg, msg_len-1,
 					"unknown hook attribute %s", pal->al_name);
@@ -2388,6 +2420,20 @@ status_hook(hook *phook, struct batch_request *preq, pbs_list_head *pstathd, cha
 			(attrlist_add(&pstat->brp_attr, HOOKATT_FAIL_ACTION,
 			hook_fail_action_as_string(phook->fail_action)) != 0))
 			return (PBSE_INTERNAL);
+		if (!(phook->event & MOM_EVENTS)) {
+			static char *run_stats[] = {HOOKATT_RUN_COUNT,
+				HOOKATT_RUN_WALLTIME, HOOKATT_RUN_WALLTIME_MAX,
+				HOOKATT_RUN_CPUTIME, NULL};
+			int i;
+
+			for (i = 0; run_stats[i] != NULL; i++) {
+				hook_run_stat_as_string(phook, run_stats[i],
+					val_str, sizeof(val_str));
+				if (attrlist_add(&pstat->brp_attr, run_stats[i],
+					val_str) != 0)
+					return (PBSE_INTERNAL);
+			}
+		}
 	}
 
 	return (0);
@@ -3112,6 +3158,7 @@ set_job_reslist(job *pjob, char *hook_name, char *msg, int msg_len,
 	/* The following forces new job's Resource_List values to be seen */
 	/* in qstat -f */
 	jb->at_flags |= ATR_MOD_MCACHE;
+	pjob->ji_modseq = 1;
 
 	pseldef = &svr_resc_def[RESC_SELECT];
 	presc = find_resc_entry(jb, pseldef);
@@ -3798,6 +3845,11 @@ process_hooks(struct batch_request *preq, char *hook_msg, size_t msg_len,
 		if ((preq->rq_user != NULL) && (strcmp(preq->rq_user, PBS_SCHED_DAEMON_NAME) == 0) && (pbs_conf.sched_modify_event == 0)) {
 			return(2);
 		}
+		/* nor for its Modify Job List, which stands in for its async modifies */
+		if ((preq->rq_parentbr != NULL) && (preq->rq_parentbr->rq_type == PBS_BATCH_ModifyJobList) &&
+			(strcmp(preq->rq_user, PBS_SCHED_DAEMON_NAME) == 0)) {
+			return(2);
+		}
 	} else if (preq->rq_type == PBS_BATCH_MoveJob) {
 		hook_event = HOOK_EVENT_MOVEJOB;
 		req_ptr.rq_move = (struct rq_move *)&preq->rq_ind.rq_move;
@@ -4308,7 +4360,11 @@ int server_process_hooks(int rq_type, char *rq_user, char *rq_host, hook *phook,
 	/* let rc pass through */
 	if (rc == 0) {
 		hook_perf_stat_start(perf_label, "run_code", 0);
+		if (rq_type != PBS_BATCH_HookPeriodic)
+			hook_run_stat_start(phook);
 		rc = pbs_python_run_code_in_namespace(&svr_interp_data, phook->script, 0);
+		if (rq_type != PBS_BATCH_HookPeriodic)
+			hook_run_stat_stop(phook, 1);
 		hook_perf_stat_stop(perf_label, "run_code", 0);
 	}
 
@@ -6778,6 +6834,8 @@ post_server_periodic_hook(struct work_task *ptask)
 		log_err(-1, __func__, "A periodic hook disappeared");
 		return;
 	}
+	/* the hook ran in a child: only its walltime is known */
+	hook_run_stat_stop(phook, 0);
 	if (WIFEXITED(stat)) {
 		char reject_msg[HOOK_MSG_SIZE + 1] = {'\0'};
 		char *next_time_str;
@@ -6856,6 +6914,28 @@ post_server_periodic_hook(struct work_task *ptask)
 	return;
 }
 
+/**
+ * @brief
+ *		Returns the data for the pbs.event().vnode_list or
+ *		pbs.event().resv_list of a periodic hook, when the hook
+ *		script first uses it.
+ *
+ * @param[in]	which	- HOOK_REFS_VNODE_LIST or HOOK_REFS_RESV_LIST
+ *
+ * @return	pbs_list_head *
+ * @retval	the list of attributes of the vnodes or reservations
+ * @retval	NULL	unknown 'which'
+ */
+static pbs_list_head *
+get_event_param_list(int which)
+{
+	if (which == HOOK_REFS_VNODE_LIST)
+		return (get_vnode_list());
+	if (which == HOOK_REFS_RESV_LIST)
+		return (get_resv_list());
+	return (NULL);
+}
+
 /**
  * @brief
  *		Callback function for Timed work tasks to run periodic hooks
@@ -6896,6 +6976,11 @@ run_periodic_hook(struct work_task *ptask)
 		return;
 	}
 
+	/* compile here so that the code is kept for the next children */
+	if (phook->script != NULL)
+		(void)pbs_python_check_and_compile_script(&svr_interp_data,
+			phook->script);
+
 	pid = fork();
 
 	if (pid == -1) {	/* Error on fork */
@@ -6905,6 +6990,7 @@ run_periodic_hook(struct work_task *ptask)
 	}
 
 	if (pid != 0) {		/* The parent (main server) */
+		hook_run_stat_start(phook);
 		/* Set a task for post processing of the running hook */
 		struct  work_task *ptask;
 		ptask = set_task(WORK_Deferred_Child, (long)pid,
@@ -6923,9 +7009,14 @@ run_periodic_hook(struct work_task *ptask)
 		/* Unprotect child from being killed by kernel */
 		daemon_protect(0, PBS_DAEMON_PROTECT_OFF);
 
-		/* set vnodes and reservation list to hook input parameter */
-		req_ptr.vns_list = (pbs_list_head *)get_vnode_list();
-		req_ptr.resv_list = (pbs_list_head *)get_resv_list();
+		/* set vnodes and reservation list to hook input parameter; */
+		/* they are built when the hook script first uses them, */
+		/* unless needed for the hook debug input file */
+		if (phook->debug) {
+			req_ptr.vns_list = (pbs_list_head *)get_vnode_list();
+			req_ptr.resv_list = (pbs_list_head *)get_resv_list();
+		} else
+			pbs_python_set_event_param_loader(get_event_param_list);
 
 		ret = server_process_hooks(PBS_BATCH_HookPeriodic, NULL, NULL, phook,
 					HOOK_EVENT_PERIODIC, NULL, &req_ptr, hook_msg,
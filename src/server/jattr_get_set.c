@@ -39,6 +39,13 @@
 
 #include "job.h"
 
+/* the server restamps a modified job's chgseq when it is next read, see job_chgseq_update() */
+#ifndef PBS_MOM
+#define MARK_JOB_MODIFIED(pjob) ((pjob)->ji_modseq = 1)
+#else
+#define MARK_JOB_MODIFIED(pjob)
+#endif
+
 /**
  * @brief	Get attribute of job based on given attr index
  *
@@ -306,8 +313,10 @@ get_jattr_priv_encoded(const job *pjob, int attr_idx)
 void
 set_job_state(job *pjob, char val)
 {
-	if (pjob != NULL)
+	if (pjob != NULL) {
 		set_attr_c(get_jattr(pjob, JOB_ATR_state), val, SET);
+		MARK_JOB_MODIFIED(pjob);
+	}
 }
 
 /**
@@ -344,6 +353,7 @@ set_jattr_generic(job *pjob, int attr_idx, char *val, char *rscn, enum batch_op
 	if (pjob == NULL || val == NULL)
 		return 1;
 
+	MARK_JOB_MODIFIED(pjob);
 	return set_attr_generic(get_jattr(pjob, attr_idx), &job_attr_def[attr_idx], val, rscn, op);
 }
 
@@ -365,6 +375,7 @@ set_jattr_str_slim(job *pjob, int attr_idx, char *val, char *rscn)
 	if (pjob == NULL || val == NULL)
 		return 1;
 
+	MARK_JOB_MODIFIED(pjob);
 	return set_attr_generic(get_jattr(pjob, attr_idx), &job_attr_def[attr_idx], val, rscn, INTERNAL);
 }
 
@@ -387,6 +398,7 @@ set_jattr_l_slim(job *pjob, int attr_idx, long val, enum batch_op op)
 		return 1;
 
 	set_attr_l(get_jattr(pjob, attr_idx), val, op);
+	MARK_JOB_MODIFIED(pjob);
 
 	return 0;
 }
@@ -410,6 +422,7 @@ set_jattr_ll_slim(job *pjob, int attr_idx, long long val, enum batch_op op)
 		return 1;
 
 	set_attr_ll(get_jattr(pjob, attr_idx), val, op);
+	MARK_JOB_MODIFIED(pjob);
 
 	return 0;
 }
@@ -434,6 +447,7 @@ set_jattr_b_slim(job *pjob, int attr_idx, long val, enum batch_op op)
 		return 1;
 
 	set_attr_b(get_jattr(pjob, attr_idx), val, op);
+	MARK_JOB_MODIFIED(pjob);
 
 	return 0;
 }
@@ -457,6 +471,7 @@ set_jattr_c_slim(job *pjob, int attr_idx, char val, enum batch_op op)
 		return 1;
 
 	set_attr_c(get_jattr(pjob, attr_idx), val, op);
+	MARK_JOB_MODIFIED(pjob);
 
 	return 0;
 }
@@ -495,6 +510,7 @@ mark_jattr_not_set(job *pjob, int attr_idx)
 	if (pjob != NULL) {
 		attribute *attr = get_jattr(pjob, attr_idx);
 		ATR_UNSET(attr);
+		MARK_JOB_MODIFIED(pjob);
 	}
 }
 
@@ -509,8 +525,10 @@ mark_jattr_not_set(job *pjob, int attr_idx)
 void
 mark_jattr_set(job *pjob, int attr_idx)
 {
-	if (pjob != NULL)
+	if (pjob != NULL) {
 		(get_jattr(pjob, attr_idx))->at_flags |= ATR_VFLAG_SET;
+		MARK_JOB_MODIFIED(pjob);
+	}
 }
 
 /**
@@ -524,6 +542,8 @@ mark_jattr_set(job *pjob, int attr_idx)
 void
 free_jattr(job *pjob, int attr_idx)
 {
-	if (pjob != NULL)
+	if (pjob != NULL) {
 		free_attr(job_attr_def, get_jattr(pjob, attr_idx), attr_idx);
+		MARK_JOB_MODIFIED(pjob);
+	}
 }
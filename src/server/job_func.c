@@ -522,6 +522,7 @@ job_free(job *pj)
 	}
 	if (pj->ji_ajinfo) {
 		free_range_list(pj->ji_ajinfo->trm_quelist);
+		free(pj->ji_ajinfo->tkm_sjflags);
 		free(pj->ji_ajinfo);
 		pj->ji_ajinfo = NULL;
 	}
@@ -536,6 +537,7 @@ job_free(job *pj)
 		free(pj->ji_script);
 	if (pj->ji_prov_startjob_task)
 		delete_task(pj->ji_prov_startjob_task);
+	job_statcache_free(pj);
 
 #else	/* PBS_MOM  Mom Only */
 
@@ -1119,6 +1121,8 @@ job_purge(job *pjob)
 
 		svr_dequejob(pjob);
 	}
+	if ((pjob->ji_qs.ji_svrflags & JOB_SVFLG_SubJob) == 0)
+		add_stat_tombstone(MGR_OBJ_JOB, pjob->ji_qs.ji_jobid, get_jattr_str(pjob, JOB_ATR_job_owner));
 #endif	/* PBS_MOM */
 
 #ifdef PBS_MOM
@@ -1749,6 +1753,9 @@ resv_free(resc_resv *presv)
 	char *dot = NULL;
 	char *resvid = presv->ri_qs.ri_resvID;
 
+	/* drop it from the vnode to occurrence index */
+	unindex_resv_occurrences(presv);
+
 	/* remove any malloc working attribute space */
 
 	for (i=0; i < (int)RESV_ATR_LAST; i++)
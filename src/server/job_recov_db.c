@@ -244,6 +244,11 @@ job_save_db(job *pjob)
 	if ((savetype = job_to_db(pjob, &dbjob)) == -1)
 		goto done;
 
+	if (savetype & OBJ_SAVE_NEW)
+		svr_db_group_commit(); /* a jobid clash must not abort the group */
+	else
+		svr_db_group_join();
+
 	obj.pbs_db_obj_type = PBS_DB_JOB;
 	obj.pbs_db_un.pbs_db_job = &dbjob;
 
@@ -461,6 +466,11 @@ resv_save_db(resc_resv *presv)
 	if ((savetype = resv_to_db(presv, &dbresv)) == -1)
 		goto done;
 
+	if (savetype & OBJ_SAVE_NEW)
+		svr_db_group_commit(); /* a resvid clash must not abort the group */
+	else
+		svr_db_group_join();
+
 	obj.pbs_db_obj_type = PBS_DB_RESV;
 	obj.pbs_db_un.pbs_db_resv = &dbresv;
 
@@ -44,7 +44,7 @@
  *
  */
 
-#include "avltree.h"
+#include "pbs_idx.h"
 #include "batch_request.h"
 #include "pbs_error.h"
 #include "pbs_nodes.h"
@@ -420,13 +420,13 @@ void
 clean_saved_rsc(void *idx)
 {
 	psvr_ru_t *ru_cur;
-	void *idx_ctx = NULL;
 
-	while (pbs_idx_find(idx, NULL, (void **) &ru_cur, &idx_ctx) == PBS_IDX_RET_OK) {
+	/* empty the index, it is kept for later updates */
+	while (pbs_idx_find(idx, NULL, (void **) &ru_cur, NULL) == PBS_IDX_RET_OK) {
+		pbs_idx_delete(idx, ru_cur->jobid);
 		reverse_resc_update(ru_cur);
 		free(ru_cur);
 	}
-	avl_destroy_index(idx);
 }
 
 /**
@@ -39,6 +39,9 @@
 
 #include "pbs_nodes.h"
 
+/* the server restamps a modified vnode's chgseq when it is next read, see req_stat_delta() */
+#define MARK_NODE_MODIFIED(pnode) ((pnode)->nd_modseq = 1)
+
 /**
  * @brief	Get attribute of node based on given attr index
  *
@@ -167,6 +170,7 @@ set_nattr_generic(struct pbsnode *pnode, int attr_idx, char *val, char *rscn, en
 	if (pnode == NULL || val == NULL)
 		return 1;
 
+	MARK_NODE_MODIFIED(pnode);
 	return set_attr_generic(get_nattr(pnode, attr_idx), &node_attr_def[attr_idx], val, rscn, op);
 }
 
@@ -188,6 +192,7 @@ set_nattr_str_slim(struct pbsnode *pnode, int attr_idx, char *val, char *rscn)
 	if (pnode == NULL || val == NULL)
 		return 1;
 
+	MARK_NODE_MODIFIED(pnode);
 	return set_attr_generic(get_nattr(pnode, attr_idx), &node_attr_def[attr_idx], val, rscn, INTERNAL);
 }
 
@@ -210,6 +215,7 @@ set_nattr_l_slim(struct pbsnode *pnode, int attr_idx, long val, enum batch_op op
 		return 1;
 
 	set_attr_l(get_nattr(pnode, attr_idx), val, op);
+	MARK_NODE_MODIFIED(pnode);
 
 	return 0;
 }
@@ -233,6 +239,7 @@ set_nattr_b_slim(struct pbsnode *pnode, int attr_idx, long val, enum batch_op op
 		return 1;
 
 	set_attr_b(get_nattr(pnode, attr_idx), val, op);
+	MARK_NODE_MODIFIED(pnode);
 
 	return 0;
 }
@@ -256,6 +263,7 @@ set_nattr_c_slim(struct pbsnode *pnode, int attr_idx, char val, enum batch_op op
 		return 1;
 
 	set_attr_c(get_nattr(pnode, attr_idx), val, op);
+	MARK_NODE_MODIFIED(pnode);
 
 	return 0;
 }
@@ -279,6 +287,7 @@ set_nattr_short_slim(struct pbsnode *pnode, int attr_idx, short val, enum batch_
 		return 1;
 
 	set_attr_short(get_nattr(pnode, attr_idx), val, op);
+	MARK_NODE_MODIFIED(pnode);
 
 	return 0;
 }
@@ -314,8 +323,10 @@ is_nattr_set(const struct pbsnode *pnode, int attr_idx)
 void
 free_nattr(struct pbsnode *pnode, int attr_idx)
 {
-	if (pnode != NULL)
+	if (pnode != NULL) {
 		free_attr(node_attr_def, get_nattr(pnode, attr_idx), attr_idx);
+		MARK_NODE_MODIFIED(pnode);
+	}
 }
 
 /**
@@ -330,6 +341,7 @@ void
 clear_nattr(struct pbsnode *pnode, int attr_idx)
 {
 	clear_attr(get_nattr(pnode, attr_idx), &node_attr_def[attr_idx]);
+	MARK_NODE_MODIFIED(pnode);
 }
 
 /**
@@ -347,4 +359,5 @@ set_nattr_jinfo(struct pbsnode *pnode, int attr_idx, struct pbsnode *val)
 	attribute *attr = get_nattr(pnode, attr_idx);
 	attr->at_val.at_jinfo = val;
 	attr->at_flags = ATR_SET_MOD_MCACHE;
+	MARK_NODE_MODIFIED(pnode);
 }
@@ -309,10 +309,13 @@ initialize_pbsnode(struct pbsnode *pnode, char *pname, int ntype)
 	pnode->nd_hostname= NULL;
 	pnode->nd_state = INUSE_UNKNOWN | INUSE_DOWN;
 	pnode->nd_resvp   = NULL;
+	pnode->nd_occr_resvp = NULL;
 	pnode->nd_pque	  = NULL;
 	pnode->nd_nummoms = 0;
 	pnode->nd_svrflags |= NODE_NEWOBJ;
 	pnode->nd_lic_info = NULL;
+	pnode->nd_modseq = 0;
+	pnode->nd_chgseq = 0;
 	pnode->nd_moms    = (mominfo_t **)calloc(1, sizeof(mominfo_t *));
 	if (pnode->nd_moms == NULL)
 		return (PBSE_SYSTEM);
@@ -562,6 +565,7 @@ effective_node_delete(struct pbsnode *pnode)
 		psubn = pnxt;
 	}
 
+	unindex_vnode_occurrences(pnode);
 	remove_from_unlicensed_node_list(pnode);
 	lic_released = release_node_lic(pnode);
 
@@ -606,6 +610,8 @@ effective_node_delete(struct pbsnode *pnode)
 
 	remove_node_topology(pnode->nd_name);
 
+	add_stat_tombstone(MGR_OBJ_NODE, pnode->nd_name, NULL);
+
 	/* delete the node from the node tree as well as the node array */
 	if (node_idx != NULL)
 		pbs_idx_delete(node_idx, pnode->nd_name);
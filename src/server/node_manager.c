@@ -106,6 +106,7 @@ static int	 cvt_overflow(size_t, size_t);
 static int	 cvt_realloc(char **, size_t *, char **, size_t *);
 
 static void set_resv_for_degrade(struct pbsnode *pnode, resc_resv *presv);
+static int resv_occr_indexed = 0; /* vnode to standing reservation index built */
 extern time_t	 time_now;
 extern int	 server_init_type;
 
@@ -1125,6 +1126,7 @@ shallow_vnode_dup(struct pbsnode *vnode)
 	vnode_dup->nd_hostname = vnode->nd_hostname;
 	vnode_dup->nd_psn = vnode->nd_psn;
 	vnode_dup->nd_resvp = vnode->nd_resvp;
+	vnode_dup->nd_occr_resvp = vnode->nd_occr_resvp;
 	vnode_dup->nd_nsn = vnode->nd_nsn;
 	vnode_dup->nd_nsnfree = vnode->nd_nsnfree;
 	vnode_dup->nd_ncpus = vnode->nd_ncpus;
@@ -1506,8 +1508,50 @@ vnode_unavailable(struct pbsnode *np, int account_vnode)
 
 /**
  * @brief
- * 		Search all reservations for an associated node that matches the one
- * 		passed as argument.
+ * 		Append a reservation to a resvinfo list unless it is already on it.
+ *
+ * @param[in,out]	head	- head of the list
+ * @param[in]	presv	- the reservation to add
+ *
+ * @return	int
+ * @retval	0	- success
+ * @retval	-1	- out of memory
+ *
+ * @par MT-safe: No
+ */
+static int
+add_resvinfo(struct resvinfo **head, resc_resv *presv)
+{
+	struct resvinfo *rinfp;
+	struct resvinfo **tail;
+
+	for (tail = head; *tail; tail = &(*tail)->next) {
+		if ((*tail)->resvp == presv)
+			return 0;
+	}
+
+	rinfp = malloc(sizeof(struct resvinfo));
+	if (rinfp == NULL) {
+		log_err(PBSE_SYSTEM, __func__,
+			"could not allocate memory to create a resvinfo list");
+		return -1;
+	}
+	rinfp->resvp = presv;
+	rinfp->next = NULL;
+	*tail = rinfp;
+
+	return 0;
+}
+
+/**
+ * @brief
+ * 		Find the reservations associated to a node.
+ *
+ * 		Advance reservations are found through the node's own list of the
+ * 		reservations it is assigned to.  Standing reservations are found
+ * 		through the node's list of the standing reservations that name it
+ * 		in any occurrence, see index_resv_occurrences().  Only reservations
+ * 		that touch the node are examined.
  *
  * @param[in]	np	-	The node to find in the reservations list
  * @param[in]	vnode_degraded_op	-	To indicate whether to set the degraded time on
@@ -1526,106 +1570,232 @@ vnode_unavailable(struct pbsnode *np, int account_vnode)
 struct resvinfo *
 find_vnode_in_resvs(struct pbsnode *np, enum vnode_degraded_op degraded_op)
 {
-	struct resvinfo *rinfp;
-	struct resvinfo *parent_rinfp;
+	struct resvinfo *rinfp = NULL;
+	struct resvinfo *rip;
 	resc_resv *presv;
-	pbsnode_list_t *pl;
-	int match = 0;
-	int is_degraded = 0;
 
 	if (np == NULL)
 		return NULL;
 
-	/* Walk all reservations and check if the node is associated to an
-	 * occurrence of a standing reservation
-	 *
-	 * While walking the reservation's list, we create a resv info linked list
-	 * that contains all reservations on which the node appears
-	 */
-	rinfp = malloc(sizeof(struct resvinfo));
-	if (!rinfp)
-		return NULL;
+	if (!resv_occr_indexed) {
+		/* first use since the reservations were recovered */
+		resv_occr_indexed = 1;
+		for (presv = (resc_resv *) GET_NEXT(svr_allresvs); presv != NULL;
+			presv = (resc_resv *) GET_NEXT(presv->ri_allresvs))
+			index_resv_occurrences(presv);
+	}
 
-	rinfp->resvp = NULL;
-	rinfp->next = NULL;
+	/* When processing an advance reservation, set the degraded time to be
+	 * the start time of the reservation
+	 */
+	for (rip = np->nd_resvp; rip != NULL; rip = rip->next) {
+		presv = rip->resvp;
+		if (get_rattr_long(presv, RESV_ATR_resv_standing) != 0)
+			continue;
 
-	parent_rinfp = rinfp;
+		presv->ri_degraded_time = get_rattr_long(presv, RESV_ATR_start);
+		if (add_resvinfo(&rinfp, presv) != 0)
+			return rinfp;
+	}
 
-	for (presv = (resc_resv *) GET_NEXT(svr_allresvs); presv != NULL;
-		presv = (resc_resv *) GET_NEXT(presv->ri_allresvs)) {
-		/* When processing an advance reservation, set the degraded time to be
-		 * the start time of the reservation and process the next reservation
+	for (rip = np->nd_occr_resvp; rip != NULL; rip = rip->next) {
+		presv = rip->resvp;
+		/* If the sequence of execvnodes of the considered standing reservation
+		 * isn't set, process the next element. Note that this should never
+		 * happen as the reservation should have been confirmed and the nodes
+		 * been assigned to it
 		 */
-		if (get_rattr_long(presv, RESV_ATR_resv_standing) == 0) {
-			for (pl = presv->ri_pbsnode_list; pl; pl=pl->next) {
-				if (np == pl->vnode)
-					break;
-			}
-			if (!pl)
-				continue;
+		if (is_rattr_set(presv, RESV_ATR_resv_execvnodes) == 0) {
+			log_event(PBSEVENT_DEBUG, PBS_EVENTCLASS_RESV, LOG_NOTICE,
+				presv->ri_qs.ri_resvID, "Reservation's execvnodes_seq are corrupted");
+			continue;
+		}
 
-			presv->ri_degraded_time = get_rattr_long(presv, RESV_ATR_start);
-			if (!match) {
-				rinfp->resvp = presv;
-				rinfp->next = NULL;
-				match = 1;
-			} else {
-				rinfp->next = malloc(sizeof(struct resvinfo));
-				if (!rinfp->next) {
-					log_err(PBSE_SYSTEM, __func__,
-						"could not allocate memory to create a resvinfo list");
-					break;
-				}
-				rinfp = rinfp->next;
-				rinfp->resvp = presv;
-				rinfp->next = NULL;
-			}
-		} else { /* Standing Reservation */
-			/* If the sequence of execvnodes of the considered standing reservation
-			 * isn't set, process the next element. Note that this should never
-			 * happen as the reservation should have been confirmed and the nodes
-			 * been assigned to it
-			 */
-			if (is_rattr_set(presv, RESV_ATR_resv_execvnodes) == 0) {
-				log_event(PBSEVENT_DEBUG, PBS_EVENTCLASS_RESV, LOG_NOTICE,
-					presv->ri_qs.ri_resvID, "Reservation's execvnodes_seq are corrupted");
-				continue;
-			}
-			is_degraded = find_degraded_occurrence(presv, np, degraded_op);
+		/* If no occurrence is degraded move on to the next reservation */
+		if (find_degraded_occurrence(presv, np, degraded_op) == 0)
+			continue;
 
-			/* If no occurrence is degraded move on to the next reservation */
-			if (is_degraded == 0)
-				continue;
+		if (add_resvinfo(&rinfp, presv) != 0)
+			return rinfp;
+	}
 
-			/* Add the reservation to the constructed linked list to which this
-			 * node is associated
-			 */
-			if (!match) {
-				rinfp->resvp = presv;
-				rinfp->next = NULL;
-				match = 1;
-			} else {
-				rinfp->next = malloc(sizeof(struct resvinfo));
-				if (!rinfp->next) {
-					log_err(PBSE_SYSTEM, __func__,
-						"could not allocate memory to create a resvinfo list");
-					break;
-				}
-				rinfp = rinfp->next;
-				rinfp->resvp = presv;
-				rinfp->next = NULL;
-			}
+	return rinfp;
+}
+
+/**
+ * @brief
+ * 		Remove a reservation from a resvinfo list.
+ *
+ * @param[in,out]	head	- head of the list
+ * @param[in]	presv	- the reservation to remove
+ *
+ * @return	void
+ *
+ * @par MT-safe: No
+ */
+static void
+remove_resvinfo(struct resvinfo **head, resc_resv *presv)
+{
+	struct resvinfo *rinfp;
+
+	while ((rinfp = *head) != NULL) {
+		if (rinfp->resvp == presv) {
+			*head = rinfp->next;
+			free(rinfp);
+		} else
+			head = &rinfp->next;
+	}
+}
+
+/**
+ * @brief
+ * 		Take a standing reservation out of the vnode to occurrence index.
+ *
+ * @param[in,out]	presv	- the reservation
+ *
+ * @return	void
+ *
+ * @par MT-safe: No
+ */
+void
+unindex_resv_occurrences(resc_resv *presv)
+{
+	pbsnode_list_t *pl;
+	pbsnode_list_t *pl_next;
+
+	if (presv == NULL)
+		return;
+
+	for (pl = presv->ri_occr_vnodes; pl != NULL; pl = pl_next) {
+		pl_next = pl->next;
+		remove_resvinfo(&pl->vnode->nd_occr_resvp, presv);
+		free(pl);
+	}
+	presv->ri_occr_vnodes = NULL;
+}
+
+/**
+ * @brief
+ * 		Index a standing reservation under every vnode its execvnodes
+ * 		sequence names, so that a vnode changing state only has to look at
+ * 		the reservations that can use it.  Every run of legal vnode
+ * 		characters in the sequence that names an existing vnode is indexed,
+ * 		which covers everything find_vnode_in_execvnode() can match.
+ *
+ * 		Call whenever RESV_ATR_resv_execvnodes is set.  Before the first
+ * 		find_vnode_in_resvs() the index is not built yet and this only
+ * 		drops any stale entries.
+ *
+ * @param[in,out]	presv	- the reservation
+ *
+ * @return	void
+ *
+ * @par MT-safe: No
+ */
+void
+index_resv_occurrences(resc_resv *presv)
+{
+	char name[PBS_MAXNODENAME + 1];
+	char *execvnodes;
+	char *p;
+	char *begin;
+	struct pbsnode *np;
+	struct resvinfo *rinfp;
+	pbsnode_list_t *pl;
+
+	if (presv == NULL)
+		return;
+
+	unindex_resv_occurrences(presv);
+
+	if (!resv_occr_indexed || get_rattr_long(presv, RESV_ATR_resv_standing) == 0 ||
+		!is_rattr_set(presv, RESV_ATR_resv_execvnodes))
+		return;
+
+	execvnodes = get_rattr_str(presv, RESV_ATR_resv_execvnodes);
+	for (p = execvnodes; *p != '\0';) {
+		if (!legal_vnode_char(*p, 1)) {
+			p++;
+			continue;
+		}
+		for (begin = p; *p != '\0' && legal_vnode_char(*p, 1); p++)
+			;
+		if (p - begin > PBS_MAXNODENAME)
+			continue;
+		memcpy(name, begin, p - begin);
+		name[p - begin] = '\0';
+
+		if ((np = find_nodebyname(name)) == NULL)
+			continue;
+		/* already indexed through an earlier occurrence */
+		if (np->nd_occr_resvp != NULL && np->nd_occr_resvp->resvp == presv)
+			continue;
+
+		rinfp = malloc(sizeof(struct resvinfo));
+		pl = malloc(sizeof(pbsnode_list_t));
+		if (rinfp == NULL || pl == NULL) {
+			free(rinfp);
+			free(pl);
+			log_err(PBSE_SYSTEM, __func__, "could not allocate memory");
+			/* rebuild the whole index on next use */
+			resv_occr_indexed = 0;
+			return;
 		}
+		rinfp->resvp = presv;
+		rinfp->next = np->nd_occr_resvp;
+		np->nd_occr_resvp = rinfp;
+		pl->vnode = np;
+		pl->next = presv->ri_occr_vnodes;
+		presv->ri_occr_vnodes = pl;
 	}
+}
+
+/**
+ * @brief
+ * 		Mark the vnode to occurrence index for a rebuild on next use.
+ * 		Called when a vnode is created, standing reservations may already
+ * 		name it in their execvnode sequence.
+ *
+ * @return	void
+ *
+ * @par MT-safe: No
+ */
+void
+invalidate_resv_occurrences(void)
+{
+	resv_occr_indexed = 0;
+}
 
-	/* no reservations are associated to this vnode */
-	if (!match) {
+/**
+ * @brief
+ * 		Drop a vnode that is being deleted from the vnode to occurrence
+ * 		index.
+ *
+ * @param[in,out]	pnode	- the vnode
+ *
+ * @return	void
+ *
+ * @par MT-safe: No
+ */
+void
+unindex_vnode_occurrences(struct pbsnode *pnode)
+{
+	struct resvinfo *rinfp;
+	pbsnode_list_t **ppl;
+	pbsnode_list_t *pl;
+
+	while ((rinfp = pnode->nd_occr_resvp) != NULL) {
+		ppl = &rinfp->resvp->ri_occr_vnodes;
+		while ((pl = *ppl) != NULL) {
+			if (pl->vnode == pnode) {
+				*ppl = pl->next;
+				free(pl);
+			} else
+				ppl = &pl->next;
+		}
+		pnode->nd_occr_resvp = rinfp->next;
 		free(rinfp);
-		rinfp = NULL;
-		parent_rinfp = NULL;
 	}
-
-	return parent_rinfp;
 }
 
 /**
@@ -2593,6 +2763,7 @@ deallocate_job_from_node(char *jobid, struct pbsnode *pnode)
 				np->jobs = next;
 			else
 				prev->next = next;
+			pnode->nd_modseq = 1;
 			if (jp->has_cpu) {
 				pnode->nd_nsnfree++;	/* up count of free */
 				numcpus++;
@@ -6205,6 +6376,7 @@ assign_jobs_on_subnode(struct pbsnode *pnode, int hw_ncpus, char *jobid, int svr
 		}
 	}
 
+	pnode->nd_modseq = 1;
 	snp = pnode->nd_psn;
 	if (hw_ncpus == 0) {
 		/* setup jobinfo struture */
@@ -6913,6 +7085,7 @@ set_nodes(void *pobj, int objtype, char *execvnod_in, char **execvnod_out, char
 				pbsnode_list_t *tmp_pl;
 				rp->next = (phowl + i)->hw_pnd->nd_resvp;
 				(phowl + i)->hw_pnd->nd_resvp = rp;
+				(phowl + i)->hw_pnd->nd_modseq = 1;
 				rp->resvp = presv;
 
 				/* create a backlink from the reservation to the vnode */
@@ -7097,6 +7270,7 @@ free_resvNodes(resc_resv *presv)
 
 			DBPRT(("Freeing resvinfo on node %s from reservation %s\n",
 				pnode->nd_name, presv->ri_qs.ri_resvID))
+			pnode->nd_modseq = 1;
 			if (prev == NULL) {
 				pnode->nd_resvp = rinfp->next;
 				free(rinfp);
@@ -7264,6 +7438,7 @@ adj_resc_on_node(char *noden, int aflag, enum batch_op op, resource_def *prdef,
 	if (op == DECR) {
 		check_for_negative_resource(prdef, presc, noden);
 	}
+	pnode->nd_modseq = 1;
 	return rc;
 }
 
@@ -336,9 +336,17 @@ node_save_db(struct pbsnode *pnode)
 	int savetype;
 	int rc = -1;
 
+	/* whoever changed the vnode's attributes in place saves it */
+	pnode->nd_modseq = 1;
+
 	if ((savetype = node_to_db(pnode, &dbnode))  == -1)
 		goto done;
 
+	if (savetype & OBJ_SAVE_NEW)
+		svr_db_group_commit();
+	else
+		svr_db_group_join();
+
 	obj.pbs_db_obj_type = PBS_DB_NODE;
 	obj.pbs_db_un.pbs_db_node = &dbnode;
 
@@ -593,6 +593,14 @@ main(int argc, char **argv)
 	/* Protect from being killed by kernel */
 	daemon_protect(0, PBS_DAEMON_PROTECT_ON);
 
+	/* log through a background writer thread from here on */
+	if (pbs_conf.pbs_log_async) {
+		if ((rc = log_async_start()) != 0)
+			log_err(rc, msg_daemonname, "failed to start asynchronous logging");
+		else
+			log_async_flush_on_crash();
+	}
+
 	/* go in a while loop */
 	while (get_out == 0) {
 
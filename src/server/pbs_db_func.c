@@ -112,6 +112,7 @@
 static int db_oper_failed_times = 0;
 static int last_rc = -1; /* we need to reset db_oper_failed_times for each state change of the db */
 static int conn_db_state = 0;
+static int db_group_open = 0; /* group commit transaction is open on svr_db_conn */
 extern int pbs_failover_active;
 extern int server_init_type;
 extern int stalone;	/* is program running not as a service ? */
@@ -175,6 +176,12 @@ stop_db()
 {
 	char *db_err = NULL;
 	int db_delay = 0;
+
+	/* saves of a still open group are committed unless they failed */
+	if (db_group_open) {
+		db_group_open = 0;
+		(void) pbs_db_end_trx(svr_db_conn, 1);
+	}
 	pbs_db_disconnect(svr_db_conn);
 	svr_db_conn = NULL;
 
@@ -599,3 +606,60 @@ free_db_attr_list(pbs_db_attr_list_t *attr_list)
 		attr_list->attr_count = 0;
 	}
 }
+
+/**
+ * @brief
+ *	Make the next object save part of the current group commit.
+ *
+ * @par Functionality:
+ *	When the server attribute db_group_commit is True, saves of jobs,
+ *	reservations and nodes made while processing one iteration of the
+ *	main loop run inside a single database transaction. The transaction
+ *	is committed by svr_db_group_commit() before a reply is sent to a
+ *	client and before the server blocks waiting for the next request,
+ *	so a reply still only goes out once the data it reports is durable.
+ *	Saves that insert a new object must call svr_db_group_commit()
+ *	instead, since a failed insert would abort the whole group.
+ *
+ * @return	void
+ *
+ */
+void
+svr_db_group_join(void)
+{
+	if (db_group_open || svr_db_conn == NULL)
+		return;
+
+	if (get_sattr_long(SVR_ATR_db_group_commit) != 1)
+		return;
+
+	if (pbs_db_begin_trx(svr_db_conn) != 0) {
+		log_err(PBSE_INTERNAL, __func__, "Failed to start group commit transaction");
+		panic_stop_db();
+	}
+	db_group_open = 1;
+}
+
+/**
+ * @brief
+ *	Commit the saves of the current group commit, if any.
+ *
+ * @return	void
+ *
+ */
+void
+svr_db_group_commit(void)
+{
+	char *conn_db_err = NULL;
+
+	if (!db_group_open)
+		return;
+
+	db_group_open = 0;
+	if (pbs_db_end_trx(svr_db_conn, 1) != 0) {
+		pbs_db_get_errmsg(PBS_DB_ERR, &conn_db_err);
+		log_errf(PBSE_INTERNAL, __func__, "Failed to commit group of saves %s", conn_db_err ? conn_db_err : "");
+		free(conn_db_err);
+		panic_stop_db();
+	}
+}
@@ -717,7 +717,7 @@ pbsd_init(int type)
 	 *    If a create or clean recovery, delete any jobs.
 	 *    Before job creation/recovery, create the jobs index.
 	 */
-	if ((jobs_idx = pbs_idx_create(0, 0)) == NULL) {
+	if ((jobs_idx = pbs_idx_create(PBS_IDX_HASH, 0)) == NULL) {
 		log_err(-1, __func__, "Creating jobs index failed!");
 		return (-1);
 	}
@@ -808,6 +808,9 @@ pbsd_init(int type)
 					PBS_EVENTCLASS_SERVER, LOG_NOTICE,
 					msg_daemonname, log_buffer);
 			} else {
+				/* the script only changes through import */
+				if (phook->script != NULL)
+					((struct python_script *)phook->script)->check_for_recompile = 0;
 				sprintf(log_buffer, "Found hook %s type=%s",
 					phook->hook_name,
 					((phook->type == HOOK_SITE)?"site":"pbs"));
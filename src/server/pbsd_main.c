@@ -1126,6 +1126,14 @@ main(int argc, char **argv)
 
 	/* Protect from being killed by kernel */
 	daemon_protect(0, PBS_DAEMON_PROTECT_ON);
+	/* log through a background writer thread from here on */
+	if (pbs_conf.pbs_log_async) {
+		if ((rc = log_async_start()) != 0)
+			log_err(rc, msg_daemonname, "failed to start asynchronous logging");
+		else
+			log_async_flush_on_crash();
+	}
+
 
 #ifdef _POSIX_MEMLOCK
 	if (do_mlockall == 1) {
@@ -1419,6 +1427,10 @@ main(int argc, char **argv)
 		if (reap_child_flag)
 			reap_child();
 
+		/* end the group commit of this iteration before blocking */
+		svr_db_group_commit();
+		acct_flush();
+
 		/* wait for a request and process it */
 		if (wait_request(waittime, priority_context) != 0) {
 			log_err(-1, msg_daemonname, "wait_requst failed");
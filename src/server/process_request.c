@@ -660,6 +660,7 @@ process_request(int sfds)
 			case PBS_BATCH_MoveJob:
 			case PBS_BATCH_QueueJob:
 			case PBS_BATCH_RunJob:
+			case PBS_BATCH_RunJobList:
 			case PBS_BATCH_StageIn:
 			case PBS_BATCH_jobscript:
 				req_reject(PBSE_SVRDOWN, 0, request);
@@ -929,6 +930,10 @@ dispatch_request(int sfds, struct batch_request *request)
 			req_rerunjob(request);
 			break;
 #ifndef PBS_MOM
+		case PBS_BATCH_ModifyJobList:
+			req_modifyjoblist(request);
+			break;
+
 		case PBS_BATCH_MoveJob:
 			req_movejob(request);
 			break;
@@ -961,6 +966,10 @@ dispatch_request(int sfds, struct batch_request *request)
 			req_runjob(request);
 			break;
 
+		case PBS_BATCH_RunJobList:
+			req_runjoblist(request);
+			break;
+
 		case PBS_BATCH_DefSchReply:
 			req_defschedreply(request);
 			break;
@@ -1003,6 +1012,16 @@ dispatch_request(int sfds, struct batch_request *request)
 			clear_non_blocking(get_conn(sfds));
 			break;
 
+		case PBS_BATCH_StatusDelta:
+			if (set_to_non_blocking(conn) == -1) {
+				req_reject(PBSE_SYSTEM, 0, request);
+				close_client(sfds);
+				return;
+			}
+			req_stat_delta(request);
+			clear_non_blocking(get_conn(sfds));
+			break;
+
 		case PBS_BATCH_StatusQue:
 			if (set_to_non_blocking(conn) == -1) {
 				req_reject(PBSE_SYSTEM, 0, request);
@@ -1555,6 +1574,8 @@ decode_DIS_RelnodesJob(int sock, struct batch_request *preq)
 void
 free_br(struct batch_request *preq)
 {
+	int i;
+
 	delete_link(&preq->rq_link);
 	reply_free(&preq->rq_reply);
 
@@ -1566,6 +1587,10 @@ free_br(struct batch_request *preq)
 		 * goes to zero,  reply_send() it
 		 */
 		struct batch_reply *preply = &preq->rq_parentbr->rq_reply;
+		/* a job of a Modify Job List was handed its own attribute list */
+		int own_attrs = (preq->rq_type == PBS_BATCH_ModifyJob) &&
+			(preq->rq_parentbr->rq_type == PBS_BATCH_ModifyJobList);
+
 		if (preq->rq_parentbr->rq_refct > 0) {
 			if (--preq->rq_parentbr->rq_refct == 0) {
 				if (preq->rq_parentbr->rq_type == PBS_BATCH_DeleteJobList) {
@@ -1581,6 +1606,8 @@ free_br(struct batch_request *preq)
 		if (preq->rq_type == PBS_BATCH_DeleteJobList)
 			if (preq->rq_ind.rq_deletejoblist.rq_jobslist)
 				free_string_array(preq->rq_ind.rq_deletejoblist.rq_jobslist);
+		if (own_attrs)
+			free_attrlist(&preq->rq_ind.rq_modify.rq_attr);
 		free(preq);
 		return;
 	}
@@ -1656,10 +1683,25 @@ free_br(struct batch_request *preq)
 				free(preq->rq_ind.rq_status.rq_id);
 			free_attrlist(&preq->rq_ind.rq_status.rq_attr);
 			break;
+		case PBS_BATCH_StatusDelta:
+			free_attrlist(&preq->rq_ind.rq_statdelta.rq_attr);
+			break;
 		case PBS_BATCH_DeleteJobList:
 			if (preq->rq_ind.rq_deletejoblist.rq_jobslist)
 				free_string_array(preq->rq_ind.rq_deletejoblist.rq_jobslist);
 			break;
+		case PBS_BATCH_RunJobList:
+			free_string_array(preq->rq_ind.rq_runjoblist.rq_jobslist);
+			free_string_array(preq->rq_ind.rq_runjoblist.rq_destins);
+			break;
+		case PBS_BATCH_ModifyJobList:
+			if (preq->rq_ind.rq_modifyjoblist.rq_attrs) {
+				for (i = 0; i < preq->rq_ind.rq_modifyjoblist.rq_count; i++)
+					free_attrlist(&preq->rq_ind.rq_modifyjoblist.rq_attrs[i]);
+				free(preq->rq_ind.rq_modifyjoblist.rq_attrs);
+			}
+			free_string_array(preq->rq_ind.rq_modifyjoblist.rq_jobslist);
+			break;
 		case PBS_BATCH_CopyFiles:
 		case PBS_BATCH_DelFiles:
 			freebr_cpyfile(&preq->rq_ind.rq_cpyfile);
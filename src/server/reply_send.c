@@ -59,6 +59,7 @@
 #include <pbs_config.h>   /* the master config generated by configure */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <errno.h>
 #include <sys/types.h>
@@ -271,6 +272,73 @@ reply_send_status_part(struct batch_request *preq)
 	return rc;
 }
 
+#ifndef PBS_MOM
+/**
+ * @brief
+ * 		Record a job of a Run Job List or Modify Job List request that
+ *		failed in the reply of that request.
+ *
+ * @param[in,out] preq - the list request
+ * @param[in]	jid - job id
+ * @param[in]	errcode - reason the job failed
+ *
+ * @return	int
+ * @retval	0	- success
+ * @retval	PBSE_SYSTEM	- out of memory
+ */
+int
+add_joblist_stat(struct batch_request *preq, char *jid, int errcode)
+{
+	struct batch_deljob_status *pstat;
+	struct batch_reply *preply = &preq->rq_reply;
+
+	pstat = malloc(sizeof(struct batch_deljob_status));
+	if (pstat == NULL)
+		return PBSE_SYSTEM;
+	if ((pstat->name = strdup(jid)) == NULL) {
+		free(pstat);
+		return PBSE_SYSTEM;
+	}
+	pstat->code = errcode;
+	pstat->next = preply->brp_un.brp_deletejoblist.brp_delstatc;
+	preply->brp_un.brp_deletejoblist.brp_delstatc = pstat;
+	preply->brp_count++;
+
+	return 0;
+}
+
+/**
+ * @brief
+ * 		Called when the reply to the child request of one job of a Run
+ *		Job List or Modify Job List request is ready.  A failed job is
+ *		added to the reply of the parent request, jobs that succeeded
+ *		are not reported.
+ *
+ * @param[in]	preq - the child request of the job
+ *
+ * @return	int
+ * @retval	0	- success
+ * @retval	PBSE_SYSTEM	- out of memory
+ */
+static int
+update_joblist_stat(struct batch_request *preq)
+{
+	char *jid;
+
+	if (preq->rq_reply.brp_code == PBSE_NONE)
+		return 0;
+
+	if (preq->rq_type == PBS_BATCH_ModifyJob)
+		jid = preq->rq_ind.rq_modify.rq_objname;
+	else if (preq->rq_type == PBS_BATCH_MoveJob)
+		jid = preq->rq_ind.rq_move.rq_jid; /* move_and_runjob() turns a run into a move */
+	else
+		jid = preq->rq_ind.rq_run.rq_jid;
+
+	return add_joblist_stat(preq->rq_parentbr, jid, preq->rq_reply.brp_code);
+}
+#endif	/* PBS_MOM */
+
 /**
  * @brief
  * 		Send a reply to a batch request, reply either goes to a
@@ -320,6 +388,13 @@ reply_send(struct batch_request *request)
 
 	/* if this is a child request, just move the error to the parent */
 	if (request->rq_parentbr) {
+#ifndef PBS_MOM
+		/* each job of a Run/Modify Job List reports its own outcome */
+		if ((request->rq_parentbr->rq_type == PBS_BATCH_RunJobList) ||
+			(request->rq_parentbr->rq_type == PBS_BATCH_ModifyJobList))
+			rc = update_joblist_stat(request);
+		else
+#endif	/* PBS_MOM */
 		if ((request->rq_parentbr->rq_reply.brp_choice == BATCH_REPLY_CHOICE_NULL) && (request->rq_parentbr->rq_reply.brp_code == 0)) {
 			request->rq_parentbr->rq_reply.brp_code = request->rq_reply.brp_code;
 			request->rq_parentbr->rq_reply.brp_auxcode = request->rq_reply.brp_auxcode;
@@ -366,6 +441,10 @@ reply_send(struct batch_request *request)
 		/*
 		 * Otherwise, the reply is to be sent to a remote client
 		 */
+#ifndef PBS_MOM
+		/* what the reply reports must be durable before it goes out */
+		svr_db_group_commit();
+#endif	/* PBS_MOM */
 		if (rc == PBSE_NONE) {
 			rc = dis_reply_write(sfds, request);
 		}
@@ -459,6 +538,7 @@ reply_free(struct batch_reply *prep)
 		while (pstat) {
 			pstatx = (struct brp_status *)GET_NEXT(pstat->brp_stlink);
 			free_attrlist(&pstat->brp_attr);
+			free_brp_encoded(pstat->brp_enc);
 			(void)free(pstat);
 			pstat = pstatx;
 		}
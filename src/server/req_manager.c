@@ -2768,7 +2768,7 @@ create_pbs_node2(char *objname, svrattrl *plist, int perms, int *bad, struct pbs
 
 		/* create node index if not already done */
 		if (node_idx == NULL) {
-			if ((node_idx = pbs_idx_create(0, 0)) == NULL) {
+			if ((node_idx = pbs_idx_create(PBS_IDX_HASH, 0)) == NULL) {
 				svr_totnodes--;
 				free_pnode(pnode);
 				return (PBSE_SYSTEM);
@@ -2781,6 +2781,9 @@ create_pbs_node2(char *objname, svrattrl *plist, int perms, int *bad, struct pbs
 			free_pnode(pnode);
 			return (PBSE_SYSTEM);
 		}
+
+		/* standing reservations may already name this vnode */
+		invalidate_resv_occurrences();
 	} else if (nodup == TRUE) {
 		/* duplicating/modifying vnode by qmgr is not allowed */
 		/* as what qmgr creates is the natural vnode          */
@@ -46,6 +46,7 @@
 #include <pbs_config.h>   /* the master config generated by configure */
 
 #include <stdio.h>
+#include <string.h>
 #include <sys/types.h>
 #include "libpbs.h"
 #include <signal.h>
@@ -393,6 +394,74 @@ req_modifyjob(struct batch_request *preq)
 	reply_ack(preq);
 }
 
+/**
+ * @brief
+ * 		Service the Modify Job List Request, used by the scheduler to
+ *		send the attribute updates of many jobs at once.
+ *
+ * @par	Functionality:
+ *		Each job of the request is altered by req_modifyjob() through a
+ *		Modify Job request of its own, linked to this request like the
+ *		subjob requests of dup_br_for_subjob().  The attribute list of a
+ *		job is moved to its request and freed with it.  The single reply
+ *		lists the jobs that could not be altered and is sent once every
+ *		job has been answered.
+ *
+ * @param[in] preq - pointer to batch request from client
+ */
+void
+req_modifyjoblist(struct batch_request *preq)
+{
+	int i;
+	char *jid;
+	struct batch_request *pchild;
+	struct rq_modifyjoblist *pml = &preq->rq_ind.rq_modifyjoblist;
+
+	preq->rq_reply.brp_choice = BATCH_REPLY_CHOICE_Delete;
+	preq->rq_reply.brp_un.brp_deletejoblist.brp_delstatc = NULL;
+	preq->rq_reply.brp_count = 0;
+
+	++preq->rq_refct;	/* protect the request/reply struct */
+
+	for (i = 0; i < pml->rq_count; i++) {
+		jid = pml->rq_jobslist[i];
+
+		if (strlen(jid) > PBS_MAXSVRJOBID) {
+			add_joblist_stat(preq, jid, PBSE_IVALREQ);
+			continue;
+		}
+
+		if ((pchild = alloc_br(PBS_BATCH_ModifyJob)) == NULL) {
+			add_joblist_stat(preq, jid, PBSE_SYSTEM);
+			continue;
+		}
+		pchild->rq_perm = preq->rq_perm;
+		pchild->rq_fromsvr = preq->rq_fromsvr;
+		pchild->rq_conn = preq->rq_conn;
+		pchild->rq_orgconn = preq->rq_orgconn;
+		pchild->rq_time = preq->rq_time;
+		strcpy(pchild->rq_user, preq->rq_user);
+		strcpy(pchild->rq_host, preq->rq_host);
+		pchild->rq_extend = preq->rq_extend;
+		pchild->rq_reply.brp_choice = BATCH_REPLY_CHOICE_NULL;
+		pchild->rq_refct = 0;
+
+		pchild->rq_ind.rq_modify.rq_cmd = MGR_CMD_SET;
+		pchild->rq_ind.rq_modify.rq_objtype = MGR_OBJ_JOB;
+		strcpy(pchild->rq_ind.rq_modify.rq_objname, jid);
+		list_move(&pml->rq_attrs[i], &pchild->rq_ind.rq_modify.rq_attr);
+
+		pchild->rq_parentbr = preq;
+		++preq->rq_refct;
+
+		req_modifyjob(pchild);
+	}
+
+	/* reply now unless some of the jobs are still being answered */
+	if (--preq->rq_refct == 0)
+		reply_send(preq);
+}
+
 /**
  * @brief
  * 		Returns the svrattrl entry matching attribute 'name', or NULL if not found.
@@ -666,6 +735,7 @@ modify_job_attr(job *pjob, svrattrl *plist, int perm, int *bad)
 			}
 			/* ATR_VFLAG_MODCACHE will be included if set */
 			pattr[i].at_flags = newattr[i].at_flags;
+			pjob->ji_modseq = 1;
 		}
 	}
 
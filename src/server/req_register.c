@@ -211,6 +211,7 @@ static void update_depend(job *pjob, char *d_jobid, char *d_svr, int op, int typ
 			del_depend(dp);
 
 		pattr->at_flags |= ATR_MOD_MCACHE;
+		pjob->ji_modseq = 1;
 		/* runone dependencies are circular */
 		if (type == JOB_DEPEND_TYPE_RUNONE)
 			update_depend(d_job, pjob->ji_qs.ji_jobid, d_svr, op, type);
@@ -444,6 +445,7 @@ req_register(struct batch_request *preq)
 						if (pdj) {
 							del_depend_job(pdj);
 							pattr->at_flags |= ATR_MOD_MCACHE;
+							pjob->ji_modseq = 1;
 							(void)sprintf(log_buffer, msg_registerrel,
 								preq->rq_ind.rq_register.rq_child);
 							log_event(PBSEVENT_JOB, PBS_EVENTCLASS_JOB,
@@ -930,6 +932,7 @@ int depend_runone_remove_dependency(job *pjob)
 				if (temp_pdj) {
 					del_depend_job(temp_pdj);
 					pattr->at_flags |= ATR_MOD_MCACHE;
+					d_pjob->ji_modseq = 1;
 				}
 			}
 		}
@@ -347,6 +347,7 @@ remove_node_from_resv(resc_resv *presv, struct pbsnode *pnode)
 			else
 				prev->next = rinfp->next;
 			free(rinfp);
+			pnode->nd_modseq = 1;
 			break;
 		}
 	}
@@ -728,6 +729,7 @@ req_confirmresv(struct batch_request *preq)
 			if (remaining_occurrences > 0) {
 				/* now assign the execvnodes sequence attribute */
 				set_rattr_str_slim(presv, RESV_ATR_resv_execvnodes, preq->rq_ind.rq_run.rq_destin, NULL);
+				index_resv_occurrences(presv);
 			}
 		}
 	} else { /* Advance reservation */
@@ -695,6 +695,82 @@ req_runjob(struct batch_request *preq)
 		reply_send(preq);
 	return;
 }
+
+/**
+ * @brief
+ * 	req_runjoblist - service the Run Job List Request
+ *
+ * @par
+ *	Runs each (job, execvnode) pair of the request through req_runjob() as
+ *	an Asynchronous Run Job request with ack, linked to this request like
+ *	the subjob requests of dup_br_for_subjob().  The single reply lists the
+ *	jobs that were rejected and is sent once every job has been answered.
+ *
+ * @param[in] preq - pointer to batch request structure
+ *
+ * @return void
+ */
+void
+req_runjoblist(struct batch_request *preq)
+{
+	int i;
+	char *jid;
+	char *dest;
+	struct batch_request *pchild;
+	struct rq_runjoblist *prl = &preq->rq_ind.rq_runjoblist;
+
+	if ((preq->rq_perm & (ATR_DFLAG_MGWR | ATR_DFLAG_OPWR)) == 0) {
+		req_reject(PBSE_PERM, 0, preq);
+		return;
+	}
+
+	preq->rq_reply.brp_choice = BATCH_REPLY_CHOICE_Delete;
+	preq->rq_reply.brp_un.brp_deletejoblist.brp_delstatc = NULL;
+	preq->rq_reply.brp_count = 0;
+
+	++preq->rq_refct;	/* protect the request/reply struct */
+
+	for (i = 0; i < prl->rq_count; i++) {
+		jid = prl->rq_jobslist[i];
+		dest = prl->rq_destins[i];
+
+		/* without a destination the job would be deferred to the scheduler */
+		if ((strlen(jid) > PBS_MAXSVRJOBID) || (dest == NULL) || (*dest == '\0')) {
+			add_joblist_stat(preq, jid, PBSE_IVALREQ);
+			continue;
+		}
+
+		if ((pchild = alloc_br(PBS_BATCH_AsyrunJob_ack)) == NULL) {
+			add_joblist_stat(preq, jid, PBSE_SYSTEM);
+			continue;
+		}
+		pchild->rq_perm = preq->rq_perm;
+		pchild->rq_fromsvr = preq->rq_fromsvr;
+		pchild->rq_conn = preq->rq_conn;
+		pchild->rq_orgconn = preq->rq_orgconn;
+		pchild->rq_time = preq->rq_time;
+		strcpy(pchild->rq_user, preq->rq_user);
+		strcpy(pchild->rq_host, preq->rq_host);
+		pchild->rq_extend = preq->rq_extend;
+		pchild->rq_reply.brp_choice = BATCH_REPLY_CHOICE_NULL;
+		pchild->rq_refct = 0;
+
+		/* the destination stays owned by the parent, see free_br() */
+		strcpy(pchild->rq_ind.rq_run.rq_jid, jid);
+		pchild->rq_ind.rq_run.rq_destin = dest;
+		pchild->rq_ind.rq_run.rq_resch = 0;
+
+		pchild->rq_parentbr = preq;
+		++preq->rq_refct;
+
+		req_runjob(pchild);
+	}
+
+	/* reply now unless some of the jobs are still being answered */
+	if (--preq->rq_refct == 0)
+		reply_send(preq);
+}
+
 /**
  * @brief
  * 		req_runjob - service the Run Job and Asyc Run Job Requests
@@ -402,8 +402,13 @@ req_selectjobs(struct batch_request *preq)
 			 * If "T" was specified, dosubjobs is set, and if the job is
 			 * an Array Job, then the State is Not checked. The State
 			 * must be checked against the state of each Subjob
+			 *
+			 * the job is stamped first so a selection on its change
+			 * sequence number sees any modification made since the
+			 * last query
 			 */
 
+			job_chgseq_update(pjob);
 			if (select_job(pjob, selistp, dosubjobs, dohistjobs)) {
 
 				/* job is selected, include in reply */
@@ -648,9 +648,11 @@ void set_admin_suspend(job *pjob, int set_remove_nstate) {
 			if(pnode) {
 				if(set_remove_nstate) {
 					set_arst(get_nattr(pnode, ND_ATR_MaintJobs), &new, INCR);
+					pnode->nd_modseq = 1;
 					set_vnode_state(pnode, INUSE_MAINTENANCE, Nd_State_Or);
 				} else {
 					set_arst(get_nattr(pnode, ND_ATR_MaintJobs), &new, DECR);
+					pnode->nd_modseq = 1;
 					if ((get_nattr_arst(pnode, ND_ATR_MaintJobs))->as_usedptr == 0)
 						set_vnode_state(pnode, ~INUSE_MAINTENANCE, Nd_State_And);
 				}
@@ -52,6 +52,10 @@
  * 	status_que()
  * 	req_stat_node()
  * 	status_node()
+ * 	add_stat_tombstone()
+ * 	node_chgseq_update()
+ * 	status_delta_entry()
+ * 	req_stat_delta()
  * 	req_stat_svr()
  * 	req_stat_sched()
  * 	update_state_ct()
@@ -121,10 +125,26 @@ extern int svr_chk_histjob(job *);
 
 static int bad;
 
+/*
+ * Deleted jobs and vnodes, oldest first, reported by req_stat_delta() to
+ * clients whose change sequence number is older than the deletion.
+ */
+struct stat_tombstone {
+	pbs_list_link ts_link;
+	int ts_objtype;		/* MGR_OBJ_JOB or MGR_OBJ_NODE */
+	long ts_seq;		/* change sequence number of the deletion */
+	char *ts_name;
+	char *ts_owner;		/* owner of a deleted job, NULL for a vnode */
+};
+#define MAX_STAT_TOMBSTONES 10000
+static pbs_list_head stat_tombstones;
+static int stat_tombstone_ct = 0;
+static long stat_tombstone_floor = 0;	/* seq of the newest discarded tombstone */
+
 /* The following private support functions are included */
 
 static int status_que(pbs_queue *, struct batch_request *, pbs_list_head *);
-static int status_node(struct pbsnode *, struct batch_request *, pbs_list_head *);
+static int status_node(struct pbsnode *, struct batch_request *, svrattrl *, pbs_list_head *);
 static int status_resv(resc_resv *, struct batch_request *, pbs_list_head *);
 
 /**
@@ -171,7 +191,7 @@ do_stat_of_a_job(struct batch_request *preq, job *pjob, int dohistjobs, int dosu
 		    && pjob->ji_ajinfo != NULL
 		    && pjob->ji_ajinfo->tkm_ct != pjob->ji_ajinfo->tkm_subjsct[JOB_STATE_QUEUED]) {
 			for (i = pjob->ji_ajinfo->tkm_start; i <= pjob->ji_ajinfo->tkm_end; i += pjob->ji_ajinfo->tkm_step) {
-				if (range_contains(pjob->ji_ajinfo->trm_quelist, i))
+				if (is_subjob_queued(pjob, i))
 					continue;
 				rc = status_subjob(pjob, preq, pal, i, &preply->brp_un.brp_status, &bad, 1);
 				if (rc && rc != PBSE_PERM)
@@ -527,6 +547,7 @@ status_que(pbs_queue *pque, struct batch_request *preq, pbs_list_head *pstathd)
 	strcpy(pstat->brp_objname, pque->qu_qs.qu_name);
 	CLEAR_LINK(pstat->brp_stlink);
 	CLEAR_HEAD(pstat->brp_attr);
+	pstat->brp_enc = NULL;
 	append_link(pstathd, &pstat->brp_stlink, pstat);
 	preq->rq_reply.brp_count++;
 
@@ -594,16 +615,17 @@ req_stat_node(struct batch_request *preq)
 	preply->brp_choice = BATCH_REPLY_CHOICE_Status;
 	CLEAR_HEAD(preply->brp_un.brp_status);
 	preply->brp_count = 0;
+	pal = (svrattrl *)GET_NEXT(preq->rq_ind.rq_status.rq_attr);
 
 	if (type == 0) {		/* get status of the named node */
-		rc = status_node(pnode, preq, &preply->brp_un.brp_status);
+		rc = status_node(pnode, preq, pal, &preply->brp_un.brp_status);
 
 	} else {			/* get status of all nodes */
 	
 		for (i = 0; i < svr_totnodes; i++) {
 			pnode = pbsndlist[i];
 
-			rc = status_node(pnode, preq,
+			rc = status_node(pnode, preq, pal,
 				&preply->brp_un.brp_status);
 			if (rc)
 				break;
@@ -630,6 +652,7 @@ req_stat_node(struct batch_request *preq)
  *
  * @param[in,out]	pnode	-	ptr to node receiving status query
  * @param[in]	preq	-	ptr to the decoded request
+ * @param[in]	pal	-	list of attributes to report, NULL for all
  * @param[in,out]	pstathd	-	head of list to append status to
  *
  * @return	int
@@ -638,12 +661,12 @@ req_stat_node(struct batch_request *preq)
  */
 
 static int
-status_node(struct pbsnode *pnode, struct batch_request *preq, pbs_list_head *pstathd)
+status_node(struct pbsnode *pnode, struct batch_request *preq, svrattrl *pal, pbs_list_head *pstathd)
 {
 	int		   rc = 0;
 	struct brp_status *pstat;
-	svrattrl	  *pal;
 	unsigned long		   old_nd_state = VNODE_UNAVAILABLE;
+	int		   old_modseq;
 
 	if (pnode->nd_state & INUSE_DELETED)  /*node no longer valid*/
 		return  (0);
@@ -656,6 +679,9 @@ status_node(struct pbsnode *pnode, struct batch_request *preq, pbs_list_head *ps
 	if (pnode->nd_state != get_nattr_long(pnode, ND_ATR_state))
 		set_nattr_l_slim(pnode, ND_ATR_state, pnode->nd_state, SET);
 
+	/* masking the state below is not a change of the vnode */
+	old_modseq = pnode->nd_modseq;
+
 	/*node is provisioning - mask out the DOWN/UNKNOWN flags while prov is on*/
 	if (get_nattr_long(pnode, ND_ATR_state) & (INUSE_PROV | INUSE_WAIT_PROV)) {
 		old_nd_state = get_nattr_long(pnode, ND_ATR_state);
@@ -676,6 +702,7 @@ status_node(struct pbsnode *pnode, struct batch_request *preq, pbs_list_head *ps
 	strcpy(pstat->brp_objname, pnode->nd_name);
 	CLEAR_LINK(pstat->brp_stlink);
 	CLEAR_HEAD(pstat->brp_attr);
+	pstat->brp_enc = NULL;
 
 	/*add this new brp_status structure to the list hanging off*/
 	/*the request's reply substructure                         */
@@ -687,18 +714,272 @@ status_node(struct pbsnode *pnode, struct batch_request *preq, pbs_list_head *ps
 	/*hang that status information from the brp_attr field for this  */
 	/*brp_status structure                                           */
 	bad = 0;                                        /*global variable*/
-	pal = (svrattrl *)GET_NEXT(preq->rq_ind.rq_status.rq_attr);
-
 	rc = status_nodeattrib(pal, pnode, ND_ATR_LAST, preq->rq_perm, &pstat->brp_attr, &bad);
 
 	/*reverting back the state*/
 
 	if (get_nattr_long(pnode, ND_ATR_state) & INUSE_PROV)
 		set_nattr_l_slim(pnode, ND_ATR_state, old_nd_state, SET);
+	pnode->nd_modseq = old_modseq;
 
 	return (rc);
 }
 
+/**
+ * @brief
+ * 		add_stat_tombstone - remember that a job or vnode was deleted so
+ *		req_stat_delta() can report it.  Only the most recent
+ *		MAX_STAT_TOMBSTONES deletions are kept; clients older than the
+ *		oldest one kept are told to query everything again.
+ *
+ * @param[in]	objtype	-	MGR_OBJ_JOB or MGR_OBJ_NODE
+ * @param[in]	name	-	job id or vnode name
+ * @param[in]	owner	-	owner of the job, NULL for a vnode
+ *
+ * @return	void
+ */
+void
+add_stat_tombstone(int objtype, char *name, char *owner)
+{
+	struct stat_tombstone *pts;
+
+	if (stat_tombstones.ll_next == NULL)
+		CLEAR_HEAD(stat_tombstones);
+
+	if (stat_tombstone_ct >= MAX_STAT_TOMBSTONES) {
+		pts = (struct stat_tombstone *) GET_NEXT(stat_tombstones);
+		stat_tombstone_floor = pts->ts_seq;
+		delete_link(&pts->ts_link);
+		free(pts->ts_name);
+		free(pts->ts_owner);
+		free(pts);
+		stat_tombstone_ct--;
+	}
+
+	pts = (struct stat_tombstone *) malloc(sizeof(struct stat_tombstone));
+	if (pts != NULL) {
+		pts->ts_name = strdup(name);
+		pts->ts_owner = owner ? strdup(owner) : NULL;
+	}
+	if (pts == NULL || pts->ts_name == NULL || (owner && pts->ts_owner == NULL)) {
+		log_err(errno, __func__, "Out of memory");
+		if (pts) {
+			free(pts->ts_name);
+			free(pts->ts_owner);
+		}
+		free(pts);
+		/* the deletion is lost, make older clients start over */
+		stat_tombstone_floor = next_chgseq();
+		return;
+	}
+	pts->ts_objtype = objtype;
+	pts->ts_seq = next_chgseq();
+	CLEAR_LINK(pts->ts_link);
+	append_link(&stat_tombstones, &pts->ts_link, pts);
+	stat_tombstone_ct++;
+}
+
+/**
+ * @brief
+ * 		node_chgseq_update - stamp the vnode with a new change sequence
+ *		number if it was modified since it was last stamped.
+ *
+ * @param[in,out]	pnode	-	vnode to stamp
+ *
+ * @return	void
+ */
+static void
+node_chgseq_update(struct pbsnode *pnode)
+{
+	if (pnode->nd_state != get_nattr_long(pnode, ND_ATR_state))
+		set_nattr_l_slim(pnode, ND_ATR_state, pnode->nd_state, SET);
+
+	if (!pnode->nd_modseq && pnode->nd_chgseq != 0)
+		return;
+
+	pnode->nd_chgseq = next_chgseq();
+	pnode->nd_modseq = 0;
+}
+
+/**
+ * @brief
+ * 		status_delta_entry - append a status entry with a single attribute
+ *		to the reply, used for tombstones and the change sequence number.
+ *
+ * @param[in,out]	preq	-	ptr to the decoded request
+ * @param[in]	objtype	-	object type of the entry
+ * @param[in]	name	-	object name
+ * @param[in]	atname	-	attribute name
+ * @param[in]	value	-	attribute value
+ *
+ * @return	int
+ * @retval	PBSE_NONE	: success
+ * @retval	PBSE_SYSTEM	: out of memory
+ */
+static int
+status_delta_entry(struct batch_request *preq, int objtype, char *name, char *atname, char *value)
+{
+	struct brp_status *pstat;
+	svrattrl *pal;
+
+	pstat = (struct brp_status *) malloc(sizeof(struct brp_status));
+	if (pstat == NULL)
+		return (PBSE_SYSTEM);
+	if ((pal = attrlist_create(atname, NULL, strlen(value) + 1)) == NULL) {
+		free(pstat);
+		return (PBSE_SYSTEM);
+	}
+	strcpy(pal->al_value, value);
+
+	CLEAR_LINK(pstat->brp_stlink);
+	pstat->brp_objtype = objtype;
+	pbs_strncpy(pstat->brp_objname, name, sizeof(pstat->brp_objname));
+	CLEAR_HEAD(pstat->brp_attr);
+	pstat->brp_enc = NULL;
+	append_link(&pstat->brp_attr, &pal->al_link, pal);
+	append_link(&preq->rq_reply.brp_un.brp_status, &pstat->brp_stlink, pstat);
+	preq->rq_reply.brp_count++;
+
+	return (PBSE_NONE);
+}
+
+/**
+ * @brief
+ * 		req_stat_delta - service the Status Delta Request
+ *
+ *		Returns the status of the jobs or vnodes stamped with a change
+ *		sequence number greater than the client's, an entry with the
+ *		ATTR_deleted attribute for each one deleted since, and finally an
+ *		entry with an empty name holding the server's current change
+ *		sequence number for the client's next request.
+ *
+ * @param[in,out]	preq	-	ptr to the decoded request
+ *
+ * @return	void
+ */
+void
+req_stat_delta(struct batch_request *preq)
+{
+	struct rq_statdelta *pdelta = &preq->rq_ind.rq_statdelta;
+	struct batch_reply *preply = &preq->rq_reply;
+	struct stat_tombstone *pts;
+	svrattrl *pal;
+	job *pjob;
+	struct pbsnode *pnode;
+	long seq = pdelta->rq_seq;
+	long cur;
+	long start;
+	int dohistjobs = 0;
+	int chkowner;
+	int rc = PBSE_NONE;
+	int i;
+	char buf[32];
+
+	if ((pdelta->rq_objtype != MGR_OBJ_JOB) && (pdelta->rq_objtype != MGR_OBJ_NODE)) {
+		req_reject(PBSE_IVALREQ, 0, preq);
+		return;
+	}
+
+	if (preq->rq_extend && strchr(preq->rq_extend, (int) 'x')) {
+		if (svr_history_enable == 0) {
+			req_reject(PBSE_JOBHISTNOTSET, 0, preq);
+			return;
+		}
+		dohistjobs = 1;
+	}
+
+	/* deletions before seq may have been forgotten, or seq is from another server instance */
+	cur = get_chgseq(&start);
+	if ((seq != 0) && ((seq < start) || (seq < stat_tombstone_floor) || (seq > cur))) {
+		req_reject(PBSE_DELTASEQ, 0, preq);
+		return;
+	}
+
+	if (stat_tombstones.ll_next == NULL)
+		CLEAR_HEAD(stat_tombstones);
+
+	/* as in status_job(), users may only see their own jobs come and go */
+	chkowner = !get_sattr_long(SVR_ATR_query_others) &&
+		((preq->rq_perm & (ATR_DFLAG_OPRD | ATR_DFLAG_OPWR | ATR_DFLAG_MGRD | ATR_DFLAG_MGWR)) == 0);
+
+	preply->brp_choice = BATCH_REPLY_CHOICE_Status;
+	CLEAR_HEAD(preply->brp_un.brp_status);
+	preply->brp_count = 0;
+	pal = (svrattrl *) GET_NEXT(pdelta->rq_attr);
+
+	if (pdelta->rq_objtype == MGR_OBJ_JOB) {
+		for (pjob = (job *) GET_NEXT(svr_alljobs); pjob; pjob = (job *) GET_NEXT(pjob->ji_alljobs)) {
+			if (pjob->ji_qs.ji_svrflags & JOB_SVFLG_SubJob)
+				continue;
+			job_chgseq_update(pjob);
+			if (get_jattr_long(pjob, JOB_ATR_chgseq) <= seq)
+				continue;
+			if (chkowner && svr_chk_owner(preq, pjob))
+				continue;
+			if (preply->brp_count >= MAX_JOBS_PER_REPLY) {
+				if ((rc = reply_send_status_part(preq)) != PBSE_NONE)
+					return;
+			}
+			/* a job which became history is gone for a client not asking for history */
+			if (!dohistjobs && (check_job_state(pjob, JOB_STATE_LTR_FINISHED) ||
+				check_job_state(pjob, JOB_STATE_LTR_MOVED))) {
+				if (seq != 0)
+					rc = status_delta_entry(preq, MGR_OBJ_JOB, pjob->ji_qs.ji_jobid, ATTR_deleted, ATR_TRUE);
+			} else
+				rc = status_job(pjob, preq, pal, &preply->brp_un.brp_status, &bad, 0);
+			if (rc != PBSE_NONE && rc != PBSE_PERM) {
+				req_reject(rc, bad, preq);
+				return;
+			}
+		}
+	} else {
+		if (pbsndlist == 0 || svr_totnodes <= 0) {
+			req_reject(PBSE_NONODES, 0, preq);
+			return;
+		}
+		resc_access_perm = preq->rq_perm;
+		for (i = 0; i < svr_totnodes; i++) {
+			pnode = pbsndlist[i];
+			if (pnode->nd_state & INUSE_DELETED)
+				continue;
+			node_chgseq_update(pnode);
+			if (pnode->nd_chgseq <= seq)
+				continue;
+			rc = status_node(pnode, preq, pal, &preply->brp_un.brp_status);
+			if (rc == PBSE_UNKNODEATR) {
+				reply_badattr(rc, bad, pal, preq);
+				return;
+			} else if (rc) {
+				req_reject(rc, 0, preq);
+				return;
+			}
+		}
+	}
+
+	if (seq != 0) {
+		for (pts = (struct stat_tombstone *) GET_PRIOR(stat_tombstones);
+			pts && pts->ts_seq > seq;
+			pts = (struct stat_tombstone *) GET_PRIOR(pts->ts_link)) {
+			if (pts->ts_objtype != pdelta->rq_objtype)
+				continue;
+			if (chkowner && pts->ts_objtype == MGR_OBJ_JOB && svr_chk_owner_name(preq, pts->ts_owner))
+				continue;
+			if ((rc = status_delta_entry(preq, pts->ts_objtype, pts->ts_name, ATTR_deleted, ATR_TRUE)) != PBSE_NONE) {
+				req_reject(rc, 0, preq);
+				return;
+			}
+		}
+	}
+
+	snprintf(buf, sizeof(buf), "%ld", get_chgseq(NULL));
+	if ((rc = status_delta_entry(preq, MGR_OBJ_SERVER, "", ATTR_chgseq, buf)) != PBSE_NONE) {
+		req_reject(rc, 0, preq);
+		return;
+	}
+
+	reply_send(preq);
+}
+
 /**
  * @brief
  * 	update_isrunhook - update the value is has_runjob_hook
@@ -780,6 +1061,7 @@ req_stat_svr(struct batch_request *preq)
 	strcpy(pstat->brp_objname, server_name);
 	pstat->brp_objtype = MGR_OBJ_SERVER;
 	CLEAR_HEAD(pstat->brp_attr);
+	pstat->brp_enc = NULL;
 	append_link(&preply->brp_un.brp_status, &pstat->brp_stlink, pstat);
 	preply->brp_count++;
 
@@ -887,6 +1169,7 @@ status_sched(pbs_sched *psched, struct batch_request *preq, pbs_list_head *pstat
 
 	CLEAR_LINK(pstat->brp_stlink);
 	CLEAR_HEAD(pstat->brp_attr);
+	pstat->brp_enc = NULL;
 	append_link(pstathd, &pstat->brp_stlink, pstat);
 	preq->rq_reply.brp_count++;
 
@@ -1104,6 +1387,7 @@ status_resv(resc_resv *presv, struct batch_request *preq, pbs_list_head *pstathd
 	strcpy(pstat->brp_objname, presv->ri_qs.ri_resvID);
 	CLEAR_LINK(pstat->brp_stlink);
 	CLEAR_HEAD(pstat->brp_attr);
+	pstat->brp_enc = NULL;
 	append_link(pstathd, &pstat->brp_stlink, pstat);
 	preq->rq_reply.brp_count++;
 
@@ -1157,6 +1441,7 @@ status_resc(struct resource_def *prd, struct batch_request *preq, pbs_list_head
 	strcpy(pstat->brp_objname, prd->rs_name);
 	CLEAR_LINK(pstat->brp_stlink);
 	CLEAR_HEAD(pstat->brp_attr);
+	pstat->brp_enc = NULL;
 
 	/* add attributes to the status reply */
 	if (private) {
@@ -48,6 +48,12 @@
  * Included funtions are:
  *	svrcached()
  *	status_attrib()
+ *	next_chgseq()
+ *	get_chgseq()
+ *	job_chgseq_update()
+ *	status_select_str()
+ *	job_statcache_slot()
+ *	job_statcache_free()
  *	status_job()
  *	status_subjob()
  *
@@ -82,6 +88,9 @@ extern struct server server;
 extern char	     statechars[];
 extern time_t time_now;
 
+static long svr_chgseq = 0;		/* last change sequence number handed out */
+static long svr_chgseq_start = 0;	/* first one of this server instance */
+
 /**
  * @brief
  * 		svrcached - either link in (to phead) a cached svrattrl struct which is
@@ -228,11 +237,192 @@ status_attrib(svrattrl *pal, void *pidx, attribute_def *padef, attribute *pattr,
 	return (0);
 }
 
+/**
+ * @brief
+ * 		next_chgseq - hand out the next change sequence number.
+ *
+ * @par
+ *		The sequence starts from a time based value so it keeps increasing
+ *		across server restarts.
+ *
+ * @return	long
+ * @retval	the new change sequence number
+ */
+long
+next_chgseq(void)
+{
+	if (svr_chgseq == 0) {
+		svr_chgseq = (long) time(NULL) << 20;
+		svr_chgseq_start = svr_chgseq;
+	}
+	return ++svr_chgseq;
+}
+
+/**
+ * @brief
+ * 		get_chgseq - return the last change sequence number handed out
+ *		and, optionally, the first one of this server instance.
+ *
+ * @param[out]	start	-	if not NULL, the first change sequence number
+ *
+ * @return	long
+ * @retval	last change sequence number
+ */
+long
+get_chgseq(long *start)
+{
+	if (svr_chgseq == 0) {
+		svr_chgseq = (long) time(NULL) << 20;
+		svr_chgseq_start = svr_chgseq;
+	}
+	if (start != NULL)
+		*start = svr_chgseq_start;
+	return svr_chgseq;
+}
+
+/**
+ * @brief
+ * 		job_chgseq_update - stamp the job with a new change sequence number
+ *		if it was modified since it was last stamped.
+ *
+ * @par
+ *		The job setters, modify_job_attr() and job_save() mark the job
+ *		modified through ji_modseq.  The eligible_time of a job accruing
+ *		eligible time is calculated on the fly and does not count.
+ *
+ * @param[in,out]	pjob	-	ptr to job to stamp
+ *
+ * @return	void
+ */
+void
+job_chgseq_update(job *pjob)
+{
+	attribute *pattr;
+
+	if (!pjob->ji_modseq && is_jattr_set(pjob, JOB_ATR_chgseq))
+		return;
+
+	/* set directly, the stamp itself must not count as a modification */
+	pattr = get_jattr(pjob, JOB_ATR_chgseq);
+	pattr->at_val.at_long = next_chgseq();
+	pattr->at_flags |= ATR_VFLAG_SET | ATR_VFLAG_MODCACHE;
+	pjob->ji_modseq = 0;
+}
+
+/**
+ * @brief
+ * 		status_select_str - build a string naming the attributes in the
+ *		list, to tell whether a cached job status fits the request.
+ *
+ * @param[in]	pal	-	specific attributes to status, NULL for all
+ *
+ * @return	char *
+ * @retval	malloc'ed string, "" for all attributes
+ * @retval	NULL	: out of memory
+ */
+static char *
+status_select_str(svrattrl *pal)
+{
+	svrattrl *ps;
+	size_t len = 1;
+	char *sel;
+
+	for (ps = pal; ps; ps = (svrattrl *)GET_NEXT(ps->al_link)) {
+		len += strlen(ps->al_name) + 2;
+		if (ps->al_resc)
+			len += strlen(ps->al_resc);
+	}
+	if ((sel = malloc(len)) == NULL)
+		return NULL;
+	*sel = '\0';
+	for (ps = pal; ps; ps = (svrattrl *)GET_NEXT(ps->al_link)) {
+		strcat(sel, ps->al_name);
+		strcat(sel, ".");
+		if (ps->al_resc)
+			strcat(sel, ps->al_resc);
+		strcat(sel, ",");
+	}
+	return sel;
+}
+
+/**
+ * @brief
+ * 		job_statcache_slot - find the job's cached status for the key and
+ *		attribute selection, or make room for a new one.
+ *
+ * @par
+ *		The slots are kept most recently used first, a new entry is put in
+ *		the first slot and the last one is dropped.  The selection string
+ *		is taken over by the slot.
+ *
+ * @param[in,out]	pjob	-	job
+ * @param[in]	key	-	privilege and server settings the status depends on
+ * @param[in]	sel	-	attribute selection, see status_select_str()
+ *
+ * @return	struct job_statcache *
+ * @retval	the slot for key and sel
+ */
+static struct job_statcache *
+job_statcache_slot(job *pjob, int key, char *sel)
+{
+	struct job_statcache *psc = pjob->ji_statcache;
+	struct job_statcache tmp;
+	int i;
+
+	for (i = 0; i < JOB_STATCACHE_SLOTS; i++) {
+		if (psc[i].jsc_select && (psc[i].jsc_key == key) && (strcmp(psc[i].jsc_select, sel) == 0))
+			break;
+	}
+	if (i == JOB_STATCACHE_SLOTS) {
+		i = JOB_STATCACHE_SLOTS - 1;
+		free_brp_encoded(psc[i].jsc_enc);
+		free(psc[i].jsc_select);
+		psc[i].jsc_enc = NULL;
+		psc[i].jsc_chgseq = 0;
+		psc[i].jsc_key = key;
+		psc[i].jsc_select = sel;
+	} else
+		free(sel);
+
+	if (i > 0) {
+		tmp = psc[i];
+		memmove(&psc[1], &psc[0], i * sizeof(struct job_statcache));
+		psc[0] = tmp;
+	}
+	return &psc[0];
+}
+
+/**
+ * @brief
+ * 		job_statcache_free - free the job's cached status replies.
+ *
+ * @param[in,out]	pjob	-	job
+ *
+ * @return	void
+ */
+void
+job_statcache_free(job *pjob)
+{
+	int i;
+
+	for (i = 0; i < JOB_STATCACHE_SLOTS; i++) {
+		free_brp_encoded(pjob->ji_statcache[i].jsc_enc);
+		free(pjob->ji_statcache[i].jsc_select);
+		pjob->ji_statcache[i].jsc_enc = NULL;
+		pjob->ji_statcache[i].jsc_select = NULL;
+	}
+}
+
 /**
  * @brief
  * 		status_job - Build the status reply for a single job, regular or Array,
  *		but not a subjob of an Array Job.
  *
+ * @par
+ *		For a reply sent over the network, the encoded attributes are kept
+ *		with the job and sent again as is until the job is restamped with a
+ *		new change sequence number, see job_chgseq_update().
+ *
  * @param[in,out]	pjob	-	ptr to job to status
  * @param[in]		preq	-	request structure
  * @param[in]		pal	-	specific attributes to status
@@ -255,6 +445,10 @@ status_job(job *pjob, struct batch_request *preq, svrattrl *pal, pbs_list_head *
 	int old_elig_flags = 0;
 	int old_atyp_flags = 0;
 	int revert_state_r = 0;
+	struct job_statcache *psc = NULL;
+	struct brp_encoded *pbe;
+	char *sel;
+	int key;
 
 	/* see if the client is authorized to status this job */
 
@@ -262,21 +456,7 @@ status_job(job *pjob, struct batch_request *preq, svrattrl *pal, pbs_list_head *
 		if (svr_authorize_jobreq(preq, pjob))
 			return (PBSE_PERM);
 
-	/* calc eligible time on the fly and return, don't save. */
-	if (get_sattr_long(SVR_ATR_EligibleTimeEnable) == TRUE) {
-		if (get_jattr_long(pjob, JOB_ATR_accrue_type) == JOB_ELIGIBLE) {
-			oldtime = get_jattr_long(pjob, JOB_ATR_eligible_time);
-			set_jattr_l_slim(pjob, JOB_ATR_eligible_time,
-					time_now - get_jattr_long(pjob, JOB_ATR_sample_starttime), INCR);
-		}
-	} else {
-		/* eligible_time_enable is off so, clear set flag so that eligible_time and accrue type dont show */
-		old_elig_flags = get_jattr(pjob, JOB_ATR_eligible_time)->at_flags;
-		mark_jattr_not_set(pjob, JOB_ATR_eligible_time);
-
-		old_atyp_flags = get_jattr(pjob, JOB_ATR_accrue_type)->at_flags;
-		mark_jattr_not_set(pjob, JOB_ATR_accrue_type);
-	}
+	job_chgseq_update(pjob);
 
 	/* allocate reply structure and fill in header portion */
 
@@ -292,9 +472,54 @@ status_job(job *pjob, struct batch_request *preq, svrattrl *pal, pbs_list_head *
 		pstat->brp_objtype = MGR_OBJ_JOB;
 	(void)strcpy(pstat->brp_objname, pjob->ji_qs.ji_jobid);
 	CLEAR_HEAD(pstat->brp_attr);
+	pstat->brp_enc = NULL;
 	append_link(pstathd, &pstat->brp_stlink, pstat);
 	preq->rq_reply.brp_count++;
 
+	/*
+	 * Local requests read the attribute list itself, not the encoding.
+	 * The eligible_time of a job accruing eligible time is calculated
+	 * on the fly, no point in caching it.
+	 */
+	if (get_sattr_long(SVR_ATR_EligibleTimeEnable) == TRUE)
+		key = (get_jattr_long(pjob, JOB_ATR_accrue_type) == JOB_ELIGIBLE) ? -1 : 0x10000;
+	else
+		key = 0;
+	if ((key != -1) && (preq->rq_conn >= 0) && (preq->rq_parentbr == NULL) &&
+		((sel = status_select_str(pal)) != NULL)) {
+		key |= preq->rq_perm & (ATR_DFLAG_RDACC | ATR_DFLAG_SvWR);
+		if (get_sattr_long(SVR_ATR_show_hidden_attribs))
+			key |= 0x20000;
+		if (pjob->ji_qs.ji_svrflags & JOB_SVFLG_Suspend)
+			key |= 0x40000;
+		if (pjob->ji_qs.ji_svrflags & JOB_SVFLG_Actsuspd)
+			key |= 0x80000;
+		psc = job_statcache_slot(pjob, key, sel);
+		if ((psc->jsc_enc != NULL) && (psc->jsc_enc->be_data != NULL) &&
+			(psc->jsc_chgseq == get_jattr_long(pjob, JOB_ATR_chgseq))) {
+			pstat->brp_enc = psc->jsc_enc;
+			psc->jsc_enc->be_refct++;
+			*bad = 0;
+			return (0);
+		}
+	}
+
+	/* calc eligible time on the fly and return, don't save. */
+	if (get_sattr_long(SVR_ATR_EligibleTimeEnable) == TRUE) {
+		if (get_jattr_long(pjob, JOB_ATR_accrue_type) == JOB_ELIGIBLE) {
+			oldtime = get_jattr_long(pjob, JOB_ATR_eligible_time);
+			set_jattr_l_slim(pjob, JOB_ATR_eligible_time,
+					time_now - get_jattr_long(pjob, JOB_ATR_sample_starttime), INCR);
+		}
+	} else {
+		/* eligible_time_enable is off so, clear set flag so that eligible_time and accrue type dont show */
+		old_elig_flags = get_jattr(pjob, JOB_ATR_eligible_time)->at_flags;
+		mark_jattr_not_set(pjob, JOB_ATR_eligible_time);
+
+		old_atyp_flags = get_jattr(pjob, JOB_ATR_accrue_type)->at_flags;
+		mark_jattr_not_set(pjob, JOB_ATR_accrue_type);
+	}
+
 	/* Temporarily set suspend/user suspend states for the stat */
 	if (check_job_state(pjob, JOB_STATE_LTR_RUNNING)) {
 		if (pjob->ji_qs.ji_svrflags & JOB_SVFLG_Suspend) {
@@ -315,8 +540,9 @@ status_job(job *pjob, struct batch_request *preq, svrattrl *pal, pbs_list_head *
 	/* reset eligible time, it was calctd on the fly, real calctn only when accrue_type changes */
 
 	if (get_sattr_long(SVR_ATR_EligibleTimeEnable) != 0) {
-		if (get_jattr_long(pjob, JOB_ATR_accrue_type) == JOB_ELIGIBLE)
+		if (get_jattr_long(pjob, JOB_ATR_accrue_type) == JOB_ELIGIBLE) {
 			set_jattr_l_slim(pjob, JOB_ATR_eligible_time, oldtime, SET);
+		}
 	} else {
 		/* reset the set flags */
 		get_jattr(pjob, JOB_ATR_eligible_time)->at_flags = old_elig_flags;
@@ -324,8 +550,21 @@ status_job(job *pjob, struct batch_request *preq, svrattrl *pal, pbs_list_head *
 		get_jattr(pjob, JOB_ATR_accrue_type)->at_flags = old_atyp_flags;
 	}
 
-	if (revert_state_r)
+	if (revert_state_r) {
 		set_job_state(pjob, JOB_STATE_LTR_RUNNING);
+	}
+
+	/* the temporary changes above are not modifications */
+	pjob->ji_modseq = 0;
+
+	/* the encoding is filled in when the reply is sent */
+	if (psc != NULL && (pbe = calloc(1, sizeof(struct brp_encoded))) != NULL) {
+		free_brp_encoded(psc->jsc_enc);
+		pbe->be_refct = 2;
+		psc->jsc_enc = pbe;
+		psc->jsc_chgseq = get_jattr_long(pjob, JOB_ATR_chgseq);
+		pstat->brp_enc = pbe;
+	}
 
 	return (0);
 }
@@ -363,6 +602,7 @@ status_subjob(job *pjob, struct batch_request *preq, svrattrl *pal, int subj, pb
 	char sjst;
 	int sjsst;
 	char *objname;
+	int old_modseq;
 
 	/* see if the client is authorized to status this job */
 
@@ -403,6 +643,7 @@ status_subjob(job *pjob, struct batch_request *preq, svrattrl *pal, int subj, pb
 		pstat->brp_objtype = MGR_OBJ_JOB;
 	(void)strcpy(pstat->brp_objname, objname);
 	CLEAR_HEAD(pstat->brp_attr);
+	pstat->brp_enc = NULL;
 	append_link(pstathd, &pstat->brp_stlink, pstat);
 	preq->rq_reply.brp_count++;
 
@@ -415,6 +656,7 @@ status_subjob(job *pjob, struct batch_request *preq, svrattrl *pal, int subj, pb
 	 * and comment to that of the subjob
 	 */
 	realstate = get_job_state(pjob);
+	old_modseq = pjob->ji_modseq;
 	set_job_state(pjob, sjst);
 
 	if (sjst == JOB_STATE_LTR_EXPIRED || sjst == JOB_STATE_LTR_FINISHED) {
@@ -485,5 +727,8 @@ status_subjob(job *pjob, struct batch_request *preq, svrattrl *pal, int subj, pb
 		attr->at_flags = oldatypflags;
 	}
 
+	/* faking the subjob did not modify the parent */
+	pjob->ji_modseq = old_modseq;
+
 	return (rc);
 }
@@ -112,6 +112,25 @@ static	int svr_authorize_resvReq(struct batch_request*, resc_resv*);
 
 int
 svr_chk_owner(struct batch_request *preq, job *pjob)
+{
+	return (svr_chk_owner_name(preq, get_jattr_str(pjob, JOB_ATR_job_owner)));
+}
+
+/**
+ * @brief
+ * 		svr_chk_owner_name - compare a user name from a request and the
+ *		owner of a job given as "user@host", for when only the owner of
+ *		the job is left, as for a deleted job.
+ *
+ * @param[in]	preq	-	request structure which contains the user name
+ * @param[in]	jobowner	-	owner of the job, "user@host"
+ *
+ * @return	int
+ * @retval	0	: success
+ * @retval	!0	: user is not the job owner
+ */
+int
+svr_chk_owner_name(struct batch_request *preq, char *jobowner)
 {
 	char  owner[PBS_MAXUSER+1];
 	char *pu;
@@ -120,8 +139,11 @@ svr_chk_owner(struct batch_request *preq, job *pjob)
 	extern int ruserok(const char *rhost, int suser, const char *ruser,
 		const char *luser);
 
+	if (jobowner == NULL)
+		return -1;
+
 	/* Are the owner and requestor the same? */
-	snprintf(rmtuser, sizeof(rmtuser), "%s", get_jattr_str(pjob, JOB_ATR_job_owner));
+	snprintf(rmtuser, sizeof(rmtuser), "%s", jobowner);
 	pu = rmtuser;
 	ph = strchr(rmtuser, '@');
 	if (!ph)
@@ -147,8 +169,8 @@ svr_chk_owner(struct batch_request *preq, job *pjob)
 	 * Get job owner name without "@host" and then map to "local" name.
 	 */
 
-	get_jobowner(get_jattr_str(pjob, JOB_ATR_job_owner), owner);
-	pu = site_map_user(owner, get_hostPart(get_jattr_str(pjob, JOB_ATR_job_owner)));
+	get_jobowner(jobowner, owner);
+	pu = site_map_user(owner, get_hostPart(jobowner));
 
 	if (get_sattr_long(SVR_ATR_FlatUID)) {
 		/* with flatuid, all that must match is user names */
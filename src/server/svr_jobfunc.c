@@ -1520,11 +1520,14 @@ job_set_wait(attribute *pattr, void *pjob, int mode)
 
 	if (((job *)pjob)->ji_qs.ji_svrflags & JOB_SVFLG_HASWAIT) {
 		while (ptask) {
-			if ((ptask->wt_event == WORK_Timed) &&
+			if ((ptask->wt_type == WORK_Timed) &&
 				(ptask->wt_func == job_wait_over) &&
 				(ptask->wt_parm1 == pjob)) {
-				ptask->wt_event = when;
-				return (0);
+				if (ptask->wt_event == when)
+					return (0);
+				/* timed tasks are ordered by time, requeue it rather than modify it */
+				delete_task(ptask);
+				break;
 			}
 			ptask = (struct work_task *)GET_NEXT(ptask->wt_linkobj);
 		}
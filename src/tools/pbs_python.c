@@ -59,6 +59,7 @@
  * 	fprint_svrattrl_list()
  * 	fprint_str_array()
  * 	argv_list_to_str()
+ * 	hook_preload_main()
  * 	main()
  */
 #include <pbs_config.h>
@@ -89,6 +90,13 @@
 #include "batch_request.h"
 #include "hook.h"
 #include <signal.h>
+#ifndef WIN32
+#include <poll.h>
+#include <sys/file.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#endif
 #include "job.h"
 #include "reservation.h"
 #include "server.h"
@@ -1377,6 +1385,441 @@ argv_list_to_str(pbs_list_head *argv_list)
 
 }
 
+#ifndef WIN32
+/*
+ * Hook preload mode (see HOOK_PRELOAD_MODE in hook.h): Python is started
+ * once, and each hook event requested by MoM runs in a process forked from
+ * this one, so it does not pay for starting Python and loading the PBS
+ * modules.  Hook scripts are compiled here too and the compiled code is
+ * reused by the forked processes until the script file changes.
+ */
+struct preload_client {
+	int	pc_fd;		/* connection from MoM, -1 once MoM went away */
+	pid_t	pc_pid;		/* process running the hook event */
+};
+static struct preload_client *preload_clients = NULL;
+static int	preload_nclients = 0;
+static int	preload_sigpipe[2] = {-1, -1};
+static struct python_script **preload_scripts = NULL;
+static int	preload_nscripts = 0;
+static int	preload_child = 0;	/* forked to run a hook event */
+
+/**
+ * @brief
+ *		SIGCHLD handler of the preloaded pbs_python: wakes up the poll()
+ *		in hook_preload_main().
+ *
+ * @param[in]	sig	-	signal number
+ */
+static void
+preload_sigchld(int sig)
+{
+	int	save_errno = errno;
+
+	(void)write(preload_sigpipe[1], "", 1);
+	errno = save_errno;
+}
+
+/**
+ * @brief
+ *		Return the compiled code of a hook script, compiling it first if it
+ *		is new or has changed since it was last compiled.
+ *
+ * @param[in]	path	-	path of the hook script
+ * @param[in]	compile	-	if 0, only look up an already compiled script
+ *
+ * @return	struct python_script *
+ * @retval	the script	: success
+ * @retval	NULL	: not compiled, the hook event compiles the script itself
+ */
+static struct python_script *
+preload_script(char *path, int compile)
+{
+	int	i;
+	struct python_script *py_script = NULL;
+	void	*hold;
+
+	for (i = 0; i < preload_nscripts; i++) {
+		if (strcmp(preload_scripts[i]->path, path) == 0) {
+			py_script = preload_scripts[i];
+			break;
+		}
+	}
+	if (!compile)
+		return py_script;
+
+	if (py_script == NULL) {
+		if (pbs_python_ext_alloc_python_script(path, &py_script) != 0)
+			return NULL;
+		hold = realloc(preload_scripts,
+			(preload_nscripts + 1) * sizeof(struct python_script *));
+		if (hold == NULL) {
+			pbs_python_ext_free_python_script(py_script);
+			free(py_script);
+			return NULL;
+		}
+		preload_scripts = (struct python_script **)hold;
+		preload_scripts[preload_nscripts++] = py_script;
+	}
+	if (pbs_python_check_and_compile_script(&svr_interp_data, py_script) != 0)
+		return NULL;
+	return py_script;
+}
+
+/**
+ * @brief
+ *		Read a hook event request from MoM.
+ *
+ * @param[in]	fd	-	connection from MoM
+ * @param[out]	nargs	-	number of strings in the request
+ *
+ * @return	char **
+ * @retval	malloc-ed, NULL terminated array of the strings of the request
+ * @retval	NULL	: bad request
+ */
+static char **
+preload_read_request(int fd, int *nargs)
+{
+	uint32_t	len;
+	char	*buf;
+	char	**args;
+	size_t	got;
+	ssize_t	n;
+	int	i, j;
+
+	for (got = 0; got < sizeof(len); got += n) {
+		n = read(fd, (char *)&len + got, sizeof(len) - got);
+		if (n <= 0)
+			return NULL;
+	}
+	if (len == 0 || len > HOOK_PRELOAD_MAXREQ)
+		return NULL;
+	if ((buf = malloc(len + 1)) == NULL)
+		return NULL;
+	for (got = 0; got < len; got += n) {
+		n = read(fd, buf + got, len - got);
+		if (n <= 0) {
+			free(buf);
+			return NULL;
+		}
+	}
+	buf[len] = '\0';
+
+	for (i = 0, j = 0; i < len; i++)
+		if (buf[i] == '\0')
+			j++;
+	/* working directory, hook config file and at least pbs_python --hook */
+	if (buf[len - 1] != '\0' || j < 4 ||
+		(args = calloc(j + 1, sizeof(char *))) == NULL) {
+		free(buf);
+		return NULL;
+	}
+	args[0] = buf;
+	for (i = 0, j = 1; i < len - 1; i++)
+		if (buf[i] == '\0')
+			args[j++] = buf + i + 1;
+	*nargs = j;
+	return args;
+}
+
+/**
+ * @brief
+ *		Collect the hook event processes that have exited and send their
+ *		wait status to MoM.
+ */
+static void
+preload_reap(void)
+{
+	pid_t	pid;
+	int	status;
+	int	i;
+	char	c;
+
+	while (read(preload_sigpipe[0], &c, 1) > 0)
+		;
+	while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+		for (i = 0; i < preload_nclients; i++) {
+			if (preload_clients[i].pc_pid != pid)
+				continue;
+			if (preload_clients[i].pc_fd != -1) {
+				(void)send(preload_clients[i].pc_fd, &status,
+					sizeof(status), MSG_NOSIGNAL);
+				close(preload_clients[i].pc_fd);
+			}
+			preload_clients[i] = preload_clients[--preload_nclients];
+			break;
+		}
+	}
+}
+
+/**
+ * @brief
+ *		Kill a hook event process whose MoM process went away, as MoM does
+ *		when the hook alarm expires, so that it does not outlive it.
+ *
+ * @param[in]	pc	-	the hook event
+ */
+static void
+preload_abandon(struct preload_client *pc)
+{
+	close(pc->pc_fd);
+	pc->pc_fd = -1;
+	(void)kill(-pc->pc_pid, SIGKILL);
+	(void)kill(pc->pc_pid, SIGKILL);
+}
+
+/**
+ * @brief
+ *		Run pbs_python in hook preload mode:
+ *		pbs_python --hook-preload <socket> [-L <path_log>] [-e <log_event_mask>]
+ *
+ * @par
+ *		Starts Python, then serves hook event requests from MoM on the
+ *		socket until MoM exits.  For each request, a process is forked that
+ *		continues as "pbs_python --hook" with the arguments of the request.
+ *
+ * @param[in]	argc	-	argument count
+ * @param[in]	argv	-	arguments
+ * @param[out]	hook_argv	-	in a forked process, the "pbs_python --hook"
+ *								arguments of its hook event
+ *
+ * @return	int
+ * @retval	the number of arguments in hook_argv, in a forked process only
+ *
+ * @note
+ *		The preloaded pbs_python itself never returns.
+ */
+static int
+hook_preload_main(int argc, char **argv, char ***hook_argv)
+{
+	char	*path_log = ".";
+	char	*sockpath;
+	char	lockpath[MAXPATHLEN + 1];
+	char	*pc;
+	int	lockfd;
+	mode_t	oldmask;
+	struct sockaddr_un sa;
+	struct sigaction act;
+	sigset_t sigs, omask;
+	struct pollfd *pfds = NULL;
+	char	**args;
+	int	nargs;
+	int	lfd, fd;
+	int	i, n;
+	pid_t	pid, ppid;
+	void	*hold;
+#ifdef SO_PEERCRED
+	struct ucred cred;
+	socklen_t credlen;
+#endif
+	struct timeval tv;
+
+	/* python externs */
+	extern void pbs_python_svr_initialize_interpreter_data(struct python_interpreter_data *interp_data);
+	extern void pbs_python_svr_destroy_interpreter_data(struct python_interpreter_data *interp_data);
+
+	if (argc < 3 || strlen(argv[2]) >= sizeof(sa.sun_path)) {
+		fprintf(stderr, "%s %s <socket> [-L <path_log>] [-e <log_event_mask>]\n",
+			argv[0], HOOK_PRELOAD_MODE);
+		exit(2);
+	}
+	sockpath = argv[2];
+	for (i = 3; i + 1 < argc; i += 2) {
+		if (strcmp(argv[i], "-L") == 0)
+			path_log = argv[i + 1];
+		else if (strcmp(argv[i], "-e") == 0)
+			*log_event_mask = strtol(argv[i + 1], NULL, 0);
+	}
+	if (log_open_main(NULL, path_log, 1) != 0) {
+		fprintf(stderr, "pbs_python: Unable to open logfile\n");
+		exit(1);
+	}
+
+	/* the lock, next to the socket, tells MoM this pbs_python runs */
+	snprintf(lockpath, sizeof(lockpath), "%s", sockpath);
+	pc = strrchr(lockpath, '/');
+	pc = (pc == NULL) ? lockpath : pc + 1;
+	snprintf(pc, sizeof(lockpath) - (pc - lockpath), "%s", HOOK_PRELOAD_LOCK);
+	if ((lockfd = open(lockpath, O_WRONLY | O_CREAT, 0600)) == -1) {
+		log_err(errno, __func__, lockpath);
+		exit(1);
+	}
+	if (flock(lockfd, LOCK_EX | LOCK_NB) == -1) {
+		log_err(errno, __func__, "another preloaded pbs_python is running");
+		exit(1);
+	}
+	(void)fcntl(lockfd, F_SETFD, FD_CLOEXEC);
+	if (ftruncate(lockfd, 0) == -1 || dprintf(lockfd, "%d\n", (int)getpid()) < 0)
+		log_err(errno, __func__, lockpath);
+
+	svr_interp_data.data_initialized = 0;
+	svr_interp_data.init_interpreter_data = pbs_python_svr_initialize_interpreter_data;
+	svr_interp_data.destroy_interpreter_data = pbs_python_svr_destroy_interpreter_data;
+	svr_interp_data.daemon_name = strdup(PBS_PYTHON_PROGRAM);
+	if (svr_interp_data.daemon_name == NULL ||
+		pbs_python_ext_start_interpreter(&svr_interp_data) != 0) {
+		log_err(-1, __func__, "Failed to start Python interpreter");
+		exit(1);
+	}
+
+	if (pipe(preload_sigpipe) == -1) {
+		log_err(errno, __func__, "pipe");
+		exit(1);
+	}
+	for (i = 0; i < 2; i++) {
+		(void)fcntl(preload_sigpipe[i], F_SETFL, O_NONBLOCK);
+		(void)fcntl(preload_sigpipe[i], F_SETFD, FD_CLOEXEC);
+	}
+	memset(&act, 0, sizeof(act));
+	act.sa_handler = preload_sigchld;
+	act.sa_flags = SA_RESTART | SA_NOCLDSTOP;
+	sigemptyset(&act.sa_mask);
+	(void)sigaction(SIGCHLD, &act, NULL);
+	/* MoM runs its children with SIGCHLD blocked, hook events get that mask back */
+	sigemptyset(&sigs);
+	sigaddset(&sigs, SIGCHLD);
+	(void)sigprocmask(SIG_UNBLOCK, &sigs, &omask);
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sun_family = AF_UNIX;
+	strcpy(sa.sun_path, sockpath);
+	(void)unlink(sockpath);
+	/* created with no access for others, there is no window before a chmod */
+	oldmask = umask(077);
+	if ((lfd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1 ||
+		bind(lfd, (struct sockaddr *)&sa, sizeof(sa)) == -1 ||
+		listen(lfd, 64) == -1) {
+		log_err(errno, __func__, sockpath);
+		exit(1);
+	}
+	(void)umask(oldmask);
+	(void)fcntl(lfd, F_SETFD, FD_CLOEXEC);
+	log_eventf(PBSEVENT_DEBUG2, PBS_EVENTCLASS_HOOK, LOG_INFO, __func__,
+		"pbs_python waiting for hook events on %s", sockpath);
+
+	ppid = getppid();
+	for (;;) {
+		hold = realloc(pfds, (preload_nclients + 2) * sizeof(struct pollfd));
+		if (hold == NULL) {
+			log_err(errno, __func__, "realloc");
+			exit(1);
+		}
+		pfds = (struct pollfd *)hold;
+		pfds[0].fd = lfd;
+		pfds[0].events = POLLIN;
+		pfds[1].fd = preload_sigpipe[0];
+		pfds[1].events = POLLIN;
+		for (i = 0; i < preload_nclients; i++) {
+			pfds[i + 2].fd = preload_clients[i].pc_fd;
+			pfds[i + 2].events = POLLIN;
+		}
+		n = preload_nclients + 2;
+		if (poll(pfds, n, 1000) == -1 && errno != EINTR) {
+			log_err(errno, __func__, "poll");
+			exit(1);
+		}
+
+		/* MoM is gone */
+		if (getppid() != ppid) {
+			for (i = 0; i < preload_nclients; i++)
+				if (preload_clients[i].pc_fd != -1)
+					preload_abandon(&preload_clients[i]);
+			(void)unlink(sockpath);
+			exit(0);
+		}
+
+		/* MoM sends nothing more after its request, so input means it went away */
+		for (i = 2; i < n; i++) {
+			if (pfds[i].fd != -1 && pfds[i].revents != 0)
+				preload_abandon(&preload_clients[i - 2]);
+		}
+		preload_reap();
+
+		if ((pfds[0].revents & POLLIN) == 0)
+			continue;
+		if ((fd = accept(lfd, NULL, NULL)) == -1)
+			continue;
+#ifdef SO_PEERCRED
+		credlen = sizeof(cred);
+		if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &credlen) == -1 ||
+			cred.uid != 0) {
+			log_err(-1, __func__, "hook event request not from root");
+			close(fd);
+			continue;
+		}
+#endif
+		tv.tv_sec = 10;
+		tv.tv_usec = 0;
+		(void)setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+		if ((args = preload_read_request(fd, &nargs)) == NULL) {
+			log_err(-1, __func__, "bad hook event request");
+			close(fd);
+			continue;
+		}
+		hold = realloc(preload_clients,
+			(preload_nclients + 1) * sizeof(struct preload_client));
+		if (hold == NULL) {
+			log_err(errno, __func__, "realloc");
+			free(args[0]);
+			free(args);
+			close(fd);
+			continue;
+		}
+		preload_clients = (struct preload_client *)hold;
+
+		/* the script is the last argument */
+		(void)preload_script(args[nargs - 1], 1);
+
+#if PY_VERSION_HEX >= 0x03070000
+		PyOS_BeforeFork();
+#endif
+		pid = fork();
+		if (pid == 0) {
+			preload_child = 1;
+			close(lfd);
+			close(lockfd);
+			close(fd);
+			close(preload_sigpipe[0]);
+			close(preload_sigpipe[1]);
+			for (i = 0; i < preload_nclients; i++)
+				if (preload_clients[i].pc_fd != -1)
+					close(preload_clients[i].pc_fd);
+			free(preload_clients);
+			free(pfds);
+			(void)signal(SIGCHLD, SIG_DFL);
+			(void)sigprocmask(SIG_SETMASK, &omask, NULL);
+			(void)setsid();
+#if PY_VERSION_HEX >= 0x03070000
+			PyOS_AfterFork_Child();
+#else
+			PyOS_AfterFork();
+#endif
+			if (chdir(args[0]) == -1)
+				log_errf(errno, __func__, "chdir %s", args[0]);
+			if (args[1][0] == '\0')
+				(void)unsetenv(PBS_HOOK_CONFIG_FILE);
+			else
+				(void)setenv(PBS_HOOK_CONFIG_FILE, args[1], 1);
+			*hook_argv = args + 2;
+			return (nargs - 2);
+		}
+#if PY_VERSION_HEX >= 0x03070000
+		PyOS_AfterFork_Parent();
+#endif
+		free(args[0]);
+		free(args);
+		if (pid == -1) {
+			log_err(errno, __func__, "fork");
+			close(fd);
+			continue;
+		}
+		preload_clients[preload_nclients].pc_fd = fd;
+		preload_clients[preload_nclients].pc_pid = pid;
+		preload_nclients++;
+	}
+}
+#endif /* WIN32 */
+
 /**
  *
  * @brief
@@ -1480,6 +1923,16 @@ main(int argc, char *argv[], char *envp[])
 		svr_resc_def[i].rs_next = &svr_resc_def[i+1];
 	/* last entry is left with null pointer */
 
+	if ((argv[1] != NULL) && (strcmp(argv[1], HOOK_PRELOAD_MODE) == 0)) {
+#ifndef WIN32
+		/* returns only in a process forked to run a hook event */
+		argc = hook_preload_main(argc, argv, &argv);
+#else
+		fprintf(stderr, "%s: %s not supported\n", argv[0], HOOK_PRELOAD_MODE);
+		return 2;
+#endif
+	}
+
 	if ((argv[1] == NULL) || (strcmp(argv[1], HOOK_MODE) != 0)) {
 		char *python_path = NULL;
 		if (get_py_progname(&python_path)) {
@@ -1971,6 +2424,15 @@ main(int argc, char *argv[], char *envp[])
 			snprintf(logname, sizeof(logname), "%s", full_logname);
 		}
 
+#ifndef WIN32
+		/* forked by a preloaded pbs_python: Python is already started */
+		if (preload_child) {
+			py_script = preload_script(hook_script, 0);
+			if (py_script == NULL)
+				(void)pbs_python_ext_alloc_python_script(hook_script,
+					(struct python_script **) &py_script);
+		} else {
+#endif
 		/* set python interp data */
 		svr_interp_data.data_initialized = 0;
 		svr_interp_data.init_interpreter_data = pbs_python_svr_initialize_interpreter_data;
@@ -1992,6 +2454,9 @@ main(int argc, char *argv[], char *envp[])
 			exit(1);
 		}
 		hook_perf_stat_stop(perf_label, HOOK_PERF_START_PYTHON, 0);
+#ifndef WIN32
+		}
+#endif
 		hook_input_param_init(&req_params);
 		switch (hook_event) {
 
@@ -118,6 +118,8 @@ ATTR_resv_idx = 'reserve_index'
 ATTR_resv_rrule = 'reserve_rrule'
 ATTR_resv_execvnodes = 'reserve_execvnodes'
 ATTR_resv_timezone = 'reserve_timezone'
+ATTR_chgseq = 'chgseq'
+ATTR_deleted = 'deleted'
 ATTR_ctime = 'ctime'
 ATTR_estimated = 'estimated'
 ATTR_exechost = 'exec_host'
@@ -395,6 +397,10 @@ def pbs_alterjob(c, jobid, attrib, extend):
     pass
 
 
+def pbs_alterjoblist(c, jobids, attribs, count, extend):
+    pass
+
+
 def pbs_connect(c):
     pass
 
@@ -455,6 +461,10 @@ def pbs_runjob(c, jobid, loc, extend):
     pass
 
 
+def pbs_runjoblist(c, jobids, locs, count, extend):
+    pass
+
+
 def pbs_selectjob(c, attropl, extend):
     pass
 
@@ -475,6 +485,10 @@ def pbs_selstat(c, attropl, attrl, extend):
     pass
 
 
+def pbs_statdelta(c, obj_type, seq, newseq, attrl, extend):
+    pass
+
+
 def pbs_statque(c, q, attrl, extend):
     pass
 
@@ -0,0 +1,119 @@
+# coding: utf-8
+# Copyright (C) 1994-2021 Altair Engineering, Inc.
+# For more information, contact Altair at www.altair.com.
+#
+# This file is part of both the OpenPBS software ("OpenPBS")
+# and the PBS Professional ("PBS Pro") software.
+#
+# Open Source License Information:
+#
+# OpenPBS is free software. You can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# OpenPBS is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public
+# License for more details.
+#
+# You should have received a copy of the GNU Affero General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Commercial License Information:
+#
+# PBS Pro is commercially licensed software that shares a common core with
+# the OpenPBS software.  For a copy of the commercial license terms and
+# conditions, go to: (http://www.pbspro.com/agreement.html) or contact the
+# Altair Legal Department.
+#
+# Altair's dual-license business model allows companies, individuals, and
+# organizations to create proprietary derivative works of OpenPBS and
+# distribute them - whether embedded or bundled with other software -
+# under a commercial license agreement.
+#
+# Use of Altair's trademarks, including but not limited to "PBS™",
+# "OpenPBS®", "PBS Professional®", and "PBS Pro™" and Altair's logos is
+# subject to Altair's trademark licensing policies.
+
+
+
+from tests.functional import *
+
+
+class TestAsyncLogging(TestFunctional):
+    """
+    TestSuite for asynchronous (buffered) logging in PBS
+    """
+
+    def switch_async_logging(self, hostname=None, enable=1):
+        """
+        Set asynchronous logging in pbs.conf and restart PBS
+        """
+        if hostname is None:
+            hostname = self.server.hostname
+        a = {'PBS_LOG_ASYNC': enable}
+        self.du.set_pbs_config(hostname=hostname, confs=a, append=True)
+        PBSInitServices().restart()
+        self.assertTrue(self.server.isUp(), 'Failed to restart PBS Daemons')
+
+    def test_basic(self):
+        """
+        Enable asynchronous logging and check that the server, scheduler
+        and mom still log the life of a job, in order, and that records
+        are written out shortly after they are logged
+        """
+        self.switch_async_logging()
+        j = Job(TEST_USER)
+        j.set_sleep_time(1)
+        jid = self.server.submit(j)
+        self.server.expect(JOB, 'queue', id=jid, op=UNSET, offset=1)
+        self.server.log_match(jid + ";Job Queued", max_attempts=10)
+        self.scheduler.log_match(jid + ";Job run", max_attempts=10)
+        self.mom.log_match(jid + ";Started", max_attempts=10)
+        self.server.log_match(jid + ";Exit_status=0", max_attempts=10)
+        lines = self.server.log_lines(logtype=self.server, id=jid, n='ALL')
+        queued = [i for i, l in enumerate(lines) if 'Job Queued' in l]
+        exited = [i for i, l in enumerate(lines) if 'Exit_status=0' in l]
+        self.assertTrue(queued and exited and queued[0] < exited[0],
+                        'Job records out of order in server log')
+
+    def test_flush_on_shutdown(self):
+        """
+        Check that with asynchronous logging a daemon stopped right after
+        logging still has its records and the shutdown record in the log
+        """
+        self.switch_async_logging()
+        now = time.time()
+        self.server.manager(MGR_CMD_SET, SERVER, {'scheduling': 'False'})
+        jid = self.server.submit(Job(TEST_USER))
+        self.server.stop()
+        self.server.log_match(jid + ";Job Queued", starttime=now,
+                              max_attempts=5)
+        self.server.log_match("Log closed", starttime=now, max_attempts=5)
+        self.server.start()
+        self.assertTrue(self.server.isUp(), 'Failed to restart server')
+
+    def test_flush_on_crash(self):
+        """
+        Check that with asynchronous logging a server that crashes right
+        after logging still has its records in the log
+        """
+        self.switch_async_logging()
+        now = time.time()
+        self.server.manager(MGR_CMD_SET, SERVER, {'scheduling': 'False'})
+        jid = self.server.submit(Job(TEST_USER))
+        self.server.signal('-SEGV')
+        time.sleep(2)
+        self.assertFalse(self.server.isUp(max_attempts=1),
+                         'Server did not crash')
+        self.server.log_match(jid + ";Job Queued", starttime=now,
+                              max_attempts=5)
+        self.server.start()
+        self.assertTrue(self.server.isUp(), 'Failed to restart server')
+
+    def tearDown(self):
+        self.du.unset_pbs_config(hostname=self.server.hostname,
+                                 confs=['PBS_LOG_ASYNC'])
+        PBSInitServices().restart()
+        TestFunctional.tearDown(self)
@@ -0,0 +1,91 @@
+# coding: utf-8
+
+# Copyright (C) 1994-2021 Altair Engineering, Inc.
+# For more information, contact Altair at www.altair.com.
+#
+# This file is part of both the OpenPBS software ("OpenPBS")
+# and the PBS Professional ("PBS Pro") software.
+#
+# Open Source License Information:
+#
+# OpenPBS is free software. You can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# OpenPBS is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public
+# License for more details.
+#
+# You should have received a copy of the GNU Affero General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Commercial License Information:
+#
+# PBS Pro is commercially licensed software that shares a common core with
+# the OpenPBS software.  For a copy of the commercial license terms and
+# conditions, go to: (http://www.pbspro.com/agreement.html) or contact the
+# Altair Legal Department.
+#
+# Altair's dual-license business model allows companies, individuals, and
+# organizations to create proprietary derivative works of OpenPBS and
+# distribute them - whether embedded or bundled with other software -
+# under a commercial license agreement.
+#
+# Use of Altair's trademarks, including but not limited to "PBS™",
+# "OpenPBS®", "PBS Professional®", and "PBS Pro™" and Altair's logos is
+# subject to Altair's trademark licensing policies.
+
+
+
+from tests.functional import *
+
+
+class TestDbGroupCommit(TestFunctional):
+    """
+    Test that job, reservation and node state saved with the server
+    attribute db_group_commit set survives a server restart
+    """
+
+    def setUp(self):
+        TestFunctional.setUp(self)
+        a = {'resources_available.ncpus': 4}
+        self.server.manager(MGR_CMD_SET, NODE, a, self.mom.shortname)
+        self.server.manager(MGR_CMD_SET, SERVER, {'db_group_commit': 'True'})
+
+    def test_group_commit_recovery(self):
+        """
+        Run, hold and alter jobs and confirm a reservation with group
+        commit enabled, then restart the server and check that all of the
+        changes were saved
+        """
+        j = Job(TEST_USER, {'Resource_List.ncpus': 1})
+        j.set_sleep_time(1000)
+        jid1 = self.server.submit(j)
+        self.server.expect(JOB, {'job_state': 'R'}, id=jid1)
+
+        self.server.manager(MGR_CMD_SET, SERVER, {'scheduling': 'False'})
+        j = Job(TEST_USER)
+        jid2 = self.server.submit(j)
+        self.server.holdjob(jid2, USER_HOLD)
+        self.server.alterjob(jid2, {ATTR_N: 'grouped'})
+        self.server.expect(JOB, {'job_state': 'H', ATTR_N: 'grouped'},
+                           id=jid2)
+        self.server.manager(MGR_CMD_SET, SERVER, {'scheduling': 'True'})
+
+        now = int(time.time())
+        r = Reservation(TEST_USER, {'Resource_List.ncpus': 1,
+                                    'reserve_start': now + 3600,
+                                    'reserve_end': now + 7200})
+        rid = self.server.submit(r)
+        a = {'reserve_state': (MATCH_RE, 'RESV_CONFIRMED|2')}
+        self.server.expect(RESV, a, id=rid)
+
+        self.server.restart()
+
+        self.server.expect(SERVER, {'db_group_commit': 'True'})
+        self.server.expect(JOB, {'job_state': 'R'}, id=jid1)
+        self.server.expect(JOB, {'job_state': 'H', ATTR_N: 'grouped'},
+                           id=jid2)
+        self.server.expect(RESV, a, id=rid)
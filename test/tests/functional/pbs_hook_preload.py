@@ -0,0 +1,124 @@
+# coding: utf-8
+# Copyright (C) 1994-2021 Altair Engineering, Inc.
+# For more information, contact Altair at www.altair.com.
+#
+# This file is part of both the OpenPBS software ("OpenPBS")
+# and the PBS Professional ("PBS Pro") software.
+#
+# Open Source License Information:
+#
+# OpenPBS is free software. You can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# OpenPBS is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public
+# License for more details.
+#
+# You should have received a copy of the GNU Affero General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Commercial License Information:
+#
+# PBS Pro is commercially licensed software that shares a common core with
+# the OpenPBS software.  For a copy of the commercial license terms and
+# conditions, go to: (http://www.pbspro.com/agreement.html) or contact the
+# Altair Legal Department.
+#
+# Altair's dual-license business model allows companies, individuals, and
+# organizations to create proprietary derivative works of OpenPBS and
+# distribute them - whether embedded or bundled with other software -
+# under a commercial license agreement.
+#
+# Use of Altair's trademarks, including but not limited to "PBS™",
+# "OpenPBS®", "PBS Professional®", and "PBS Pro™" and Altair's logos is
+# subject to Altair's trademark licensing policies.
+
+from tests.functional import *
+
+
+class TestHookPreload(TestFunctional):
+    """
+    TestSuite for running MoM hooks from a preloaded pbs_python
+    ($hook_preload in the MoM config file)
+    """
+
+    hook_body = """
+import pbs
+e = pbs.event()
+pbs.logmsg(pbs.LOG_DEBUG, "preload hook %s ran for %s" % (e.hook_name,
+                                                        e.job.id))
+e.accept()
+"""
+
+    reject_body = """
+import pbs
+pbs.event().reject("preload hook rejected")
+"""
+
+    def setUp(self):
+        TestFunctional.setUp(self)
+        c = {'$hook_preload': 'true', '$logevent': '0xffffffff'}
+        self.mom.add_config(c)
+
+    def test_hook_preload_runs_hooks(self):
+        """
+        With $hook_preload set, check that execjob_begin and execjob_end
+        hooks run for every job and that the preloaded pbs_python is used
+        """
+        a = {'event': 'execjob_begin,execjob_end', 'enabled': 'True'}
+        self.server.create_import_hook('preload', a, self.hook_body)
+        jids = []
+        for _ in range(3):
+            j = Job(TEST_USER)
+            j.set_sleep_time(1)
+            jids.append(self.server.submit(j))
+        for jid in jids:
+            self.server.expect(JOB, 'queue', id=jid, op=UNSET, offset=1)
+            self.mom.log_match("preload hook preload ran for %s" % jid,
+                               n='ALL', max_attempts=10)
+        self.mom.log_match("started preloaded pbs_python", n='ALL')
+        self.mom.log_match("pbs_python waiting for hook events", n='ALL')
+
+    def test_hook_preload_reject(self):
+        """
+        With $hook_preload set, check that a rejecting execjob_begin hook
+        still rejects the job
+        """
+        a = {'event': 'execjob_begin', 'enabled': 'True'}
+        self.server.create_import_hook('preload', a, self.reject_body)
+        self.server.manager(MGR_CMD_SET, SERVER, {'scheduling': 'False'})
+        jid = self.server.submit(Job(TEST_USER))
+        self.server.manager(MGR_CMD_SET, SERVER, {'scheduling': 'True'})
+        self.mom.log_match("preload hook rejected", max_attempts=10)
+        self.server.expect(JOB, {'job_state': 'R'}, id=jid, op=NE)
+
+    def test_hook_preload_socket_and_lock(self):
+        """
+        With $hook_preload set, check that the socket of the preloaded
+        pbs_python is only accessible by root and that its lock file
+        names the running pbs_python
+        """
+        a = {'event': 'execjob_begin', 'enabled': 'True'}
+        self.server.create_import_hook('preload', a, self.hook_body)
+        jid = self.server.submit(Job(TEST_USER))
+        self.server.expect(JOB, {'job_state': 'R'}, id=jid)
+        self.mom.log_match("pbs_python waiting for hook events", n='ALL')
+
+        tmpdir = os.path.join(self.mom.pbs_conf['PBS_HOME'], 'mom_priv',
+                              'hooks', 'tmp')
+        cmd = ['stat', '-c', '%a', os.path.join(tmpdir, 'pbs_python.sock')]
+        ret = self.du.run_cmd(self.mom.hostname, cmd=cmd, sudo=True)
+        self.assertEqual(ret['out'], ['600'])
+
+        lock = os.path.join(tmpdir, 'pbs_python.lock')
+        out = self.du.cat(self.mom.hostname, lock, sudo=True)['out']
+        cmd = ['ps', '-o', 'args=', '-p', out[0].strip()]
+        ret = self.du.run_cmd(self.mom.hostname, cmd=cmd)
+        self.assertIn('--hook-preload', ret['out'][0])
+
+    def tearDown(self):
+        self.mom.unset_mom_config('$hook_preload', hup=True)
+        TestFunctional.tearDown(self)
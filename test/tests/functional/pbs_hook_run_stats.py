@@ -0,0 +1,103 @@
+# coding: utf-8
+# Copyright (C) 1994-2021 Altair Engineering, Inc.
+# For more information, contact Altair at www.altair.com.
+#
+# This file is part of both the OpenPBS software ("OpenPBS")
+# and the PBS Professional ("PBS Pro") software.
+#
+# Open Source License Information:
+#
+# OpenPBS is free software. You can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# OpenPBS is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public
+# License for more details.
+#
+# You should have received a copy of the GNU Affero General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Commercial License Information:
+#
+# PBS Pro is commercially licensed software that shares a common core with
+# the OpenPBS software.  For a copy of the commercial license terms and
+# conditions, go to: (http://www.pbspro.com/agreement.html) or contact the
+# Altair Legal Department.
+#
+# Altair's dual-license business model allows companies, individuals, and
+# organizations to create proprietary derivative works of OpenPBS and
+# distribute them - whether embedded or bundled with other software -
+# under a commercial license agreement.
+#
+# Use of Altair's trademarks, including but not limited to "PBS™",
+# "OpenPBS®", "PBS Professional®", and "PBS Pro™" and Altair's logos is
+# subject to Altair's trademark licensing policies.
+
+from tests.functional import *
+
+
+class TestHookRunStats(TestFunctional):
+    """
+    TestSuite for the server hook run statistics and for the event data
+    of periodic hooks built on first use
+    """
+
+    accept_body = """
+import pbs
+pbs.event().accept()
+"""
+
+    periodic_vnodes_body = """
+import pbs
+e = pbs.event()
+for vn in e.vnode_list.keys():
+    e.vnode_list[vn].comment = "set by periodic hook"
+pbs.logmsg(pbs.LOG_DEBUG, "periodic hook saw %d vnodes" % len(e.vnode_list))
+e.accept()
+"""
+
+    periodic_plain_body = """
+import pbs
+pbs.logmsg(pbs.LOG_DEBUG, "periodic hook without vnode_list")
+pbs.event().accept()
+"""
+
+    def test_run_stats_queuejob(self):
+        """
+        Check that a queuejob hook reports how many times it ran and for
+        how long, and that "print hook" leaves the statistics out
+        """
+        a = {'event': 'queuejob', 'enabled': 'True'}
+        self.server.create_import_hook('stats', a, self.accept_body)
+        for _ in range(3):
+            self.server.submit(Job(TEST_USER))
+        h = self.server.status(HOOK, id='stats')[0]
+        self.assertEqual(h['run_count'], '3')
+        self.assertGreaterEqual(float(h['run_walltime']),
+                                float(h['run_walltime_max']))
+        self.assertGreaterEqual(float(h['run_cputime']), 0)
+        qmgr = os.path.join(self.server.pbs_conf['PBS_EXEC'], 'bin', 'qmgr')
+        ret = self.du.run_cmd(self.server.hostname,
+                              [qmgr, '-c', 'print hook stats'], sudo=True)
+        self.assertEqual(ret['rc'], 0)
+        self.assertFalse([l for l in ret['out'] if 'run_count' in l],
+                         'run statistics printed as settable attributes')
+
+    def test_periodic_vnode_list_on_use(self):
+        """
+        Check that a periodic hook using pbs.event().vnode_list still sees
+        and updates the vnodes, and that one that does not use it runs
+        """
+        a = {'event': 'periodic', 'enabled': 'True', 'freq': 5}
+        self.server.create_import_hook('vnodes', a, self.periodic_vnodes_body)
+        self.server.create_import_hook('plain', a, self.periodic_plain_body)
+        self.server.log_match("periodic hook saw", max_attempts=20)
+        self.server.log_match("periodic hook without vnode_list",
+                              max_attempts=20)
+        self.server.expect(NODE, {'comment': 'set by periodic hook'},
+                           id=self.mom.shortname, max_attempts=20)
+        h = self.server.status(HOOK, id='plain')[0]
+        self.assertGreater(int(h['run_count']), 0)
@@ -0,0 +1,124 @@
+# coding: utf-8
+
+# Copyright (C) 1994-2021 Altair Engineering, Inc.
+# For more information, contact Altair at www.altair.com.
+#
+# This file is part of both the OpenPBS software ("OpenPBS")
+# and the PBS Professional ("PBS Pro") software.
+#
+# Open Source License Information:
+#
+# OpenPBS is free software. You can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# OpenPBS is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public
+# License for more details.
+#
+# You should have received a copy of the GNU Affero General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Commercial License Information:
+#
+# PBS Pro is commercially licensed software that shares a common core with
+# the OpenPBS software.  For a copy of the commercial license terms and
+# conditions, go to: (http://www.pbspro.com/agreement.html) or contact the
+# Altair Legal Department.
+#
+# Altair's dual-license business model allows companies, individuals, and
+# organizations to create proprietary derivative works of OpenPBS and
+# distribute them - whether embedded or bundled with other software -
+# under a commercial license agreement.
+#
+# Use of Altair's trademarks, including but not limited to "PBS™",
+# "OpenPBS®", "PBS Professional®", and "PBS Pro™" and Altair's logos is
+# subject to Altair's trademark licensing policies.
+
+
+
+from tests.functional import *
+
+
+class TestIncrJobQuery(TestFunctional):
+    """
+    Test the scheduler's incremental_job_query option, which only
+    queries jobs changed since the previous scheduling cycle.
+    """
+
+    def setUp(self):
+        TestFunctional.setUp(self)
+        a = {'resources_available.ncpus': 2}
+        self.mom.create_vnodes(a, 1, usenatvnode=True)
+        self.server.manager(MGR_CMD_SET, SCHED, {'log_events': 2047})
+        self.scheduler.set_sched_config(
+            {'incremental_job_query': 'true ALL'})
+        self.server.manager(MGR_CMD_SET, SERVER, {'scheduling': 'False'})
+
+    def submit_job(self, ncpus=1):
+        """
+        Submit a long running job requesting ncpus and return its id
+        """
+        j = Job(TEST_USER, {'Resource_List.select': '1:ncpus=%d' % ncpus})
+        j.set_sleep_time(1000)
+        return self.server.submit(j)
+
+    def test_changes_seen(self):
+        """
+        Test that modifications, deletions and new submissions made
+        between cycles are seen by the scheduler when it only queries
+        the changed jobs
+        """
+        jid1 = self.submit_job()
+        jid2 = self.submit_job()
+        jid3 = self.submit_job(ncpus=2)
+
+        # First cycle queries all jobs and fills the cache
+        self.scheduler.run_scheduling_cycle()
+        self.server.expect(JOB, {'job_state': 'R'}, id=jid1)
+        self.server.expect(JOB, {'job_state': 'R'}, id=jid2)
+        self.server.expect(JOB, {'job_state': 'Q'}, id=jid3)
+        a = {ATTR_chgseq: (GT, 0)}
+        self.server.expect(JOB, a, id=jid3)
+
+        # jid3 can only run on the freed cpu if the scheduler sees the
+        # altered request rather than a stale cached one
+        t = time.time()
+        self.server.alterjob(jid3, {'Resource_List.select': '1:ncpus=1'})
+        self.server.deljob(jid1, wait=True)
+        self.scheduler.run_scheduling_cycle()
+        self.scheduler.log_match("Queried [0-9]+ changed jobs incrementally",
+                                 regexp=True, starttime=t)
+        self.server.expect(JOB, {'job_state': 'R'}, id=jid3)
+
+        # A job submitted between cycles is picked up too
+        jid4 = self.submit_job()
+        self.scheduler.run_scheduling_cycle()
+        self.server.expect(JOB, {'job_state': 'Q'}, id=jid4)
+        self.server.deljob(jid2, wait=True)
+        self.scheduler.run_scheduling_cycle()
+        self.server.expect(JOB, {'job_state': 'R'}, id=jid4)
+
+    def test_eligible_job_not_restamped(self):
+        """
+        Test that querying a job accruing eligible time does not give it
+        a new chgseq, so an unchanged job is not queried again
+        """
+        self.server.manager(MGR_CMD_SET, SERVER,
+                            {'eligible_time_enable': 'True'})
+        jid1 = self.submit_job(ncpus=2)
+        jid2 = self.submit_job()
+
+        # the first cycles run jid1 and pick up the comment set on jid2
+        self.scheduler.run_scheduling_cycle()
+        self.server.expect(JOB, {'job_state': 'R'}, id=jid1)
+        self.server.expect(JOB, {ATTR_accrue_type: 2}, id=jid2)
+        self.scheduler.run_scheduling_cycle()
+
+        seq = self.server.status(JOB, ATTR_chgseq, id=jid2)[0][ATTR_chgseq]
+        time.sleep(2)
+        self.server.expect(JOB, {ATTR_chgseq: seq}, id=jid2, max_attempts=1)
+        self.scheduler.run_scheduling_cycle()
+        self.server.expect(JOB, {ATTR_chgseq: seq}, id=jid2, max_attempts=1)
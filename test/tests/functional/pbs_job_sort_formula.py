@@ -72,3 +72,29 @@ class TestJobSortFormula(TestFunctional):
             self.assertEqual(job.split('.')[0], c.political_order[i])
 
         self.server.expect(JOB, {'job_state=R': 2})
+
+    def test_job_sort_formula_evaluation(self):
+        """
+        Test that the values of formulas evaluated natively and formulas
+        left to the embedded interpreter are as Python computes them
+        """
+        a = {'resources_available.ncpus': 4}
+        self.server.manager(MGR_CMD_SET, NODE, a, self.mom.shortname)
+        self.server.manager(MGR_CMD_CREATE, RSC, {'type': 'float'}, id='foo')
+        self.server.manager(MGR_CMD_SET, SERVER, {'scheduling': 'False'})
+
+        j = Job(TEST_USER, attrs={'Resource_List.foo': 7.5,
+                                  'Resource_List.ncpus': 4})
+        jid = self.server.submit(j)
+
+        formulas = [('foo // 2 + sqrt(ncpus) * 10 - ncpus % 3', '22'),
+                    ('max(foo, ncpus) * 2 ** -1', '3.75'),
+                    ('10 if foo > ncpus else 20', '10'),
+                    ('foo / (ncpus - 4)', '0')]
+        for formula, value in formulas:
+            a = {'job_sort_formula': formula}
+            self.server.manager(MGR_CMD_SET, SERVER, a, runas=ROOT_USER)
+            t = time.time()
+            self.scheduler.run_scheduling_cycle()
+            self.scheduler.log_match(jid + ';Formula Evaluation = ' + value,
+                                     starttime=t)
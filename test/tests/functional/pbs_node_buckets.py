@@ -798,6 +798,43 @@ class TestNodeBuckets(TestFunctional):
         self.assertGreater(len(set(s)), 1,
                            "Job did not span properly")
 
+    def run_pset_jobs(self, nthreads):
+        """
+        Restart the scheduler with nthreads threads, run one bucket job
+        that only fits in one placement set and one which fits in all of
+        them, and return their exec_vnodes
+        """
+        self.du.set_pbs_config(confs={'PBS_SCHED_THREADS': nthreads})
+        self.scheduler.restart()
+
+        ret = []
+        for sel in ['10:ncpus=1:letter=G', '10:ncpus=1']:
+            a = {'Resource_List.select': sel,
+                 'Resource_List.place': 'scatter:excl'}
+            jid = self.server.submit(Job(TEST_USER, attrs=a))
+            self.server.expect(JOB, {'job_state': 'R'}, id=jid)
+            ev = self.server.status(JOB, 'exec_vnode', id=jid)
+            ret.append(ev[0]['exec_vnode'])
+        self.server.cleanup_jobs()
+        return ret
+
+    @timeout(1800)
+    def test_psets_threads_same_placement(self):
+        """
+        Test that bucket jobs in placement sets are placed on the same
+        nodes whether placement sets are searched by one scheduler thread
+        or in parallel by several
+        """
+        a = {'node_group_key': 'shape', 'node_group_enable': 'True'}
+        self.server.manager(MGR_CMD_SET, SERVER, a)
+
+        serial = self.run_pset_jobs(1)
+        parallel = self.run_pset_jobs(4)
+        self.du.unset_pbs_config(confs=['PBS_SCHED_THREADS'])
+        self.scheduler.restart()
+
+        self.assertEqual(serial, parallel)
+
     @timeout(900)
     @skip("issue 2334")
     def test_psets_queue(self):
@@ -0,0 +1,114 @@
+# coding: utf-8
+
+# Copyright (C) 1994-2021 Altair Engineering, Inc.
+# For more information, contact Altair at www.altair.com.
+#
+# This file is part of both the OpenPBS software ("OpenPBS")
+# and the PBS Professional ("PBS Pro") software.
+#
+# Open Source License Information:
+#
+# OpenPBS is free software. You can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# OpenPBS is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public
+# License for more details.
+#
+# You should have received a copy of the GNU Affero General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Commercial License Information:
+#
+# PBS Pro is commercially licensed software that shares a common core with
+# the OpenPBS software.  For a copy of the commercial license terms and
+# conditions, go to: (http://www.pbspro.com/agreement.html) or contact the
+# Altair Legal Department.
+#
+# Altair's dual-license business model allows companies, individuals, and
+# organizations to create proprietary derivative works of OpenPBS and
+# distribute them - whether embedded or bundled with other software -
+# under a commercial license agreement.
+#
+# Use of Altair's trademarks, including but not limited to "PBS™",
+# "OpenPBS®", "PBS Professional®", and "PBS Pro™" and Altair's logos is
+# subject to Altair's trademark licensing policies.
+
+
+from tests.functional import *
+
+
+class TestPsetsThreads(TestFunctional):
+    """
+    Test that jobs and reservations which take the standard node search
+    path get the same nodes whether more than 32 placement sets are checked
+    by one scheduler thread or in parallel by several
+    """
+
+    def setUp(self):
+        TestFunctional.setUp(self)
+        self.server.manager(MGR_CMD_CREATE, RSC,
+                            {'type': 'string', 'flag': 'h'}, id='pset')
+        a = {'resources_available.ncpus': 4}
+        # 96 vnodes in 48 placement sets of 2 vnodes each
+        self.mom.create_vnodes(attrib=a, num=96, sharednode=False,
+                               attrfunc=self.cust_attr_func)
+        a = {'node_group_key': 'pset', 'node_group_enable': 'True'}
+        self.server.manager(MGR_CMD_SET, SERVER, a)
+        self.server.manager(MGR_CMD_SET, SCHED, {'do_not_span_psets': 'True'})
+
+    def cust_attr_func(self, name, totalnodes, numnode, attribs):
+        """
+        Put every two vnodes in their own placement set
+        """
+        a = {'resources_available.pset': 'p%d' % (numnode // 2)}
+        return {**attribs, **a}
+
+    def place_work(self, nthreads):
+        """
+        Restart the scheduler with nthreads threads, confirm a reservation
+        and run two jobs which use the standard node search path.  Return
+        the reservation's resv_nodes and the jobs' exec_vnodes
+        """
+        self.du.set_pbs_config(confs={'PBS_SCHED_THREADS': nthreads})
+        self.scheduler.restart()
+
+        ret = []
+        start = int(time.time()) + 3600
+        a = {'Resource_List.select': '2:ncpus=3',
+             'Resource_List.place': 'vscatter',
+             'reserve_start': start, 'reserve_end': start + 3600}
+        rid = self.server.submit(Reservation(TEST_USER, a))
+        self.server.expect(RESV,
+                           {'reserve_state': (MATCH_RE, 'RESV_CONFIRMED|2')},
+                           id=rid)
+        rs = self.server.status(RESV, 'resv_nodes', id=rid)
+        ret.append(rs[0]['resv_nodes'])
+
+        for sel, pl in [('2:ncpus=4', 'free'), ('1:ncpus=2+1:ncpus=1',
+                                                 'pack')]:
+            a = {'Resource_List.select': sel, 'Resource_List.place': pl}
+            jid = self.server.submit(Job(TEST_USER, attrs=a))
+            self.server.expect(JOB, {'job_state': 'R'}, id=jid)
+            self.scheduler.log_match(jid + ';Evaluating subchunk',
+                                     n=10000, interval=1)
+            ev = self.server.status(JOB, 'exec_vnode', id=jid)
+            ret.append(ev[0]['exec_vnode'])
+        self.server.cleanup_jobs_and_reservations()
+        return ret
+
+    def test_psets_threads_standard_path(self):
+        """
+        Test that the standard node search path places jobs and
+        reservations on the same nodes with one and with four scheduler
+        threads when there are more than 32 placement sets
+        """
+        serial = self.place_work(1)
+        parallel = self.place_work(4)
+        self.du.unset_pbs_config(confs=['PBS_SCHED_THREADS'])
+        self.scheduler.restart()
+
+        self.assertEqual(serial, parallel)
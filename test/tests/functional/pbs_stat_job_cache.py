@@ -0,0 +1,83 @@
+# coding: utf-8
+
+# Copyright (C) 1994-2021 Altair Engineering, Inc.
+# For more information, contact Altair at www.altair.com.
+#
+# This file is part of both the OpenPBS software ("OpenPBS")
+# and the PBS Professional ("PBS Pro") software.
+#
+# Open Source License Information:
+#
+# OpenPBS is free software. You can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# OpenPBS is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public
+# License for more details.
+#
+# You should have received a copy of the GNU Affero General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Commercial License Information:
+#
+# PBS Pro is commercially licensed software that shares a common core with
+# the OpenPBS software.  For a copy of the commercial license terms and
+# conditions, go to: (http://www.pbspro.com/agreement.html) or contact the
+# Altair Legal Department.
+#
+# Altair's dual-license business model allows companies, individuals, and
+# organizations to create proprietary derivative works of OpenPBS and
+# distribute them - whether embedded or bundled with other software -
+# under a commercial license agreement.
+#
+# Use of Altair's trademarks, including but not limited to "PBS™",
+# "OpenPBS®", "PBS Professional®", and "PBS Pro™" and Altair's logos is
+# subject to Altair's trademark licensing policies.
+
+
+from tests.functional import *
+
+
+class TestStatJobCache(TestFunctional):
+    """
+    Test that job status replies reused from the server's per job cache
+    reflect changes made to the job between queries
+    """
+
+    def setUp(self):
+        TestFunctional.setUp(self)
+        a = {'resources_available.ncpus': 2}
+        self.mom.create_vnodes(a, 1, usenatvnode=True)
+
+    def test_cached_status_updates(self):
+        """
+        Query a job repeatedly, as a user and as a manager, with all and
+        with selected attributes, and check modifications show up
+        """
+        j = Job(TEST_USER, {ATTR_N: 'before'})
+        j.set_sleep_time(1000)
+        jid = self.server.submit(j)
+        self.server.expect(JOB, {'job_state': 'R', ATTR_N: 'before'}, id=jid)
+
+        for _ in range(2):
+            self.server.expect(JOB, {ATTR_N: 'before'}, id=jid,
+                               runas=TEST_USER)
+            st = self.server.status(JOB, id=jid)
+            self.assertEqual(st[0][ATTR_N], 'before')
+
+        self.server.alterjob(jid, {ATTR_N: 'after'})
+        self.server.expect(JOB, {ATTR_N: 'after'}, id=jid, runas=TEST_USER)
+        st = self.server.status(JOB, id=jid)
+        self.assertEqual(st[0][ATTR_N], 'after')
+
+        # suspending only changes a server flag, the reported state must
+        # still change
+        self.server.sigjob(jid, 'suspend')
+        self.server.expect(JOB, {'job_state': 'S'}, id=jid, runas=TEST_USER)
+        self.server.expect(JOB, {'job_state': 'S'}, id=jid)
+        self.server.sigjob(jid, 'resume')
+        self.server.expect(JOB, {'job_state': 'R'}, id=jid, runas=TEST_USER)
+        self.server.expect(JOB, {'job_state': 'R'}, id=jid)
@@ -0,0 +1,212 @@
+# coding: utf-8
+
+# Copyright (C) 1994-2021 Altair Engineering, Inc.
+# For more information, contact Altair at www.altair.com.
+#
+# This file is part of both the OpenPBS software ("OpenPBS")
+# and the PBS Professional ("PBS Pro") software.
+#
+# Open Source License Information:
+#
+# OpenPBS is free software. You can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# OpenPBS is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public
+# License for more details.
+#
+# You should have received a copy of the GNU Affero General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Commercial License Information:
+#
+# PBS Pro is commercially licensed software that shares a common core with
+# the OpenPBS software.  For a copy of the commercial license terms and
+# conditions, go to: (http://www.pbspro.com/agreement.html) or contact the
+# Altair Legal Department.
+#
+# Altair's dual-license business model allows companies, individuals, and
+# organizations to create proprietary derivative works of OpenPBS and
+# distribute them - whether embedded or bundled with other software -
+# under a commercial license agreement.
+#
+# Use of Altair's trademarks, including but not limited to "PBS™",
+# "OpenPBS®", "PBS Professional®", and "PBS Pro™" and Altair's logos is
+# subject to Altair's trademark licensing policies.
+
+
+from tests.interfaces import *
+
+test_code = """
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pbs_error.h>
+#include <pbs_ifl.h>
+
+int main(int argc, char **argv)
+{
+    struct batch_deljob_status *failed;
+    struct batch_deljob_status *p;
+    char *jobids[16];
+    struct attrl attrs[16];
+    struct attrl *attribs[16];
+    int count = 0;
+    int c;
+    int i;
+
+    if (argc < 4 || argc % 3 != 1 || argc > 49)
+        return 1;
+    for (i = 1; i < argc; i += 3) {
+        jobids[count] = argv[i];
+        memset(&attrs[count], 0, sizeof(struct attrl));
+        attrs[count].name = argv[i + 1];
+        attrs[count].value = argv[i + 2];
+        attribs[count] = &attrs[count];
+        count++;
+    }
+    c = pbs_connect(NULL);
+    if (c <= 0)
+        return 1;
+    failed = pbs_alterjoblist(c, jobids, attribs, count, NULL);
+    if (failed == NULL && pbs_errno != PBSE_NONE) {
+        printf("error %d\\n", pbs_errno);
+        pbs_disconnect(c);
+        return 0;
+    }
+    for (p = failed; p != NULL; p = p->next)
+        printf("%s %d\\n", p->name, p->code);
+    pbs_delstatfree(failed);
+    pbs_disconnect(c);
+    return 0;
+}
+"""
+
+
+class TestAlterJobList(TestInterfaces):
+    """
+    Test suite for the pbs_alterjoblist() API
+    """
+
+    def setUp(self):
+        TestInterfaces.setUp(self)
+        if self.du.get_platform().lower() != 'linux':
+            self.skipTest("This test is only supported on Linux!")
+        _gcc = self.du.which(exe='gcc')
+        if _gcc == 'gcc':
+            self.skipTest("Couldn't find gcc!")
+        _exec = self.server.pbs_conf['PBS_EXEC']
+        _id = os.path.join(_exec, 'include')
+        self.ld = os.path.join(_exec, 'lib')
+        if not self.du.isfile(path=os.path.join(_id, 'pbs_ifl.h')):
+            _m = "Couldn't find pbs_ifl.h in %s" % _id
+            _m += ", Please install PBS devel package"
+            self.skipTest(_m)
+        _fn = self.du.create_temp_file(body=test_code, suffix='.c')
+        self.exe = self.du.create_temp_file()
+        self.du.rm(path=self.exe)
+        cmd = ['gcc', '-g', '-O2', '-Wall', '-Werror', '-o', self.exe]
+        cmd += ['-I%s' % _id, _fn, '-L%s' % self.ld, '-lpbs', '-lz']
+        _res = self.du.run_cmd(cmd=cmd)
+        self.assertEqual(_res['rc'], 0, "\n".join(_res['err']))
+
+    def alterjoblist(self, changes, runas=None):
+        """
+        Apply the (job id, attribute, value) changes with one request and
+        return the lines reported by the test program
+        """
+        args = ' '.join('"%s" "%s" "%s"' % c for c in changes)
+        cmd = ['LD_LIBRARY_PATH=%s %s %s' % (self.ld, self.exe, args)]
+        if runas is None:
+            _res = self.du.run_cmd(cmd=cmd, as_script=True, sudo=True)
+        else:
+            _res = self.du.run_cmd(cmd=cmd, as_script=True, runas=runas)
+        self.assertEqual(_res['rc'], 0)
+        return _res['out']
+
+    def test_alterjoblist(self):
+        """
+        Test that the valid changes of a list are applied and that only
+        the jobs which could not be altered are reported back
+        """
+        self.server.manager(MGR_CMD_SET, SERVER, {'scheduling': 'False'})
+        jid1 = self.server.submit(Job(TEST_USER))
+        jid2 = self.server.submit(Job(TEST_USER))
+        jid3 = self.server.submit(Job(TEST_USER))
+        bad = '999999.' + self.server.shortname
+
+        out = self.alterjoblist([(jid1, ATTR_comment, 'first'),
+                                 (bad, ATTR_comment, 'none'),
+                                 (jid2, 'no_such_attr', 'x'),
+                                 (jid3, ATTR_comment, 'third')])
+        failed = dict(line.split() for line in out)
+        self.assertEqual(sorted(failed.keys()), sorted([bad, jid2]))
+        self.assertEqual(int(failed[bad]), 15001)
+        self.assertEqual(int(failed[jid2]), 15002)
+
+        self.server.expect(JOB, {ATTR_comment: 'first'}, id=jid1)
+        self.server.expect(JOB, {ATTR_comment: 'third'}, id=jid3)
+
+    def test_alterjoblist_perm(self):
+        """
+        Test that a user can alter their own jobs in a list but not the
+        jobs of another user
+        """
+        self.server.manager(MGR_CMD_SET, SERVER, {'scheduling': 'False'})
+        jid1 = self.server.submit(Job(TEST_USER))
+        jid2 = self.server.submit(Job(TEST_USER1))
+
+        out = self.alterjoblist([(jid1, ATTR_N, 'mine'),
+                                 (jid2, ATTR_N, 'theirs')], runas=TEST_USER)
+        self.assertEqual(out, ['%s 15007' % jid2])
+        self.server.expect(JOB, {ATTR_N: 'mine'}, id=jid1)
+
+    def test_sched_comments(self):
+        """
+        Test that the comments the scheduler sets on the jobs it can not
+        run, now sent together at the end of the cycle, reach the server
+        """
+        a = {'resources_available.ncpus': 1}
+        self.mom.create_vnodes(a, 1, usenatvnode=True)
+        jids = []
+        for _ in range(3):
+            j = Job(TEST_USER, {'Resource_List.ncpus': 2})
+            jids.append(self.server.submit(j))
+        for jid in jids:
+            self.server.expect(JOB, {'job_state': 'Q',
+                                     ATTR_comment: (MATCH_RE, 'Not Running')},
+                               id=jid)
+
+    def test_alterjoblist_hooks(self):
+        """
+        Test that modifyjob hooks run for the jobs of a user's list, but
+        not for the scheduler's list even with PBS_SCHED_MODIFY_EVENT set,
+        as for its asynchronous alter requests
+        """
+        self.du.set_pbs_config(confs={'PBS_SCHED_MODIFY_EVENT': '1'})
+        self.server.restart()
+        hook_body = """
+import pbs
+pbs.event().reject("no modify")
+"""
+        self.server.create_import_hook('rejmod', {'event': 'modifyjob'},
+                                       hook_body, overwrite=True)
+
+        self.server.manager(MGR_CMD_SET, SERVER, {'scheduling': 'False'})
+        jid1 = self.server.submit(Job(TEST_USER))
+        out = self.alterjoblist([(jid1, ATTR_comment, 'user')],
+                                runas=TEST_USER)
+        self.assertEqual([line.split()[0] for line in out], [jid1])
+        self.server.expect(JOB, {ATTR_comment: 'user'}, op=NE, id=jid1)
+
+        a = {'resources_available.ncpus': 1}
+        self.mom.create_vnodes(a, 1, usenatvnode=True)
+        jid2 = self.server.submit(Job(TEST_USER, {'Resource_List.ncpus': 2}))
+        self.server.manager(MGR_CMD_SET, SERVER, {'scheduling': 'True'})
+        self.server.expect(JOB, {'job_state': 'Q',
+                                 ATTR_comment: (MATCH_RE, 'Not Running')},
+                           id=jid2)
+
@@ -0,0 +1,157 @@
+# coding: utf-8
+
+# Copyright (C) 1994-2021 Altair Engineering, Inc.
+# For more information, contact Altair at www.altair.com.
+#
+# This file is part of both the OpenPBS software ("OpenPBS")
+# and the PBS Professional ("PBS Pro") software.
+#
+# Open Source License Information:
+#
+# OpenPBS is free software. You can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# OpenPBS is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public
+# License for more details.
+#
+# You should have received a copy of the GNU Affero General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Commercial License Information:
+#
+# PBS Pro is commercially licensed software that shares a common core with
+# the OpenPBS software.  For a copy of the commercial license terms and
+# conditions, go to: (http://www.pbspro.com/agreement.html) or contact the
+# Altair Legal Department.
+#
+# Altair's dual-license business model allows companies, individuals, and
+# organizations to create proprietary derivative works of OpenPBS and
+# distribute them - whether embedded or bundled with other software -
+# under a commercial license agreement.
+#
+# Use of Altair's trademarks, including but not limited to "PBS™",
+# "OpenPBS®", "PBS Professional®", and "PBS Pro™" and Altair's logos is
+# subject to Altair's trademark licensing policies.
+
+
+from tests.interfaces import *
+
+test_code = '''
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pbs_error.h>
+#include <pbs_ifl.h>
+
+int main(int argc, char **argv)
+{
+    struct batch_deljob_status *failed;
+    struct batch_deljob_status *p;
+    char *jobids[16];
+    char *locations[16];
+    int count = 0;
+    int c;
+    int i;
+
+    if (argc < 3 || argc % 2 == 0 || argc > 33)
+        return 1;
+    for (i = 1; i < argc; i += 2) {
+        jobids[count] = argv[i];
+        locations[count++] = argv[i + 1];
+    }
+    c = pbs_connect(NULL);
+    if (c <= 0)
+        return 1;
+    failed = pbs_runjoblist(c, jobids, locations, count, NULL);
+    if (failed == NULL && pbs_errno != PBSE_NONE) {
+        printf("error %d\\n", pbs_errno);
+        pbs_disconnect(c);
+        return 0;
+    }
+    for (p = failed; p != NULL; p = p->next)
+        printf("%s %d\\n", p->name, p->code);
+    pbs_delstatfree(failed);
+    pbs_disconnect(c);
+    return 0;
+}
+'''
+
+
+class TestRunJobList(TestInterfaces):
+    """
+    Test suite for the pbs_runjoblist() API
+    """
+
+    def setUp(self):
+        TestInterfaces.setUp(self)
+        if self.du.get_platform().lower() != 'linux':
+            self.skipTest("This test is only supported on Linux!")
+        _gcc = self.du.which(exe='gcc')
+        if _gcc == 'gcc':
+            self.skipTest("Couldn't find gcc!")
+        _exec = self.server.pbs_conf['PBS_EXEC']
+        _id = os.path.join(_exec, 'include')
+        self.ld = os.path.join(_exec, 'lib')
+        if not self.du.isfile(path=os.path.join(_id, 'pbs_ifl.h')):
+            _m = "Couldn't find pbs_ifl.h in %s" % _id
+            _m += ", Please install PBS devel package"
+            self.skipTest(_m)
+        _fn = self.du.create_temp_file(body=test_code, suffix='.c')
+        self.exe = self.du.create_temp_file()
+        self.du.rm(path=self.exe)
+        cmd = ['gcc', '-g', '-O2', '-Wall', '-Werror', '-o', self.exe]
+        cmd += ['-I%s' % _id, _fn, '-L%s' % self.ld, '-lpbs', '-lz']
+        _res = self.du.run_cmd(cmd=cmd)
+        self.assertEqual(_res['rc'], 0, "\n".join(_res['err']))
+
+    def runjoblist(self, pairs):
+        """
+        Run the jobs in the (job id, location) pairs with one request and
+        return the lines reported by the test program
+        """
+        args = ' '.join('"%s" "%s"' % (j, l) for (j, l) in pairs)
+        cmd = ['LD_LIBRARY_PATH=%s %s %s' % (self.ld, self.exe, args)]
+        _res = self.du.run_cmd(cmd=cmd, as_script=True, sudo=True)
+        self.assertEqual(_res['rc'], 0)
+        return _res['out']
+
+    def test_runjoblist(self):
+        """
+        Test that the valid jobs of a list run and that only the jobs
+        which could not be run are reported back
+        """
+        self.server.manager(MGR_CMD_SET, SERVER, {'scheduling': 'False'})
+        vn = self.mom.shortname
+        jid1 = self.server.submit(Job(TEST_USER))
+        jid2 = self.server.submit(Job(TEST_USER))
+        jid3 = self.server.submit(Job(TEST_USER))
+        bad = '999999.' + self.server.shortname
+
+        out = self.runjoblist([(jid1, '(%s:ncpus=1)' % vn),
+                               (bad, '(%s:ncpus=1)' % vn),
+                               (jid2, ''),
+                               (jid3, '(%s:ncpus=1)' % vn)])
+        failed = dict(line.split() for line in out)
+        self.assertEqual(sorted(failed.keys()), sorted([bad, jid2]))
+        self.assertEqual(int(failed[bad]), 15001)
+        self.assertEqual(int(failed[jid2]), 15004)
+
+        self.server.expect(JOB, {'job_state': 'R'}, id=jid1)
+        self.server.expect(JOB, {'job_state': 'R'}, id=jid3)
+        self.server.expect(JOB, {'job_state': 'Q'}, id=jid2)
+
+    def test_runjoblist_perm(self):
+        """
+        Test that a user without operator or manager privilege can not
+        run jobs with pbs_runjoblist()
+        """
+        jid = self.server.submit(Job(TEST_USER, {ATTR_h: None}))
+        args = '"%s" "(%s:ncpus=1)"' % (jid, self.mom.shortname)
+        cmd = ['LD_LIBRARY_PATH=%s %s %s' % (self.ld, self.exe, args)]
+        _res = self.du.run_cmd(cmd=cmd, as_script=True, runas=TEST_USER)
+        self.assertEqual(_res['rc'], 0)
+        self.assertEqual(_res['out'], ['error 15007'])
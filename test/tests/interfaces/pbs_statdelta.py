@@ -0,0 +1,174 @@
+# coding: utf-8
+
+# Copyright (C) 1994-2021 Altair Engineering, Inc.
+# For more information, contact Altair at www.altair.com.
+#
+# This file is part of both the OpenPBS software ("OpenPBS")
+# and the PBS Professional ("PBS Pro") software.
+#
+# Open Source License Information:
+#
+# OpenPBS is free software. You can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# OpenPBS is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public
+# License for more details.
+#
+# You should have received a copy of the GNU Affero General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Commercial License Information:
+#
+# PBS Pro is commercially licensed software that shares a common core with
+# the OpenPBS software.  For a copy of the commercial license terms and
+# conditions, go to: (http://www.pbspro.com/agreement.html) or contact the
+# Altair Legal Department.
+#
+# Altair's dual-license business model allows companies, individuals, and
+# organizations to create proprietary derivative works of OpenPBS and
+# distribute them - whether embedded or bundled with other software -
+# under a commercial license agreement.
+#
+# Use of Altair's trademarks, including but not limited to "PBS™",
+# "OpenPBS®", "PBS Professional®", and "PBS Pro™" and Altair's logos is
+# subject to Altair's trademark licensing policies.
+
+
+from tests.interfaces import *
+
+test_code = '''
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pbs_error.h>
+#include <pbs_ifl.h>
+
+int main(int argc, char **argv)
+{
+    struct batch_status *status = NULL;
+    struct batch_status *bs;
+    long newseq = -1;
+    int c;
+
+    if (argc != 2)
+        return 1;
+    c = pbs_connect(NULL);
+    if (c <= 0)
+        return 1;
+    status = pbs_statdelta(c, MGR_OBJ_JOB, atol(argv[1]), &newseq,
+        NULL, NULL);
+    if (status == NULL && pbs_errno != PBSE_NONE) {
+        printf("error %d\\n", pbs_errno);
+        pbs_disconnect(c);
+        return 0;
+    }
+    for (bs = status; bs != NULL; bs = bs->next) {
+        if (bs->attribs != NULL &&
+            !strcmp(bs->attribs->name, ATTR_deleted))
+            printf("%s deleted\\n", bs->name);
+        else
+            printf("%s\\n", bs->name);
+    }
+    printf("seq %ld\\n", newseq);
+    pbs_statfree(status);
+    pbs_disconnect(c);
+    return 0;
+}
+'''
+
+
+class TestStatDelta(TestInterfaces):
+    """
+    Test suite for the pbs_statdelta() API
+    """
+
+    def setUp(self):
+        TestInterfaces.setUp(self)
+        if self.du.get_platform().lower() != 'linux':
+            self.skipTest("This test is only supported on Linux!")
+        _gcc = self.du.which(exe='gcc')
+        if _gcc == 'gcc':
+            self.skipTest("Couldn't find gcc!")
+        _exec = self.server.pbs_conf['PBS_EXEC']
+        _id = os.path.join(_exec, 'include')
+        self.ld = os.path.join(_exec, 'lib')
+        if not self.du.isfile(path=os.path.join(_id, 'pbs_ifl.h')):
+            _m = "Couldn't find pbs_ifl.h in %s" % _id
+            _m += ", Please install PBS devel package"
+            self.skipTest(_m)
+        _fn = self.du.create_temp_file(body=test_code, suffix='.c')
+        self.exe = self.du.create_temp_file()
+        self.du.rm(path=self.exe)
+        cmd = ['gcc', '-g', '-O2', '-Wall', '-Werror', '-o', self.exe]
+        cmd += ['-I%s' % _id, _fn, '-L%s' % self.ld, '-lpbs', '-lz']
+        _res = self.du.run_cmd(cmd=cmd)
+        self.assertEqual(_res['rc'], 0, "\n".join(_res['err']))
+
+    def statdelta(self, seq, user=None):
+        """
+        Run the test program, as user if given, and return the reported
+        jobs and the new change sequence number
+        """
+        cmd = ['LD_LIBRARY_PATH=%s %s %d' % (self.ld, self.exe, seq)]
+        _res = self.du.run_cmd(cmd=cmd, as_script=True, runas=user)
+        self.assertEqual(_res['rc'], 0)
+        out = _res['out']
+        if out and out[0].startswith('error'):
+            return out[0], None
+        self.assertTrue(out[-1].startswith('seq '))
+        return out[:-1], int(out[-1].split()[1])
+
+    def test_statdelta_jobs(self):
+        """
+        Test that only changed and deleted jobs are reported after the
+        first query, and that a stale sequence number is rejected
+        """
+        jid1 = self.server.submit(Job(TEST_USER, {ATTR_h: None}))
+        jid2 = self.server.submit(Job(TEST_USER, {ATTR_h: None}))
+        jid3 = self.server.submit(Job(TEST_USER, {ATTR_h: None}))
+
+        jobs, seq = self.statdelta(0)
+        self.assertEqual(sorted(jobs), sorted([jid1, jid2, jid3]))
+        self.assertGreater(seq, 0)
+
+        jobs, seq2 = self.statdelta(seq)
+        self.assertEqual(jobs, [])
+
+        self.server.alterjob(jid1, {ATTR_N: 'changed'})
+        self.server.deljob(jid2, wait=True)
+        jobs, seq3 = self.statdelta(seq2)
+        self.assertEqual(sorted(jobs), sorted([jid1, jid2 + ' deleted']))
+        self.assertGreater(seq3, seq2)
+
+        # a sequence number from before this server instance started
+        jobs, seq = self.statdelta(1)
+        self.assertEqual(jobs, 'error 15233')
+        self.assertIsNone(seq)
+
+    def test_statdelta_others_jobs(self):
+        """
+        Test that with query_other_jobs unset a user is neither told about
+        the changes nor the deletion of another user's job
+        """
+        self.server.manager(MGR_CMD_SET, SERVER,
+                            {'query_other_jobs': 'False'})
+        jid = self.server.submit(Job(TEST_USER, {ATTR_h: None}))
+
+        jobs, seq1 = self.statdelta(0, user=TEST_USER)
+        self.assertEqual(jobs, [jid])
+        jobs, seq2 = self.statdelta(0, user=TEST_USER1)
+        self.assertEqual(jobs, [])
+
+        self.server.alterjob(jid, {ATTR_N: 'changed'})
+        jobs, seq2 = self.statdelta(seq2, user=TEST_USER1)
+        self.assertEqual(jobs, [])
+
+        self.server.deljob(jid, wait=True)
+        jobs, _ = self.statdelta(seq2, user=TEST_USER1)
+        self.assertEqual(jobs, [])
+        jobs, _ = self.statdelta(seq1, user=TEST_USER)
+        self.assertEqual(jobs, [jid + ' deleted'])
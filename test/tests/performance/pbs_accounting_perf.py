@@ -0,0 +1,98 @@
+# coding: utf-8
+
+# Copyright (C) 1994-2021 Altair Engineering, Inc.
+# For more information, contact Altair at www.altair.com.
+#
+# This file is part of both the OpenPBS software ("OpenPBS")
+# and the PBS Professional ("PBS Pro") software.
+#
+# Open Source License Information:
+#
+# OpenPBS is free software. You can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# OpenPBS is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public
+# License for more details.
+#
+# You should have received a copy of the GNU Affero General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Commercial License Information:
+#
+# PBS Pro is commercially licensed software that shares a common core with
+# the OpenPBS software.  For a copy of the commercial license terms and
+# conditions, go to: (http://www.pbspro.com/agreement.html) or contact the
+# Altair Legal Department.
+#
+# Altair's dual-license business model allows companies, individuals, and
+# organizations to create proprietary derivative works of OpenPBS and
+# distribute them - whether embedded or bundled with other software -
+# under a commercial license agreement.
+#
+# Use of Altair's trademarks, including but not limited to "PBS™",
+# "OpenPBS®", "PBS Professional®", and "PBS Pro™" and Altair's logos is
+# subject to Altair's trademark licensing policies.
+
+
+
+from tests.performance import *
+
+
+class TestAccountingPerformance(TestPerformance):
+    """
+    Measure how fast the server writes accounting records when many
+    running jobs end at once, with and without acct_sync_interval
+    """
+
+    def setUp(self):
+        TestPerformance.setUp(self)
+        a = {'resources_available.ncpus': 1000}
+        self.server.manager(MGR_CMD_SET, NODE, a, self.mom.shortname)
+
+    def job_end_storm(self, njobs):
+        """
+        Start njobs jobs, then delete all of them together and return
+        the time taken for every job to end
+        """
+        self.server.manager(MGR_CMD_SET, SERVER, {'scheduling': 'False'})
+        j = Job(TEST_USER, {'Resource_List.ncpus': 1})
+        j.set_sleep_time(3600)
+        jids = []
+        for _ in range(njobs):
+            jids.append(self.server.submit(j))
+        self.server.manager(MGR_CMD_SET, SERVER, {'scheduling': 'True'})
+        self.server.expect(JOB, {'job_state=R': njobs}, interval=5,
+                           max_attempts=120)
+
+        t1 = time.time()
+        self.server.delete(jids, wait=True)
+        t2 = time.time()
+        for jid in (jids[0], jids[-1]):
+            self.server.accounting_match(msg='.*;E;' + jid + ';.*',
+                                         regexp=True, n='ALL')
+        return t2 - t1
+
+    @timeout(3600)
+    def test_job_end_storm(self):
+        """
+        End 1000 running jobs at once with records written through and
+        again with records batched and synced every 5 seconds, and
+        report both times.
+        """
+        njobs = 1000
+        t_direct = self.job_end_storm(njobs)
+        self.server.manager(MGR_CMD_SET, SERVER,
+                            {'acct_sync_interval': 5})
+        t_batched = self.job_end_storm(njobs)
+        self.server.manager(MGR_CMD_UNSET, SERVER, 'acct_sync_interval')
+
+        self.logger.info('#' * 80)
+        self.logger.info('Time taken to end %d jobs: %f written through, '
+                         '%f batched' % (njobs, t_direct, t_batched))
+        self.logger.info('#' * 80)
+        self.perf_test_result(t_direct, "job_end_storm_direct", "sec")
+        self.perf_test_result(t_batched, "job_end_storm_batched", "sec")
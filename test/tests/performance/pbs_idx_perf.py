@@ -0,0 +1,96 @@
+# coding: utf-8
+
+# Copyright (C) 1994-2021 Altair Engineering, Inc.
+# For more information, contact Altair at www.altair.com.
+#
+# This file is part of both the OpenPBS software ("OpenPBS")
+# and the PBS Professional ("PBS Pro") software.
+#
+# Open Source License Information:
+#
+# OpenPBS is free software. You can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# OpenPBS is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public
+# License for more details.
+#
+# You should have received a copy of the GNU Affero General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Commercial License Information:
+#
+# PBS Pro is commercially licensed software that shares a common core with
+# the OpenPBS software.  For a copy of the commercial license terms and
+# conditions, go to: (http://www.pbspro.com/agreement.html) or contact the
+# Altair Legal Department.
+#
+# Altair's dual-license business model allows companies, individuals, and
+# organizations to create proprietary derivative works of OpenPBS and
+# distribute them - whether embedded or bundled with other software -
+# under a commercial license agreement.
+#
+# Use of Altair's trademarks, including but not limited to "PBS™",
+# "OpenPBS®", "PBS Professional®", and "PBS Pro™" and Altair's logos is
+# subject to Altair's trademark licensing policies.
+
+
+
+from tests.performance import *
+
+
+class TestJobIndexPerformance(TestPerformance):
+    """
+    Test the performance of the server's job index lookups with a
+    large number of jobs
+    """
+
+    def setUp(self):
+        TestPerformance.setUp(self)
+        self.server.manager(MGR_CMD_SET, SERVER, {'scheduling': 'False'})
+
+    @timeout(3600)
+    def test_find_jobs_by_id(self):
+        """
+        Submit many held jobs, then measure the time the server takes
+        to stat, release and delete each of them by job id, every one
+        of which looks the job up in the job index.
+        """
+        njobs = 10000
+        jids = []
+        for _ in range(njobs):
+            j = Job(TEST_USER, {ATTR_h: None})
+            jids.append(self.server.submit(j))
+        self.server.expect(JOB, {'job_state=H': njobs})
+
+        t1 = time.time()
+        for jid in jids:
+            self.server.status(JOB, id=jid)
+        t2 = time.time()
+        self.logger.info('#' * 80)
+        self.logger.info('Time taken to stat %d jobs by id %f' %
+                         (njobs, t2 - t1))
+        self.logger.info('#' * 80)
+        self.perf_test_result((t2 - t1), "time_taken_stat_jobs_by_id", "sec")
+
+        t1 = time.time()
+        for jid in jids:
+            self.server.rlsjob(jid, USER_HOLD)
+        t2 = time.time()
+        self.logger.info('#' * 80)
+        self.logger.info('Time taken to release %d jobs %f' %
+                         (njobs, t2 - t1))
+        self.logger.info('#' * 80)
+        self.perf_test_result((t2 - t1), "time_taken_release_jobs", "sec")
+
+        t1 = time.time()
+        self.server.delete(jids, wait=True)
+        t2 = time.time()
+        self.logger.info('#' * 80)
+        self.logger.info('Time taken to delete %d jobs %f' %
+                         (njobs, t2 - t1))
+        self.logger.info('#' * 80)
+        self.perf_test_result((t2 - t1), "time_taken_delete_jobs", "sec")
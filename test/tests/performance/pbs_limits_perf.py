@@ -0,0 +1,113 @@
+# coding: utf-8
+
+# Copyright (C) 1994-2021 Altair Engineering, Inc.
+# For more information, contact Altair at www.altair.com.
+#
+# This file is part of both the OpenPBS software ("OpenPBS")
+# and the PBS Professional ("PBS Pro") software.
+#
+# Open Source License Information:
+#
+# OpenPBS is free software. You can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# OpenPBS is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public
+# License for more details.
+#
+# You should have received a copy of the GNU Affero General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Commercial License Information:
+#
+# PBS Pro is commercially licensed software that shares a common core with
+# the OpenPBS software.  For a copy of the commercial license terms and
+# conditions, go to: (http://www.pbspro.com/agreement.html) or contact the
+# Altair Legal Department.
+#
+# Altair's dual-license business model allows companies, individuals, and
+# organizations to create proprietary derivative works of OpenPBS and
+# distribute them - whether embedded or bundled with other software -
+# under a commercial license agreement.
+#
+# Use of Altair's trademarks, including but not limited to "PBS™",
+# "OpenPBS®", "PBS Professional®", and "PBS Pro™" and Altair's logos is
+# subject to Altair's trademark licensing policies.
+
+
+from tests.performance import *
+
+
+class TestLimitsPerf(TestPerformance):
+    """
+    Measure scheduling cycle time when run limits have to be checked
+    against a large population of limit entities
+    """
+
+    def setUp(self):
+        TestPerformance.setUp(self)
+        self.nrunning = 1000
+        a = {'resources_available.ncpus': self.nrunning}
+        self.server.manager(MGR_CMD_SET, NODE, a, self.mom.shortname)
+        self.server.manager(MGR_CMD_SET, SCHED, {'log_events': 2047})
+
+    def run_n_get_cycle_time(self):
+        """
+        Run a scheduling cycle and return its duration
+        """
+        t = time.time()
+        self.server.manager(MGR_CMD_SET, MGR_OBJ_SERVER,
+                            {'scheduling': 'True'})
+        self.server.manager(MGR_CMD_SET, MGR_OBJ_SERVER,
+                            {'scheduling': 'False'})
+        self.scheduler.log_match("Leaving Scheduling Cycle", starttime=t,
+                                 max_attempts=300, interval=3)
+        c = self.scheduler.cycles(lastN=1)[0]
+        return c.end - c.start
+
+    def submit_project_jobs(self, first, nprojects, njobs_each):
+        """
+        Submit njobs_each jobs for each of nprojects projects, numbering
+        the projects from first
+        """
+        for p in range(first, first + nprojects):
+            j = Job(TEST_USER, {ATTR_project: 'proj%d' % p,
+                                'Resource_List.ncpus': 1})
+            j.set_sleep_time(3600)
+            for _ in range(njobs_each):
+                self.server.submit(j)
+
+    @timeout(7200)
+    def test_check_limits_many_entities(self):
+        """
+        Fill the complex with one job per project, then submit ten more
+        jobs per project and time a cycle where all of them have to be
+        checked against the server and queue limits of their project.
+        """
+        a = {'max_run': '[p:PBS_GENERIC=1]',
+             'max_run_res.ncpus': '[p:PBS_GENERIC=1]'}
+        self.server.manager(MGR_CMD_SET, SERVER, a)
+        self.server.manager(MGR_CMD_SET, QUEUE, a, id='workq')
+        self.server.manager(MGR_CMD_SET, SERVER, {'scheduling': 'False'})
+
+        self.submit_project_jobs(0, self.nrunning, 1)
+        self.run_n_get_cycle_time()
+        self.server.expect(JOB, {'job_state=R': self.nrunning}, interval=5,
+                           max_attempts=120)
+
+        # every queued job is held back by its project's limit
+        self.submit_project_jobs(0, self.nrunning, 10)
+        cycle_time = self.run_n_get_cycle_time()
+        self.server.expect(JOB, {'job_state=Q': self.nrunning * 10},
+                           interval=5, max_attempts=120)
+
+        self.logger.info('#' * 80)
+        self.logger.info('Cycle time with %d limit entities and %d queued '
+                         'jobs: %f' % (self.nrunning, self.nrunning * 10,
+                                       cycle_time))
+        self.logger.info('#' * 80)
+        self.perf_test_result(cycle_time, "check_limits_many_entities",
+                              "sec")
@@ -465,3 +465,44 @@ class TestSchedPerf(TestPerformance):
         msg1 = 'Multi scheduler is faster than single scheduler by '
         msg2 = 'secs in scheduling 5000 jobs with 5 schedulers'
         self.logger.info(msg1 + str(cyc_dur - max_dur) + msg2)
+
+    def set_sched_threads(self, nthreads):
+        """
+        Restart the scheduler with PBS_SCHED_THREADS set to nthreads,
+        or unset if nthreads is None
+        """
+        if nthreads is None:
+            self.du.unset_pbs_config(confs=['PBS_SCHED_THREADS'])
+        else:
+            self.du.set_pbs_config(confs={'PBS_SCHED_THREADS': nthreads})
+        self.scheduler.restart()
+
+    @timeout(3600)
+    def test_sched_threads_scaling(self):
+        """
+        Time a cycle over 10k nodes which can't run any jobs with one
+        scheduler thread and with the default number of threads.
+        The multi-threaded phases (node query, dup and eligibility)
+        should not be slower when spread over the thread pool.
+        """
+        self.common_setup1()
+        ncpus = os.cpu_count()
+        if ncpus is None or ncpus < 4:
+            self.skipTest('Need at least 4 cpus to compare thread counts')
+
+        # Jobs ask for more blue nodes than exist so every job is
+        # checked against every node in the complex
+        a = {'Resource_List.select': '1431:ncpus=1:color=blue',
+             'Resource_List.place': 'scatter'}
+        self.submit_jobs(a, 500)
+
+        self.set_sched_threads(1)
+        t1 = self.run_cycle()
+        self.set_sched_threads(None)
+        tn = self.run_cycle()
+
+        self.perf_test_result(t1, "cycle_time_one_sched_thread", "secs")
+        self.perf_test_result(tn, "cycle_time_default_sched_threads", "secs")
+        self.logger.info('Cycle time 1 thread: %.2f default threads: %.2f' %
+                         (t1, tn))
+        self.assertLessEqual(tn, t1)
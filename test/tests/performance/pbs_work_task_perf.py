@@ -0,0 +1,101 @@
+# coding: utf-8
+
+# Copyright (C) 1994-2021 Altair Engineering, Inc.
+# For more information, contact Altair at www.altair.com.
+#
+# This file is part of both the OpenPBS software ("OpenPBS")
+# and the PBS Professional ("PBS Pro") software.
+#
+# Open Source License Information:
+#
+# OpenPBS is free software. You can redistribute it and/or modify it under
+# the terms of the GNU Affero General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# OpenPBS is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Affero General Public
+# License for more details.
+#
+# You should have received a copy of the GNU Affero General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Commercial License Information:
+#
+# PBS Pro is commercially licensed software that shares a common core with
+# the OpenPBS software.  For a copy of the commercial license terms and
+# conditions, go to: (http://www.pbspro.com/agreement.html) or contact the
+# Altair Legal Department.
+#
+# Altair's dual-license business model allows companies, individuals, and
+# organizations to create proprietary derivative works of OpenPBS and
+# distribute them - whether embedded or bundled with other software -
+# under a commercial license agreement.
+#
+# Use of Altair's trademarks, including but not limited to "PBS™",
+# "OpenPBS®", "PBS Professional®", and "PBS Pro™" and Altair's logos is
+# subject to Altair's trademark licensing policies.
+
+
+
+from tests.performance import *
+
+
+class TestWorkTaskPerformance(TestPerformance):
+    """
+    Test the performance of the server's timed work task handling with
+    a large number of jobs waiting on an execution time
+    """
+
+    def setUp(self):
+        TestPerformance.setUp(self)
+        self.server.manager(MGR_CMD_SET, SERVER, {'scheduling': 'False'})
+
+    def submit_waiting_jobs(self, njobs, timedelta):
+        """
+        Submit njobs jobs in W state using the -a option, each with its own
+        execution time so that every job owns a distinct timed work task.
+        """
+        now = int(time.time())
+        jids = []
+        for i in range(njobs):
+            a = {ATTR_a: BatchUtils().convert_seconds_to_datetime(
+                now + timedelta + i * 60)}
+            jids.append(self.server.submit(Job(TEST_USER, a)))
+        self.server.expect(JOB, {'job_state=W': njobs})
+        return jids
+
+    @timeout(3600)
+    def test_alter_and_delete_waiting_jobs(self):
+        """
+        Submit many jobs with future execution times, then measure the time
+        the server takes to move each job's timed work task with qalter -a
+        and to remove all of the tasks with qdel.
+        """
+        njobs = 5000
+        jids = self.submit_waiting_jobs(njobs, 3600)
+
+        now = int(time.time())
+        t1 = time.time()
+        for i, jid in enumerate(jids):
+            a = {ATTR_a: BatchUtils().convert_seconds_to_datetime(
+                now + 7200 + i * 60)}
+            self.server.alterjob(jid, a)
+        t2 = time.time()
+        self.logger.info('#' * 80)
+        self.logger.info('Time taken to alter %d waiting jobs %f' %
+                         (njobs, t2 - t1))
+        self.logger.info('#' * 80)
+        self.perf_test_result((t2 - t1),
+                              "time_taken_alter_waiting_jobs", "sec")
+
+        t1 = time.time()
+        self.server.delete(jids, wait=True)
+        t2 = time.time()
+        self.logger.info('#' * 80)
+        self.logger.info('Time taken to delete %d waiting jobs %f' %
+                         (njobs, t2 - t1))
+        self.logger.info('#' * 80)
+        self.perf_test_result((t2 - t1),
+                              "time_taken_delete_waiting_jobs", "sec")